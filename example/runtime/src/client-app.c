@@ -58,12 +58,16 @@ int main(int argc, char* argv[])
   struct ONNC_RUNTIME_tensor_file* const input  = open_tensor_file(argv[1]);
   struct ONNC_RUNTIME_tensor_file* const weight = open_tensor_file(argv[2]);
 
-  struct ONNC_RUNTIME_inference_context context = {.input = input, .weight = weight, .id = 0, .completed = finish};
+  struct ONNC_RUNTIME_model* const model = model_prepare(weight);
 
-  model_main(&context);
+  struct ONNC_RUNTIME_inference_context context = {
+    .input = input, .weight = weight, .id = 0, .completed = finish, .model = model};
 
+  const int status = model_main(&context);
+
+  model_release(model);
   close_tensor_file(input);
   close_tensor_file(weight);
 
-  return EXIT_SUCCESS;
+  return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
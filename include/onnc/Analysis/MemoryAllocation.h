@@ -37,6 +37,10 @@ typedef std::unordered_map<const xValue *, MemSize> ValMemSizeMap;
 
 /** \class MemoryAllocation
  *  Perform memory allocation and generate allocation map.
+ *
+ *  The local memory of a DLA is allocated per split graph. A graph which does
+ *  not fit is tiled, or split into more graphs. No backend registers this
+ *  pass yet; the backends allocate by addStandardMemoryAllocation.
  */
 class MemoryAllocation : public CustomPass<MemoryAllocation>
 {
@@ -12,12 +12,14 @@
 //===----------------------------------------------------------------------===//
 #ifndef NODE_IR_SCHEDULER_H
 #define NODE_IR_SCHEDULER_H
+#include <onnc/Analysis/SplitNode.h>
 #include <onnc/Core/CustomPass.h>
 #include <onnc/Core/PassSupport.h>
 #include <onnc/Target/DLATargetBackend.h>
 #include <onnc/Target/TargetTransformInfo.h>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace onnc {
@@ -27,6 +29,20 @@ typedef std::vector<xNode *> Nodes;
 /** \class NodeIRScheduler
  *  \brief onnx Graph IR scheduler. Reorder IR, especially load/store for
  *         better, even maximum performance.
+ *
+ *  The scheduler is a list scheduler over the execution resources. Ready
+ *  nodes are picked by their longest path to the end of the graph, and the
+ *  scheduler tracks the local memory occupied by the values in flight:
+ *  - Stores issue as early as possible, since they release local memory.
+ *  - A Load issues just in time, i.e. once the other operands of one of its
+ *    users are issued, so the DMA overlaps the producing computation.
+ *  - A node whose outputs do not fit in the memory budget waits for running
+ *    nodes to release memory.
+ *
+ *  No backend registers this pass or MemoryAllocation, which schedules each
+ *  split graph with runOnGraph(xGraph&, const ValMemSizeMap&, uint64_t).
+ *  Both are library passes for DLA backends which provide a
+ *  TargetTransformInfo and the local memory size.
  */
 class NodeIRScheduler : public CustomPass<NodeIRScheduler>
 {
@@ -60,8 +76,18 @@ public:
 
   ReturnType runOnModule(Module& pModule) override;
 
+  /// Schedule @ref pGraph with the value sizes of the target memory info
+  /// and the local memory size as the budget.
   ReturnType runOnGraph(xGraph &pGraph);
 
+  /// Schedule @ref pGraph with the value sizes of @ref pValMemSizeMap, e.g.
+  /// the sizes of a split graph which MemoryAllocation failed to allocate.
+  ReturnType runOnGraph(xGraph &pGraph, const ValMemSizeMap &pValMemSizeMap,
+                        uint64_t pMemBudget);
+
+  /// @return the peak local memory usage of the last schedule.
+  uint64_t getPeakMemUsage() const { return m_PeakMemUsage; }
+
   void getAnalysisUsage(AnalysisUsage& pUsage) const override;
 
   void inorderSingleIssueSchedule(Module& pModule);
@@ -73,6 +99,13 @@ public:
     m_SchedTimeLine.clear();
     m_ExeResUsers.clear();
     m_CurCycle = 0;
+    m_BottomLevels.clear();
+    m_RemainUses.clear();
+    m_Issued.clear();
+    m_pValMemSizeMap = nullptr;
+    m_MemBudget = 0;
+    m_CurMemUsage = 0;
+    m_PeakMemUsage = 0;
   }
 
 private:
@@ -86,11 +119,36 @@ private:
 
   Nodes issue();
 
+  /// Compute the longest path (in cycles) from each node to the end of
+  /// @ref pGraph, and the number of users of each value.
+  void buildSchedInfo(xGraph &pGraph);
+
+  /// @return the local memory occupied by @ref pValue.
+  uint64_t getLocalMemSize(const xValue *pValue) const;
+
+  /// @return the local memory allocated for the outputs of @ref pNode.
+  uint64_t getOutputMemSize(const xNode *pNode) const;
+
+  /// @return true if the users of the value loaded by @ref pLoad are about
+  /// to run.
+  bool isLoadNeeded(const xNode *pLoad) const;
+
+  /// Release the inputs which @ref pNode uses for the last time.
+  void releaseInputs(const xNode *pNode);
+
 private:
   DLATargetBackend* m_DLATB;
   std::vector<ExeCycle> m_SchedTimeLine;
   uint64_t m_CurCycle;
   ExeResUserMap m_ExeResUsers;
+  std::unordered_map<const xNode *, uint64_t> m_BottomLevels;
+  std::unordered_map<const xValue *, unsigned> m_RemainUses;
+  std::unordered_set<const xNode *> m_Issued;
+  const ValMemSizeMap *m_pValMemSizeMap;
+  ValMemSizeMap m_TargetValMemSizes;
+  uint64_t m_MemBudget;
+  uint64_t m_CurMemUsage;
+  uint64_t m_PeakMemUsage;
 };
 
 NodeIRScheduler *CreateNodeIRSchedulerPass(DLATargetBackend *pDLATB);
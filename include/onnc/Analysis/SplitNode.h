@@ -9,6 +9,7 @@
 #define ONNC_SPLIT_NODE_H
 #include <onnc/Target/DLATargetBackend.h>
 #include <onnc/Target/TargetTransformInfo.h>
+#include <functional>
 #include <unordered_map>
 
 namespace onnc {
@@ -68,6 +69,23 @@ class SplitGraph
 public:
   typedef std::unordered_map<xNode*, SplitNode*> SplitNodeHash;
 
+  /// Split an output value along @ref axis into @ref factor tiles.
+  struct Tiling
+  {
+    unsigned axis;
+    unsigned factor;
+
+    Tiling(unsigned pAxis = 0, unsigned pFactor = 1)
+      : axis(pAxis), factor(pFactor) {}
+  };
+
+  /// One tiling for each output value (Store) of the graph.
+  typedef std::vector<Tiling> Tilings;
+
+  /// Return the memory required by the graph with the given value sizes,
+  /// e.g. the result of MemoryAllocation::allocByLiveness.
+  typedef std::function<uint64_t(const ValMemSizeMap&)> MemUsageEstimator;
+
   SplitGraph(SplitGraphManager &pSgMgr, xGraph &pGraph);
 
   ~SplitGraph();
@@ -76,8 +94,19 @@ public:
 
   void getMemUsage(ValMemSizeMap &pVMSMap) const;
 
-  /// Reduce size of all values in a group to meet memory size constraint.
-  void shrinkSize();
+  /// Search the tilings of the output values and keep the one with the
+  /// lowest cost (see getTilingCost) among those which fit @ref pMemBudget.
+  /// @retval false No tiling fits. The one using the least memory is kept.
+  bool searchTiling(uint64_t pMemBudget, const MemUsageEstimator& pEstimator);
+
+  /// @return the tilings of a value of @ref pSizes with distinct tile sizes,
+  /// axis by axis. Not splitting is not a candidate.
+  static Tilings GetTilingCandidates(const LongInts& pSizes);
+
+  /// @return the cycles of running the graph once per tile with the current
+  /// sizes: the compute cost of every tile, which grows with the halo a tile
+  /// recomputes, plus the transfer cost of the loaded and stored tiles.
+  uint64_t getTilingCost() const;
 
   xGraph & getGraph() { return m_Graph; }
 
@@ -104,6 +133,9 @@ private:
   bool splitNodeBySize(xNode* pN, const LongInts& pNewOutSize,
                        bool pUpdateUpper = true);
 
+  /// Reset the sizes and split every output value by @ref pTilings.
+  void applyTilings(const Tilings& pTilings);
+
 private:
   SplitGraphManager &m_SgMgr;
 
@@ -18,7 +18,8 @@ namespace onnc {
  *  \brief AnalysisUsage represents the analysis usage information of a pass.
  *
  *  An AnalysisUsage object analyzes that the pass REQUIRES (must ran before the
- *  pass runs).
+ *  pass runs) and the analyses that the pass PRESERVES (still valid after the
+ *  pass changes the module).
  */
 class AnalysisUsage
 {
@@ -30,7 +31,7 @@ public:
   typedef IDList::const_iterator const_iterator;
 
 public:
-  AnalysisUsage() { }
+  AnalysisUsage() : m_Required(), m_Preserved(), m_PreservesAll(false) { }
 
   AnalysisUsage& addRequiredID(Pass::AnalysisID pID);
 
@@ -46,6 +47,30 @@ public:
     return addRequiredID(PassType::id());
   }
 
+  /// The result of the pass @ref pID is not invalidated by this pass.
+  AnalysisUsage& addPreservedID(Pass::AnalysisID pID);
+
+  template <
+    typename PassType,
+    typename = typename std::enable_if<
+      std::is_base_of<Pass, PassType>::value
+    >::type
+  >
+  AnalysisUsage& addPreserved() {
+    return addPreservedID(PassType::id());
+  }
+
+  /// The pass only annotates the module. No analysis is invalidated by it.
+  void setPreservesAll() { m_PreservesAll = true; }
+
+  bool getPreservesAll() const { return m_PreservesAll; }
+
+  /// @retval true If the result of the pass @ref pID survives this pass.
+  bool isPreserved(Pass::AnalysisID pID) const;
+
+  /// @retval true If this pass preserves any analysis.
+  bool hasPreserved() const { return m_PreservesAll || !m_Preserved.empty(); }
+
   iterator begin() { return m_Required.begin(); }
 
   iterator end()   { return m_Required.end(); }
@@ -58,6 +83,8 @@ public:
 
 private:
   IDList m_Required;
+  IDList m_Preserved;
+  bool m_PreservesAll;
 };
 
 } // namespace of onnc
@@ -0,0 +1,107 @@
+//===- CompilationCache.h -------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_CORE_COMPILATION_CACHE_H
+#define ONNC_CORE_COMPILATION_CACHE_H
+#include <onnc/ADT/StringRef.h>
+#include <onnc/Support/Path.h>
+
+#include <cstdint>
+#include <string>
+
+namespace onnc {
+
+/** \class onnc::CompilationCache
+ *  \brief CompilationCache keeps the artifacts of previous compilations on
+ *  disk.
+ *
+ *  An entry is keyed by the content of the input model and a context string
+ *  which describes everything else affecting the code generation (compiler
+ *  release, target quadruple, architecture, options, output file name). An entry is a
+ *  directory holding every file the backend emitted. A warm start copies
+ *  those files to the output directory and skips the whole pass pipeline.
+ *
+ *  The directory is named by a 64-bit hash. The entry also records the full
+ *  context and a second digest of the model, and a lookup only reuses an
+ *  entry whose record matches, so a hash collision is a miss.
+ *
+ *  \code
+ *  CompilationCache cache(dir);
+ *  CompilationCache::Key key;
+ *  if (cache.makeKey(key, model, context) && cache.lookup(key, outputDir))
+ *    return; // hit
+ *  Path staging = cache.prepare(key);
+ *  // ... emit the artifacts into staging ...
+ *  cache.commit(key, staging, outputDir);
+ *  \endcode
+ */
+class CompilationCache
+{
+public:
+  struct Key
+  {
+    Key() : hash(0) { }
+
+    bool operator==(const Key& pOther) const {
+      return hash == pOther.hash && identity == pOther.identity;
+    }
+    bool operator!=(const Key& pOther) const { return !(*this == pOther); }
+
+    uint64_t hash;        ///< names the entry
+    std::string identity; ///< the context and a digest of the model
+  };
+
+public:
+  explicit CompilationCache(const Path& pDirectory);
+
+  const Path& directory() const { return m_Directory; }
+
+  /// Hash the content of @ref pModel and @ref pContext.
+  /// @retval false The model can not be read.
+  bool makeKey(Key& pKey, const Path& pModel, StringRef pContext) const;
+
+  /// @return The directory of the entry @ref pKey.
+  Path getEntryPath(const Key& pKey) const;
+
+  /// Copy the artifacts of entry @ref pKey into @ref pOutputDir.
+  /// @retval false No such entry, the entry was made for another model or
+  ///               context, or the copy fails.
+  bool lookup(const Key& pKey, const Path& pOutputDir) const;
+
+  /// Create an empty staging directory for entry @ref pKey. The backend
+  /// shall emit its artifacts into it.
+  /// @return The staging directory. Empty if it can not be created.
+  Path prepare(const Key& pKey) const;
+
+  /// Copy the artifacts in @ref pStaging into @ref pOutputDir and publish
+  /// @ref pStaging as entry @ref pKey. Only commit a successful compilation.
+  /// If @ref pStaging holds no artifact, remove it and publish nothing.
+  /// @retval false Fails to copy the artifacts to @ref pOutputDir. Nothing
+  ///               is published.
+  bool commit(const Key& pKey, const Path& pStaging, const Path& pOutputDir) const;
+
+  /// Remove entry @ref pKey.
+  void erase(const Key& pKey) const;
+
+  /// @return The hexadecimal representation of @ref pHash.
+  static std::string ToString(uint64_t pHash);
+
+private:
+  /// @return Whether @ref pDirectory holds no regular file.
+  static bool IsEmpty(const Path& pDirectory);
+
+  /// copy all regular files in @ref pFrom to @ref pTo, except the record of
+  /// the key.
+  static bool CopyFiles(const Path& pFrom, const Path& pTo);
+
+private:
+  Path m_Directory;
+};
+
+} // namespace of onnc
+
+#endif
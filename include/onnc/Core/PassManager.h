@@ -19,6 +19,7 @@
 #include <onnc/Core/CustomPass.h>
 #include <onnc/Core/PassInfo.h>
 #include <onnc/Core/PassRegistry.h>
+#include <onnc/Core/PassTimingInfo.h>
 #include <onnc/IR/Module.h>
 #include <onnc/ADT/Digraph.h>
 
@@ -38,6 +39,7 @@ private:
   using LastExecuted = std::unordered_map<
     Pass::AnalysisID, Pass*
   >;
+  using ValidTimeSteps = std::unordered_map<const Pass*, unsigned>;
 
 public:
   using ExecutionOrder = std::deque<Pass*>;
@@ -90,6 +92,9 @@ public:
   ///
   /// 3. If a pass return retry, PassManager re-executes that pass, but whether
   ///    re-executes it's dependencies or not follows rule 2.
+  ///
+  /// 4. When a pass changes the module, the results of the passes it declares
+  ///    preserved in its AnalysisUsage stay valid and are not re-executed.
 
   /// run all passes
   /// @retval false A pass return failure.
@@ -119,6 +124,12 @@ public:
 
   PassRegistry* getPassRegistry() { return m_pPassRegistry; }
 
+  /// Record the cost of every pass execution into @ref pInfo. Passing null
+  /// disables the instrumentation.
+  void setTimingInfo(PassTimingInfo* pInfo) { m_pTimingInfo = pInfo; }
+
+  PassTimingInfo* getTimingInfo() const { return m_pTimingInfo; }
+
   void printState(const State& pState, OStream& pOS) const;
 
   void dumpState(const State& pState) const;
@@ -190,6 +201,14 @@ private:
 
   Pass* getLastExecutedOrFromStore(Pass::AnalysisID passId) const;
 
+  /// @return The last time step at which the result of @ref pPass is known
+  ///         to be up to date.
+  unsigned getValidTimeStep(const Pass& pPass) const;
+
+  /// Keep the results of the passes preserved by @ref pPass valid after
+  /// @ref pPass changed the module.
+  void preserveAnalyses(const Pass& pPass, const Module& pModule);
+
 private:
   PassRegistry* m_pPassRegistry;
 
@@ -201,12 +220,18 @@ private:
 
   LastExecuted m_lastExecuted;
 
+  // Time steps at which a module revision preserved the result of a pass.
+  // @see PassManager::getValidTimeStep
+  ValidTimeSteps m_validTimeSteps;
+
   PassStore m_passStore;
 
   State m_RunState;
 
   DepNode *m_pStart;
 
+  PassTimingInfo* m_pTimingInfo;
+
   // Executing time step, it is reset on initRunState. PassManager uses time
   // step to decide whether to execute a pass or not. If PassManager execute a
   // pass, it also updates Pass' time step.
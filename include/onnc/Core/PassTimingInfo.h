@@ -0,0 +1,103 @@
+//===- PassTimingInfo.h ---------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_CORE_PASS_TIMING_INFO_H
+#define ONNC_CORE_PASS_TIMING_INFO_H
+#include <onnc/ADT/StringRef.h>
+#include <onnc/Analysis/Statistics.h>
+#include <onnc/Support/OStream.h>
+
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace onnc {
+
+class Pass;
+
+/** \class onnc::PassTimingInfo
+ *  \brief PassTimingInfo collects the cost of every pass execution.
+ *
+ *  Wall time, CPU time and the change of resident set size are aggregated
+ *  by pass name into the "PassTiming" group of a Statistics object, its own
+ *  one unless another is given, e.g. global::stats(). Re-runs of a pass
+ *  (retries and invalidations) are accumulated into the same entry.
+ *
+ *  \code
+ *  PassTimingInfo timing;
+ *  PassManager pm;
+ *  pm.setTimingInfo(&timing);
+ *  pm.run(module);
+ *  timing.print(outs());
+ *  \endcode
+ */
+class PassTimingInfo
+{
+public:
+  enum Format {
+    kTable,
+    kJSON
+  };
+
+  /// The accumulated cost of one pass.
+  struct Record
+  {
+    std::string name;
+    long runs;
+    long wall; ///< wall time in nanoseconds
+    long cpu;  ///< CPU time in nanoseconds
+    long rss;  ///< resident set size delta in bytes
+  };
+
+  typedef std::vector<Record> RecordList;
+
+  /** \class onnc::PassTimingInfo::Scope
+   *  \brief measures one execution of a pass, from construction to
+   *  destruction. Does nothing if the timing info is null.
+   */
+  class Scope
+  {
+  public:
+    Scope(PassTimingInfo* pInfo, const Pass& pPass);
+
+    ~Scope();
+
+  private:
+    PassTimingInfo* m_pInfo;
+    const Pass& m_Pass;
+    std::chrono::steady_clock::time_point m_Wall;
+    std::clock_t m_CPU;
+    long m_RSS;
+  };
+
+public:
+  /// Aggregate into a Statistics object of its own.
+  PassTimingInfo();
+
+  /// Aggregate into @ref pStats, which outlives this object.
+  explicit PassTimingInfo(Statistics& pStats);
+
+  /// Accumulate one execution of pass @ref pPassName.
+  void add(StringRef pPassName, long pWall, long pCPU, long pRSS);
+
+  /// @return The records sorted by wall time in descending order.
+  RecordList getRecords() const;
+
+  /// Print the records as a table or as a JSON array.
+  void print(OStream& pOS, Format pFormat = kTable) const;
+
+  void clear();
+
+private:
+  Statistics m_OwnStats;
+  Statistics& m_Stats;
+};
+
+} // namespace of onnc
+
+#endif
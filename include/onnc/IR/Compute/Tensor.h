@@ -9,6 +9,7 @@
 #define ONNC_IR_COMPUTE_TENSOR_H
 #include <onnc/Config/ONNX.h>
 #include <onnc/IR/Compute/Value.h>
+#include <onnc/Support/Float16.h>
 #include <onnc/Support/Memory.h>
 #include <onnc/Support/TypeTraits.h>
 
@@ -126,7 +127,8 @@ void TensorT<ValueTypeT, Kind>::print(std::ostream& pOS) const {
 
 // clang-format off
 typedef TensorT<float,       onnc::Value::kFloat>   FloatTensor;
-typedef TensorT<float,       onnc::Value::kFloat16> Float16Tensor;
+typedef TensorT<Float16,     onnc::Value::kFloat16> Float16Tensor;
+typedef TensorT<BFloat16,    onnc::Value::kBFloat16> BFloat16Tensor;
 typedef TensorT<bool,        onnc::Value::kBoolean> BooleanTensor;
 typedef TensorT<int8_t,      onnc::Value::kInt8>    Int8Tensor;
 typedef TensorT<int16_t,     onnc::Value::kInt16>   Int16Tensor;
@@ -205,7 +207,7 @@ void copyTensor(const Tensor& tensor, OutputIterator&& out)
 template <typename OutputIterator>
 void copy(const Tensor& tensor, OutputIterator&& out)
 {
-  internal::copyTensor<BooleanTensor, FloatTensor, Float16Tensor, Int8Tensor, Int16Tensor, Int32Tensor, Int64Tensor,
+  internal::copyTensor<BooleanTensor, FloatTensor, Float16Tensor, BFloat16Tensor, Int8Tensor, Int16Tensor, Int32Tensor, Int64Tensor,
                        Uint8Tensor, Uint16Tensor, Uint32Tensor, Uint64Tensor, DoubleTensor, StringTensor>(
     tensor, std::forward<OutputIterator>(out));
 }
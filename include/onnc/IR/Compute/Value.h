@@ -44,6 +44,7 @@ public:
     kDouble    = xValueType::kDouble,
     kUint32    = xValueType::kUint32,
     kUint64    = xValueType::kUint64,
+    kBFloat16  = xValueType::kBFloat16,
 
     // complex with float32 real and imaginary components
     kComplex64  = xValueType::kComplex64,
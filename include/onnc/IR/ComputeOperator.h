@@ -67,6 +67,8 @@ public:
 
   unsigned int getNumOfGraphOperators() const { return m_GraphOperators.size(); }
 
+  const GraphOperator* getGraphOperator(unsigned int pIdx) const { return m_GraphOperators[pIdx]; }
+
   unsigned int getNumOfInputs() const { return m_Inputs.size(); }
 
   unsigned int getNumOfOutputs() const { return m_Outputs.size(); }
@@ -10,6 +10,14 @@ typedef struct ONNC_RUNTIME_Context {
   void *output_context;
   void **mem; /* Deprecated */
   size_t mem_i; /* Deprecated */
+  const void **constants; /* Tensors which never change, sorted by address */
+  size_t constants_i;
+  size_t constants_capacity;
+  float **widened; /* Weights widened to float, freed at shutdown */
+  size_t widened_i;
+  size_t widened_capacity;
+  void *mkldnn_context; /* Owned by the MKL-DNN operators, if any */
+  void (*destroy_mkldnn_context)(void *mkldnn_context);
 } Context;
 
 
@@ -42,17 +42,36 @@ const struct ONNC_RUNTIME_tensor_offset_table*
 struct ONNC_RUNTIME_tensor_view ONNC_RUNTIME_read_tensor(struct ONNC_RUNTIME_tensor_file* file, uint64_t tensor);
 
 // Service Library
+struct ONNC_RUNTIME_model; /* Defined by the generated code */
+
 struct ONNC_RUNTIME_inference_context
 {
   struct ONNC_RUNTIME_tensor_file* input;
   struct ONNC_RUNTIME_tensor_file* weight;
   uint64_t                         id;
   void (*completed)(uint64_t id, struct ONNC_RUNTIME_tensor_view output);
+  struct ONNC_RUNTIME_model*       model; /* From model_prepare(), or NULL */
 };
 
+/**
+ * Prepare the weights of the ONNC generated model, e.g. widen the 16-bit
+ * weights, and the runtime the operators share across model_main() calls.
+ * @param weight The weight file, which must outlive the prepared model.
+ * @return The prepared model, or NULL if it can not be allocated.
+ */
+struct ONNC_RUNTIME_model* model_prepare(struct ONNC_RUNTIME_tensor_file* weight);
+
+/**
+ * Release a model returned by model_prepare(). NULL is ignored.
+ */
+void model_release(struct ONNC_RUNTIME_model* model);
+
 /**
  * ONNC generated entry point.
- * @param context The ONNC Runtime Context.
+ * Calls may run concurrently as long as they do not share a prepared model.
+ * @param context The ONNC Runtime Context. Without a prepared model, one is
+ *        prepared from the weight file for this call only.
+ * @return 0 on success, -1 if the model or its memory can not be allocated.
  */
 int model_main(const struct ONNC_RUNTIME_inference_context* context);
 
@@ -71,6 +90,36 @@ void *ONNC_RUNTIME_init_runtime();
  */
 bool ONNC_RUNTIME_shutdown_runtime(void *onnc_runtime_context);
 
+/**
+ * Tell the runtime that a tensor never changes until the runtime shuts down,
+ * e.g. an initializer. Operators may keep data derived from it.
+ * @param onnc_runtime_context The ONNC Runtime Context.
+ * @param data The first byte of the tensor.
+ * @return False if the tensor can not be recorded.
+ */
+bool ONNC_RUNTIME_add_constant(void *onnc_runtime_context, const void *data);
+
+/**
+ * @return True if the tensor was added by ONNC_RUNTIME_add_constant.
+ */
+bool ONNC_RUNTIME_is_constant(void *onnc_runtime_context, const void *data);
+
+/**
+ * Widen a tensor of IEEE 754 binary16 values to float, for the operators.
+ * @param onnc_runtime_context The ONNC Runtime Context, which owns the result
+ *        until it shuts down.
+ * @param tensor The 16-bit values.
+ * @return The float values, or NULL if they can not be allocated.
+ */
+float *ONNC_RUNTIME_widen_float16(void *onnc_runtime_context,
+                                  struct ONNC_RUNTIME_tensor_view tensor);
+
+/**
+ * Widen a tensor of bfloat16 values to float, like ONNC_RUNTIME_widen_float16.
+ */
+float *ONNC_RUNTIME_widen_bfloat16(void *onnc_runtime_context,
+                                   struct ONNC_RUNTIME_tensor_view tensor);
+
 void ONNC_RUNTIME_abs_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_X
@@ -6,6 +6,14 @@ typedef struct ONNC_RUNTIME_Context {
   void *output_context;
   void **mem; /* Deprecated */
   size_t mem_i; /* Deprecated */
+  const void **constants; /* Tensors which never change, sorted by address */
+  size_t constants_i;
+  size_t constants_capacity;
+  float **widened; /* Weights widened to float, freed at shutdown */
+  size_t widened_i;
+  size_t widened_capacity;
+  void *mkldnn_context; /* Owned by the MKL-DNN operators, if any */
+  void (*destroy_mkldnn_context)(void *mkldnn_context);
 } Context;
 
 /**
@@ -21,6 +29,20 @@ void *ONNC_RUNTIME_init_runtime();
  */
 bool ONNC_RUNTIME_shutdown_runtime(void *onnc_runtime_context);
 
+/**
+ * Tell the runtime that a tensor never changes until the runtime shuts down,
+ * e.g. an initializer. Operators may keep data derived from it.
+ * @param onnc_runtime_context The ONNC Runtime Context.
+ * @param data The first byte of the tensor.
+ * @return False if the tensor can not be recorded.
+ */
+bool ONNC_RUNTIME_add_constant(void *onnc_runtime_context, const void *data);
+
+/**
+ * @return True if the tensor was added by ONNC_RUNTIME_add_constant.
+ */
+bool ONNC_RUNTIME_is_constant(void *onnc_runtime_context, const void *data);
+
 #include "operator/abs.h"
 #include "operator/acos.h"
 #include "operator/add.h"
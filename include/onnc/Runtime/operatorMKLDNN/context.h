@@ -0,0 +1,190 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "mkldnn.h"
+
+#define ONNC_RUNTIME_MKLDNN_MAX_KEY 64
+#define ONNC_RUNTIME_MKLDNN_MAX_STEPS 4
+#define ONNC_RUNTIME_MKLDNN_MAX_ARGS 8
+#define ONNC_RUNTIME_MKLDNN_MAX_MEMORIES 10
+#define ONNC_RUNTIME_MKLDNN_MAX_NDIM 6
+
+/**
+ * The first entry of every key, so that operators never share a primitive.
+ */
+enum ONNC_RUNTIME_mkldnn_kind {
+  ONNC_RUNTIME_MKLDNN_CONV = 1,
+  ONNC_RUNTIME_MKLDNN_INNER_PRODUCT,
+  ONNC_RUNTIME_MKLDNN_MAXPOOL,
+  ONNC_RUNTIME_MKLDNN_AVERAGEPOOL,
+  ONNC_RUNTIME_MKLDNN_BATCHNORMALIZATION,
+  ONNC_RUNTIME_MKLDNN_LRN,
+  ONNC_RUNTIME_MKLDNN_SOFTMAX,
+  ONNC_RUNTIME_MKLDNN_ELTWISE,
+  ONNC_RUNTIME_MKLDNN_SUM,
+  ONNC_RUNTIME_MKLDNN_CONCAT
+};
+
+/**
+ * Memory slots of the operators built by ONNC_RUNTIME_mkldnn_create_unary.
+ * Slots from ONNC_RUNTIME_MKLDNN_UNARY_SLOTS on are free for the operator.
+ */
+enum {
+  ONNC_RUNTIME_MKLDNN_UNARY_SRC,
+  ONNC_RUNTIME_MKLDNN_UNARY_DST,
+  ONNC_RUNTIME_MKLDNN_UNARY_SLOTS
+};
+
+/**
+ * One primitive of a cached operator, with the arguments it executes with.
+ */
+typedef struct ONNC_RUNTIME_mkldnn_step {
+  mkldnn_primitive_t primitive;
+  int nargs;
+  mkldnn_exec_arg_t args[ONNC_RUNTIME_MKLDNN_MAX_ARGS];
+} MKLDNNStep;
+
+/**
+ * A cached operator instance, keyed by the shapes and the attributes of the
+ * operator. It owns its primitives, executed in order (e.g. reorder the
+ * input, compute, reorder the output), and its memory objects. The operator
+ * decides what each memory slot means, and sets the data handles of the
+ * user tensors before every execution.
+ */
+typedef struct ONNC_RUNTIME_mkldnn_primitive {
+  int64_t key[ONNC_RUNTIME_MKLDNN_MAX_KEY];
+  int32_t key_size;
+  int32_t nsteps;
+  MKLDNNStep steps[ONNC_RUNTIME_MKLDNN_MAX_STEPS];
+  mkldnn_memory_t memories[ONNC_RUNTIME_MKLDNN_MAX_MEMORIES];
+  struct ONNC_RUNTIME_mkldnn_primitive *next;
+} MKLDNNPrimitive;
+
+/**
+ * A weight tensor reordered into the layout a primitive prefers.
+ */
+typedef struct ONNC_RUNTIME_mkldnn_weights {
+  const void *data;
+  mkldnn_memory_t memory;
+  struct ONNC_RUNTIME_mkldnn_weights *next;
+} MKLDNNWeights;
+
+/**
+ * The MKL-DNN state of an ONNC Runtime Context, alive until the runtime
+ * shuts down.
+ */
+typedef struct ONNC_RUNTIME_mkldnn_context {
+  void *runtime;
+  mkldnn_engine_t engine;
+  mkldnn_stream_t stream;
+  MKLDNNPrimitive *primitives;
+  MKLDNNWeights *weights;
+} MKLDNNContext;
+
+/**
+ * @return The bits of a float attribute, to be put in a key.
+ */
+static inline int64_t ONNC_RUNTIME_mkldnn_float_key(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/**
+ * Get the MKL-DNN state of a runtime context. The engine and the stream are
+ * created by the first call.
+ * @return NULL if MKL-DNN can not create them.
+ */
+MKLDNNContext *ONNC_RUNTIME_mkldnn_get_context(void *onnc_runtime_context);
+
+void ONNC_RUNTIME_mkldnn_destroy_context(void *mkldnn_context);
+
+/**
+ * @return The cached operator of the key, or NULL.
+ */
+MKLDNNPrimitive *ONNC_RUNTIME_mkldnn_find_primitive(MKLDNNContext *context,
+                                                    const int64_t *key,
+                                                    int32_t key_size);
+
+/**
+ * Add an empty operator to the cache. The operator fills it by
+ * ONNC_RUNTIME_mkldnn_create_memory, ONNC_RUNTIME_mkldnn_add_step and
+ * ONNC_RUNTIME_mkldnn_add_reorder.
+ */
+MKLDNNPrimitive *ONNC_RUNTIME_mkldnn_create_primitive(MKLDNNContext *context,
+                                                      const int64_t *key,
+                                                      int32_t key_size);
+
+/**
+ * Remove an operator which fails to build from the cache, and destroy it.
+ */
+void ONNC_RUNTIME_mkldnn_destroy_primitive(MKLDNNContext *context,
+                                           MKLDNNPrimitive *primitive);
+
+/**
+ * Create the memory object of a slot. A memory which is not allocated gets
+ * its data handle by ONNC_RUNTIME_mkldnn_set_handle.
+ */
+mkldnn_memory_t ONNC_RUNTIME_mkldnn_create_memory(MKLDNNContext *context,
+                                                  MKLDNNPrimitive *primitive,
+                                                  int32_t slot,
+                                                  const mkldnn_memory_desc_t *md,
+                                                  bool allocate);
+
+/**
+ * Initialize the descriptor of a dense row-major tensor, the layout of every
+ * tensor the runtime passes around.
+ * @return false if the tensor has too many dimensions.
+ */
+bool ONNC_RUNTIME_mkldnn_init_plain_desc(mkldnn_memory_desc_t *md,
+                                         int32_t ndim, const int32_t *dims);
+
+/**
+ * Add an operator of one source and one destination, both in the plain
+ * layout, to the cache. Its first step is the primitive of op_desc, with
+ * the source and the destination as arguments.
+ * @return NULL if MKL-DNN does not support the operator.
+ */
+MKLDNNPrimitive *ONNC_RUNTIME_mkldnn_create_unary(MKLDNNContext *context,
+                                                  const int64_t *key,
+                                                  int32_t key_size,
+                                                  const void *op_desc,
+                                                  const mkldnn_memory_desc_t *src_md,
+                                                  const mkldnn_memory_desc_t *dst_md);
+
+/**
+ * Append the primitive of a primitive descriptor.
+ * @return NULL if the primitive can not be created.
+ */
+MKLDNNStep *ONNC_RUNTIME_mkldnn_add_step(MKLDNNPrimitive *primitive,
+                                         const_mkldnn_primitive_desc_t pd);
+
+void ONNC_RUNTIME_mkldnn_add_arg(MKLDNNStep *step, int arg,
+                                 mkldnn_memory_t memory);
+
+/**
+ * Append a reorder from one memory to another.
+ */
+bool ONNC_RUNTIME_mkldnn_add_reorder(MKLDNNContext *context,
+                                     MKLDNNPrimitive *primitive,
+                                     mkldnn_memory_t from, mkldnn_memory_t to);
+
+void ONNC_RUNTIME_mkldnn_set_handle(MKLDNNPrimitive *primitive, int32_t slot,
+                                    const void *data);
+
+/**
+ * Let the weight slot see the weights. If the slot has a layout other than
+ * the user slot, the weights are reordered into a copy kept by the context.
+ * Weights added by ONNC_RUNTIME_add_constant are reordered only once, the
+ * others by every call.
+ * @return False if the weights can not be reordered.
+ */
+bool ONNC_RUNTIME_mkldnn_set_weights(MKLDNNContext *context,
+                                     MKLDNNPrimitive *primitive,
+                                     int32_t user_slot, int32_t slot,
+                                     const void *weights);
+
+void ONNC_RUNTIME_mkldnn_execute(MKLDNNContext *context,
+                                 MKLDNNPrimitive *primitive);
@@ -0,0 +1,202 @@
+//===- Float16.h ----------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_SUPPORT_FLOAT16_H
+#define ONNC_SUPPORT_FLOAT16_H
+#include <cstdint>
+#include <cstring>
+
+namespace onnc {
+
+/** \class onnc::Float16
+ *  \brief IEEE 754 binary16 storage type.
+ *
+ *  Float16 only stores 16 bits. Arithmetic is done in single precision: a
+ *  Float16 widens to float implicitly and narrows back (round to nearest
+ *  even) when a float is assigned to it.
+ */
+class Float16
+{
+public:
+  typedef std::uint16_t bits_type;
+
+public:
+  Float16() : m_Bits(0) { }
+
+  Float16(float pValue) : m_Bits(FromFloat(pValue)) { }
+
+  operator float() const { return ToFloat(m_Bits); }
+
+  Float16& operator+=(float pRHS) { return *this = float(*this) + pRHS; }
+
+  Float16& operator-=(float pRHS) { return *this = float(*this) - pRHS; }
+
+  Float16& operator*=(float pRHS) { return *this = float(*this) * pRHS; }
+
+  Float16& operator/=(float pRHS) { return *this = float(*this) / pRHS; }
+
+  bits_type bits() const { return m_Bits; }
+
+  /// reinterpret @ref pBits as a binary16 value.
+  static Float16 fromBits(bits_type pBits) {
+    Float16 result;
+    result.m_Bits = pBits;
+    return result;
+  }
+
+  static bits_type FromFloat(float pValue);
+
+  static float ToFloat(bits_type pBits);
+
+private:
+  bits_type m_Bits;
+};
+
+/** \class onnc::BFloat16
+ *  \brief brain floating point storage type.
+ *
+ *  BFloat16 keeps the upper 16 bits of an IEEE 754 binary32 value, so it has
+ *  the range of float with an 8-bit mantissa.
+ */
+class BFloat16
+{
+public:
+  typedef std::uint16_t bits_type;
+
+public:
+  BFloat16() : m_Bits(0) { }
+
+  BFloat16(float pValue) : m_Bits(FromFloat(pValue)) { }
+
+  operator float() const { return ToFloat(m_Bits); }
+
+  BFloat16& operator+=(float pRHS) { return *this = float(*this) + pRHS; }
+
+  BFloat16& operator-=(float pRHS) { return *this = float(*this) - pRHS; }
+
+  BFloat16& operator*=(float pRHS) { return *this = float(*this) * pRHS; }
+
+  BFloat16& operator/=(float pRHS) { return *this = float(*this) / pRHS; }
+
+  bits_type bits() const { return m_Bits; }
+
+  /// reinterpret @ref pBits as a bfloat16 value.
+  static BFloat16 fromBits(bits_type pBits) {
+    BFloat16 result;
+    result.m_Bits = pBits;
+    return result;
+  }
+
+  static bits_type FromFloat(float pValue);
+
+  static float ToFloat(bits_type pBits);
+
+private:
+  bits_type m_Bits;
+};
+
+static_assert(sizeof(Float16) == 2, "Float16 must be a 16-bit type");
+static_assert(sizeof(BFloat16) == 2, "BFloat16 must be a 16-bit type");
+
+//===----------------------------------------------------------------------===//
+// Float16 inline member functions
+//===----------------------------------------------------------------------===//
+inline Float16::bits_type Float16::FromFloat(float pValue)
+{
+  std::uint32_t f;
+  std::memcpy(&f, &pValue, sizeof(f));
+
+  const std::uint32_t sign = (f >> 16) & 0x8000u;
+  const std::uint32_t absf = f & 0x7FFFFFFFu;
+
+  // NaN and infinity. Keep NaN quiet.
+  if (absf >= 0x7F800000u)
+    return sign | 0x7C00u | ((absf > 0x7F800000u) ? 0x0200u : 0u);
+
+  // overflow to infinity.
+  if (absf >= 0x477FF000u)
+    return sign | 0x7C00u;
+
+  // subnormal or zero in half precision.
+  if (absf < 0x38800000u) {
+    if (absf < 0x33000000u)
+      return sign;
+    const std::uint32_t exp = absf >> 23;
+    const std::uint32_t mant = (absf & 0x007FFFFFu) | 0x00800000u;
+    const std::uint32_t shift = 126u - exp;
+    std::uint32_t half = mant >> shift;
+    const std::uint32_t rest = mant & ((1u << shift) - 1u);
+    const std::uint32_t halfway = 1u << (shift - 1u);
+    if (rest > halfway || (rest == halfway && (half & 1u)))
+      ++half;
+    return sign | half;
+  }
+
+  // normal number: rebias exponent and round mantissa to nearest even.
+  std::uint32_t half = ((absf - 0x38000000u) >> 13);
+  const std::uint32_t rest = absf & 0x1FFFu;
+  if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+    ++half;
+  return sign | half;
+}
+
+inline float Float16::ToFloat(bits_type pBits)
+{
+  const std::uint32_t sign = (std::uint32_t(pBits) & 0x8000u) << 16;
+  std::uint32_t exp = (pBits >> 10) & 0x1Fu;
+  std::uint32_t mant = pBits & 0x3FFu;
+
+  std::uint32_t f;
+  if (0x1Fu == exp)
+    f = sign | 0x7F800000u | (mant << 13);
+  else if (0 != exp)
+    f = sign | ((exp + 112u) << 23) | (mant << 13);
+  else if (0 == mant)
+    f = sign;
+  else {
+    // normalize the subnormal value.
+    exp = 113u;
+    while (0 == (mant & 0x400u)) {
+      mant <<= 1;
+      --exp;
+    }
+    f = sign | (exp << 23) | ((mant & 0x3FFu) << 13);
+  }
+
+  float result;
+  std::memcpy(&result, &f, sizeof(result));
+  return result;
+}
+
+//===----------------------------------------------------------------------===//
+// BFloat16 inline member functions
+//===----------------------------------------------------------------------===//
+inline BFloat16::bits_type BFloat16::FromFloat(float pValue)
+{
+  std::uint32_t f;
+  std::memcpy(&f, &pValue, sizeof(f));
+
+  // NaN: truncate but keep it quiet.
+  if ((f & 0x7FFFFFFFu) > 0x7F800000u)
+    return (f >> 16) | 0x0040u;
+
+  // round to nearest even.
+  f += 0x7FFFu + ((f >> 16) & 1u);
+  return f >> 16;
+}
+
+inline float BFloat16::ToFloat(bits_type pBits)
+{
+  const std::uint32_t f = std::uint32_t(pBits) << 16;
+  float result;
+  std::memcpy(&result, &f, sizeof(result));
+  return result;
+}
+
+} // namespace of onnc
+
+#endif
@@ -34,6 +34,10 @@ namespace sys {
   /// Get the host quadruple.
   std::string GetHostQuadruple();
 
+  /// Get the resident set size of the current process in bytes.
+  /// @retval 0 The size is unknown on this host.
+  long GetResidentSetSize();
+
 } // namespace of sys
 } // namespace of onnc
 
@@ -61,11 +61,23 @@ public:
 
   void useDummyCTable(bool pEnable = true) { m_AddDummyCTable = pEnable; }
 
+  /// This property holds the calibration table file which provides the
+  /// activation thresholds, e.g. the output of `onni --calibrate`
+  const Path& calibrationTable() const { return m_CalibrationTable; }
+
+  void setCalibrationTable(const Path& pFile) { m_CalibrationTable = pFile; }
+
   /// This property holds whether adding dummy weight
   bool shouldUseDummyWeight() const { return m_AddDummyWeight; }
 
   void useDummyWeight(bool pEnable = true) { m_AddDummyWeight = pEnable; }
 
+  /// This property holds whether the backend reports the estimated latency
+  /// of the generated code
+  bool shouldEstimatePerformance() const { return m_EstimatePerformance; }
+
+  void estimatePerformance(bool pEnable = true) { m_EstimatePerformance = pEnable; }
+
   /// This property holds the output file name for optimized onnx model
   /// in backend
   std::string optOnnxModel() const { return m_OptOnnxModel; }
@@ -81,8 +93,10 @@ private:
   bool        m_IgnoreCalibrationStep = false;
   bool        m_AddDummyCTable        = false;
   bool        m_AddDummyWeight        = false;
+  bool        m_EstimatePerformance   = false;
   unsigned    m_VerboseLevel          = 0;
   std::string m_OptOnnxModel          = "";
+  Path        m_CalibrationTable;
 };
 
 } // namespace onnc
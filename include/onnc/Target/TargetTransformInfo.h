@@ -87,6 +87,10 @@ public:
     return MemSize();
   }
 
+  /// Get coarse-grained (approximately) cycles to move @ref pBytes between
+  /// the global and the local memory. Used to score tilings.
+  virtual uint64_t getTransferCost(uint64_t pBytes) const { return pBytes; }
+
   /// Expose coarse grained execution units information, so scheduler can use
   /// it to scheduling graph IR.
   virtual const ExeResource *queryExeResType(const xNode *pNode) const {
@@ -0,0 +1,40 @@
+//===- EliminateCommonSubexpression.h -------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_ELIMINATE_COMMON_SUBEXPRESSION
+#define ONNC_ELIMINATE_COMMON_SUBEXPRESSION
+#include <onnc/Core/CustomPass.h>
+
+#include <string>
+
+namespace onnc {
+
+/** \class EliminateCommonSubexpression
+ *  \brief Merge operators which compute the same values.
+ *
+ *  Two operators are equivalent if they have the same kind, the same
+ *  attributes and the same input values. The outputs of the latter one are
+ *  replaced by the outputs of the former one. Random operators and
+ *  operators without printable attributes are never merged.
+ */
+class EliminateCommonSubexpression : public CustomPass<EliminateCommonSubexpression>
+{
+public:
+  EliminateCommonSubexpression() = default;
+
+  ReturnType runOnModule(Module& pModule) override;
+
+private:
+  ReturnType runOnComputeGraph(ComputeGraph& pCG) override;
+
+  /// @retval false If @ref pOp can not be merged with others.
+  static bool GetKey(const ComputeOperator& pOp, std::string& pKey);
+};
+
+} // namespace of onnc
+
+#endif // ONNC_ELIMINATE_COMMON_SUBEXPRESSION
@@ -0,0 +1,33 @@
+//===- EliminateDuplicateInitializer.h ------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_ELIMINATE_DUPLICATE_INITIALIZER
+#define ONNC_ELIMINATE_DUPLICATE_INITIALIZER
+#include <onnc/Core/CustomPass.h>
+
+namespace onnc {
+
+/** \class EliminateDuplicateInitializer
+ *  \brief Merge initializers which hold the same data.
+ *
+ *  Initializers with the same type, the same dimensions and byte-identical
+ *  values are merged into the first one, so the weight is emitted once.
+ */
+class EliminateDuplicateInitializer : public CustomPass<EliminateDuplicateInitializer>
+{
+public:
+  EliminateDuplicateInitializer() = default;
+
+  ReturnType runOnModule(Module& pModule) override;
+
+private:
+  ReturnType runOnComputeGraph(ComputeGraph& pCG) override;
+};
+
+} // namespace of onnc
+
+#endif // ONNC_ELIMINATE_DUPLICATE_INITIALIZER
@@ -12,6 +12,8 @@
 #include <onnc/Support/Enum.h>
 #include <onnc/Support/TypeTraits.h>
 #include <onnc/Transforms/Optimizations/DivideGlobalAPIntoAPs.h>
+#include <onnc/Transforms/Optimizations/EliminateCommonSubexpression.h>
+#include <onnc/Transforms/Optimizations/EliminateDuplicateInitializer.h>
 #include <onnc/Transforms/Optimizations/EliminateIdentity.h>
 #include <onnc/Transforms/Optimizations/ExpandBatchNormalization.h>
 #include <onnc/Transforms/Optimizations/PropagateConstWithDiffShape.h>
@@ -33,6 +35,12 @@ enum class OptimizationOption : unsigned
   expand_batch_normalization,
   replace_gemm_by_conv,
   split_conv_by_channel,
+  // the options are applied in this order. The merging passes see the result
+  // of the rewrites above, and the fusion of the target runs last, on the
+  // merged graph.
+  eliminate_common_subexpression,
+  eliminate_duplicate_initializer,
+  fuse_sdp_into_conv,
 };
 
 class OptimizationOptions
@@ -89,6 +97,12 @@ private:
     case OptimizationOption::eliminate_identity:
       passManager.add<EliminateIdentity>();
       break;
+    case OptimizationOption::eliminate_common_subexpression:
+      passManager.add<EliminateCommonSubexpression>();
+      break;
+    case OptimizationOption::eliminate_duplicate_initializer:
+      passManager.add<EliminateDuplicateInitializer>();
+      break;
     case OptimizationOption::propagate_const_with_diff_shape:
       passManager.add<PropagateConstWithDiffShape>();
       break;
@@ -18,20 +18,20 @@
 
 #ifndef FP_TENSORTYPE_LIST
 #  define FP_TENSORTYPE_LIST \
-    (FloatTensor, Float16Tensor, DoubleTensor)
+    (FloatTensor, Float16Tensor, BFloat16Tensor, DoubleTensor)
 #endif
 
 #ifndef NUMERIC_TENSORTYPE_LIST
 #  define NUMERIC_TENSORTYPE_LIST \
-    (FloatTensor, Float16Tensor, Int8Tensor, Int16Tensor, \
-     Int32Tensor, Uint8Tensor, Uint16Tensor, Int64Tensor, \
+    (FloatTensor, Float16Tensor, BFloat16Tensor, Int8Tensor, \
+     Int16Tensor, Int32Tensor, Uint8Tensor, Uint16Tensor, Int64Tensor, \
      Uint32Tensor, Uint64Tensor, DoubleTensor)
 #endif
 
 #ifndef ALL_TENSORTYPE_LIST
 #  define ALL_TENSORTYPE_LIST \
-    (FloatTensor, Float16Tensor, BooleanTensor, Int8Tensor, \
-     Int16Tensor, Int32Tensor, Uint8Tensor, Uint16Tensor, \
+    (FloatTensor, Float16Tensor, BFloat16Tensor, BooleanTensor, \
+     Int8Tensor, Int16Tensor, Int32Tensor, Uint8Tensor, Uint16Tensor, \
      Int64Tensor, Uint32Tensor, Uint64Tensor, DoubleTensor, \
      StringTensor)
 #endif
@@ -131,51 +131,57 @@ Pass::ReturnType MemoryAllocation::runOnModule(Module& pModule)
     SplitGraph *spGraph = worklist.back();
     worklist.pop_back();
 
-    scheduler->runOnGraph(spGraph->getGraph());
-    liveAnaly->runOnGraph(spGraph->getGraph());
+    xGraph &graph = spGraph->getGraph();
+
+    // Memory required by the graph with the given sizes.
+    auto estimate = [&] (const ValMemSizeMap &pSizes) -> uint64_t {
+      ValMemSizeMap sizes(pSizes);
+      scheduler->runOnGraph(graph, sizes, localMemSize);
+      liveAnaly->runOnGraph(graph);
+      return allocByLiveness(graph, sizes, *liveAnaly);
+    };
 
     // per graph
-    int64_t prevMinSize = 0;
-    const float threshold = 0.9f; // 90% splitting threshold.
+    bool hasSearched = false;
 
-    outs() << "Allocate graph: " << spGraph->getGraph().name() << "\n";
+    outs() << "Allocate graph: " << graph.name() << "\n";
     while (true) {
       ValMemSizeMap valMemSMap;
       spGraph->getMemUsage(valMemSMap);
 
+      // Schedule with the current (tiled) sizes, so that the order keeps the
+      // peak memory under the local memory when possible.
+      scheduler->runOnGraph(graph, valMemSMap, localMemSize);
+      liveAnaly->runOnGraph(graph);
+
       // Try to allocate.
-      uint64_t minSize = allocByLiveness(spGraph->getGraph(),
-                                         valMemSMap, *liveAnaly);
+      uint64_t minSize = allocByLiveness(graph, valMemSMap, *liveAnaly);
       outs() << " -> " << (float)minSize / 1024.f << " kb\n";
       if (minSize < localMemSize) {
         spGraph->setAllocStatus(true, minSize);
         break;
       }
 
-      // If new allocation is not smaller enough than previous allocation, then
-      // create new sub graph
-      if (prevMinSize && (float)minSize / prevMinSize > threshold) {
-        prevMinSize = 0;
-
-        SplitGraph *newSpGraph = sgMgr.splitNewSubGraph(*spGraph);
-
-        if (newSpGraph) {
-          worklist.push_back(newSpGraph);
-
-          spGraph->resetToOrigSize();
-          scheduler->runOnGraph(spGraph->getGraph());
-          liveAnaly->runOnGraph(spGraph->getGraph());
-          continue;
-        }
-        else {
-          outs() << "[MemoryAllocation] Unable to allocate memory for graph.\n";
-          spGraph->setAllocStatus(false, minSize);
-          break;
-        }
+      // Search the cheapest tiling which fits, then allocate it.
+      if (!hasSearched) {
+        hasSearched = true;
+        spGraph->searchTiling(localMemSize, estimate);
+        continue;
+      }
+
+      // No tiling fits, create new sub graph.
+      SplitGraph *newSpGraph = sgMgr.splitNewSubGraph(*spGraph);
+      if (newSpGraph) {
+        worklist.push_back(newSpGraph);
+
+        spGraph->resetToOrigSize();
+        hasSearched = false;
+        continue;
       }
-      prevMinSize = minSize;
 
-      spGraph->shrinkSize();
+      outs() << "[MemoryAllocation] Unable to allocate memory for graph.\n";
+      spGraph->setAllocStatus(false, minSize);
+      break;
     }
   }
   return kModuleChanged;
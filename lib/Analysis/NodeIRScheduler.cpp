@@ -12,6 +12,7 @@
 #include <onnc/IR/Dump.h>
 #include <onnc/Support/IOStream.h>
 #include <onnc/Target/TargetTransformInfo.h>
+#include <algorithm>
 #include <iomanip> // for setw
 #include <limits>
 
@@ -48,7 +49,8 @@ static void InsertLoadStoreNode(xGraph &pGraph)
         first = u.user;
     }
 
-    // Create load node and insert before the first use node.
+    // Create load node and insert before the first use node. The scheduler
+    // then moves it to the time its users need it.
     xNode* loadN = pGraph.create(xSymbol("Load"));
     loadN->insertBefore(first);
     loadN->output()->copyMetadata(v);
@@ -81,7 +83,8 @@ static void InsertLoadStoreNode(xGraph &pGraph)
 // NodeIRScheduler
 //===----------------------------------------------------------------------===//
 NodeIRScheduler::NodeIRScheduler(DLATargetBackend* pDLATB)
-  : m_DLATB(pDLATB), m_CurCycle(0) {
+  : m_DLATB(pDLATB), m_CurCycle(0), m_pValMemSizeMap(nullptr),
+    m_MemBudget(0), m_CurMemUsage(0), m_PeakMemUsage(0) {
 }
 
 NodeIRScheduler::~NodeIRScheduler()
@@ -90,6 +93,16 @@ NodeIRScheduler::~NodeIRScheduler()
 
 using DegreeMap = std::unordered_map<xNode *, unsigned>;
 
+static bool IsLoad(const xNode *pNode)
+{
+  return pNode->kind() == xSymbol("Load");
+}
+
+static bool IsStore(const xNode *pNode)
+{
+  return pNode->kind() == xSymbol("Store");
+}
+
 static DegreeMap BuildDegreeMap(xGraph &pGraph)
 {
   DegreeMap dmap;
@@ -157,6 +170,18 @@ Nodes NodeIRScheduler::issue()
 
 Nodes NodeIRScheduler::greedyPickNextNodes(Nodes &pCands)
 {
+  // Stores first, since they release memory, then the longest path first.
+  std::stable_sort(pCands.begin(), pCands.end(),
+                   [this] (xNode *pA, xNode *pB) {
+                     if (IsStore(pA) != IsStore(pB))
+                       return IsStore(pA);
+                     return m_BottomLevels[pA] > m_BottomLevels[pB];
+                   });
+
+  // When nothing runs, a node must be picked even though it waits for
+  // memory or for its users, otherwise the schedule makes no progress.
+  const bool mustPick = isAllExeResEmpty();
+
   Nodes next;
   std::vector<int> rmList;
 
@@ -168,11 +193,23 @@ Nodes NodeIRScheduler::greedyPickNextNodes(Nodes &pCands)
     if (m_ExeResUsers.find(res) == m_ExeResUsers.end())
       m_ExeResUsers[res] = {};
 
-    if (isExeResAvailable(res)) {
-      addExeResUser(res, n);
-      next.push_back(n);
-      rmList.push_back(i);
-    }
+    if (!isExeResAvailable(res))
+      continue;
+
+    const bool isForced = mustPick && next.empty();
+    if (!isForced && IsLoad(n) && !isLoadNeeded(n))
+      continue;
+
+    const uint64_t required = getOutputMemSize(n);
+    if (!isForced && 0 < required && m_MemBudget < m_CurMemUsage + required)
+      continue;
+
+    addExeResUser(res, n);
+    m_Issued.insert(n);
+    m_CurMemUsage += required;
+    m_PeakMemUsage = std::max(m_PeakMemUsage, m_CurMemUsage);
+    next.push_back(n);
+    rmList.push_back(i);
   }
 
   // Remove picked node in backward direction.
@@ -182,6 +219,93 @@ Nodes NodeIRScheduler::greedyPickNextNodes(Nodes &pCands)
   return next;
 }
 
+void NodeIRScheduler::buildSchedInfo(xGraph &pGraph)
+{
+  const TargetTransformInfo *tti = m_DLATB->getTTI();
+  for (auto it = pGraph.nodes().rbegin(); it != pGraph.nodes().rend(); ++it) {
+    xNode *n = *it;
+    if (n->kind() == xBuiltinSymbol::kUndefined)
+      continue;
+
+    uint64_t tail = 0;
+    for (xValue *v : n->outputs()) {
+      unsigned numUses = 0;
+      for (auto u : v->uses()) {
+        if (u.user->kind() == xBuiltinSymbol::kReturn)
+          continue;
+        ++numUses;
+        tail = std::max(tail, m_BottomLevels[u.user]);
+      }
+      m_RemainUses[v] = numUses;
+    }
+    m_BottomLevels[n] =
+        tail + tti->getOperatorCost(n, TargetTransformInfo::kCycleCount);
+  }
+}
+
+uint64_t NodeIRScheduler::getLocalMemSize(const xValue *pValue) const
+{
+  // graph inputs and stored values live in the global memory.
+  if (pValue->node() == nullptr ||
+      pValue->node()->kind() == xBuiltinSymbol::kParam ||
+      IsStore(pValue->node()))
+    return 0;
+
+  auto it = m_pValMemSizeMap->find(pValue);
+  if (it == m_pValMemSizeMap->end())
+    return 0;
+  return it->second.size;
+}
+
+uint64_t NodeIRScheduler::getOutputMemSize(const xNode *pNode) const
+{
+  uint64_t size = 0;
+  for (const xValue *v : pNode->outputs())
+    size += getLocalMemSize(v);
+  return size;
+}
+
+bool NodeIRScheduler::isLoadNeeded(const xNode *pLoad) const
+{
+  for (auto u : pLoad->outputs()[0]->uses()) {
+    if (u.user->kind() == xBuiltinSymbol::kReturn)
+      continue;
+
+    bool isReady = true;
+    for (const xValue *v : u.user->inputs()) {
+      const xNode *producer = v->node();
+      if (producer == nullptr || producer == pLoad ||
+          producer->kind() == xBuiltinSymbol::kParam || IsLoad(producer))
+        continue;
+      if (!m_Issued.count(producer)) {
+        isReady = false;
+        break;
+      }
+    }
+    if (isReady)
+      return true;
+  }
+  return false;
+}
+
+void NodeIRScheduler::releaseInputs(const xNode *pNode)
+{
+  for (const xValue *v : pNode->inputs()) {
+    auto it = m_RemainUses.find(v);
+    if (it == m_RemainUses.end() || it->second == 0)
+      continue;
+    if (--it->second == 0)
+      m_CurMemUsage -= std::min(m_CurMemUsage, getLocalMemSize(v));
+  }
+
+  // values nobody reads are released at once.
+  for (const xValue *v : pNode->outputs()) {
+    auto it = m_RemainUses.find(v);
+    if (it != m_RemainUses.end() && it->second == 0)
+      m_CurMemUsage -= std::min(m_CurMemUsage, getLocalMemSize(v));
+  }
+}
+
 bool NodeIRScheduler::isAllExeResEmpty() const
 {
   for (auto &it : m_ExeResUsers) {
@@ -204,12 +328,37 @@ Pass::ReturnType NodeIRScheduler::runOnGraph(xGraph &pGraph)
     return kPassFailure;
   }
 
+  if (!HasInsertedLoadStoreNode(pGraph))
+    InsertLoadStoreNode(pGraph);
+
+  m_TargetValMemSizes.clear();
+  for (xNode *n : pGraph.nodes())
+    for (xValue *v : n->outputs())
+      m_TargetValMemSizes[v] = m_DLATB->getMemInfo()->getValueMemorySize(v);
+
+  return runOnGraph(pGraph, m_TargetValMemSizes,
+                    m_DLATB->getMemInfo()->getLocalMemSize());
+}
+
+Pass::ReturnType NodeIRScheduler::runOnGraph(xGraph &pGraph,
+                                             const ValMemSizeMap &pValMemSizeMap,
+                                             uint64_t pMemBudget)
+{
+  if (!m_DLATB) {
+    errs() << "No backend infomation that is needed for memory allcation.\n";
+    return kPassFailure;
+  }
+
   clear();
+  m_pValMemSizeMap = &pValMemSizeMap;
+  m_MemBudget = pMemBudget;
 
   xGraph &graph = pGraph;
   if (!HasInsertedLoadStoreNode(graph))
     InsertLoadStoreNode(graph);
 
+  buildSchedInfo(graph);
+
   DegreeMap dmap = BuildDegreeMap(graph);
   Nodes worklist;
 
@@ -228,6 +377,7 @@ Pass::ReturnType NodeIRScheduler::runOnGraph(xGraph &pGraph)
     Nodes completes = issue();
 
     for (xNode *n : completes) {
+      releaseInputs(n);
       for (xValue *v : n->outputs()) {
         // Update degree map.
         for(auto u : v->uses()) {
@@ -258,6 +408,8 @@ Pass::ReturnType NodeIRScheduler::runOnGraph(xGraph &pGraph)
       ++it;
   }
 
+  // the size map belongs to the caller.
+  m_pValMemSizeMap = nullptr;
   return kModuleChanged;
 }
 
@@ -274,6 +426,9 @@ void NodeIRScheduler::print(OStream& pOS, const Module* pModule) const
                      return (c + cycleUnit - 1) / cycleUnit;
                    };
 
+  pOS << "Peak local memory: " << m_PeakMemUsage << " / " << m_MemBudget
+      << " bytes\n";
+
   // print schedule diagram
   for (const ExeCycle &exe : m_SchedTimeLine) {
     pOS << std::setw(normalize(exe.begin));
@@ -8,6 +8,7 @@
 #include <onnc/Analysis/SplitNode.h>
 #include <onnc/IR/ONNXUtils.h>
 #include <onnc/Support/IOStream.h>
+#include <algorithm>
 #include <limits>
 #include <iomanip> // for setw
 #include <tuple>
@@ -393,28 +394,148 @@ void SplitGraph::getMemUsage(ValMemSizeMap &pVMSMap) const
   }
 }
 
-void SplitGraph::shrinkSize()
+static uint64_t GetNumOfElements(const LongInts& pSizes)
 {
-  // Shrink size, and propogate backward.
-  for (unsigned i = 0; i < m_Stores.size(); ++i) {
-    xNode *n = m_Stores[i];
-
-    const TensorSizes &origSizes = n->inputs()[0]->sizes();
-    unsigned &factor = m_CurSplitFactor[i],
-             &splitAxis = m_CurSplitAxis[i];
-    ++factor;
-    // Can't divide this axis further, try next axis.
-    if (origSizes[splitAxis].dim < factor) {
-      ++splitAxis;
-      factor = 1;
+  uint64_t num = 1;
+  for (int64_t s : pSizes)
+    num *= s;
+  return num;
+}
+
+SplitGraph::Tilings SplitGraph::GetTilingCandidates(const LongInts& pSizes)
+{
+  Tilings candidates;
+  for (unsigned axis = 0; axis < pSizes.size(); ++axis) {
+    const int64_t dim = pSizes[axis];
+    int64_t prevTile = 0;
+    for (int64_t factor = 2; factor <= dim; ++factor) {
+      const int64_t tile = (dim + factor - 1) / factor;
+      if (tile == prevTile)
+        continue;
+      prevTile = tile;
+      candidates.emplace_back(axis, factor);
     }
+  }
+  return candidates;
+}
 
-    // Unable divide further, give up shrink this output value.
-    if (origSizes.size() == splitAxis)
+void SplitGraph::applyTilings(const Tilings& pTilings)
+{
+  resetToOrigSize();
+  for (unsigned i = 0; i < m_Stores.size(); ++i) {
+    m_CurSplitAxis[i] = pTilings[i].axis;
+    m_CurSplitFactor[i] = pTilings[i].factor;
+    if (1 < pTilings[i].factor)
+      splitNodeByFactor(m_Stores[i], pTilings[i].axis, pTilings[i].factor,
+                        true);
+  }
+}
+
+uint64_t SplitGraph::getTilingCost() const
+{
+  const TargetTransformInfo &tti = m_SgMgr.getTTI();
+
+  // The graph runs once per tile of the most split output value.
+  uint64_t numTiles = 1;
+  for (unsigned factor : m_CurSplitFactor)
+    numTiles = std::max<uint64_t>(numTiles, factor);
+
+  double tileCost = 0.0;
+  for (const auto &snIt : m_SplitNodes) {
+    const xNode *n = snIt.first;
+    const SplitNode *sn = snIt.second;
+    if (sn->skipWhenCalMemSize() || n->outputs().empty())
       continue;
 
-    splitNodeByFactor(n, splitAxis, factor, true);
+    // a tile computes its share of the output plus the halo its users need.
+    const uint64_t origElems = GetNumOfElements(GetOutputValueSizes(*n));
+    const uint64_t tileElems = GetNumOfElements(sn->getNewOutputSize(0));
+    if (0 < origElems)
+      tileCost += static_cast<double>(tti.getOperatorCost(
+                      n, TargetTransformInfo::kCycleCount)) *
+                  tileElems / origElems;
+
+    for (unsigned i = 0; i < n->inputs().size(); ++i) {
+      const xNode *producer = n->inputs()[i]->node();
+      if (producer == nullptr || !IsType("Load", producer))
+        continue;
+      tileCost += tti.getTransferCost(
+          tti.getOperatorInputMemUsage(n, i, sn->calNewInputSize(i)).size);
+    }
+
+    for (unsigned i = 0; i < n->outputs().size(); ++i) {
+      for (auto u : n->outputs()[i]->uses()) {
+        if (!IsType("Store", u.user))
+          continue;
+        tileCost += tti.getTransferCost(
+            tti.getOperatorOutputMemUsage(n, i, sn->getNewOutputSize(i)).size);
+        break;
+      }
+    }
   }
+  return static_cast<uint64_t>(numTiles * tileCost);
+}
+
+bool SplitGraph::searchTiling(uint64_t pMemBudget,
+                              const MemUsageEstimator& pEstimator)
+{
+  struct Score
+  {
+    uint64_t memUsage;
+    uint64_t cost;
+  };
+
+  auto evaluate = [&] (const Tilings& pTilings) -> Score {
+    applyTilings(pTilings);
+    ValMemSizeMap sizes;
+    getMemUsage(sizes);
+    return Score{pEstimator(sizes), getTilingCost()};
+  };
+
+  // A fitting tiling beats any other; among the fitting ones the cheapest
+  // wins, otherwise the smallest, so the search moves towards fitting.
+  auto isBetter = [pMemBudget] (const Score& pA, const Score& pB) {
+    const bool fitA = pA.memUsage < pMemBudget,
+               fitB = pB.memUsage < pMemBudget;
+    if (fitA != fitB)
+      return fitA;
+    if (fitA)
+      return pA.cost < pB.cost;
+    return pA.memUsage < pB.memUsage ||
+           (pA.memUsage == pB.memUsage && pA.cost < pB.cost);
+  };
+
+  std::vector<Tilings> candidates;
+  for (xNode *store : m_Stores) {
+    candidates.push_back(GetTilingCandidates(GetValueSizes(*store->inputs()[0])));
+    candidates.back().emplace_back(0, 1);
+  }
+
+  // Coordinate descent: re-pick the tiling of one output value at a time
+  // while the others stay, until no single change improves the score.
+  Tilings best(m_Stores.size());
+  Score bestScore = evaluate(best);
+  const unsigned maxRounds = 4;
+  for (unsigned round = 0; round < maxRounds; ++round) {
+    bool changed = false;
+    for (unsigned i = 0; i < m_Stores.size(); ++i) {
+      for (const Tiling &candidate : candidates[i]) {
+        Tilings trial(best);
+        trial[i] = candidate;
+        Score score = evaluate(trial);
+        if (isBetter(score, bestScore)) {
+          best = trial;
+          bestScore = score;
+          changed = true;
+        }
+      }
+    }
+    if (!changed)
+      break;
+  }
+
+  applyTilings(best);
+  return bestScore.memUsage < pMemBudget;
 }
 
 SplitNode* SplitGraph::getSplitNode(xNode* pN)
@@ -5,8 +5,11 @@
 // See LICENSE.TXT for details.
 //
 //===----------------------------------------------------------------------===//
+#include <onnc/CodeGen/LiveIntervalsData.h>
+#include <onnc/CodeGen/LiveValueMatrix.h>
 #include <onnc/CodeGen/MemAllocData.h>
 #include <onnc/CodeGen/SetMemOperand.h>
+#include <onnc/CodeGen/SlotIndexes.h>
 #include <onnc/Core/PassAnalysisSupport.h>
 #include <onnc/Core/PassSupport.h>
 
@@ -37,6 +40,12 @@ Pass::ReturnType SetMemOperand::runOnModule(Module& pModule)
 void SetMemOperand::getAnalysisUsage(AnalysisUsage& pUsage) const
 {
   pUsage.addRequired<MemAllocData>();
+
+  // only memory operands are updated, the schedule and liveness are intact.
+  pUsage.addPreserved<BuildSlotIndexes>();
+  pUsage.addPreserved<LiveIntervalsData>();
+  pUsage.addPreserved<LiveValueMatrix>();
+  pUsage.addPreserved<MemAllocData>();
 }
 
 //===----------------------------------------------------------------------===//
@@ -7,6 +7,8 @@
 //===----------------------------------------------------------------------===//
 #include <onnc/Core/AnalysisUsage.h>
 
+#include <algorithm>
+
 using namespace onnc;
 
 //===----------------------------------------------------------------------===//
@@ -17,3 +19,16 @@ AnalysisUsage& AnalysisUsage::addRequiredID(Pass::AnalysisID pID)
   m_Required.push_back(pID);
   return *this;
 }
+
+AnalysisUsage& AnalysisUsage::addPreservedID(Pass::AnalysisID pID)
+{
+  m_Preserved.push_back(pID);
+  return *this;
+}
+
+bool AnalysisUsage::isPreserved(Pass::AnalysisID pID) const
+{
+  if (m_PreservesAll)
+    return true;
+  return m_Preserved.end() != std::find(m_Preserved.begin(), m_Preserved.end(), pID);
+}
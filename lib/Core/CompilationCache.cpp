@@ -0,0 +1,235 @@
+//===- CompilationCache.cpp -----------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Core/CompilationCache.h>
+#include <onnc/Config/Config.h>
+#include <onnc/Support/Directory.h>
+#include <onnc/Support/FileSystem.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#if defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+using namespace onnc;
+
+// Bump it whenever the layout of an entry or the key changes. The compiler
+// release is part of the context of the key.
+static const char* g_CacheVersion = "onnc-compilation-cache-2";
+
+// The record of the key in an entry. It is not an artifact.
+static const char* g_KeyFile = "onnc-cache-key";
+
+static const uint64_t g_FNVOffset = 14695981039346656037ULL;
+static const uint64_t g_FNVPrime  = 1099511628211ULL;
+
+static uint64_t HashBytes(uint64_t pHash, const char* pData, size_t pSize)
+{
+  for (size_t i = 0; i < pSize; ++i) {
+    pHash ^= static_cast<unsigned char>(pData[i]);
+    pHash *= g_FNVPrime;
+  }
+  return pHash;
+}
+
+static uint64_t HashString(uint64_t pHash, StringRef pString)
+{
+  // hash the length too, so that ("ab", "c") and ("a", "bc") differ.
+  const uint64_t size = pString.size();
+  pHash = HashBytes(pHash, reinterpret_cast<const char*>(&size), sizeof(size));
+  return HashBytes(pHash, pString.data(), pString.size());
+}
+
+// A multiply-rotate digest, unrelated to FNV-1a, so that a model colliding
+// with another under one of them still differs under the other.
+static uint64_t DigestBytes(uint64_t pDigest, const char* pData, size_t pSize)
+{
+  for (size_t i = 0; i < pSize; ++i) {
+    pDigest = ((pDigest << 5) | (pDigest >> 59)) ^ static_cast<unsigned char>(pData[i]);
+    pDigest *= 0x9E3779B97F4A7C15ULL;
+  }
+  return pDigest;
+}
+
+//===----------------------------------------------------------------------===//
+// CompilationCache
+//===----------------------------------------------------------------------===//
+CompilationCache::CompilationCache(const Path& pDirectory)
+  : m_Directory(pDirectory) {
+}
+
+bool CompilationCache::makeKey(Key& pKey, const Path& pModel,
+                               StringRef pContext) const
+{
+  std::ifstream model(pModel.native(), std::ios::in | std::ios::binary);
+  if (!model.good())
+    return false;
+
+  uint64_t hash = HashString(g_FNVOffset, g_CacheVersion);
+  hash = HashString(hash, pContext);
+
+  uint64_t digest = 0;
+  uint64_t size = 0;
+  char buffer[64 * 1024];
+  while (model) {
+    model.read(buffer, sizeof(buffer));
+    hash = HashBytes(hash, buffer, model.gcount());
+    digest = DigestBytes(digest, buffer, model.gcount());
+    size += model.gcount();
+  }
+  if (model.bad())
+    return false;
+
+  pKey.hash = hash;
+  pKey.identity = std::string(g_CacheVersion) + "\n" + pContext.str() + "\n" +
+                  std::to_string(size) + " " + ToString(digest) + "\n";
+  return true;
+}
+
+Path CompilationCache::getEntryPath(const Key& pKey) const
+{
+  Path result(m_Directory);
+  result.append(Path(ToString(pKey.hash)));
+  return result;
+}
+
+bool CompilationCache::lookup(const Key& pKey, const Path& pOutputDir) const
+{
+  Path entry = getEntryPath(pKey);
+  if (!is_directory(entry))
+    return false;
+
+  // another model or context with the same hash
+  Path record(entry);
+  record.append(Path(g_KeyFile));
+  std::ifstream ifs(record.native(), std::ios::in | std::ios::binary);
+  std::string identity((std::istreambuf_iterator<char>(ifs)),
+                       std::istreambuf_iterator<char>());
+  if (!ifs.good() && !ifs.eof())
+    return false;
+  if (identity != pKey.identity)
+    return false;
+
+  return CopyFiles(entry, pOutputDir);
+}
+
+Path CompilationCache::prepare(const Key& pKey) const
+{
+  if (!exists(m_Directory) && !mkdir(m_Directory, 0755).isGood())
+    return Path();
+
+  std::string name = ToString(pKey.hash) + ".tmp";
+#if defined(HAVE_UNISTD_H)
+  // concurrent compilations of the same model must not share a staging area.
+  name += "." + std::to_string(::getpid());
+#endif
+
+  Path staging(m_Directory);
+  staging.append(Path(name));
+  if (exists(staging))
+    clean(staging);
+  if (!mkdir(staging, 0755).isGood())
+    return Path();
+  return staging;
+}
+
+bool CompilationCache::commit(const Key& pKey, const Path& pStaging,
+                              const Path& pOutputDir) const
+{
+  // A backend which emits nothing into the staging directory either has
+  // no artifact or writes it elsewhere. A warm start could not restore it,
+  // so the compilation succeeds without being cached.
+  if (IsEmpty(pStaging)) {
+    clean(pStaging);
+    return true;
+  }
+
+  if (!CopyFiles(pStaging, pOutputDir)) {
+    clean(pStaging);
+    return false;
+  }
+
+  // Without the record, lookup can not tell the entry is for this key.
+  Path record(pStaging);
+  record.append(Path(g_KeyFile));
+  std::ofstream ofs(record.native(), std::ios::out | std::ios::binary);
+  ofs << pKey.identity;
+  ofs.close();
+  if (!ofs) {
+    clean(pStaging);
+    return true;
+  }
+
+  // Publish the entry atomically. If another process has published the same
+  // entry, or another key with the same hash has, keep theirs.
+  Path entry = getEntryPath(pKey);
+  if (exists(entry) || 0 != std::rename(pStaging.c_str(), entry.c_str()))
+    clean(pStaging);
+  return true;
+}
+
+void CompilationCache::erase(const Key& pKey) const
+{
+  Path entry = getEntryPath(pKey);
+  if (exists(entry))
+    clean(entry);
+}
+
+std::string CompilationCache::ToString(uint64_t pHash)
+{
+  static const char* digits = "0123456789abcdef";
+  std::string result(2 * sizeof(pHash), '0');
+  for (std::string::reverse_iterator c = result.rbegin(); c != result.rend(); ++c) {
+    *c = digits[pHash & 0xF];
+    pHash >>= 4;
+  }
+  return result;
+}
+
+bool CompilationCache::IsEmpty(const Path& pDirectory)
+{
+  Directory dir(pDirectory);
+  if (!dir.isGood())
+    return true;
+
+  for (Directory::const_iterator file = dir.begin(), fEnd = dir.end();
+       file != fEnd; file.next()) {
+    Path path(pDirectory);
+    path.append(file.fileInfo().path());
+    if (is_regular(path))
+      return false;
+  }
+  return true;
+}
+
+bool CompilationCache::CopyFiles(const Path& pFrom, const Path& pTo)
+{
+  Directory dir(pFrom);
+  if (!dir.isGood())
+    return false;
+
+  for (Directory::const_iterator file = dir.begin(), fEnd = dir.end();
+       file != fEnd; file.next()) {
+    if (file.fileInfo().path().native() == g_KeyFile)
+      continue;
+
+    Path from(pFrom);
+    from.append(file.fileInfo().path());
+    if (!is_regular(from))
+      continue;
+
+    Path to(pTo);
+    to.append(file.fileInfo().path());
+    if (!copy_file(from, to, kOverwriteIfExists).isGood())
+      return false;
+  }
+  return true;
+}
@@ -30,6 +30,7 @@ PassManager::PassManager()
   , m_passStore{}
   , m_RunState{}
   , m_pStart{m_depGraph.addNode(StartPass::id())}
+  , m_pTimingInfo{nullptr}
   , m_TimeStep{0u}
 { }
 
@@ -40,6 +41,7 @@ PassManager::PassManager(PassRegistry& pRegistry)
   , m_passStore{}
   , m_RunState{}
   , m_pStart{m_depGraph.addNode(StartPass::id())}
+  , m_pTimingInfo{nullptr}
   , m_TimeStep(0u)
 { }
 
@@ -165,6 +167,7 @@ void PassManager::initRunState(Module& pModule, State& pState)
     }
   }
   m_lastExecuted.clear();
+  m_validTimeSteps.clear();
 }
 
 bool PassManager::run(Module& pModule, State& pState)
@@ -209,8 +212,10 @@ bool PassManager::step(Module& pModule, State& pState)
   if (Pass::IsFailed(result))
     return false;
 
-  if (Pass::IsRevised(result))
+  if (Pass::IsRevised(result)) {
+    preserveAnalyses(*pState.pass, pModule);
     pModule.setTimeStep(m_TimeStep);
+  }
 
   if (Pass::IsRetry(result)) {
     UpdateExecutionOrder(pState.execution);
@@ -235,7 +240,7 @@ bool PassManager::needRun(Pass& pPass, Module& pModule)
   if (pPass.getModule() != &pModule)
     return true;
 
-  if (pModule.getTimeStep() > pPass.getTimeStep())
+  if (pModule.getTimeStep() > getValidTimeStep(pPass))
     return true;
 
   AnalysisUsage usage;
@@ -273,6 +278,9 @@ void PassManager::movePassToStore(Pass* pass)
 
 Pass::ReturnType PassManager::doRun(Pass& pPass, Module& pModule)
 {
+  // measure every execution, including the retried ones.
+  PassTimingInfo::Scope timing(m_pTimingInfo, pPass);
+
   // initialize the pass
   Pass::ReturnType result = pPass.doInitialization(pModule);
 
@@ -437,6 +445,40 @@ Pass* PassManager::getLastExecutedOrFromStore(Pass::AnalysisID passId) const
   return getPass(passId);
 }
 
+unsigned PassManager::getValidTimeStep(const Pass& pPass) const
+{
+  const auto found = m_validTimeSteps.find(&pPass);
+  if (found == end(m_validTimeSteps)) {
+    return pPass.getTimeStep();
+  }
+
+  return std::max(found->second, pPass.getTimeStep());
+}
+
+void PassManager::preserveAnalyses(const Pass& pPass, const Module& pModule)
+{
+  AnalysisUsage usage;
+  pPass.getAnalysisUsage(usage);
+  if (!usage.hasPreserved())
+    return;
+
+  for (auto& entry : m_passStore) {
+    if (!usage.isPreserved(entry.first))
+      continue;
+
+    for (auto& pass : entry.second) {
+      if (pass.get() == &pPass || pass->getModule() != &pModule)
+        continue;
+
+      // A result that is already out of date stays out of date.
+      if (pModule.getTimeStep() > getValidTimeStep(*pass))
+        continue;
+
+      m_validTimeSteps[pass.get()] = m_TimeStep;
+    }
+  }
+}
+
 Pass* PassManager::getPass(Pass::AnalysisID passId) const
 {
   const auto found = m_passStore.find(passId);
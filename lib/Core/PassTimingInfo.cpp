@@ -0,0 +1,159 @@
+//===- PassTimingInfo.cpp -------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Core/PassTimingInfo.h>
+#include <onnc/Core/Pass.h>
+#include <onnc/Support/Host.h>
+
+#include <algorithm>
+#include <iomanip>
+
+using namespace onnc;
+
+static const char* g_GroupName = "PassTiming";
+static const char* g_RunsKey = "runs";
+static const char* g_WallKey = "wall-ns";
+static const char* g_CPUKey  = "cpu-ns";
+static const char* g_RSSKey  = "rss-delta";
+
+//===----------------------------------------------------------------------===//
+// PassTimingInfo::Scope
+//===----------------------------------------------------------------------===//
+PassTimingInfo::Scope::Scope(PassTimingInfo* pInfo, const Pass& pPass)
+  : m_pInfo(pInfo), m_Pass(pPass), m_Wall(), m_CPU(0), m_RSS(0) {
+  if (nullptr == m_pInfo)
+    return;
+
+  m_RSS = sys::GetResidentSetSize();
+  m_CPU = std::clock();
+  m_Wall = std::chrono::steady_clock::now();
+}
+
+PassTimingInfo::Scope::~Scope()
+{
+  if (nullptr == m_pInfo)
+    return;
+
+  const auto wall = std::chrono::steady_clock::now() - m_Wall;
+  const std::clock_t cpu = std::clock() - m_CPU;
+  const long rss = sys::GetResidentSetSize() - m_RSS;
+
+  m_pInfo->add(m_Pass.getPassName(),
+               std::chrono::duration_cast<std::chrono::nanoseconds>(wall).count(),
+               static_cast<long>(cpu * (1000000000.0 / CLOCKS_PER_SEC)),
+               rss);
+}
+
+//===----------------------------------------------------------------------===//
+// PassTimingInfo
+//===----------------------------------------------------------------------===//
+PassTimingInfo::PassTimingInfo()
+  : m_OwnStats(), m_Stats(m_OwnStats) {
+}
+
+PassTimingInfo::PassTimingInfo(Statistics& pStats)
+  : m_OwnStats(), m_Stats(pStats) {
+}
+
+void PassTimingInfo::add(StringRef pPassName, long pWall, long pCPU, long pRSS)
+{
+  json::Group pass = m_Stats.addGroup(g_GroupName).addGroup(pPassName);
+  pass.writeEntry(g_RunsKey, pass.readEntry(g_RunsKey, 0L) + 1);
+  pass.writeEntry(g_WallKey, pass.readEntry(g_WallKey, 0L) + pWall);
+  pass.writeEntry(g_CPUKey,  pass.readEntry(g_CPUKey, 0L) + pCPU);
+  pass.writeEntry(g_RSSKey,  pass.readEntry(g_RSSKey, 0L) + pRSS);
+}
+
+PassTimingInfo::RecordList PassTimingInfo::getRecords() const
+{
+  RecordList result;
+  if (!m_Stats.hasGroup(g_GroupName))
+    return result;
+
+  json::Group timing = m_Stats.group(g_GroupName);
+  for (json::Group::iterator it = timing.gBegin(), iEnd = timing.gEnd();
+       it != iEnd; it.next()) {
+    json::Group pass = it.group();
+    Record record;
+    record.name = it.name().str();
+    record.runs = pass.readEntry(g_RunsKey, 0L);
+    record.wall = pass.readEntry(g_WallKey, 0L);
+    record.cpu  = pass.readEntry(g_CPUKey, 0L);
+    record.rss  = pass.readEntry(g_RSSKey, 0L);
+    result.push_back(record);
+  }
+
+  std::stable_sort(result.begin(), result.end(),
+                   [](const Record& pA, const Record& pB) {
+                     return pA.wall > pB.wall;
+                   });
+  return result;
+}
+
+static void PrintJSONString(OStream& pOS, const std::string& pString)
+{
+  pOS << '"';
+  for (char c : pString) {
+    if ('"' == c || '\\' == c)
+      pOS << '\\';
+    pOS << c;
+  }
+  pOS << '"';
+}
+
+void PassTimingInfo::print(OStream& pOS, Format pFormat) const
+{
+  const RecordList records = getRecords();
+
+  if (kJSON == pFormat) {
+    pOS << "[";
+    for (RecordList::const_iterator r = records.begin(); r != records.end(); ++r) {
+      pOS << (r == records.begin() ? "\n" : ",\n") << "  { \"name\": ";
+      PrintJSONString(pOS, r->name);
+      pOS << ", \"" << g_RunsKey << "\": " << r->runs
+          << ", \"" << g_WallKey << "\": " << r->wall
+          << ", \"" << g_CPUKey << "\": " << r->cpu
+          << ", \"" << g_RSSKey << "\": " << r->rss << " }";
+    }
+    pOS << "\n]" << std::endl;
+    return;
+  }
+
+  long totalWall = 0, totalCPU = 0, totalRSS = 0;
+  for (const Record& r : records) {
+    totalWall += r.wall;
+    totalCPU += r.cpu;
+    totalRSS += r.rss;
+  }
+
+  std::ios::fmtflags flags(pOS.flags());
+  pOS << "===---------------------------------------------------------===\n"
+      << "                  Pass execution timing report\n"
+      << "===---------------------------------------------------------===\n"
+      << "  Total wall time: " << std::fixed << std::setprecision(3)
+      << totalWall / 1e6 << " ms, CPU time: " << totalCPU / 1e6 << " ms\n\n"
+      << std::setw(12) << "Wall (ms)" << std::setw(9) << "%"
+      << std::setw(12) << "CPU (ms)" << std::setw(12) << "RSS (KiB)"
+      << std::setw(7) << "Runs" << "  Name\n";
+  for (const Record& r : records) {
+    pOS << std::setw(12) << r.wall / 1e6
+        << std::setw(8) << std::setprecision(1)
+        << (0 == totalWall ? 0.0 : 100.0 * r.wall / totalWall) << '%'
+        << std::setw(12) << std::setprecision(3) << r.cpu / 1e6
+        << std::setw(12) << r.rss / 1024
+        << std::setw(7) << r.runs << "  " << r.name << '\n';
+  }
+  pOS << std::setw(12) << totalWall / 1e6 << std::setw(9) << "100.0%"
+      << std::setw(12) << totalCPU / 1e6 << std::setw(12) << totalRSS / 1024
+      << std::setw(7) << "" << "  Total" << std::endl;
+  pOS.flags(flags);
+}
+
+void PassTimingInfo::clear()
+{
+  m_Stats.deleteGroup(g_GroupName);
+}
@@ -45,6 +45,7 @@ void Tensor::print(std::ostream& pOS) const {
     case kBoolean: pOS << "bool"; break;
 
     case kFloat16: pOS << "float16"; break;
+    case kBFloat16: pOS << "bfloat16"; break;
     case kDouble: pOS << "double"; break;
     case kUint32: pOS << "uint32"; break;
     case kUint64: pOS << "uint64"; break;
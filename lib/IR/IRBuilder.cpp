@@ -268,6 +268,28 @@ bool IRBuilder::FinalizeTensorGraph(const StringList& pOutputs)
   result = t; \
 }
 
+/// ONNX keeps 16-bit floating point data as bit patterns, either packed in
+/// raw data or widened into int32_data. Store the bits without conversion.
+#define CREATE_HALF_VAL_DATA(result, CG, tensor, ONNCType) \
+{ \
+  auto t = CG.addValue<ONNCType>(name); \
+  using ElemType = ONNCType::ValueType; \
+  if (tensor.is_raw_data()) { \
+    const size_t numElems = tensor.raw().size() / sizeof(uint16_t); \
+    const uint16_t* d = (const uint16_t*)tensor.raw().c_str(); \
+    t->getValues().resize(numElems); \
+    for (size_t i = 0; i < numElems; ++i) \
+      t->getValues()[i] = ElemType::fromBits(d[i]); \
+  } \
+  else { \
+    const size_t numElems = tensor.int32s().size(); \
+    t->getValues().resize(numElems); \
+    for (size_t i = 0; i < numElems; ++i) \
+      t->getValues()[i] = ElemType::fromBits(tensor.int32s()[i]); \
+  } \
+  result = t; \
+}
+
 Tensor* IRBuilder::CreateComputeTensor(ComputeGraph& pCG,
                                        const xValue& pValue,
                                        const xTensor& pTensor)
@@ -312,7 +334,11 @@ Tensor* IRBuilder::CreateComputeTensor(ComputeGraph& pCG,
     break;
   }
   case onnc::Value::kFloat16: {
-    CREATE_VAL_DATA(result, pCG, pTensor, Float16Tensor, float, floats);
+    CREATE_HALF_VAL_DATA(result, pCG, pTensor, Float16Tensor);
+    break;
+  }
+  case onnc::Value::kBFloat16: {
+    CREATE_HALF_VAL_DATA(result, pCG, pTensor, BFloat16Tensor);
     break;
   }
   case onnc::Value::kString: {
@@ -390,6 +416,10 @@ Tensor* IRBuilder::CreateComputeTensor(ComputeGraph& pCG, const xValue& pValue)
     result = pCG.addValue<onnc::Float16Tensor>(pValue.uniqueName());
     break;
   }
+  case onnc::Value::kBFloat16: {
+    result = pCG.addValue<onnc::BFloat16Tensor>(pValue.uniqueName());
+    break;
+  }
   case onnc::Value::kString: {
     result = pCG.addValue<onnc::StringTensor>(pValue.uniqueName());
     break;
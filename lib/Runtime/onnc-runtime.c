@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 
 #include <unistd.h>
 #include <sys/stat.h> 
@@ -24,11 +25,147 @@ bool ONNC_RUNTIME_shutdown_runtime(void *onnc_runtime_context) {
   }
 
   Context *context = (Context *)onnc_runtime_context;
+  if (context->mkldnn_context != NULL) {
+    context->destroy_mkldnn_context(context->mkldnn_context);
+  }
+
   for (size_t i = 0; i < context->mem_i; ++i) {
     free(context->mem[i]);
   }
 
+  for (size_t i = 0; i < context->widened_i; ++i) {
+    free(context->widened[i]);
+  }
+
   free(context->mem);
+  free(context->constants);
+  free(context->widened);
   free(context);
   return true;
 }
+
+/* The constants are kept sorted by address, so both the lookup and the
+ * duplicate check of an insertion are binary searches. */
+static size_t lower_bound_constant(const Context *context, const void *data) {
+  size_t first = 0;
+  size_t last = context->constants_i;
+  while (first < last) {
+    size_t middle = first + (last - first) / 2;
+    if ((uintptr_t)context->constants[middle] < (uintptr_t)data) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  return first;
+}
+
+bool ONNC_RUNTIME_add_constant(void *onnc_runtime_context, const void *data) {
+  Context *context = (Context *)onnc_runtime_context;
+  size_t index = lower_bound_constant(context, data);
+  if (index < context->constants_i && context->constants[index] == data) {
+    return true;
+  }
+
+  if (context->constants_i == context->constants_capacity) {
+    size_t capacity = (context->constants_capacity == 0)
+                          ? 16
+                          : context->constants_capacity * 2;
+    const void **constants = (const void **)realloc(
+        context->constants, capacity * sizeof(const void *));
+    if (constants == NULL) {
+      return false;
+    }
+    context->constants = constants;
+    context->constants_capacity = capacity;
+  }
+
+  memmove(&context->constants[index + 1], &context->constants[index],
+          (context->constants_i - index) * sizeof(const void *));
+  context->constants[index] = data;
+  context->constants_i += 1;
+  return true;
+}
+
+bool ONNC_RUNTIME_is_constant(void *onnc_runtime_context, const void *data) {
+  Context *context = (Context *)onnc_runtime_context;
+  size_t index = lower_bound_constant(context, data);
+  return index < context->constants_i && context->constants[index] == data;
+}
+
+static float float16_to_float(uint16_t bits) {
+  uint32_t sign = ((uint32_t)bits & 0x8000u) << 16;
+  uint32_t exp = (bits >> 10) & 0x1Fu;
+  uint32_t mant = bits & 0x3FFu;
+
+  uint32_t f;
+  if (exp == 0x1Fu) {
+    f = sign | 0x7F800000u | (mant << 13);
+  } else if (exp != 0) {
+    f = sign | ((exp + 112u) << 23) | (mant << 13);
+  } else if (mant == 0) {
+    f = sign;
+  } else {
+    /* normalize the subnormal value. */
+    exp = 113u;
+    while ((mant & 0x400u) == 0) {
+      mant <<= 1;
+      --exp;
+    }
+    f = sign | (exp << 23) | ((mant & 0x3FFu) << 13);
+  }
+
+  float result;
+  memcpy(&result, &f, sizeof(result));
+  return result;
+}
+
+static float bfloat16_to_float(uint16_t bits) {
+  uint32_t f = (uint32_t)bits << 16;
+  float result;
+  memcpy(&result, &f, sizeof(result));
+  return result;
+}
+
+static float *widen(void *onnc_runtime_context,
+                    struct ONNC_RUNTIME_tensor_view tensor,
+                    float (*to_float)(uint16_t)) {
+  Context *context = (Context *)onnc_runtime_context;
+  if (context->widened_i == context->widened_capacity) {
+    size_t capacity = (context->widened_capacity == 0)
+                          ? 16
+                          : context->widened_capacity * 2;
+    float **widened =
+        (float **)realloc(context->widened, capacity * sizeof(float *));
+    if (widened == NULL) {
+      return NULL;
+    }
+    context->widened = widened;
+    context->widened_capacity = capacity;
+  }
+
+  size_t count = tensor.size / sizeof(uint16_t);
+  float *result = (float *)malloc(count * sizeof(float));
+  if (result == NULL) {
+    return NULL;
+  }
+
+  const uint16_t *bits = (const uint16_t *)tensor.data;
+  for (size_t i = 0; i < count; ++i) {
+    result[i] = to_float(bits[i]);
+  }
+
+  context->widened[context->widened_i] = result;
+  context->widened_i += 1;
+  return result;
+}
+
+float *ONNC_RUNTIME_widen_float16(void *onnc_runtime_context,
+                                  struct ONNC_RUNTIME_tensor_view tensor) {
+  return widen(onnc_runtime_context, tensor, float16_to_float);
+}
+
+float *ONNC_RUNTIME_widen_bfloat16(void *onnc_runtime_context,
+                                   struct ONNC_RUNTIME_tensor_view tensor) {
+  return widen(onnc_runtime_context, tensor, bfloat16_to_float);
+}
@@ -3,6 +3,16 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/assign.h"
+#include "generic/binary.h"
+
+static float and_(float a, float b)
+{
+    return (int32_t)a & (int32_t)b;
+}
+
 void ONNC_RUNTIME_and_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_A
@@ -12,11 +22,6 @@ void ONNC_RUNTIME_and_float(
   ,float * restrict output_C
   ,int32_t output_C_ndim, const int32_t * restrict output_C_dims
 ) {
-  int32_t size = 1;
-  for(int32_t dim = 0 ; dim < input_A_ndim ; dim++){
-      size *= input_A_dims[dim];
-  }
-  for(int32_t index = 0 ; index < size ; index++){
-      output_C[index] = (int32_t)input_A[index] & (int32_t)input_B[index];
-  }
+  ONNC_ASSIGN(float, output_C, output_C_dims, output_C_ndim, input_A, input_A_dims, input_A_ndim);
+  ONNC_BINARY(float, output_C, output_C_dims, output_C_ndim, input_B, input_B_dims, input_B_ndim, and_);
 }
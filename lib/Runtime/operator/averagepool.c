@@ -4,6 +4,45 @@
 #include <stdbool.h>
 #include <string.h>
 
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/pool.h"
+
+static float add_(float a, float b)
+{
+    return a + b;
+}
+
+// Divide the sums of ONNC_POOL2D by the number of elements of the windows.
+static void divide_by_window(float * restrict y, const int32_t * restrict x_dims,
+                             const int32_t * restrict y_dims, int32_t kernel,
+                             int32_t stride, const int32_t * restrict pads,
+                             int32_t count_include_pad) {
+  int32_t height = y_dims[2], width = y_dims[3];
+  float rows[height], cols[width];
+
+  for (int32_t r = 0; r < height; ++r) {
+    int32_t top = r * stride - pads[0];
+    int32_t bottom = top + kernel < x_dims[2] ? top + kernel : x_dims[2];
+    rows[r] = count_include_pad ? kernel : bottom - (top < 0 ? 0 : top);
+  }
+
+  for (int32_t c = 0; c < width; ++c) {
+    int32_t left = c * stride - pads[1];
+    int32_t right = left + kernel < x_dims[3] ? left + kernel : x_dims[3];
+    cols[c] = count_include_pad ? kernel : right - (left < 0 ? 0 : left);
+  }
+
+  for (int32_t p = 0; p < y_dims[0] * y_dims[1]; ++p) {
+    for (int32_t r = 0; r < height; ++r) {
+      float * restrict row = y + ((size_t)p * height + r) * width;
+      for (int32_t c = 0; c < width; ++c) {
+        row[c] /= rows[r] * cols[c];
+      }
+    }
+  }
+}
+
 static inline bool next_dim(int32_t ndim, int32_t * restrict dim,
                             const int32_t * restrict dim_max) {
   do {
@@ -64,6 +103,15 @@ void ONNC_RUNTIME_averagepool_float(
   ,int32_t number_of_strides
 ) {
   // TODO auto_pad
+  if (onnc_pool2d_specialized(input_X_ndim, kernel_shape, number_of_kernel_shape,
+                              pads, number_of_pads, strides, number_of_strides)) {
+    ONNC_POOL2D(float, output_Y, input_X, input_X_dims, output_Y_dims,
+                kernel_shape[0], strides[0], pads, 0, add_);
+    divide_by_window(output_Y, input_X_dims, output_Y_dims, kernel_shape[0],
+                     strides[0], pads, count_include_pad);
+    return;
+  }
+
   int64_t size = 1;
   for (int i = 0; i < input_X_ndim - 2; ++i) {
     size *= kernel_shape[i];
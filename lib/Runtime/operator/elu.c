@@ -3,6 +3,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_elu_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_X
@@ -11,4 +13,13 @@ void ONNC_RUNTIME_elu_float(
   ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
   ,float alpha
 ) {
+  int32_t size = 1;
+  for(int32_t i = 0 ; i < input_X_ndim ; ++i){
+    size *= input_X_dims[i];
+  }
+
+  for(int32_t i = 0 ; i < size ; ++i){
+    float x = input_X[i];
+    output_Y[i] = (x >= 0.0f) ? x : alpha * (onnc_expf(x) - 1.0f);
+  }
 }
@@ -3,6 +3,16 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/assign.h"
+#include "generic/binary.h"
+
+static float equal_(float a, float b)
+{
+    return a == b;
+}
+
 void ONNC_RUNTIME_equal_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_A
@@ -13,11 +23,6 @@ void ONNC_RUNTIME_equal_float(
   ,int32_t output_C_ndim, const int32_t * restrict output_C_dims
   
 ) {
-	int32_t size = 1;
-	for(int32_t i = 0 ; i < input_A_ndim ; ++i){
-		size *= input_A_dims[i];
-	}
-	for(int32_t i = 0 ; i < size ; ++i){
-		output_C[i] = (input_A[i] == input_B[i]);
-	}
+  ONNC_ASSIGN(float, output_C, output_C_dims, output_C_ndim, input_A, input_A_dims, input_A_ndim);
+  ONNC_BINARY(float, output_C, output_C_dims, output_C_ndim, input_B, input_B_dims, input_B_ndim, equal_);
 }
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_exp_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_input
@@ -18,6 +20,6 @@ void ONNC_RUNTIME_exp_float(
   }
 
   for(int32_t index = 0 ; index < size ; index++){
-    output_output[index] = expf(input_input[index]);
+    output_output[index] = onnc_expf(input_input[index]);
   }
 }
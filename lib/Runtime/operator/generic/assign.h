@@ -1,5 +1,6 @@
 #ifndef ONNC_ASSIGN
 
+#include "broadcast.h"
 #include "size.h"
 #include "strides.h"
 #include <string.h>
@@ -14,6 +15,9 @@
  *     [a  b  c  d;
  *      a  b  c  d;
  *      a  b  c  d]
+ *
+ * The common broadcast patterns are copied without index arithmetic.  See
+ * onnc_broadcast().
  */
 #define ONNC_ASSIGN(SCALAR, y, yshape, yorder, x, xshape, xorder) do { \
     typedef SCALAR Scalar;                                             \
@@ -23,25 +27,52 @@
     const Scalar* restrict _x = x;                                     \
     const Index* restrict _yshape = yshape;                            \
     const Index* restrict _xshape = xshape;                            \
+    Index _yorder = yorder;                                            \
     Index _xorder = xorder;                                            \
-    Index _diff = (Index)(yorder) - _xorder;                           \
-    Index _size = onnc_size(_yshape + _diff, _xorder);                 \
-    Index _count = onnc_size(_yshape, _diff);                          \
-    Index _strides[_xorder];                                           \
-    Index _index[_xorder];                                             \
+    Index _outer, _middle, _inner;                                     \
                                                                        \
-    onnc_strides(_strides, _xshape, _xorder);                          \
+    switch (onnc_broadcast(&_outer, &_middle, &_inner,                 \
+                           _yshape, _yorder, _xshape, _xorder)) {      \
+    case ONNC_BROADCAST_SAME:                                          \
+        memcpy(_y, _x, onnc_size(_yshape, _yorder) * sizeof(Scalar));  \
+        break;                                                         \
+    case ONNC_BROADCAST_SCALAR:                                        \
+        for (Index _i = 0; _i < _outer; ++_i)                          \
+            _y[_i] = _x[0];                                            \
+        break;                                                         \
+    case ONNC_BROADCAST_OUTER:                                         \
+        for (Index _o = 0; _o < _outer * _middle; ++_o) {              \
+            Scalar* restrict _row = _y + _o * _inner;                  \
+            Scalar _s = _x[_o % _middle];                              \
+            for (Index _i = 0; _i < _inner; ++_i)                      \
+                _row[_i] = _s;                                         \
+        }                                                              \
+        break;                                                         \
+    case ONNC_BROADCAST_INNER:                                         \
+        for (Index _o = 0; _o < _outer; ++_o)                          \
+            memcpy(_y + _o * _middle, _x, _middle * sizeof(Scalar));   \
+        break;                                                         \
+    default: {                                                         \
+        Index _diff = _yorder - _xorder;                               \
+        Index _size = onnc_size(_yshape + _diff, _xorder);             \
+        Index _count = onnc_size(_yshape, _diff);                      \
+        Index _strides[_xorder];                                       \
+        Index _index[_xorder];                                         \
                                                                        \
-    for (Index _i = 0; _i < _xorder; ++_i)                             \
-        _index[_i] = 0;                                                \
+        onnc_strides(_strides, _xshape, _xorder);                      \
                                                                        \
-    for (Index _i = 0; _i < _size; ++_i) {                             \
-        _y[_i] = _x[onnc_idot(_index, _strides, _xorder)];             \
-        onnc_increment(_index, _yshape + _diff, _xorder);              \
-    }                                                                  \
+        for (Index _i = 0; _i < _xorder; ++_i)                         \
+            _index[_i] = 0;                                            \
+                                                                       \
+        for (Index _i = 0; _i < _size; ++_i) {                         \
+            _y[_i] = _x[onnc_idot(_index, _strides, _xorder)];         \
+            onnc_increment(_index, _yshape + _diff, _xorder);          \
+        }                                                              \
                                                                        \
-    for (Index _i = 1; _i < _count; ++_i)                              \
-        memcpy(_y + _i * _size, _y, _size * sizeof(Scalar));           \
+        for (Index _i = 1; _i < _count; ++_i)                          \
+            memcpy(_y + _i * _size, _y, _size * sizeof(Scalar));       \
+    }                                                                  \
+    }                                                                  \
 } while (0)
 
 #endif
@@ -1,5 +1,6 @@
 #ifndef ONNC_BINARY
 
+#include "broadcast.h"
 #include "size.h"
 #include "strides.h"
 /*!
@@ -7,6 +8,9 @@
  *
  * This function performs `y = f.(y, x)` where `x` is broadcastable to `y`.
  * For example, if `f = +`, then `y .+= x` is performed.
+ *
+ * The broadcast is classified once, and the common patterns run contiguous
+ * loops without index arithmetic.  See onnc_broadcast().
  */
 #define ONNC_BINARY(SCALAR, y, yshape, yorder, x, xshape, xorder, f) do {     \
     typedef SCALAR Scalar;                                                    \
@@ -19,19 +23,51 @@
     Index _yorder = yorder;                                                   \
     Index _xorder = xorder;                                                   \
                                                                               \
-    Index _diff = _yorder - _xorder;                                          \
     Index _size = onnc_size(_yshape, _yorder);                                \
-    Index _index[_yorder];                                                    \
-    Index _strides[_xorder];                                                  \
+    Index _outer, _middle, _inner;                                            \
+                                                                              \
+    switch (onnc_broadcast(&_outer, &_middle, &_inner,                        \
+                           _yshape, _yorder, _xshape, _xorder)) {             \
+    case ONNC_BROADCAST_SAME:                                                 \
+        for (Index _i = 0; _i < _size; ++_i)                                  \
+            _y[_i] = f(_y[_i], _x[_i]);                                       \
+        break;                                                                \
+    case ONNC_BROADCAST_SCALAR: {                                             \
+        Scalar _s = _x[0];                                                    \
+        for (Index _i = 0; _i < _size; ++_i)                                  \
+            _y[_i] = f(_y[_i], _s);                                           \
+        break;                                                                \
+    }                                                                         \
+    case ONNC_BROADCAST_INNER:                                                \
+        for (Index _o = 0; _o < _outer; ++_o) {                               \
+            Scalar* restrict _row = _y + _o * _middle;                        \
+            for (Index _i = 0; _i < _middle; ++_i)                            \
+                _row[_i] = f(_row[_i], _x[_i]);                               \
+        }                                                                     \
+        break;                                                                \
+    case ONNC_BROADCAST_OUTER:                                                \
+        for (Index _o = 0; _o < _outer * _middle; ++_o) {                     \
+            Scalar* restrict _row = _y + _o * _inner;                         \
+            Scalar _s = _x[_o % _middle];                                     \
+            for (Index _i = 0; _i < _inner; ++_i)                             \
+                _row[_i] = f(_row[_i], _s);                                   \
+        }                                                                     \
+        break;                                                                \
+    default: {                                                                \
+        Index _diff = _yorder - _xorder;                                      \
+        Index _index[_yorder];                                                \
+        Index _strides[_xorder];                                              \
                                                                               \
-    onnc_strides(_strides, _xshape, _xorder);                                 \
+        onnc_strides(_strides, _xshape, _xorder);                             \
                                                                               \
-    for (Index _i = 0; _i < _yorder; ++_i)                                    \
-       _index[_i] = 0;                                                        \
+        for (Index _i = 0; _i < _yorder; ++_i)                                \
+           _index[_i] = 0;                                                    \
                                                                               \
-    for (Index _i = 0; _i < _size; ++_i) {                                    \
-        _y[_i] = f(_y[_i], _x[onnc_idot(_index + _diff, _strides, _xorder)]); \
-        onnc_increment(_index, _yshape, _yorder);                             \
+        for (Index _i = 0; _i < _size; ++_i) {                                \
+            _y[_i] = f(_y[_i], _x[onnc_idot(_index + _diff, _strides, _xorder)]); \
+            onnc_increment(_index, _yshape, _yorder);                         \
+        }                                                                     \
+    }                                                                         \
     }                                                                         \
 } while (0)
 
@@ -0,0 +1,73 @@
+#ifndef ONNC_RUNTIME_BROADCAST_H
+#define ONNC_RUNTIME_BROADCAST_H
+/*!
+ * \brief Broadcast patterns with a dedicated loop
+ *
+ * See onnc_broadcast().
+ */
+enum {
+    ONNC_BROADCAST_GENERAL,
+    ONNC_BROADCAST_SAME,
+    ONNC_BROADCAST_SCALAR,
+    ONNC_BROADCAST_INNER,
+    ONNC_BROADCAST_OUTER
+};
+
+/*!
+ * \brief Classify how `x` is broadcast to `y`
+ *
+ * Most broadcasts view `y` as an `outer x middle x inner` tensor, where `x`
+ * is a vector of `middle` elements repeated along the other two axes.  This
+ * function computes the three sizes and returns
+ *
+ * - `ONNC_BROADCAST_SAME` if `x` has the shape of `y` (up to ones),
+ * - `ONNC_BROADCAST_SCALAR` if `x` has a single element,
+ * - `ONNC_BROADCAST_INNER` if `x` varies along the innermost axis, e.g. the
+ *   bias of a fully connected layer, `[N, C] + [C]`,
+ * - `ONNC_BROADCAST_OUTER` if `x` is constant along the innermost axis, e.g.
+ *   a per-channel scale, `[N, C, H, W] * [C, 1, 1]`, or
+ * - `ONNC_BROADCAST_GENERAL` otherwise, e.g. `[A, B, C] + [A, 1, C]`.
+ */
+static int onnc_broadcast(
+    ONNC_INDEX_TYPE* restrict outer,
+    ONNC_INDEX_TYPE* restrict middle,
+    ONNC_INDEX_TYPE* restrict inner,
+    const ONNC_INDEX_TYPE* restrict yshape, ONNC_INDEX_TYPE yorder,
+    const ONNC_INDEX_TYPE* restrict xshape, ONNC_INDEX_TYPE xorder)
+{
+    typedef ONNC_INDEX_TYPE Index;
+    Index diff = yorder - xorder;
+    int after = 0;
+
+    *outer = *middle = *inner = 1;
+
+    for (Index i = 0; i < yorder; ++i) {
+        Index ydim = yshape[i];
+        Index xdim = i < diff ? 1 : xshape[i - diff];
+
+        if (ydim == 1)
+            continue;
+
+        if (xdim == ydim) {
+            if (after)
+                return ONNC_BROADCAST_GENERAL;
+            *middle *= ydim;
+        }
+        else if (*middle == 1) {
+            *outer *= ydim;
+        }
+        else {
+            after = 1;
+            *inner *= ydim;
+        }
+    }
+
+    if (*middle == 1)
+        return ONNC_BROADCAST_SCALAR;
+    if (*outer == 1 && *inner == 1)
+        return ONNC_BROADCAST_SAME;
+    return *inner == 1 ? ONNC_BROADCAST_INNER : ONNC_BROADCAST_OUTER;
+}
+
+#endif
+// vim: ft=c
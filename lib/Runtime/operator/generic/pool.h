@@ -0,0 +1,123 @@
+#ifndef ONNC_POOL2D
+
+#include <stdbool.h>
+/*!
+ * \brief Whether a pooling has a window with a specialized loop
+ *
+ * They are the square 2D windows common in CNNs: 2x2 with stride 2, and 3x3
+ * with stride 1 or 2.  See ONNC_POOL2D.
+ */
+static bool onnc_pool2d_specialized(
+    ONNC_INDEX_TYPE order,
+    const ONNC_INDEX_TYPE* kernel_shape, ONNC_INDEX_TYPE kernels,
+    const ONNC_INDEX_TYPE* pads, ONNC_INDEX_TYPE paddings,
+    const ONNC_INDEX_TYPE* strides, ONNC_INDEX_TYPE stridings)
+{
+    if (order != 4 || kernels != 2 || paddings != 4 || stridings != 2)
+        return false;
+
+    if (kernel_shape[0] != kernel_shape[1] || strides[0] != strides[1])
+        return false;
+
+    for (ONNC_INDEX_TYPE i = 0; i < 4; ++i)
+        if (pads[i] < 0 || pads[i] >= kernel_shape[0])
+            return false;
+
+    switch (kernel_shape[0]) {
+    case 2:
+        return strides[0] == 2;
+    case 3:
+        return strides[0] == 1 || strides[0] == 2;
+    }
+    return false;
+}
+
+/*!
+ * \brief 2D pooling by a `K x K` window of stride `S`
+ *
+ * `K` and `S` shall be constants so that the loops over the window unroll.
+ * Each output row is initialized to `init` and combined with one input row
+ * at a time, so that the loop over the output width is vectorized.  The
+ * columns whose windows cross the left or right padding are done by
+ * separate border loops, and padded elements are skipped.
+ */
+#define ONNC_POOL2D_LOOP(SCALAR, y, x, planes, height, width, out_height, out_width, K, S, pad_top, pad_left, init, combine) do { \
+    typedef SCALAR Scalar;                                                     \
+    typedef ONNC_INDEX_TYPE Index;                                             \
+                                                                               \
+    Scalar* restrict _y = y;                                                   \
+    const Scalar* restrict _x = x;                                             \
+    Index _planes = planes;                                                    \
+    Index _height = height;                                                    \
+    Index _width = width;                                                      \
+    Index _out_height = out_height;                                            \
+    Index _out_width = out_width;                                              \
+    Index _pad_top = pad_top;                                                  \
+    Index _pad_left = pad_left;                                                \
+    Scalar _init = init;                                                       \
+                                                                               \
+    /* Windows of [_first, _last) are inside the row. */                       \
+    Index _first = (_pad_left + S - 1) / S;                                    \
+    Index _last = _width + _pad_left >= K ? (_width + _pad_left - K) / S + 1 : 0; \
+    _last = _last < _out_width ? _last : _out_width;                           \
+    _first = _first < _last ? _first : _last;                                  \
+    Index _borders[2][2] = { { 0, _first }, { _last, _out_width } };           \
+                                                                               \
+    for (Index _p = 0; _p < _planes; ++_p) {                                   \
+        const Scalar* restrict _plane = _x + (size_t)_p * _height * _width;    \
+                                                                               \
+        for (Index _r = 0; _r < _out_height; ++_r) {                           \
+            Scalar* restrict _row = _y + ((size_t)_p * _out_height + _r) * _out_width; \
+            Index _top = _r * S - _pad_top;                                    \
+            Index _begin = _top < 0 ? 0 : _top;                                \
+            Index _end = _top + K < _height ? _top + K : _height;              \
+                                                                               \
+            for (Index _c = 0; _c < _out_width; ++_c)                          \
+                _row[_c] = _init;                                              \
+                                                                               \
+            for (Index _i = _begin; _i < _end; ++_i) {                         \
+                const Scalar* restrict _in = _plane + (size_t)_i * _width;     \
+                                                                               \
+                for (Index _c = _first; _c < _last; ++_c)                      \
+                    for (Index _k = 0; _k < K; ++_k)                           \
+                        _row[_c] = combine(_row[_c], _in[_c * S - _pad_left + _k]); \
+                                                                               \
+                for (int _b = 0; _b < 2; ++_b) {                               \
+                    for (Index _c = _borders[_b][0]; _c < _borders[_b][1]; ++_c) \
+                        for (Index _k = 0; _k < K; ++_k) {                     \
+                            Index _j = _c * S - _pad_left + _k;                \
+                            if (_j >= 0 && _j < _width)                        \
+                                _row[_c] = combine(_row[_c], _in[_j]);         \
+                        }                                                      \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+} while (0)
+
+/*!
+ * \brief 2D pooling of an NCHW tensor by a specialized window
+ *
+ * This function computes `y = combine(init, x...)` over the elements of each
+ * window inside `x`, for the windows accepted by onnc_pool2d_specialized().
+ * `pads` is in the ONNX order, i.e. `{ top, left, bottom, right }`.
+ */
+#define ONNC_POOL2D(SCALAR, y, x, xshape, yshape, kernel, stride, pads, init, combine) do { \
+    const ONNC_INDEX_TYPE* restrict _xshape = xshape;                         \
+    const ONNC_INDEX_TYPE* restrict _yshape = yshape;                         \
+    const ONNC_INDEX_TYPE* restrict _pads = pads;                             \
+    ONNC_INDEX_TYPE _window = (kernel) * 10 + (stride);                        \
+                                                                               \
+    if (_window == 22)                                                         \
+        ONNC_POOL2D_LOOP(SCALAR, y, x, _xshape[0] * _xshape[1], _xshape[2], _xshape[3], \
+            _yshape[2], _yshape[3], 2, 2, _pads[0], _pads[1], init, combine);   \
+    else if (_window == 31)                                                    \
+        ONNC_POOL2D_LOOP(SCALAR, y, x, _xshape[0] * _xshape[1], _xshape[2], _xshape[3], \
+            _yshape[2], _yshape[3], 3, 1, _pads[0], _pads[1], init, combine);   \
+    else if (_window == 32)                                                    \
+        ONNC_POOL2D_LOOP(SCALAR, y, x, _xshape[0] * _xshape[1], _xshape[2], _xshape[3], \
+            _yshape[2], _yshape[3], 3, 2, _pads[0], _pads[1], init, combine);   \
+} while (0)
+
+#endif
+// vim: ft=c
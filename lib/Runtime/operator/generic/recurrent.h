@@ -0,0 +1,255 @@
+#ifndef ONNC_RUNTIME_RECURRENT_H
+#define ONNC_RUNTIME_RECURRENT_H
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fastmath.h"
+
+/*!
+ * \brief Activation function of a recurrent operator
+ *
+ * See the `activations`, `activation_alpha` and `activation_beta` attributes
+ * of LSTM, GRU and RNN.
+ */
+typedef struct {
+    enum {
+        ONNC_ACTIVATION_RELU,
+        ONNC_ACTIVATION_TANH,
+        ONNC_ACTIVATION_SIGMOID,
+        ONNC_ACTIVATION_AFFINE,
+        ONNC_ACTIVATION_LEAKY_RELU,
+        ONNC_ACTIVATION_THRESHOLDED_RELU,
+        ONNC_ACTIVATION_SCALED_TANH,
+        ONNC_ACTIVATION_HARD_SIGMOID,
+        ONNC_ACTIVATION_ELU,
+        ONNC_ACTIVATION_SOFTSIGN,
+        ONNC_ACTIVATION_SOFTPLUS
+    } kind;
+    float alpha;
+    float beta;
+} onnc_activation;
+
+static float onnc_activate(const onnc_activation* f, float x)
+{
+    switch (f->kind) {
+    case ONNC_ACTIVATION_RELU:
+        return x > 0 ? x : 0;
+    case ONNC_ACTIVATION_TANH:
+        return onnc_tanhf(x);
+    case ONNC_ACTIVATION_SIGMOID:
+        return onnc_sigmoidf(x);
+    case ONNC_ACTIVATION_AFFINE:
+        return f->alpha * x + f->beta;
+    case ONNC_ACTIVATION_LEAKY_RELU:
+        return x >= 0 ? x : f->alpha * x;
+    case ONNC_ACTIVATION_THRESHOLDED_RELU:
+        return x > f->alpha ? x : 0;
+    case ONNC_ACTIVATION_SCALED_TANH:
+        return f->alpha * onnc_tanhf(f->beta * x);
+    case ONNC_ACTIVATION_HARD_SIGMOID:
+        return fmaxf(0, fminf(1, f->alpha * x + f->beta));
+    case ONNC_ACTIVATION_ELU:
+        return x >= 0 ? x : f->alpha * (onnc_expf(x) - 1);
+    case ONNC_ACTIVATION_SOFTSIGN:
+        return x / (1 + fabsf(x));
+    case ONNC_ACTIVATION_SOFTPLUS:
+        return fmaxf(x, 0) + onnc_logf(1 + onnc_expf(-fabsf(x)));
+    }
+    return x;
+}
+
+/*!
+ * \brief Parse the activation functions of all directions
+ *
+ * `defaults` holds the `per_direction` default functions of one direction.
+ * The alphas and the betas are consumed in the order of the functions which
+ * take them.
+ */
+static void onnc_activations(
+    onnc_activation* result, ONNC_INDEX_TYPE per_direction,
+    ONNC_INDEX_TYPE directions, const char* const* defaults,
+    const char* const* names, ONNC_INDEX_TYPE count,
+    const float* alpha, ONNC_INDEX_TYPE alpha_count,
+    const float* beta, ONNC_INDEX_TYPE beta_count)
+{
+    static const struct {
+        const char* name;
+        int kind;
+        int takes_alpha;
+        int takes_beta;
+        float alpha;
+        float beta;
+    } table[] = {
+        { "Relu", ONNC_ACTIVATION_RELU, 0, 0, 0, 0 },
+        { "Tanh", ONNC_ACTIVATION_TANH, 0, 0, 0, 0 },
+        { "Sigmoid", ONNC_ACTIVATION_SIGMOID, 0, 0, 0, 0 },
+        { "Affine", ONNC_ACTIVATION_AFFINE, 1, 1, 1, 0 },
+        { "LeakyRelu", ONNC_ACTIVATION_LEAKY_RELU, 1, 0, 0.01f, 0 },
+        { "ThresholdedRelu", ONNC_ACTIVATION_THRESHOLDED_RELU, 1, 0, 1, 0 },
+        { "ScaledTanh", ONNC_ACTIVATION_SCALED_TANH, 1, 1, 1, 1 },
+        { "HardSigmoid", ONNC_ACTIVATION_HARD_SIGMOID, 1, 1, 0.2f, 0.5f },
+        { "Elu", ONNC_ACTIVATION_ELU, 1, 0, 1, 0 },
+        { "Softsign", ONNC_ACTIVATION_SOFTSIGN, 0, 0, 0, 0 },
+        { "Softplus", ONNC_ACTIVATION_SOFTPLUS, 0, 0, 0, 0 },
+    };
+    ONNC_INDEX_TYPE entries = sizeof(table) / sizeof(table[0]);
+
+    ONNC_INDEX_TYPE a = 0, b = 0;
+    for (ONNC_INDEX_TYPE i = 0; i < per_direction * directions; ++i) {
+        const char* name = count == per_direction * directions ? names[i] : defaults[i % per_direction];
+        ONNC_INDEX_TYPE e = 0;
+        while (e < entries && strcmp(table[e].name, name) != 0)
+            ++e;
+        if (e == entries)
+            e = 1; /* unknown names act as Tanh */
+
+        result[i].kind = table[e].kind;
+        result[i].alpha = table[e].takes_alpha && a < alpha_count ? alpha[a++] : table[e].alpha;
+        result[i].beta = table[e].takes_beta && b < beta_count ? beta[b++] : table[e].beta;
+    }
+}
+
+/*!
+ * \brief Number of directions of the `direction` attribute
+ */
+static ONNC_INDEX_TYPE onnc_directions(const char* direction)
+{
+    return direction != NULL && strcmp(direction, "bidirectional") == 0 ? 2 : 1;
+}
+
+/*!
+ * \brief Whether a direction runs from the end of its sequence
+ */
+static int onnc_is_reverse(const char* direction, ONNC_INDEX_TYPE d)
+{
+    if (direction == NULL)
+        return 0;
+    if (strcmp(direction, "reverse") == 0)
+        return 1;
+    return strcmp(direction, "bidirectional") == 0 && d == 1;
+}
+
+/*!
+ * \brief Length of the sequence of a batch
+ *
+ * `sequence_lens` is an int32 tensor, although the runtime passes every
+ * tensor as float.
+ */
+static ONNC_INDEX_TYPE onnc_sequence_length(
+    const float* sequence_lens, ONNC_INDEX_TYPE batch, ONNC_INDEX_TYPE steps)
+{
+    if (sequence_lens == NULL)
+        return steps;
+
+    ONNC_INDEX_TYPE length = ((const int32_t*)sequence_lens)[batch];
+    return length < 0 ? 0 : (length > steps ? steps : length);
+}
+
+static float onnc_clip(float x, float clip)
+{
+    if (clip > 0)
+        return fmaxf(-clip, fminf(clip, x));
+    return x;
+}
+
+/*!
+ * \brief Matrix multiplication on selected rows
+ *
+ * This function performs `y[r] += a[r] * transpose(w)` for each `r` in
+ * `rows`, where `y` is `? x cols`, `a` is `? x depth` and `w` is
+ * `cols x depth`.  Both operands are read along rows, and the columns are
+ * blocked so that a block of `w` stays in cache for all rows.
+ */
+static void onnc_rows_gemm_nt(
+    float* restrict y, const float* restrict a, const float* restrict w,
+    const ONNC_INDEX_TYPE* restrict rows, ONNC_INDEX_TYPE count,
+    ONNC_INDEX_TYPE cols, ONNC_INDEX_TYPE depth)
+{
+    typedef ONNC_INDEX_TYPE Index;
+    enum { kBlock = 64 };
+
+    for (Index j0 = 0; j0 < cols; j0 += kBlock) {
+        Index j1 = j0 + kBlock < cols ? j0 + kBlock : cols;
+
+        for (Index i = 0; i < count; ++i) {
+            const float* restrict x = a + (size_t)rows[i] * depth;
+            float* restrict out = y + (size_t)rows[i] * cols;
+            Index j = j0;
+
+            for (; j + 4 <= j1; j += 4) {
+                const float* restrict w0 = w + (size_t)j * depth;
+                const float* restrict w1 = w0 + depth;
+                const float* restrict w2 = w1 + depth;
+                const float* restrict w3 = w2 + depth;
+                float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+                for (Index k = 0; k < depth; ++k) {
+                    s0 += x[k] * w0[k];
+                    s1 += x[k] * w1[k];
+                    s2 += x[k] * w2[k];
+                    s3 += x[k] * w3[k];
+                }
+                out[j] += s0;
+                out[j + 1] += s1;
+                out[j + 2] += s2;
+                out[j + 3] += s3;
+            }
+
+            for (; j < j1; ++j) {
+                const float* restrict wj = w + (size_t)j * depth;
+                float s = 0;
+
+                for (Index k = 0; k < depth; ++k)
+                    s += x[k] * wj[k];
+                out[j] += s;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Input projection of all timesteps of one direction
+ *
+ * This function returns a newly allocated `steps x batches x cols` tensor of
+ * `x * transpose(w) + bias`, where `x` is `steps x batches x depth`.  Rows
+ * past the length of their sequence are left uninitialized and skipped by
+ * the multiplication.  `rows` receives the computed rows, and its length is
+ * returned by `count`.  It returns NULL if the tensor cannot be allocated.
+ */
+static float* onnc_project_inputs(
+    const float* x, const float* w, const float* bias,
+    const float* sequence_lens, ONNC_INDEX_TYPE steps,
+    ONNC_INDEX_TYPE batches, ONNC_INDEX_TYPE cols, ONNC_INDEX_TYPE depth,
+    ONNC_INDEX_TYPE* rows, ONNC_INDEX_TYPE* count)
+{
+    typedef ONNC_INDEX_TYPE Index;
+    float* result = (float*)malloc(sizeof(float) * steps * batches * cols);
+
+    *count = 0;
+    if (result == NULL)
+        return NULL;
+
+    for (Index t = 0; t < steps; ++t) {
+        for (Index b = 0; b < batches; ++b) {
+            if (t >= onnc_sequence_length(sequence_lens, b, steps))
+                continue;
+
+            Index row = t * batches + b;
+            float* out = result + (size_t)row * cols;
+
+            if (bias != NULL)
+                memcpy(out, bias, sizeof(float) * cols);
+            else
+                memset(out, 0, sizeof(float) * cols);
+            rows[(*count)++] = row;
+        }
+    }
+
+    onnc_rows_gemm_nt(result, x, w, rows, *count, cols, depth);
+    return result;
+}
+
+#endif
+// vim: ft=c
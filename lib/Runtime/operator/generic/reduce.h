@@ -0,0 +1,242 @@
+#ifndef ONNC_REDUCE
+
+#include "size.h"
+#include "transpose.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ONNC_REDUCE_PARALLEL_SIZE
+/*!
+ * \brief Number of elements from which a reduction runs in parallel
+ */
+#define ONNC_REDUCE_PARALLEL_SIZE 65536
+#endif
+
+#ifdef _OPENMP
+#define ONNC_REDUCE_PARALLEL_FOR _Pragma("omp parallel for if (_parallel)")
+#else
+#define ONNC_REDUCE_PARALLEL_FOR
+#endif
+
+/*!
+ * \brief Canonical form of a reduction
+ *
+ * Reducing a tensor over some axes is the same as reducing an
+ * `outer x reduce x inner` tensor over its middle axis, if the reduced axes
+ * are adjacent once axes of length 1 are ignored.  In this case, this
+ * function computes the three sizes and returns 1.
+ *
+ * Otherwise, `permutation` receives a transpose which moves the reduced axes
+ * innermost.  The transposed tensor is `outer x reduce x 1`, and this
+ * function returns 0.
+ *
+ * As in ONNX, negative axes count from the back, and no axes at all mean
+ * all axes.
+ */
+static inline int onnc_reduce_canonicalize(
+    ONNC_INDEX_TYPE* restrict outer,
+    ONNC_INDEX_TYPE* restrict reduce,
+    ONNC_INDEX_TYPE* restrict inner,
+    ONNC_INDEX_TYPE* restrict permutation,
+    const ONNC_INDEX_TYPE* restrict shape, ONNC_INDEX_TYPE order,
+    const ONNC_INDEX_TYPE* restrict axes, ONNC_INDEX_TYPE count)
+{
+    typedef ONNC_INDEX_TYPE Index;
+    int reduced[order + 1];
+    int state = 0, adjacent = 1;
+    Index kept = 0;
+
+    for (Index i = 0; i < order; ++i)
+        reduced[i] = count == 0;
+
+    for (Index i = 0; i < count; ++i)
+        reduced[axes[i] < 0 ? axes[i] + order : axes[i]] = 1;
+
+    *outer = *reduce = *inner = 1;
+
+    for (Index i = 0; i < order; ++i) {
+        if (shape[i] == 1)
+            continue;
+
+        if (reduced[i]) {
+            adjacent &= state < 2;
+            state = 1;
+            *reduce *= shape[i];
+        }
+        else if (state == 0) {
+            *outer *= shape[i];
+        }
+        else {
+            state = 2;
+            *inner *= shape[i];
+        }
+    }
+
+    if (adjacent)
+        return 1;
+
+    for (Index i = 0; i < order; ++i)
+        if (!reduced[i])
+            permutation[kept++] = i;
+
+    for (Index i = 0, r = kept; i < order; ++i)
+        if (reduced[i])
+            permutation[r++] = i;
+
+    *outer *= *inner;
+    *inner = 1;
+    return 0;
+}
+
+/*!
+ * \brief Push a partial result on a pairwise summation stack
+ *
+ * Partials on the same level are combined at once, so that any partial
+ * combines as many elements as its sibling.  See ONNC_REDUCE.
+ */
+#define ONNC_REDUCE_PUSH(stack, levels, top, partial, width, combine) do { \
+    memcpy(stack[top], partial, (width) * sizeof(partial[0]));             \
+    levels[top++] = 0;                                                     \
+                                                                           \
+    while (top > 1 && levels[top - 1] == levels[top - 2]) {                \
+        for (Index _k = 0; _k < (width); ++_k)                             \
+            stack[top - 2][_k] = combine(stack[top - 2][_k], stack[top - 1][_k]); \
+        ++levels[top - 2];                                                 \
+        --top;                                                             \
+    }                                                                      \
+} while (0)
+
+/*!
+ * \brief Pop all partial results of a pairwise summation stack
+ *
+ * `result` receives the combination of the partials, or `init` if none.
+ */
+#define ONNC_REDUCE_POP(result, stack, top, width, init, combine) do { \
+    for (Index _k = 0; _k < (width); ++_k)                             \
+        result[_k] = top > 0 ? stack[top - 1][_k] : init;              \
+                                                                       \
+    for (Index _t = top - 1; _t > 0; --_t)                             \
+        for (Index _k = 0; _k < (width); ++_k)                         \
+            result[_k] = combine(stack[_t - 1][_k], result[_k]);       \
+} while (0)
+
+/*!
+ * \brief Reduce the middle axis of an `outer x reduce x inner` tensor
+ *
+ * This function computes
+ *
+ *     y[o, i] = combine(... combine(combine(init, map(x[o, 0, i])),
+ *                                             map(x[o, 1, i])) ...)
+ *
+ * where `combine` is associative and commutative, e.g. `+` or `max`, and
+ * `init` is its identity, e.g. 0 or -inf.
+ *
+ * The elements are combined in blocks of at most `kBlock` along the reduced
+ * axis, and the blocks are combined pairwise.  For sums, the rounding error
+ * grows with the logarithm of the length instead of the length.  Inside a
+ * block, the loop runs over `inner` contiguous elements, or over `kLanes`
+ * independent accumulators if `inner` is 1, so that it is vectorized.
+ *
+ * Outer blocks run in parallel if the runtime is built with OpenMP.
+ */
+#define ONNC_REDUCE(SCALAR, y, x, outer, reduce, inner, init, map, combine) do {  \
+    typedef SCALAR Scalar;                                                     \
+    typedef ONNC_INDEX_TYPE Index;                                             \
+    enum { kLanes = 8, kBlock = 128, kChunk = 256, kLevels = 32 };             \
+                                                                               \
+    Scalar* restrict _y = y;                                                   \
+    const Scalar* restrict _x = x;                                             \
+    Index _outer = outer;                                                      \
+    Index _reduce = reduce;                                                    \
+    Index _inner = inner;                                                      \
+    Scalar _init = init;                                                       \
+    int _parallel = _outer > 1 &&                                              \
+        (double)_outer * _reduce * _inner >= ONNC_REDUCE_PARALLEL_SIZE;        \
+    (void)_parallel;                                                           \
+                                                                               \
+    ONNC_REDUCE_PARALLEL_FOR                                                   \
+    for (Index _o = 0; _o < _outer; ++_o) {                                    \
+        const Scalar* restrict _xo = _x + (size_t)_o * _reduce * _inner;      \
+        Scalar* restrict _yo = _y + (size_t)_o * _inner;                       \
+        Index _levels[kLevels], _top = 0;                                      \
+                                                                               \
+        if (_inner == 1) {                                                     \
+            Scalar _stack[kLevels][kLanes], _acc[kLanes];                      \
+                                                                               \
+            for (Index _r0 = 0; _r0 < _reduce; _r0 += kBlock) {                \
+                Index _end = _reduce - _r0 < kBlock ? _reduce : _r0 + kBlock;  \
+                Index _r = _r0;                                                \
+                                                                               \
+                for (Index _k = 0; _k < kLanes; ++_k)                          \
+                    _acc[_k] = _init;                                          \
+                for (; _r + kLanes <= _end; _r += kLanes)                      \
+                    for (Index _k = 0; _k < kLanes; ++_k)                      \
+                        _acc[_k] = combine(_acc[_k], map(_xo[_r + _k]));       \
+                for (; _r < _end; ++_r)                                        \
+                    _acc[0] = combine(_acc[0], map(_xo[_r]));                  \
+                                                                               \
+                ONNC_REDUCE_PUSH(_stack, _levels, _top, _acc, kLanes, combine); \
+            }                                                                  \
+                                                                               \
+            ONNC_REDUCE_POP(_acc, _stack, _top, kLanes, _init, combine);       \
+            for (Index _w = kLanes / 2; _w > 0; _w /= 2)                       \
+                for (Index _k = 0; _k < _w; ++_k)                              \
+                    _acc[_k] = combine(_acc[_k], _acc[_k + _w]);               \
+            _yo[0] = _acc[0];                                                  \
+        }                                                                      \
+        else for (Index _c0 = 0; _c0 < _inner; _c0 += kChunk) {                \
+            Index _width = _inner - _c0 < kChunk ? _inner - _c0 : kChunk;      \
+            Scalar _stack[kLevels][kChunk], _acc[kChunk];                      \
+                                                                               \
+            _top = 0;                                                          \
+            for (Index _r0 = 0; _r0 < _reduce; _r0 += kBlock) {                \
+                Index _end = _reduce - _r0 < kBlock ? _reduce : _r0 + kBlock;  \
+                                                                               \
+                for (Index _k = 0; _k < _width; ++_k)                          \
+                    _acc[_k] = _init;                                          \
+                for (Index _r = _r0; _r < _end; ++_r) {                        \
+                    const Scalar* restrict _row = _xo + (size_t)_r * _inner + _c0; \
+                    for (Index _k = 0; _k < _width; ++_k)                      \
+                        _acc[_k] = combine(_acc[_k], map(_row[_k]));           \
+                }                                                              \
+                                                                               \
+                ONNC_REDUCE_PUSH(_stack, _levels, _top, _acc, _width, combine); \
+            }                                                                  \
+                                                                               \
+            ONNC_REDUCE_POP(_acc, _stack, _top, _width, _init, combine);       \
+            memcpy(_yo + _c0, _acc, _width * sizeof(Scalar));                  \
+        }                                                                      \
+    }                                                                          \
+} while (0)
+
+/*!
+ * \brief Reduce a tensor over some axes
+ *
+ * This function canonicalizes the axes by onnc_reduce_canonicalize(), and
+ * reduces by ONNC_REDUCE.  If the reduced axes are not adjacent, they are
+ * first transposed innermost into a temporary buffer.  The layout of `y`
+ * does not depend on `keepdims`.
+ */
+#define ONNC_REDUCE_AXES(SCALAR, y, x, shape, order, axes, count, init, map, combine) do { \
+    typedef SCALAR Scalar;                                                     \
+    typedef ONNC_INDEX_TYPE Index;                                             \
+                                                                               \
+    const Index* restrict _dims = shape;                                       \
+    Index _ndim = order;                                                       \
+    Index _blocks, _length, _columns, _order_of[_ndim + 1];                    \
+    const Scalar* _source = x;                                                 \
+    Scalar* _buffer = NULL;                                                    \
+                                                                               \
+    if (!onnc_reduce_canonicalize(&_blocks, &_length, &_columns, _order_of,   \
+                                  _dims, _ndim, axes, count)) {               \
+        _buffer = (Scalar*)malloc(onnc_size(_dims, _ndim) * sizeof(Scalar));  \
+        ONNC_TRANSPOSE(Scalar, _buffer, _source, _order_of, _dims, _ndim);     \
+        _source = _buffer;                                                     \
+    }                                                                          \
+                                                                               \
+    ONNC_REDUCE(Scalar, y, _source, _blocks, _length, _columns, init, map, combine); \
+    free(_buffer);                                                             \
+} while (0)
+
+#endif
+// vim: ft=c
@@ -6,7 +6,7 @@
  * This function computes data offset from a multidimensional index.
  * See onnc_strides() for details.
  */
-static ONNC_INDEX_TYPE onnc_idot(
+static inline ONNC_INDEX_TYPE onnc_idot(
     const ONNC_INDEX_TYPE* x,
     const ONNC_INDEX_TYPE* y,
     ONNC_INDEX_TYPE count)
@@ -32,7 +32,7 @@ static ONNC_INDEX_TYPE onnc_idot(
  *     { 1, 0, 1 }
  *     { 1, 0, 2 }
  */
-static void onnc_increment(
+static inline void onnc_increment(
     ONNC_INDEX_TYPE* restrict index,
     const ONNC_INDEX_TYPE* restrict shape,
     ONNC_INDEX_TYPE order)
@@ -63,7 +63,7 @@ static void onnc_increment(
  * broadcasting.  For example, the example array of strides still works if the
  * tensor is read as a 3xnx3x3x7 tensor.
  */
-static void onnc_strides(
+static inline void onnc_strides(
     ONNC_INDEX_TYPE* restrict result,
     const ONNC_INDEX_TYPE* restrict shape,
     ONNC_INDEX_TYPE order)
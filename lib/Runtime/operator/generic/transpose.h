@@ -2,6 +2,7 @@
 
 #include "size.h"
 #include "strides.h"
+#include <string.h>
 /*!
  * \brief Permutation of index vector
  *
@@ -10,7 +11,7 @@
  * `permutation = { 1, 0, 2 }` and `index = { a, b, c }`, this function writes
  * the permuted index `{ b, a, c }` to `result`.
  */
-static void onnc_permute(
+static inline void onnc_permute(
     ONNC_INDEX_TYPE* restrict result,
     const ONNC_INDEX_TYPE* restrict permutation,
     const ONNC_INDEX_TYPE* restrict index,
@@ -20,6 +21,57 @@ static void onnc_permute(
         result[i] = index[permutation[i]];
 }
 
+/*!
+ * \brief Simplify a transpose
+ *
+ * Axes of length 1 are dropped, and input axes which stay adjacent in the
+ * output are merged.  The result moves data the same way with fewer axes.
+ * For example, NCHW to NHWC becomes `{ N, C, H*W }` with permutation
+ * `{ 0, 2, 1 }`, i.e. a batch of matrix transposes.  This function returns
+ * the reduced order.
+ */
+static inline ONNC_INDEX_TYPE onnc_transpose_merge(
+    ONNC_INDEX_TYPE* restrict result_shape,
+    ONNC_INDEX_TYPE* restrict result_permutation,
+    const ONNC_INDEX_TYPE* restrict shape,
+    const ONNC_INDEX_TYPE* restrict permutation,
+    ONNC_INDEX_TYPE order)
+{
+    typedef ONNC_INDEX_TYPE Index;
+    Index kept = 0, groups = 0, count = 0;
+    Index axis[order + 1], position[order + 1], group[order + 1];
+
+    for (Index i = 0; i < order; ++i)
+        axis[i] = shape[i] == 1 ? -1 : kept++;
+
+    for (Index i = 0, p = 0; i < order; ++i)
+        if (axis[permutation[i]] >= 0)
+            position[axis[permutation[i]]] = p++;
+
+    for (Index i = 0; i < order; ++i) {
+        if (axis[i] < 0)
+            continue;
+
+        Index a = axis[i];
+        if (a > 0 && position[a] == position[a - 1] + 1) {
+            group[a] = group[a - 1];
+            result_shape[group[a]] *= shape[i];
+        }
+        else {
+            group[a] = groups;
+            result_shape[groups++] = shape[i];
+        }
+    }
+
+    for (Index i = 0; i < order; ++i) {
+        Index a = axis[permutation[i]];
+        if (a >= 0 && (count == 0 || result_permutation[count - 1] != group[a]))
+            result_permutation[count++] = group[a];
+    }
+
+    return groups;
+}
+
 /*!
  * \brief Tensor transpose
  *
@@ -27,31 +79,93 @@ static void onnc_permute(
  * As there is more than one non-trivial transpose in 3+ ordered tensors,
  * transpose is described as permutation of indices.  See onnc_permute() for
  * details of index permutation.
+ *
+ * The axes are first merged by onnc_transpose_merge().  If the innermost
+ * axis stays innermost, rows are copied as a whole.  Otherwise, the
+ * transpose is a batch of matrix transposes between the innermost axes of
+ * `x` and `y`, e.g. 2D matrices and NCHW <-> NHWC.  They are done by 8x8
+ * tiles, which are small enough to be transposed in registers, so that
+ * both `x` and `y` are accessed by cache lines.
  */
-#define ONNC_TRANSPOSE(SCALAR, y, x, permutation, shape, order) do { \
-    typedef SCALAR Scalar;                                           \
-    typedef ONNC_INDEX_TYPE Index;                                   \
-                                                                     \
-    Scalar* restrict _y = y;                                         \
-    const Scalar* restrict _x = x;                                   \
-    const Index* restrict _permutation = permutation;                \
-    const Index* restrict _shape = shape;                            \
-    Index _order = order;                                            \
-                                                                     \
-    Index _size = onnc_size(_shape, _order);                         \
-    Index _index[_order], _permuted[_order], _strides[_order];       \
-                                                                     \
-    for (Index _i = 0; _i < _order; ++_i)                            \
-        _index[_i] = 0;                                              \
-                                                                     \
-    onnc_strides(_permuted, _shape, _order);                         \
-    onnc_permute(_strides, _permutation, _permuted, _order);         \
-    onnc_permute(_permuted, _permutation, _shape, _order);           \
-                                                                     \
-    for (Index _i = 0; _i < _size; ++_i) {                           \
-        _y[_i] = _x[onnc_idot(_index, _strides, _order)];            \
-        onnc_increment(_index, _permuted, _order);                   \
-    }                                                                \
+#define ONNC_TRANSPOSE(SCALAR, y, x, permutation, shape, order) do {         \
+    typedef SCALAR Scalar;                                                   \
+    typedef ONNC_INDEX_TYPE Index;                                           \
+    enum { kTile = 8 };                                                      \
+                                                                             \
+    Scalar* restrict _y = y;                                                 \
+    const Scalar* restrict _x = x;                                           \
+    const Index* restrict _permutation = permutation;                        \
+    const Index* restrict _shape = shape;                                    \
+    Index _order = order;                                                    \
+                                                                             \
+    Index _size = onnc_size(_shape, _order);                                 \
+    Index _dims[_order + 1], _permuted[_order + 1];                          \
+    Index _n = onnc_transpose_merge(_dims, _permuted,                        \
+                                    _shape, _permutation, _order);           \
+                                                                             \
+    if (_n <= 1) {                                                           \
+        memcpy(_y, _x, _size * sizeof(Scalar));                              \
+    }                                                                        \
+    else {                                                                   \
+        Index _xstrides[_n], _ystrides[_n], _ydims[_n];                      \
+        Index _inner = _dims[_n - 1], _column = _permuted[_n - 1];           \
+        Index _rows = _dims[_column];                                        \
+        Index _m = 0;                                                        \
+        Index _outer[_n], _xouter[_n], _youter[_n], _index[_n];              \
+                                                                             \
+        onnc_strides(_xstrides, _dims, _n);                                  \
+        onnc_permute(_ydims, _permuted, _dims, _n);                          \
+        onnc_strides(_index, _ydims, _n);                                    \
+        for (Index _i = 0; _i < _n; ++_i)                                    \
+            _ystrides[_permuted[_i]] = _index[_i];                           \
+                                                                             \
+        for (Index _i = 0; _i < _n; ++_i) {                                  \
+            Index _a = _permuted[_i];                                        \
+            if (_a != _n - 1 && _a != _column) {                             \
+                _outer[_m] = _dims[_a];                                      \
+                _xouter[_m] = _xstrides[_a];                                 \
+                _youter[_m] = _ystrides[_a];                                 \
+                _index[_m++] = 0;                                            \
+            }                                                                \
+        }                                                                    \
+                                                                             \
+        Index _count = onnc_size(_outer, _m);                                \
+        Index _xstride = _xstrides[_column], _ystride = _ystrides[_n - 1];   \
+                                                                             \
+        for (Index _o = 0; _o < _count; ++_o) {                              \
+            const Scalar* restrict _xo = _x + onnc_idot(_index, _xouter, _m); \
+            Scalar* restrict _yo = _y + onnc_idot(_index, _youter, _m);      \
+                                                                             \
+            if (_column == _n - 1) {                                         \
+                memcpy(_yo, _xo, _inner * sizeof(Scalar));                   \
+            }                                                                \
+            else for (Index _i0 = 0; _i0 < _rows; _i0 += kTile) {            \
+                for (Index _j0 = 0; _j0 < _inner; _j0 += kTile) {            \
+                    const Scalar* restrict _xt = _xo + _i0 * _xstride + _j0; \
+                    Scalar* restrict _yt = _yo + _j0 * _ystride + _i0;       \
+                                                                             \
+                    if (_i0 + kTile <= _rows && _j0 + kTile <= _inner) {     \
+                        Scalar _tile[kTile][kTile];                          \
+                        for (Index _i = 0; _i < kTile; ++_i)                 \
+                            for (Index _j = 0; _j < kTile; ++_j)             \
+                                _tile[_j][_i] = _xt[_i * _xstride + _j];     \
+                        for (Index _j = 0; _j < kTile; ++_j)                 \
+                            for (Index _i = 0; _i < kTile; ++_i)             \
+                                _yt[_j * _ystride + _i] = _tile[_j][_i];     \
+                    }                                                        \
+                    else {                                                   \
+                        Index _ri = _rows - _i0 < kTile ? _rows - _i0 : kTile; \
+                        Index _rj = _inner - _j0 < kTile ? _inner - _j0 : kTile; \
+                        for (Index _j = 0; _j < _rj; ++_j)                   \
+                            for (Index _i = 0; _i < _ri; ++_i)               \
+                                _yt[_j * _ystride + _i] = _xt[_i * _xstride + _j]; \
+                    }                                                        \
+                }                                                            \
+            }                                                                \
+                                                                             \
+            onnc_increment(_index, _outer, _m);                              \
+        }                                                                    \
+    }                                                                        \
 } while (0)
 
 #endif
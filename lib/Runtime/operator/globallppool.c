@@ -4,6 +4,30 @@
 #include <stdbool.h>
 #include <math.h>
 
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/reduce.h"
+
+static float identity_(float x)
+{
+    return x;
+}
+
+static float abs_(float x)
+{
+    return fabsf(x);
+}
+
+static float square_(float x)
+{
+    return x * x;
+}
+
+static float add_(float a, float b)
+{
+    return a + b;
+}
+
 void ONNC_RUNTIME_globallppool_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_X
@@ -12,19 +36,28 @@ void ONNC_RUNTIME_globallppool_float(
   ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
   ,int32_t p
 ) {
-  int32_t mul = 1 ;
-	for(int32_t i = input_X_ndim - 1 ; i >= 2 ; --i){
-		mul *= input_X_dims[i] ;
-	}
-	for(int32_t i = 0 ; i < output_Y_dims[0] ; ++i){
-		for(int32_t j = 0 ; j < output_Y_dims[1] ; ++j){
-			output_Y[ i * output_Y_dims[1] + j ] = 0;
-			for(int32_t k = 0 ; k < mul ; ++k){
-				output_Y[ i * output_Y_dims[1] + j ] += powf(
-					fabs( input_X[ ( i * input_X_dims[1] + j ) * mul + k] ), p
-				);
-			}
-			output_Y[ i * output_Y_dims[1] + j ] = powf( output_Y[ i * output_Y_dims[1] + j ], 1.0 / p );
-		}
-	}
+  int32_t outer = input_X_dims[0] * input_X_dims[1];
+  int32_t reduce = onnc_size(input_X_dims + 2, input_X_ndim - 2);
+
+  if (p == 1) {
+    ONNC_REDUCE(float, output_Y, input_X, outer, reduce, 1, 0, abs_, add_);
+  }
+  else if (p == 2) {
+    ONNC_REDUCE(float, output_Y, input_X, outer, reduce, 1, 0, square_, add_);
+    for (int32_t i = 0; i < outer; ++i)
+      output_Y[i] = sqrtf(output_Y[i]);
+  }
+  else {
+    int32_t size = outer * reduce;
+    float* powers = (float*)malloc(sizeof(float) * size);
+
+    for (int32_t i = 0; i < size; ++i)
+      powers[i] = powf(fabsf(input_X[i]), p);
+
+    ONNC_REDUCE(float, output_Y, powers, outer, reduce, 1, 0, identity_, add_);
+    for (int32_t i = 0; i < outer; ++i)
+      output_Y[i] = powf(output_Y[i], 1.0f / p);
+
+    free(powers);
+  }
 }
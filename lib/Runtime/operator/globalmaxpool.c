@@ -4,6 +4,20 @@
 #include <stdbool.h>
 #include <math.h>
 
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/reduce.h"
+
+static float identity_(float x)
+{
+    return x;
+}
+
+static float max_(float a, float b)
+{
+    return a > b ? a : b;
+}
+
 void ONNC_RUNTIME_globalmaxpool_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_X
@@ -12,19 +26,8 @@ void ONNC_RUNTIME_globalmaxpool_float(
   ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
   
 ) {
-	int32_t mul = 1 ;
-	for(int32_t i = input_X_ndim - 1 ; i >= 2 ; --i){
-		mul *= input_X_dims[i] ;
-	}
-	for(int32_t i = 0 ; i < output_Y_dims[0] ; ++i){
-		for(int32_t j = 0 ; j < output_Y_dims[1] ; ++j){
-			output_Y[ i * output_Y_dims[1] + j ] = input_X[ ( i * input_X_dims[1] + j ) * mul ] ;
-			for(int32_t k = 1 ; k < mul ; ++k){
-				output_Y[ i * output_Y_dims[1] + j ] = fmax(
-					output_Y[ i * output_Y_dims[1] + j ],
-					input_X[ ( i * input_X_dims[1] + j ) * mul + k]
-				);
-			}
-		}
-	}
+  int32_t outer = input_X_dims[0] * input_X_dims[1];
+  int32_t reduce = onnc_size(input_X_dims + 2, input_X_ndim - 2);
+
+  ONNC_REDUCE(float, output_Y, input_X, outer, reduce, 1, -INFINITY, identity_, max_);
 }
@@ -2,6 +2,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/recurrent.h"
 
 void ONNC_RUNTIME_gru_float(
   void * restrict onnc_runtime_context
@@ -32,4 +35,162 @@ void ONNC_RUNTIME_gru_float(
   ,int32_t hidden_size
   ,int32_t linear_before_reset
 ) {
+  int32_t steps = input_X_dims[0];
+  int32_t batches = input_X_dims[1];
+  int32_t input_size = input_X_dims[2];
+  int32_t hidden = input_R_dims[2];
+  int32_t directions = onnc_directions(direction);
+  int32_t gates_size = 3 * hidden; // z, r, h
+
+  static const char *defaults[] = { "Sigmoid", "Tanh" };
+  onnc_activation functions[2 * 2];
+  onnc_activations(functions, 2, directions, defaults,
+                   activations, number_of_activations,
+                   activation_alpha, number_of_activation_alpha,
+                   activation_beta, number_of_activation_beta);
+
+  if (output_Y != NULL) {
+    memset(output_Y, 0, sizeof(float) * steps * directions * batches * hidden);
+  }
+
+  int32_t *rows = (int32_t *)malloc(sizeof(int32_t) * steps * batches);
+  int32_t *active = (int32_t *)malloc(sizeof(int32_t) * batches);
+  float *bias = (float *)malloc(sizeof(float) * gates_size);
+  float *zr = (float *)malloc(sizeof(float) * batches * 2 * hidden);
+  float *hidden_gate = (float *)malloc(sizeof(float) * batches * hidden);
+  float *reset_h = (float *)malloc(sizeof(float) * batches * hidden);
+  float *h = (float *)malloc(sizeof(float) * batches * hidden);
+  if (rows == NULL || active == NULL || bias == NULL || zr == NULL ||
+      hidden_gate == NULL || reset_h == NULL || h == NULL) {
+    free(h);
+    free(reset_h);
+    free(hidden_gate);
+    free(zr);
+    free(bias);
+    free(active);
+    free(rows);
+    return;
+  }
+
+  for (int32_t d = 0; d < directions; ++d) {
+    const onnc_activation *f = &functions[2 * d];
+    const onnc_activation *g = &functions[2 * d + 1];
+    const float *R = input_R + (size_t)d * gates_size * hidden;
+    const float *Rh = R + (size_t)2 * hidden * hidden;
+    const float *Rbh = input_B != NULL ?
+        input_B + (size_t)d * 2 * gates_size + gates_size + 2 * hidden : NULL;
+    bool reverse = onnc_is_reverse(direction, d);
+
+    // The biases go into the projection of the inputs, except the one of
+    // the hidden gate which the reset gate scales.
+    if (input_B != NULL) {
+      const float *Wb = input_B + (size_t)d * 2 * gates_size;
+      for (int32_t j = 0; j < gates_size; ++j) {
+        bias[j] = Wb[j];
+        if (j < 2 * hidden || !linear_before_reset) {
+          bias[j] += Wb[gates_size + j];
+        }
+      }
+    }
+    int32_t count = 0;
+    float *projection = onnc_project_inputs(
+        input_X, input_W + (size_t)d * gates_size * input_size,
+        input_B != NULL ? bias : NULL, input_sequence_lens,
+        steps, batches, gates_size, input_size, rows, &count);
+    if (projection == NULL) {
+      break;
+    }
+
+    size_t state_size = sizeof(float) * batches * hidden;
+    if (input_initial_h != NULL) {
+      memcpy(h, input_initial_h + (size_t)d * batches * hidden, state_size);
+    } else {
+      memset(h, 0, state_size);
+    }
+
+    for (int32_t s = 0; s < steps; ++s) {
+      // Only the batches whose sequences are still running.
+      int32_t nactive = 0;
+      for (int32_t b = 0; b < batches; ++b) {
+        int32_t length = onnc_sequence_length(input_sequence_lens, b, steps);
+        if (s >= length) {
+          continue;
+        }
+        int32_t t = reverse ? length - 1 - s : s;
+        memcpy(zr + (size_t)b * 2 * hidden,
+               projection + ((size_t)t * batches + b) * gates_size,
+               sizeof(float) * 2 * hidden);
+        active[nactive++] = b;
+      }
+      if (nactive == 0) {
+        break;
+      }
+
+      // update and reset gates
+      onnc_rows_gemm_nt(zr, h, R, active, nactive, 2 * hidden, hidden);
+      for (int32_t n = 0; n < nactive; ++n) {
+        float *gate = zr + (size_t)active[n] * 2 * hidden;
+        for (int32_t j = 0; j < 2 * hidden; ++j) {
+          gate[j] = onnc_activate(f, onnc_clip(gate[j], clip));
+        }
+      }
+
+      // hidden gate, before its activation
+      for (int32_t n = 0; n < nactive; ++n) {
+        int32_t b = active[n];
+        float *hg = hidden_gate + (size_t)b * hidden;
+        if (linear_before_reset && Rbh != NULL) {
+          memcpy(hg, Rbh, sizeof(float) * hidden);
+        } else {
+          memset(hg, 0, sizeof(float) * hidden);
+        }
+        if (!linear_before_reset) {
+          const float *r = zr + (size_t)b * 2 * hidden + hidden;
+          const float *hb = h + (size_t)b * hidden;
+          float *rh = reset_h + (size_t)b * hidden;
+          for (int32_t j = 0; j < hidden; ++j) {
+            rh[j] = r[j] * hb[j];
+          }
+        }
+      }
+      onnc_rows_gemm_nt(hidden_gate, linear_before_reset ? h : reset_h, Rh,
+                        active, nactive, hidden, hidden);
+
+      for (int32_t n = 0; n < nactive; ++n) {
+        int32_t b = active[n];
+        int32_t length = onnc_sequence_length(input_sequence_lens, b, steps);
+        int32_t t = reverse ? length - 1 - s : s;
+        const float *z = zr + (size_t)b * 2 * hidden;
+        const float *r = z + hidden;
+        const float *xh = projection + ((size_t)t * batches + b) * gates_size +
+                          2 * hidden;
+        const float *hg = hidden_gate + (size_t)b * hidden;
+        float *hb = h + (size_t)b * hidden;
+
+        for (int32_t j = 0; j < hidden; ++j) {
+          float ht = linear_before_reset ? xh[j] + r[j] * hg[j] : xh[j] + hg[j];
+          ht = onnc_activate(g, onnc_clip(ht, clip));
+          hb[j] = (1 - z[j]) * ht + z[j] * hb[j];
+        }
+
+        if (output_Y != NULL) {
+          memcpy(output_Y + (((size_t)t * directions + d) * batches + b) * hidden,
+                 hb, sizeof(float) * hidden);
+        }
+      }
+    }
+    free(projection);
+
+    if (output_Y_h != NULL) {
+      memcpy(output_Y_h + (size_t)d * batches * hidden, h, state_size);
+    }
+  }
+
+  free(h);
+  free(reset_h);
+  free(hidden_gate);
+  free(zr);
+  free(bias);
+  free(active);
+  free(rows);
 }
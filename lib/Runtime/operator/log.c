@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_log_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_input
@@ -17,6 +19,6 @@ void ONNC_RUNTIME_log_float(
 		size *= input_input_dims[i];
 	}
 	for(int32_t i = 0 ; i < size ; ++i){
-		output_output[i] = logf(input_input[i]);
+		output_output[i] = onnc_logf(input_input[i]);
 	}
 }
@@ -5,6 +5,8 @@
 #include <float.h>
 #include <math.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_logsoftmax_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_input
@@ -29,11 +31,14 @@ void ONNC_RUNTIME_logsoftmax_float(
           maxData = fmaxf(maxData, pInput[i]);
         }
         for(int32_t i = 0; i < size_D; ++i){
-          pOutput[i] = expf(pInput[i] - maxData);
+          pOutput[i] = onnc_expf(pInput[i] - maxData);
+        }
+        for(int32_t i = 0; i < size_D; ++i){
           sumData += pOutput[i];
         }
+        float shift = maxData + onnc_logf(sumData);
         for(int32_t i = 0; i < size_D; ++i){
-          pOutput[i] = logf(pOutput[i] / sumData);
+          pOutput[i] = pInput[i] - shift;
         }
     }
 }
@@ -2,9 +2,27 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <float.h>
 #include <math.h>
 
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/reduce.h"
+
+static float abs_(float x)
+{
+    return fabsf(x);
+}
+
+static float square_(float x)
+{
+    return x * x;
+}
+
+static float add_(float a, float b)
+{
+    return a + b;
+}
+
 void ONNC_RUNTIME_lpnormalization_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_input
@@ -14,78 +32,37 @@ void ONNC_RUNTIME_lpnormalization_float(
   ,int32_t axis
   ,int32_t p
 ) {
-  //calculate new dimension
   int32_t ndim = input_input_ndim;
-
-  //ndim corresponding to axis
-  //axis accept neg value
-  if(axis < 0){
+  if (axis < 0)
     axis += ndim;
-  } 
 
-  //output elements
-  int32_t output_elem = 1;
-  int32_t input_elem = 1;
-  int32_t output_dims[ndim - 1];
+  int32_t outer = onnc_size(input_input_dims, axis);
+  int32_t reduce = input_input_dims[axis];
+  int32_t inner = onnc_size(input_input_dims + axis + 1, ndim - axis - 1);
+  float* norms = (float*)malloc(sizeof(float) * outer * inner);
 
-  int32_t ip = 0;
-  for(int32_t i = 0; i < ndim; i++){
-    if(i != axis){
-      output_elem *= input_input_dims[i];
-      output_dims[ip] = input_input_dims[i];
-      ip++;
-    }
-    input_elem *= input_input_dims[i];
+  /* ONNX only defines the L1 and the L2 norms */
+  if (p == 1) {
+    ONNC_REDUCE(float, norms, input_input, outer, reduce, inner, 0, abs_, add_);
   }
-  
-  //input stride, for reference
-  int32_t InDimStride[ndim];
-  InDimStride[ndim-1] = 1;
-  for(int32_t i = (ndim - 1) - 1; i >= 0; i--){
-    InDimStride[i] = InDimStride[i+1] * input_input_dims[i+1];
-  }
-
-  int32_t out_ndim = ndim -1;
-  int32_t OutDimStride[out_ndim];
-  OutDimStride[out_ndim-1] = 1;
-  for(int32_t i = (out_ndim - 1) - 1; i >= 0; i--){
-    OutDimStride[i] = OutDimStride[i+1] * output_dims[i+1];
+  else {
+    ONNC_REDUCE(float, norms, input_input, outer, reduce, inner, 0, square_, add_);
+    for (int32_t i = 0; i < outer * inner; ++i)
+      norms[i] = sqrtf(norms[i]);
   }
 
-  //p-norm process
-  //To locate coordinates, count the strides!
-  int32_t inDimCounter = 0;
-  int32_t outDimCounter= 0;
+  for (int32_t o = 0; o < outer; ++o) {
+    const float* restrict norm = norms + (size_t)o * inner;
 
-  int32_t inIndexCounter = 0;
-  int32_t outIndexCounter = 0;
+    for (int32_t r = 0; r < reduce; ++r) {
+      size_t offset = ((size_t)o * reduce + r) * inner;
+      const float* restrict x = input_input + offset;
+      float* restrict y = output_output + offset;
 
-  float summation[output_elem];
-  for(int32_t i = 0; i < output_elem; i++){
-    summation[i] = 0.0f;
-  }
-
-  //Forumala 
-  int32_t index = 0;
-  for(int32_t j = 0; j < input_elem; j++){
-    inIndexCounter = j;
-    outIndexCounter = 0;
-    outDimCounter = 0;
-    inDimCounter = 0;
-    while(inDimCounter < ndim){
-      index = inIndexCounter / InDimStride[inDimCounter];
-      inIndexCounter %= InDimStride[inDimCounter];
-      if(inDimCounter != axis){
-        outIndexCounter += (index * OutDimStride[outDimCounter]);
-        outDimCounter++;
-      }
-      inDimCounter++;
+      for (int32_t i = 0; i < inner; ++i)
+        y[i] = x[i] / norm[i];
     }
-    summation[outIndexCounter] += fabs(powf(input_input[j], p));
   }
 
-  //Formula
-  for(int32_t i = 0; i < output_elem; i++){
-    output_output[i] = powf(summation[i], (1.0f/(float)p)); 
-  }
+  free(norms);
 }
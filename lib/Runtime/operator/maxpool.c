@@ -8,6 +8,15 @@
 #include <assert.h>
 #include <string.h>
 
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/pool.h"
+
+static float max_(float a, float b)
+{
+    return a > b ? a : b;
+}
+
 static inline bool next_dim(int32_t ndim, int32_t * restrict dim,
                             const int32_t * restrict dim_max) {
   do {
@@ -68,6 +77,14 @@ void ONNC_RUNTIME_maxpool_float(
   ,int32_t number_of_strides
 ) {
 	assert(input_X_ndim == output_Y_ndim);
+
+  if (onnc_pool2d_specialized(input_X_ndim, kernel_shape, number_of_kernel_shape,
+                              pads, number_of_pads, strides, number_of_strides)) {
+    ONNC_POOL2D(float, output_Y, input_X, input_X_dims, output_Y_dims,
+                kernel_shape[0], strides[0], pads, -FLT_MAX, max_);
+    return;
+  }
+
 	int32_t ndim = input_X_ndim;
 
   int32_t o_dim[ndim];
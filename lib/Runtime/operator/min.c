@@ -1,6 +1,5 @@
 #include <onnc/Runtime/operator/min.h>
 
-#include <float.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <math.h>
@@ -10,6 +9,11 @@ typedef int32_t ONNC_INDEX_TYPE;
 #include "generic/assign.h"
 #include "generic/binary.h"
 
+static float min_(float a, float b)
+{
+    return a < b ? a : b;
+}
+
 void ONNC_RUNTIME_min_float(
   void * restrict onnc_runtime_context
   ,const float * const * restrict input_data_0
@@ -19,23 +23,12 @@ void ONNC_RUNTIME_min_float(
   ,int32_t output_min_ndim, const int32_t * restrict output_min_dims
   
 ) {
-	// Resize all inputs
-	for(int32_t i = 0 ; i < input_data_0_ntensor ; ++i) {
-		ONNC_ASSIGN(float, output_min, output_min_dims, output_min_ndim, input_data_0[i], input_data_0_dims[i], input_data_0_ndim[i]);
-	}
+	if (input_data_0_ntensor == 0)
+		return;
 
-	int32_t tensor_len = 1;
-	for(int32_t i = 0 ; i < output_min_ndim ; ++i) {
-		tensor_len *= output_min_dims[i];
-	}
-
-	// Initialize output with maximum
-	for(int32_t i = 0 ; i < tensor_len ; ++i) {
-		output_min[i] = FLT_MAX;
-	}
+	ONNC_ASSIGN(float, output_min, output_min_dims, output_min_ndim, input_data_0[0], input_data_0_dims[0], input_data_0_ndim[0]);
 
-	// Choose the minimum
-	for(int32_t i = 0 ; i < input_data_0_ntensor ; ++i) {
-		ONNC_BINARY(float, output_min, output_min_dims, output_min_ndim, input_data_0[i], input_data_0_dims[i], input_data_0_ndim[i], fmin);
+	for(int32_t i = 1 ; i < input_data_0_ntensor ; ++i) {
+		ONNC_BINARY(float, output_min, output_min_dims, output_min_ndim, input_data_0[i], input_data_0_dims[i], input_data_0_ndim[i], min_);
 	}
 }
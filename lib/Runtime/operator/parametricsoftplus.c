@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_parametricsoftplus_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_X
@@ -21,7 +23,7 @@ void ONNC_RUNTIME_parametricsoftplus_float(
 
 	for(int32_t i = 0 ; i < size ; ++i){
 	    float tmp_val = input_X[i];
-        tmp_val = expf(beta * tmp_val) + 1.0f;
-        output_Y[i] = alpha * logf(tmp_val);
+        tmp_val = onnc_expf(beta * tmp_val) + 1.0f;
+        output_Y[i] = alpha * onnc_logf(tmp_val);
 	}
 }
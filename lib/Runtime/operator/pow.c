@@ -4,6 +4,16 @@
 #include <stdbool.h>
 #include <math.h>
 
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/assign.h"
+#include "generic/binary.h"
+
+static float powf_(float a, float b)
+{
+    return powf(a, b);
+}
+
 void ONNC_RUNTIME_pow_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_X
@@ -14,12 +24,6 @@ void ONNC_RUNTIME_pow_float(
   ,int32_t output_Z_ndim, const int32_t * restrict output_Z_dims
   
 ) {
-  int32_t size = 1;
-  for(int32_t dim = 0 ; dim < input_X_ndim ; dim++){
-      size *= input_X_dims[dim];
-  }
-
-  for(int32_t index = 0 ; index < size ; index++){
-      output_Z[index] = pow(input_X[index], input_Y[index]);
-  }
+  ONNC_ASSIGN(float, output_Z, output_Z_dims, output_Z_ndim, input_X, input_X_dims, input_X_ndim);
+  ONNC_BINARY(float, output_Z, output_Z_dims, output_Z_ndim, input_Y, input_Y_dims, input_Y_ndim, powf_);
 }
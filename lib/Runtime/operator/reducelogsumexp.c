@@ -2,42 +2,37 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <string.h>
 #include <math.h>
 
-static inline void calculate_axis_dis(int32_t ndim, const int32_t * restrict dims, int32_t * restrict axis_dis){
-    int32_t base = axis_dis[ndim-1] = 1;
-    for(int32_t dim = ndim - 2 ; dim >= 0 ; --dim){
-        axis_dis[dim] = base * dims[dim+1];
-        base = axis_dis[dim];
-    }
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/binary.h"
+#include "generic/fastmath.h"
+#include "generic/reduce.h"
+
+static float identity_(float x)
+{
+    return x;
+}
+
+static float exp_(float x)
+{
+    return onnc_expf(x);
+}
+
+static float add_(float a, float b)
+{
+    return a + b;
 }
 
-static inline bool next_dim(int32_t ndim, int32_t * restrict dim, const int32_t * restrict dim_max) {
-  if(ndim == 0)
-    return false;
-  do {
-    ndim = ndim - 1;
-    dim[ndim] += 1;
-    if (dim[ndim] < dim_max[ndim]) {
-      return true;
-    } else { // reach dimension max
-      if (ndim == 0) { // all dimension done
-        return false;
-      }
-      dim[ndim] = 0;
-    }
-  } while(true);
+static float sub_(float a, float b)
+{
+    return a - b;
 }
 
-static inline int64_t dim_to_offset(int32_t ndim, const int32_t * restrict dim,
-                                    const int32_t * restrict axisDistance) {
-  if(ndim == 0) return 0;
-  int64_t offset = 0;
-  for (int32_t i = ndim - 1; i >= 0; --i) {
-    offset += dim[i] * axisDistance[i];
-  }
-  return offset;
+static float max_(float a, float b)
+{
+    return a > b ? a : b;
 }
 
 void ONNC_RUNTIME_reducelogsumexp_float(
@@ -50,54 +45,34 @@ void ONNC_RUNTIME_reducelogsumexp_float(
   ,int32_t number_of_axes
   ,int32_t keepdims
 ) {
-  /* initial axis */
-  int32_t mask = 0;
+  /* log(sum(exp(x))) = m + log(sum(exp(x - m))), where m = max(x) */
+  ONNC_REDUCE_AXES(float, output_reduced, input_data, input_data_dims, input_data_ndim,
+                   axes, number_of_axes, -INFINITY, identity_, max_);
 
-  /* on bit means in parameter axes */
-  for(int32_t axis = 0 ; axis < number_of_axes ; axis++){
-    mask |= (1 << axes[axis]);
-  }
+  int32_t ndim = input_data_ndim;
+  int32_t kept_dims[ndim + 1];
+  for (int32_t i = 0; i < ndim; ++i)
+    kept_dims[i] = number_of_axes == 0 ? 1 : input_data_dims[i];
+  for (int32_t i = 0; i < number_of_axes; ++i)
+    kept_dims[axes[i] < 0 ? axes[i] + ndim : axes[i]] = 1;
 
-  /* calculate axis_dis */
-  int32_t axis_dis[input_data_ndim];
-  calculate_axis_dis(input_data_ndim, input_data_dims, axis_dis);
+  int32_t size = onnc_size(output_reduced_dims, output_reduced_ndim);
+  int32_t input_size = onnc_size(input_data_dims, ndim);
+  float* shifted = (float*)malloc(sizeof(float) * input_size);
+  float* sums = (float*)malloc(sizeof(float) * size);
 
-  /* initial iterative context */
-  int32_t not_in_axes_num = input_data_ndim - number_of_axes;
-  int32_t iter_not_in_axes_max[not_in_axes_num];
-  int32_t not_in_axes_axis_dis[input_data_ndim];
-  int32_t not_in_axes_axis_index = 0;
+  for (int32_t i = 0; i < size; ++i)
+    if (!isfinite(output_reduced[i]))
+      output_reduced[i] = 0;
 
-  int32_t iter_in_axes_max[number_of_axes];
-  int32_t in_axes_axis_dis[number_of_axes];
-  int32_t in_axes_axis_index = 0;
-  for(int32_t axis = 0 ; axis < input_data_ndim; axis++){
-    if(mask & (1 << axis)){
-      in_axes_axis_dis[in_axes_axis_index] = axis_dis[axis];
-      iter_in_axes_max[in_axes_axis_index] = input_data_dims[axis];
-      in_axes_axis_index += 1;
-      continue;
-    }
-    not_in_axes_axis_dis[not_in_axes_axis_index] = axis_dis[axis];
-    iter_not_in_axes_max[not_in_axes_axis_index] = input_data_dims[axis];
-    not_in_axes_axis_index += 1;
-  }
+  memcpy(shifted, input_data, sizeof(float) * input_size);
+  ONNC_BINARY(float, shifted, input_data_dims, ndim, output_reduced, kept_dims, ndim, sub_);
+  ONNC_REDUCE_AXES(float, sums, shifted, input_data_dims, ndim,
+                   axes, number_of_axes, 0, exp_, add_);
 
-  /* traverse all axis other than parameter axes */
-  int32_t insertIndex = 0;
-  int32_t iter_not_in_axes[not_in_axes_num];
-  memset(iter_not_in_axes, 0, sizeof(int32_t) * not_in_axes_num);
-  do{
-    int32_t iter_in_axes[number_of_axes];
-    memset(iter_in_axes, 0, sizeof(int32_t) * number_of_axes);
-    int32_t base_offset = dim_to_offset(not_in_axes_num, iter_not_in_axes, not_in_axes_axis_dis);
-    float sum = 0.f;
+  for (int32_t i = 0; i < size; ++i)
+    output_reduced[i] += onnc_logf(sums[i]);
 
-    /* traver all axes with fixed axis */
-    do{
-      int32_t offset = base_offset + dim_to_offset(number_of_axes, iter_in_axes, in_axes_axis_dis);
-      sum += expf(input_data[offset]);
-    }while(next_dim(number_of_axes, iter_in_axes, iter_in_axes_max));
-    output_reduced[insertIndex++] = logf(sum);
-  }while(next_dim(not_in_axes_num, iter_not_in_axes, iter_not_in_axes_max));
+  free(shifted);
+  free(sums);
 }
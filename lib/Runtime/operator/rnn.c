@@ -2,6 +2,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+typedef int32_t ONNC_INDEX_TYPE;
+
+#include "generic/recurrent.h"
 
 void ONNC_RUNTIME_rnn_float(
   void * restrict onnc_runtime_context
@@ -31,4 +34,113 @@ void ONNC_RUNTIME_rnn_float(
   ,const char * restrict direction
   ,int32_t hidden_size
 ) {
+  int32_t steps = input_X_dims[0];
+  int32_t batches = input_X_dims[1];
+  int32_t input_size = input_X_dims[2];
+  int32_t hidden = input_R_dims[2];
+  int32_t directions = onnc_directions(direction);
+
+  static const char *defaults[] = { "Tanh" };
+  onnc_activation functions[2];
+  onnc_activations(functions, 1, directions, defaults,
+                   activations, number_of_activations,
+                   activation_alpha, number_of_activation_alpha,
+                   activation_beta, number_of_activation_beta);
+
+  if (output_Y != NULL) {
+    memset(output_Y, 0, sizeof(float) * steps * directions * batches * hidden);
+  }
+
+  int32_t *rows = (int32_t *)malloc(sizeof(int32_t) * steps * batches);
+  int32_t *active = (int32_t *)malloc(sizeof(int32_t) * batches);
+  float *bias = (float *)malloc(sizeof(float) * hidden);
+  float *gates = (float *)malloc(sizeof(float) * batches * hidden);
+  float *h = (float *)malloc(sizeof(float) * batches * hidden);
+  if (rows == NULL || active == NULL || bias == NULL || gates == NULL ||
+      h == NULL) {
+    free(h);
+    free(gates);
+    free(bias);
+    free(active);
+    free(rows);
+    return;
+  }
+
+  for (int32_t d = 0; d < directions; ++d) {
+    const onnc_activation *f = &functions[d];
+    const float *R = input_R + (size_t)d * hidden * hidden;
+    bool reverse = onnc_is_reverse(direction, d);
+
+    // Both biases go into the projection of the inputs.
+    if (input_B != NULL) {
+      const float *Wb = input_B + (size_t)d * 2 * hidden;
+      for (int32_t j = 0; j < hidden; ++j) {
+        bias[j] = Wb[j] + Wb[hidden + j];
+      }
+    }
+    int32_t count = 0;
+    float *projection = onnc_project_inputs(
+        input_X, input_W + (size_t)d * hidden * input_size,
+        input_B != NULL ? bias : NULL, input_sequence_lens,
+        steps, batches, hidden, input_size, rows, &count);
+    if (projection == NULL) {
+      break;
+    }
+
+    size_t state_size = sizeof(float) * batches * hidden;
+    if (input_initial_h != NULL) {
+      memcpy(h, input_initial_h + (size_t)d * batches * hidden, state_size);
+    } else {
+      memset(h, 0, state_size);
+    }
+
+    for (int32_t s = 0; s < steps; ++s) {
+      // Only the batches whose sequences are still running.
+      int32_t nactive = 0;
+      for (int32_t b = 0; b < batches; ++b) {
+        int32_t length = onnc_sequence_length(input_sequence_lens, b, steps);
+        if (s >= length) {
+          continue;
+        }
+        int32_t t = reverse ? length - 1 - s : s;
+        memcpy(gates + (size_t)b * hidden,
+               projection + ((size_t)t * batches + b) * hidden,
+               sizeof(float) * hidden);
+        active[nactive++] = b;
+      }
+      if (nactive == 0) {
+        break;
+      }
+
+      onnc_rows_gemm_nt(gates, h, R, active, nactive, hidden, hidden);
+
+      for (int32_t n = 0; n < nactive; ++n) {
+        int32_t b = active[n];
+        int32_t length = onnc_sequence_length(input_sequence_lens, b, steps);
+        int32_t t = reverse ? length - 1 - s : s;
+        const float *gate = gates + (size_t)b * hidden;
+        float *hb = h + (size_t)b * hidden;
+
+        for (int32_t j = 0; j < hidden; ++j) {
+          hb[j] = onnc_activate(f, onnc_clip(gate[j], clip));
+        }
+
+        if (output_Y != NULL) {
+          memcpy(output_Y + (((size_t)t * directions + d) * batches + b) * hidden,
+                 hb, sizeof(float) * hidden);
+        }
+      }
+    }
+    free(projection);
+
+    if (output_Y_h != NULL) {
+      memcpy(output_Y_h + (size_t)d * batches * hidden, h, state_size);
+    }
+  }
+
+  free(h);
+  free(gates);
+  free(bias);
+  free(active);
+  free(rows);
 }
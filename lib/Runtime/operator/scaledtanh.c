@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_scaledtanh_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_input
@@ -20,6 +22,6 @@ void ONNC_RUNTIME_scaledtanh_float(
 	}
 
 	for(int32_t i = 0 ; i < size ; ++i){
-    output_output[i] = alpha * tanhf(beta * input_input[i]);
+    output_output[i] = alpha * onnc_tanhf(beta * input_input[i]);
 	}
 }
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_selu_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_X
@@ -20,6 +22,6 @@ void ONNC_RUNTIME_selu_float(
 	}
 
 	for(int32_t i = 0 ; i < size ; ++i){
-    output_Y[i] = gamma * ((input_X[i] <= 0.0f) ? alpha * (expf(input_X[i]) - 1.0f) : input_X[i]);
+    output_Y[i] = gamma * ((input_X[i] <= 0.0f) ? alpha * (onnc_expf(input_X[i]) - 1.0f) : input_X[i]);
 	}
 }
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_sigmoid_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_X
@@ -19,6 +21,6 @@ void ONNC_RUNTIME_sigmoid_float(
 	}
 
 	for(int32_t i = 0 ; i < size ; ++i){
-		output_Y[i] = 1.0f / (1.0f + expf(input_X[i] * -1.0f));
+		output_Y[i] = onnc_sigmoidf(input_X[i]);
 	}
 }
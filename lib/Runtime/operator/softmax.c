@@ -5,6 +5,8 @@
 #include <math.h>
 #include <float.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_softmax_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_input
@@ -28,11 +30,14 @@ void ONNC_RUNTIME_softmax_float(
       maxData = fmaxf(maxData, pInput[i]);
     }
     for(int32_t i = 0; i < size_D; ++i){
-      pOutput[i] = expf(pInput[i] - maxData);
+      pOutput[i] = onnc_expf(pInput[i] - maxData);
+    }
+    for(int32_t i = 0; i < size_D; ++i){
       sumData += pOutput[i];
     }
+    float scale = 1.0f / sumData;
     for(int32_t i = 0; i < size_D; ++i){
-      pOutput[i] /= sumData;
+      pOutput[i] *= scale;
     }
   }
 }
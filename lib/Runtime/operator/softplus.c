@@ -3,6 +3,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_softplus_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_X
@@ -11,4 +13,14 @@ void ONNC_RUNTIME_softplus_float(
   ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
   
 ) {
+  int32_t size = 1;
+  for(int32_t i = 0 ; i < input_X_ndim ; ++i){
+    size *= input_X_dims[i];
+  }
+
+  // log(1 + e^x) = max(x, 0) + log(1 + e^-|x|), which does not overflow.
+  for(int32_t i = 0 ; i < size ; ++i){
+    float x = input_X[i];
+    output_Y[i] = fmaxf(x, 0.0f) + onnc_logf(1.0f + onnc_expf(-fabsf(x)));
+  }
 }
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include "generic/fastmath.h"
+
 void ONNC_RUNTIME_tanh_float(
   void * restrict onnc_runtime_context
   ,const float * restrict input_input
@@ -18,6 +20,6 @@ void ONNC_RUNTIME_tanh_float(
   }
   
   for(int32_t j = 0; j < dataSize; j++){
-    output_output[j] = tanhf(input_input[j]);
+    output_output[j] = onnc_tanhf(input_input[j]);
   }
 }
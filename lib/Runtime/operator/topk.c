@@ -2,8 +2,17 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
-#include <float.h>
+
+/* k is small if a line has at least this many times k elements. */
+#define TOPK_HEAP_RATIO 16
+
+/* Number of elements tested against the heap at once */
+#define TOPK_BLOCK 16
+
+/* Size from which the lines run in parallel */
+#define TOPK_PARALLEL_SIZE 65536
 
 /* node */
 struct node{
@@ -11,109 +20,123 @@ struct node{
     int32_t index;
 };
 
-static void init(struct node * restrict heap, int32_t input_index, float value, int32_t index){
-    heap[input_index].value = value;
-    heap[input_index].index = index;
-}
-
 static void swap(struct node * a, struct node * b){
     struct node tmp = *a;
     *a = *b;
     *b = tmp;
 }
 
-/* node comparison */
-static bool smaller(struct node a, struct node b){
-	if(a.value < b.value) return true;
-	if(a.value > b.value) return false;
-	if(a.index > b.index) return true;
-	return false;
+/* Whether a precedes b in the output: larger values first, then lower indices */
+static inline bool before(struct node a, struct node b){
+    return a.value > b.value || (a.value == b.value && a.index < b.index);
 }
 
-/* up_heap */
-static void up_heap(struct node * restrict heap, int32_t index){
-    if(index == 1) return;
-    if(smaller(heap[index], heap[index/2])){
-        swap(&heap[index/2], &heap[index]);
-        up_heap(heap, index/2);
-        return;
-    }
+static int compare(const void * a, const void * b){
+    return before(*(const struct node *)a, *(const struct node *)b) ? -1 : 1;
 }
 
-/* down_heap */
-static void down_heap(struct node * restrict heap, int32_t index, int32_t inside_num){
-    if(index >= inside_num) return;
-
-    int32_t right_index = 2 * index + 1;
-    int32_t left_index = 2 * index;
-    int32_t value = heap[index].value;
-
-    if(left_index > inside_num) return;
-	if(right_index > inside_num && smaller(heap[left_index], heap[index])){
-        swap(&heap[left_index], &heap[index]);
-        down_heap(heap, left_index, inside_num);
-		return;
-	}
-
-	if(right_index <= inside_num && smaller(heap[left_index], heap[index]) && smaller(heap[left_index], heap[right_index])){
-        swap(&heap[left_index], &heap[index]);
-        down_heap(heap, left_index, inside_num);
-		return;
-    }
-
-    if(right_index <= inside_num && smaller(heap[right_index], heap[index])){
-        swap(&heap[right_index], &heap[index]);
-        down_heap(heap, right_index, inside_num);
-		return;
+/* Restore the heap below i, whose root is the last node in the output order */
+static void sift_down(struct node * restrict heap, int32_t size, int32_t i){
+    struct node current = heap[i];
+    for(;;){
+        int32_t child = 2 * i + 1;
+        if(child >= size) break;
+        if(child + 1 < size && before(heap[child], heap[child + 1])) ++child;
+        if(!before(current, heap[child])) break;
+        heap[i] = heap[child];
+        i = child;
     }
-    return;
+    heap[i] = current;
 }
 
-/* insert a node */
-static void insert_node(struct node * restrict heap, int32_t inside_num, int32_t value, int32_t index){
-    init(heap, inside_num + 1, value, index);
-    up_heap(heap, inside_num + 1);
+static void offer(struct node * restrict heap, int32_t k, float value, int32_t index){
+    if(value <= heap[0].value) return;
+    heap[0].value = value;
+    heap[0].index = index;
+    sift_down(heap, k, 0);
 }
 
-static void delete_node(struct node * restrict heap, int32_t inside_num){
-    init(heap, 1, FLT_MAX, 0);
-    swap(&heap[1], &heap[inside_num]);
-    down_heap(heap, 1, inside_num - 1);
-}
+/*
+ * Streaming selection for small k. A block of elements is first compared
+ * with the least kept value by a vectorizable loop, and only blocks which
+ * may change the heap are inserted. A later element never displaces an
+ * equal one, so a strict comparison keeps the lower indices.
+ */
+static void select_by_heap(const float * restrict line, int32_t n, int32_t k, struct node * restrict heap){
+    for(int32_t i = 0 ; i < k ; ++i){
+        heap[i].value = line[i];
+        heap[i].index = i;
+    }
+    for(int32_t i = k / 2 - 1 ; i >= 0 ; --i){
+        sift_down(heap, k, i);
+    }
 
-static inline void calculate_axis_dis(int32_t ndim, const int32_t * restrict dims, int32_t * restrict axis_dis){
-    int32_t base = axis_dis[ndim-1] = 1;
-    for(int32_t dim = ndim - 2 ; dim >= 0 ; --dim){
-        axis_dis[dim] = base * dims[dim+1];
-        base = axis_dis[dim];
+    int32_t i = k;
+    for(; i + TOPK_BLOCK <= n ; i += TOPK_BLOCK){
+        float threshold = heap[0].value;
+        int hit = 0;
+        for(int32_t j = 0 ; j < TOPK_BLOCK ; ++j){
+            hit |= line[i + j] > threshold;
+        }
+        if(!hit) continue;
+        for(int32_t j = 0 ; j < TOPK_BLOCK ; ++j){
+            offer(heap, k, line[i + j], i + j);
+        }
+    }
+    for(; i < n ; ++i){
+        offer(heap, k, line[i], i);
     }
-}
 
-static inline bool next_dim(int32_t ndim, int32_t * restrict dim, const int32_t * restrict dim_max) {
-  if(ndim == 0)
-    return false;
-  do {
-    ndim = ndim - 1;
-    dim[ndim] += 1;
-    if (dim[ndim] < dim_max[ndim]) {
-      return true;
-    } else { // reach dimension max
-      if (ndim == 0) { // all dimension done
-        return false;
-      }
-      dim[ndim] = 0;
+    /* Sort by moving the last node to the back */
+    for(int32_t size = k - 1 ; size > 0 ; --size){
+        swap(&heap[0], &heap[size]);
+        sift_down(heap, size, 0);
     }
-  } while(true);
 }
 
-static inline int64_t dim_to_offset(int32_t ndim, const int32_t * restrict dim,
-                                    const int32_t * restrict axisDistance) {
-  if(ndim == 0) return 0;
-  int64_t offset = 0;
-  for (int32_t i = ndim - 1; i >= 0; --i) {
-    offset += dim[i] * axisDistance[i];
-  }
-  return offset;
+/*
+ * Introselect: move the k first nodes in the output order to the front, by
+ * quickselect with median-of-three pivots. If partitioning fails to shrink
+ * the range fast enough, the rest of it is sorted instead.
+ */
+static void select_by_partition(struct node * restrict nodes, int32_t n, int32_t k){
+    int32_t lo = 0, hi = n;
+    int32_t depth = 0;
+    for(int32_t size = n ; size > 1 ; size /= 2) depth += 2;
+
+    while(hi - lo > 16){
+        if(depth-- == 0){
+            qsort(nodes + lo, hi - lo, sizeof(struct node), compare);
+            return;
+        }
+
+        int32_t mid = lo + (hi - lo) / 2;
+        if(before(nodes[mid], nodes[lo])) swap(&nodes[mid], &nodes[lo]);
+        if(before(nodes[hi - 1], nodes[lo])) swap(&nodes[hi - 1], &nodes[lo]);
+        if(before(nodes[hi - 1], nodes[mid])) swap(&nodes[hi - 1], &nodes[mid]);
+        swap(&nodes[mid], &nodes[hi - 1]);
+
+        struct node pivot = nodes[hi - 1];
+        int32_t store = lo;
+        for(int32_t i = lo ; i < hi - 1 ; ++i){
+            if(before(nodes[i], pivot)) swap(&nodes[i], &nodes[store++]);
+        }
+        swap(&nodes[store], &nodes[hi - 1]);
+
+        if(store == k || store + 1 == k) return;
+        if(k < store) hi = store;
+        else lo = store + 1;
+    }
+
+    /* Insertion sort of the short range left */
+    for(int32_t i = lo + 1 ; i < hi ; ++i){
+        struct node current = nodes[i];
+        int32_t j = i;
+        for(; j > lo && before(current, nodes[j - 1]) ; --j){
+            nodes[j] = nodes[j - 1];
+        }
+        nodes[j] = current;
+    }
 }
 
 void ONNC_RUNTIME_topk_float(
@@ -127,58 +150,63 @@ void ONNC_RUNTIME_topk_float(
   ,int32_t axis
   ,int32_t k
 ) {
-  int32_t axis_dis[input_X_ndim];
-  memset(axis_dis, 0, sizeof(int32_t) * input_X_ndim);
-
-  /* calculate_axis_dis */
-  calculate_axis_dis(input_X_ndim, input_X_dims, axis_dis);
-
-  /* initialize iter context */
-  int32_t iter_ndim = input_X_ndim - 1;
-  int32_t iter_max[iter_ndim];
-  int32_t iter_axis_dis[iter_ndim];
-  int32_t iter_index = 0;
-  for(int32_t axis_index = 0 ; axis_index < input_X_ndim ; ++axis_index){
-      if(axis_index == axis) continue;
-      iter_max[iter_index] = input_X_dims[axis_index];
-      iter_axis_dis[iter_index] = axis_dis[axis_index];
-      iter_index += 1;
+  if(axis < 0) axis += input_X_ndim;
+
+  int32_t outer = 1, inner = 1;
+  int32_t n = input_X_dims[axis];
+  for(int32_t i = 0 ; i < axis ; ++i) outer *= input_X_dims[i];
+  for(int32_t i = axis + 1 ; i < input_X_ndim ; ++i) inner *= input_X_dims[i];
+  if(k > n) k = n;
+  if(k <= 0) return;
+
+  int32_t lines = outer * inner;
+  bool parallel = lines > 1 && (double)lines * n >= TOPK_PARALLEL_SIZE;
+  (void)parallel;
+
+  bool small = (int64_t)k * TOPK_HEAP_RATIO <= n;
+  bool gather = small && inner > 1;
+
+  /* Each line along the axis is independent. Each thread allocates its
+   * scratch once; a thread that cannot leaves its lines unwritten. */
+#ifdef _OPENMP
+  #pragma omp parallel if (parallel)
+#endif
+  {
+    struct node * nodes = (struct node *)malloc(sizeof(struct node) * (small ? k : n));
+    float * line = gather ? (float *)malloc(sizeof(float) * n) : NULL;
+    bool ready = nodes != NULL && (line != NULL || !gather);
+
+#ifdef _OPENMP
+    #pragma omp for
+#endif
+    for(int32_t l = 0 ; l < lines ; ++l){
+        if(!ready) continue;
+        int32_t o = l / inner, i = l % inner;
+        const float * x = input_X + (size_t)o * n * inner + i;
+        size_t offset = (size_t)o * k * inner + i;
+
+        if(small){
+            if(gather){
+                for(int32_t j = 0 ; j < n ; ++j) line[j] = x[(size_t)j * inner];
+            }
+            select_by_heap(gather ? line : x, n, k, nodes);
+        }
+        else{
+            for(int32_t j = 0 ; j < n ; ++j){
+                nodes[j].value = x[(size_t)j * inner];
+                nodes[j].index = j;
+            }
+            select_by_partition(nodes, n, k);
+            qsort(nodes, k, sizeof(struct node), compare);
+        }
+
+        for(int32_t j = 0 ; j < k ; ++j){
+            output_Values[offset + (size_t)j * inner] = nodes[j].value;
+            output_Indices[offset + (size_t)j * inner] = nodes[j].index;
+        }
+    }
+
+    free(line);
+    free(nodes);
   }
-  int32_t iter_base[iter_ndim];
-  memset(iter_base, 0, sizeof(int32_t) * iter_ndim);
-
-  int32_t insertIndex = 0;
-
-  /* traverse */
-  do{
-      int32_t base_offset = dim_to_offset(iter_ndim, iter_base, iter_axis_dis);
-      struct node heap[k];
-      memset(heap, 0, sizeof(struct node) * k);
-      int32_t inside_num = 0;
-      for(int32_t axis_index = 0 ; axis_index < input_X_dims[axis]; ++axis_index){
-          int32_t offset = base_offset + axis_dis[axis] * axis_index;
-          int32_t value = input_X[offset];
-          if(inside_num < k){
-              insert_node(heap, inside_num, value, axis_index);
-              inside_num ++;
-          }
-          else{
-              if(value <= heap[1].value) continue;
-              init(heap, 1, value, axis_index);
-              down_heap(heap, 1, k);
-          }
-      }
-      struct node output_temp[k];
-      memset(output_temp, 0, sizeof(struct node) * k);
-      for(int32_t index = k - 1; index >= 0 ; --index){
-          output_temp[index] = heap[1];
-          delete_node(heap, index + 1);
-      }
-
-      for(int32_t index = 0 ; index < k ; ++index){
-        output_Values[insertIndex] = output_temp[index].value;
-        output_Indices[insertIndex] = output_temp[index].index;
-        insertIndex++;
-      }
-  }while(next_dim(iter_ndim, iter_base, iter_max));
 }
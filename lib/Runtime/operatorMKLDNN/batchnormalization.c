@@ -0,0 +1,136 @@
+#include <onnc/Runtime/operatorMKLDNN/context.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define ONNC_RUNTIME_batchnormalization_float ONNC_RUNTIME_batchnormalization_float_reference
+#include <onnc/Runtime/operator/batchnormalization.h>
+#undef ONNC_RUNTIME_batchnormalization_float
+
+// memory slots of a cached batch normalization
+enum {
+  BN_MEAN = ONNC_RUNTIME_MKLDNN_UNARY_SLOTS,
+  BN_VARIANCE,
+  BN_SCALE_SHIFT
+};
+
+// Inference with the given statistics.
+static bool run_batchnormalization(void * restrict onnc_runtime_context,
+                                   const float * restrict input_X,
+                                   int32_t input_X_ndim,
+                                   const int32_t * restrict input_X_dims,
+                                   const float * restrict input_scale,
+                                   const float * restrict input_B,
+                                   const float * restrict input_mean,
+                                   const float * restrict input_var,
+                                   float * restrict output_Y,
+                                   float epsilon) {
+  MKLDNNContext *context = ONNC_RUNTIME_mkldnn_get_context(onnc_runtime_context);
+  if (context == NULL || input_X_ndim < 2 ||
+      input_X_ndim > ONNC_RUNTIME_MKLDNN_MAX_NDIM) {
+    return false;
+  }
+
+  int64_t key[ONNC_RUNTIME_MKLDNN_MAX_KEY];
+  int32_t key_size = 0;
+  key[key_size++] = ONNC_RUNTIME_MKLDNN_BATCHNORMALIZATION;
+  key[key_size++] = ONNC_RUNTIME_mkldnn_float_key(epsilon);
+  key[key_size++] = input_X_ndim;
+  for (int32_t i = 0; i < input_X_ndim; ++i) {
+    key[key_size++] = input_X_dims[i];
+  }
+
+  int32_t C = input_X_dims[1];
+  MKLDNNPrimitive *primitive =
+      ONNC_RUNTIME_mkldnn_find_primitive(context, key, key_size);
+  if (primitive == NULL) {
+    mkldnn_memory_desc_t md, stat_md, scale_shift_md;
+    int32_t scale_shift_dims[2] = { 2, C };
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&md, input_X_ndim, input_X_dims);
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&stat_md, 1, &C);
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&scale_shift_md, 2, scale_shift_dims);
+
+    mkldnn_batch_normalization_desc_t desc;
+    if (mkldnn_batch_normalization_forward_desc_init(
+            &desc, mkldnn_forward_inference, &md, epsilon,
+            mkldnn_use_global_stats | mkldnn_use_scaleshift) != mkldnn_success) {
+      return false;
+    }
+    primitive = ONNC_RUNTIME_mkldnn_create_unary(context, key, key_size,
+                                                 &desc, &md, &md);
+    if (primitive == NULL) {
+      return false;
+    }
+
+    MKLDNNStep *step = &primitive->steps[0];
+    ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_MEAN,
+        ONNC_RUNTIME_mkldnn_create_memory(context, primitive, BN_MEAN,
+                                          &stat_md, false));
+    ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_VARIANCE,
+        ONNC_RUNTIME_mkldnn_create_memory(context, primitive, BN_VARIANCE,
+                                          &stat_md, false));
+    ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_SCALE_SHIFT,
+        ONNC_RUNTIME_mkldnn_create_memory(context, primitive, BN_SCALE_SHIFT,
+                                          &scale_shift_md, true));
+  }
+
+  // MKL-DNN takes the scale and the shift in one tensor.
+  void *scale_shift = NULL;
+  mkldnn_memory_get_data_handle(primitive->memories[BN_SCALE_SHIFT], &scale_shift);
+  memcpy(scale_shift, input_scale, sizeof(float) * C);
+  memcpy((float *)scale_shift + C, input_B, sizeof(float) * C);
+
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_SRC, input_X);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, BN_MEAN, input_mean);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, BN_VARIANCE, input_var);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_DST, output_Y);
+  ONNC_RUNTIME_mkldnn_execute(context, primitive);
+  return true;
+}
+
+void ONNC_RUNTIME_batchnormalization_float(
+  void * restrict onnc_runtime_context
+  ,const float * restrict input_X
+  ,int32_t input_X_ndim, const int32_t * restrict input_X_dims
+  ,const float * restrict input_scale
+  ,int32_t input_scale_ndim, const int32_t * restrict input_scale_dims
+  ,const float * restrict input_B
+  ,int32_t input_B_ndim, const int32_t * restrict input_B_dims
+  ,const float * restrict input_mean
+  ,int32_t input_mean_ndim, const int32_t * restrict input_mean_dims
+  ,const float * restrict input_var
+  ,int32_t input_var_ndim, const int32_t * restrict input_var_dims
+  ,float * restrict output_Y
+  ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
+  ,float * restrict output_mean
+  ,int32_t output_mean_ndim, const int32_t * restrict output_mean_dims
+  ,float * restrict output_var
+  ,int32_t output_var_ndim, const int32_t * restrict output_var_dims
+  ,float * restrict output_saved_mean
+  ,int32_t output_saved_mean_ndim, const int32_t * restrict output_saved_mean_dims
+  ,float * restrict output_saved_var
+  ,int32_t output_saved_var_ndim, const int32_t * restrict output_saved_var_dims
+  ,float epsilon
+  ,float momentum
+  ,int32_t spatial
+) {
+  if (run_batchnormalization(onnc_runtime_context, input_X, input_X_ndim,
+                             input_X_dims, input_scale, input_B, input_mean,
+                             input_var, output_Y, epsilon)) {
+    return;
+  }
+
+  ONNC_RUNTIME_batchnormalization_float_reference(
+      onnc_runtime_context, input_X, input_X_ndim, input_X_dims,
+      input_scale, input_scale_ndim, input_scale_dims,
+      input_B, input_B_ndim, input_B_dims,
+      input_mean, input_mean_ndim, input_mean_dims,
+      input_var, input_var_ndim, input_var_dims,
+      output_Y, output_Y_ndim, output_Y_dims,
+      output_mean, output_mean_ndim, output_mean_dims,
+      output_var, output_var_ndim, output_var_dims,
+      output_saved_mean, output_saved_mean_ndim, output_saved_mean_dims,
+      output_saved_var, output_saved_var_ndim, output_saved_var_dims,
+      epsilon, momentum, spatial);
+}
@@ -0,0 +1,118 @@
+#include <onnc/Runtime/operatorMKLDNN/context.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ONNC_RUNTIME_concat_float ONNC_RUNTIME_concat_float_reference
+#include <onnc/Runtime/operator/concat.h>
+#undef ONNC_RUNTIME_concat_float
+
+// at most one argument of a step is the destination
+#define MAX_INPUTS (ONNC_RUNTIME_MKLDNN_MAX_ARGS - 1)
+
+static bool run_concat(void * restrict onnc_runtime_context,
+                       const float * const * restrict input_inputs,
+                       int32_t input_inputs_ntensor,
+                       const int32_t * input_inputs_ndim,
+                       const int32_t * const * restrict input_inputs_dims,
+                       float * restrict output_concat_result,
+                       int32_t output_concat_result_ndim,
+                       const int32_t * restrict output_concat_result_dims,
+                       int32_t axis) {
+  int32_t ndim = output_concat_result_ndim;
+  if (input_inputs_ntensor < 1 || input_inputs_ntensor > MAX_INPUTS ||
+      ndim > ONNC_RUNTIME_MKLDNN_MAX_NDIM || axis < 0 || axis >= ndim) {
+    return false;
+  }
+  for (int32_t t = 0; t < input_inputs_ntensor; ++t) {
+    if (input_inputs_ndim[t] != ndim) {
+      return false;
+    }
+  }
+
+  MKLDNNContext *context = ONNC_RUNTIME_mkldnn_get_context(onnc_runtime_context);
+  if (context == NULL) {
+    return false;
+  }
+
+  int64_t key[ONNC_RUNTIME_MKLDNN_MAX_KEY];
+  int32_t key_size = 0;
+  key[key_size++] = ONNC_RUNTIME_MKLDNN_CONCAT;
+  key[key_size++] = axis;
+  key[key_size++] = input_inputs_ntensor;
+  key[key_size++] = ndim;
+  for (int32_t t = 0; t < input_inputs_ntensor; ++t) {
+    for (int32_t i = 0; i < ndim; ++i) {
+      key[key_size++] = input_inputs_dims[t][i];
+    }
+  }
+
+  MKLDNNPrimitive *primitive =
+      ONNC_RUNTIME_mkldnn_find_primitive(context, key, key_size);
+  if (primitive == NULL) {
+    mkldnn_memory_desc_t dst_md;
+    mkldnn_memory_desc_t src_mds[MAX_INPUTS];
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&dst_md, ndim, output_concat_result_dims);
+    for (int32_t t = 0; t < input_inputs_ntensor; ++t) {
+      ONNC_RUNTIME_mkldnn_init_plain_desc(&src_mds[t], ndim, input_inputs_dims[t]);
+    }
+
+    mkldnn_primitive_desc_t pd;
+    if (mkldnn_concat_primitive_desc_create(&pd, &dst_md, input_inputs_ntensor,
+                                            axis, src_mds, NULL,
+                                            context->engine) != mkldnn_success) {
+      return false;
+    }
+    primitive = ONNC_RUNTIME_mkldnn_create_primitive(context, key, key_size);
+    if (primitive == NULL) {
+      mkldnn_primitive_desc_destroy(pd);
+      return false;
+    }
+    MKLDNNStep *step = ONNC_RUNTIME_mkldnn_add_step(primitive, pd);
+    mkldnn_primitive_desc_destroy(pd);
+    if (step == NULL) {
+      ONNC_RUNTIME_mkldnn_destroy_primitive(context, primitive);
+      return false;
+    }
+
+    // slot t is the input t, the last slot is the output
+    for (int32_t t = 0; t < input_inputs_ntensor; ++t) {
+      ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_MULTIPLE_SRC + t,
+          ONNC_RUNTIME_mkldnn_create_memory(context, primitive, t,
+                                            &src_mds[t], false));
+    }
+    ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_DST,
+        ONNC_RUNTIME_mkldnn_create_memory(context, primitive, MAX_INPUTS,
+                                          &dst_md, false));
+  }
+
+  for (int32_t t = 0; t < input_inputs_ntensor; ++t) {
+    ONNC_RUNTIME_mkldnn_set_handle(primitive, t, input_inputs[t]);
+  }
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, MAX_INPUTS, output_concat_result);
+  ONNC_RUNTIME_mkldnn_execute(context, primitive);
+  return true;
+}
+
+void ONNC_RUNTIME_concat_float(
+  void * restrict onnc_runtime_context
+  ,const float * const * restrict input_inputs
+  ,int32_t input_inputs_ntensor
+  ,const int32_t * input_inputs_ndim, const int32_t * const * restrict input_inputs_dims
+  ,float * restrict output_concat_result
+  ,int32_t output_concat_result_ndim, const int32_t * restrict output_concat_result_dims
+  ,int32_t axis
+) {
+  if (run_concat(onnc_runtime_context, input_inputs, input_inputs_ntensor,
+                 input_inputs_ndim, input_inputs_dims, output_concat_result,
+                 output_concat_result_ndim, output_concat_result_dims, axis)) {
+    return;
+  }
+
+  ONNC_RUNTIME_concat_float_reference(onnc_runtime_context,
+                                      input_inputs, input_inputs_ntensor,
+                                      input_inputs_ndim, input_inputs_dims,
+                                      output_concat_result,
+                                      output_concat_result_ndim,
+                                      output_concat_result_dims, axis);
+}
@@ -0,0 +1,315 @@
+#include <onnc/Runtime/operatorMKLDNN/context.h>
+#include <onnc/Runtime/onnc-runtime-internal.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+MKLDNNContext *ONNC_RUNTIME_mkldnn_get_context(void *onnc_runtime_context) {
+  Context *runtime = (Context *)onnc_runtime_context;
+  if (runtime == NULL) {
+    return NULL;
+  }
+  if (runtime->mkldnn_context != NULL) {
+    return (MKLDNNContext *)runtime->mkldnn_context;
+  }
+
+  MKLDNNContext *context = (MKLDNNContext *)calloc(1, sizeof(MKLDNNContext));
+  if (context == NULL) {
+    return NULL;
+  }
+  if (mkldnn_engine_create(&context->engine, mkldnn_cpu, 0) != mkldnn_success) {
+    free(context);
+    return NULL;
+  }
+  if (mkldnn_stream_create(&context->stream, context->engine,
+                           mkldnn_stream_default_flags) != mkldnn_success) {
+    mkldnn_engine_destroy(context->engine);
+    free(context);
+    return NULL;
+  }
+
+  context->runtime = runtime;
+  runtime->mkldnn_context = context;
+  runtime->destroy_mkldnn_context = ONNC_RUNTIME_mkldnn_destroy_context;
+  return context;
+}
+
+static void free_primitive(MKLDNNPrimitive *primitive) {
+  for (int32_t i = 0; i < primitive->nsteps; ++i) {
+    mkldnn_primitive_destroy(primitive->steps[i].primitive);
+  }
+  for (int32_t i = 0; i < ONNC_RUNTIME_MKLDNN_MAX_MEMORIES; ++i) {
+    if (primitive->memories[i] != NULL) {
+      mkldnn_memory_destroy(primitive->memories[i]);
+    }
+  }
+  free(primitive);
+}
+
+static void free_weights(MKLDNNWeights *weights) {
+  if (weights->memory != NULL) {
+    mkldnn_memory_destroy(weights->memory);
+  }
+  free(weights);
+}
+
+void ONNC_RUNTIME_mkldnn_destroy_context(void *mkldnn_context) {
+  MKLDNNContext *context = (MKLDNNContext *)mkldnn_context;
+
+  MKLDNNPrimitive *primitive = context->primitives;
+  while (primitive != NULL) {
+    MKLDNNPrimitive *next = primitive->next;
+    free_primitive(primitive);
+    primitive = next;
+  }
+
+  MKLDNNWeights *weights = context->weights;
+  while (weights != NULL) {
+    MKLDNNWeights *next = weights->next;
+    free_weights(weights);
+    weights = next;
+  }
+
+  mkldnn_stream_destroy(context->stream);
+  mkldnn_engine_destroy(context->engine);
+  free(context);
+}
+
+MKLDNNPrimitive *ONNC_RUNTIME_mkldnn_find_primitive(MKLDNNContext *context,
+                                                    const int64_t *key,
+                                                    int32_t key_size) {
+  for (MKLDNNPrimitive *primitive = context->primitives; primitive != NULL;
+       primitive = primitive->next) {
+    if (primitive->key_size == key_size &&
+        memcmp(primitive->key, key, sizeof(int64_t) * key_size) == 0) {
+      return primitive;
+    }
+  }
+  return NULL;
+}
+
+MKLDNNPrimitive *ONNC_RUNTIME_mkldnn_create_primitive(MKLDNNContext *context,
+                                                      const int64_t *key,
+                                                      int32_t key_size) {
+  if (key_size > ONNC_RUNTIME_MKLDNN_MAX_KEY) {
+    return NULL;
+  }
+
+  MKLDNNPrimitive *primitive = (MKLDNNPrimitive *)calloc(1, sizeof(MKLDNNPrimitive));
+  if (primitive == NULL) {
+    return NULL;
+  }
+  memcpy(primitive->key, key, sizeof(int64_t) * key_size);
+  primitive->key_size = key_size;
+  primitive->next = context->primitives;
+  context->primitives = primitive;
+  return primitive;
+}
+
+void ONNC_RUNTIME_mkldnn_destroy_primitive(MKLDNNContext *context,
+                                           MKLDNNPrimitive *primitive) {
+  MKLDNNPrimitive **link = &context->primitives;
+  while (*link != NULL && *link != primitive) {
+    link = &(*link)->next;
+  }
+  if (*link != NULL) {
+    *link = primitive->next;
+  }
+  free_primitive(primitive);
+}
+
+mkldnn_memory_t ONNC_RUNTIME_mkldnn_create_memory(MKLDNNContext *context,
+                                                  MKLDNNPrimitive *primitive,
+                                                  int32_t slot,
+                                                  const mkldnn_memory_desc_t *md,
+                                                  bool allocate) {
+  mkldnn_memory_t memory = NULL;
+  mkldnn_memory_create(&memory, md, context->engine,
+                       allocate ? MKLDNN_MEMORY_ALLOCATE : MKLDNN_MEMORY_NONE);
+  primitive->memories[slot] = memory;
+  return memory;
+}
+
+bool ONNC_RUNTIME_mkldnn_init_plain_desc(mkldnn_memory_desc_t *md,
+                                         int32_t ndim, const int32_t *dims) {
+  static const mkldnn_format_tag_t tags[ONNC_RUNTIME_MKLDNN_MAX_NDIM + 1] = {
+    mkldnn_format_tag_undef, mkldnn_a, mkldnn_ab, mkldnn_abc, mkldnn_abcd,
+    mkldnn_abcde, mkldnn_abcdef
+  };
+  if (ndim < 1 || ndim > ONNC_RUNTIME_MKLDNN_MAX_NDIM) {
+    return false;
+  }
+
+  mkldnn_dim_t md_dims[ONNC_RUNTIME_MKLDNN_MAX_NDIM];
+  for (int32_t i = 0; i < ndim; ++i) {
+    md_dims[i] = dims[i];
+  }
+  return mkldnn_memory_desc_init_by_tag(md, ndim, md_dims, mkldnn_f32,
+                                        tags[ndim]) == mkldnn_success;
+}
+
+MKLDNNPrimitive *ONNC_RUNTIME_mkldnn_create_unary(MKLDNNContext *context,
+                                                  const int64_t *key,
+                                                  int32_t key_size,
+                                                  const void *op_desc,
+                                                  const mkldnn_memory_desc_t *src_md,
+                                                  const mkldnn_memory_desc_t *dst_md) {
+  mkldnn_primitive_desc_t pd;
+  if (mkldnn_primitive_desc_create(&pd, op_desc, NULL, context->engine,
+                                   NULL) != mkldnn_success) {
+    return NULL;
+  }
+
+  MKLDNNPrimitive *primitive =
+      ONNC_RUNTIME_mkldnn_create_primitive(context, key, key_size);
+  MKLDNNStep *step = NULL;
+  if (primitive != NULL) {
+    step = ONNC_RUNTIME_mkldnn_add_step(primitive, pd);
+  }
+  mkldnn_primitive_desc_destroy(pd);
+  if (step == NULL) {
+    if (primitive != NULL) {
+      ONNC_RUNTIME_mkldnn_destroy_primitive(context, primitive);
+    }
+    return NULL;
+  }
+
+  ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_SRC,
+      ONNC_RUNTIME_mkldnn_create_memory(context, primitive,
+                                        ONNC_RUNTIME_MKLDNN_UNARY_SRC,
+                                        src_md, false));
+  ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_DST,
+      ONNC_RUNTIME_mkldnn_create_memory(context, primitive,
+                                        ONNC_RUNTIME_MKLDNN_UNARY_DST,
+                                        dst_md, false));
+  return primitive;
+}
+
+MKLDNNStep *ONNC_RUNTIME_mkldnn_add_step(MKLDNNPrimitive *primitive,
+                                         const_mkldnn_primitive_desc_t pd) {
+  if (primitive->nsteps == ONNC_RUNTIME_MKLDNN_MAX_STEPS) {
+    return NULL;
+  }
+
+  MKLDNNStep *step = &primitive->steps[primitive->nsteps];
+  if (mkldnn_primitive_create(&step->primitive, pd) != mkldnn_success) {
+    return NULL;
+  }
+  step->nargs = 0;
+  primitive->nsteps += 1;
+  return step;
+}
+
+void ONNC_RUNTIME_mkldnn_add_arg(MKLDNNStep *step, int arg,
+                                 mkldnn_memory_t memory) {
+  step->args[step->nargs].arg = arg;
+  step->args[step->nargs].memory = memory;
+  step->nargs += 1;
+}
+
+bool ONNC_RUNTIME_mkldnn_add_reorder(MKLDNNContext *context,
+                                     MKLDNNPrimitive *primitive,
+                                     mkldnn_memory_t from, mkldnn_memory_t to) {
+  const mkldnn_memory_desc_t *from_md, *to_md;
+  mkldnn_memory_get_memory_desc(from, &from_md);
+  mkldnn_memory_get_memory_desc(to, &to_md);
+
+  mkldnn_primitive_desc_t reorder_pd;
+  if (mkldnn_reorder_primitive_desc_create(&reorder_pd,
+                                           from_md, context->engine,
+                                           to_md, context->engine,
+                                           NULL) != mkldnn_success) {
+    return false;
+  }
+
+  MKLDNNStep *step = ONNC_RUNTIME_mkldnn_add_step(primitive, reorder_pd);
+  mkldnn_primitive_desc_destroy(reorder_pd);
+  if (step == NULL) {
+    return false;
+  }
+  ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_FROM, from);
+  ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_TO, to);
+  return true;
+}
+
+void ONNC_RUNTIME_mkldnn_set_handle(MKLDNNPrimitive *primitive, int32_t slot,
+                                    const void *data) {
+  mkldnn_memory_set_data_handle(primitive->memories[slot], (void *)data);
+}
+
+// Reorder the user weights into the cached memory, by a primitive of its own.
+static bool reorder_weights(MKLDNNContext *context, MKLDNNPrimitive *primitive,
+                            int32_t user_slot, MKLDNNWeights *cached) {
+  MKLDNNPrimitive reorder;
+  memset(&reorder, 0, sizeof(reorder));
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, user_slot, cached->data);
+  if (!ONNC_RUNTIME_mkldnn_add_reorder(context, &reorder,
+                                       primitive->memories[user_slot],
+                                       cached->memory)) {
+    return false;
+  }
+  ONNC_RUNTIME_mkldnn_execute(context, &reorder);
+  mkldnn_primitive_destroy(reorder.steps[0].primitive);
+  return true;
+}
+
+bool ONNC_RUNTIME_mkldnn_set_weights(MKLDNNContext *context,
+                                     MKLDNNPrimitive *primitive,
+                                     int32_t user_slot, int32_t slot,
+                                     const void *weights) {
+  // The primitive takes the weights as they are.
+  if (primitive->memories[slot] == NULL) {
+    ONNC_RUNTIME_mkldnn_set_handle(primitive, user_slot, weights);
+    return true;
+  }
+
+  const mkldnn_memory_desc_t *md;
+  mkldnn_memory_get_memory_desc(primitive->memories[slot], &md);
+
+  MKLDNNWeights *cached = context->weights;
+  for (; cached != NULL; cached = cached->next) {
+    const mkldnn_memory_desc_t *cached_md;
+    mkldnn_memory_get_memory_desc(cached->memory, &cached_md);
+    if (cached->data == weights && mkldnn_memory_desc_equal(cached_md, md)) {
+      break;
+    }
+  }
+
+  if (cached == NULL) {
+    cached = (MKLDNNWeights *)calloc(1, sizeof(MKLDNNWeights));
+    if (cached == NULL) {
+      return false;
+    }
+    cached->data = weights;
+    if (mkldnn_memory_create(&cached->memory, md, context->engine,
+                             MKLDNN_MEMORY_ALLOCATE) != mkldnn_success ||
+        !reorder_weights(context, primitive, user_slot, cached)) {
+      free_weights(cached);
+      return false;
+    }
+
+    cached->next = context->weights;
+    context->weights = cached;
+  } else if (!ONNC_RUNTIME_is_constant(context->runtime, weights) &&
+             !reorder_weights(context, primitive, user_slot, cached)) {
+    // The weights may have changed, e.g. the output of another node.
+    return false;
+  }
+
+  void *handle = NULL;
+  mkldnn_memory_get_data_handle(cached->memory, &handle);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, slot, handle);
+  return true;
+}
+
+void ONNC_RUNTIME_mkldnn_execute(MKLDNNContext *context,
+                                 MKLDNNPrimitive *primitive) {
+  for (int32_t i = 0; i < primitive->nsteps; ++i) {
+    MKLDNNStep *step = &primitive->steps[i];
+    mkldnn_primitive_execute(step->primitive, context->stream,
+                             step->nargs, step->args);
+  }
+  mkldnn_stream_wait(context->stream);
+}
@@ -1,11 +1,21 @@
 #include <onnc/Runtime/operatorMKLDNN/conv.h>
+#include <onnc/Runtime/operatorMKLDNN/context.h>
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <string.h>
 
-mkldnn_engine_t engine;
-mkldnn_stream_t stream;
+// memory slots of a cached convolution
+enum {
+  CONV_SRC_USER,
+  CONV_SRC,
+  CONV_WEIGHTS_USER,
+  CONV_WEIGHTS,
+  CONV_BIAS,
+  CONV_DST,
+  CONV_DST_USER
+};
 
 static inline bool next_dim(int32_t ndim, int32_t * restrict dim,
                             const int32_t * restrict dim_max) {
@@ -99,63 +109,60 @@ void ONNC_RUNTIME_conv_2d_float(void * restrict onnc_runtime_context,
   }
 }
 
-void ONNC_RUNTIME_conv_float(
-  void * restrict onnc_runtime_context
-  ,const float * restrict input_X
-  ,int32_t input_X_ndim, const int32_t * restrict input_X_dims
-  ,const float * restrict input_W
-  ,int32_t input_W_ndim, const int32_t * restrict input_W_dims
-  ,const float * restrict input_B
-  ,int32_t input_B_ndim, const int32_t * restrict input_B_dims
-  ,float * restrict output_Y
-  ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
-  ,const char * restrict auto_pad
-  ,int32_t * restrict dilations
-  ,int32_t number_of_dilations
-  ,int32_t group
-  ,int32_t * restrict kernel_shape
-  ,int32_t number_of_kernel_shape
-  ,int32_t * restrict pads
-  ,int32_t number_of_pads
-  ,int32_t * restrict strides
-  ,int32_t number_of_strides
-) {
-
-  mkldnn_engine_create(&engine, mkldnn_cpu, 0);
-  mkldnn_stream_create(&stream, engine, mkldnn_stream_default_flags);
-  mkldnn_convolution_desc_t conv_any_desc;
+// Build the convolution of a key. Source, weights and destination take the
+// layouts MKL-DNN prefers; the source and the destination are reordered from
+// and to the plain layouts on every call, the weights only once.
+static MKLDNNPrimitive *create_conv(MKLDNNContext *context,
+                                    const int64_t *key, int32_t key_size,
+                                    int32_t input_X_ndim,
+                                    const int32_t * restrict input_X_dims,
+                                    const int32_t * restrict input_W_dims,
+                                    bool has_bias,
+                                    const int32_t * restrict input_B_dims,
+                                    const int32_t * restrict output_Y_dims,
+                                    const int32_t * restrict dilations,
+                                    int32_t group,
+                                    const int32_t * restrict pads,
+                                    const int32_t * restrict strides) {
   int ndims = input_X_ndim - 2;
   mkldnn_memory_desc_t src_desc, weight_desc, bias_desc, dst_desc;
-  mkldnn_dim_t src_dims[5], weight_dims[6], bias_dims[1], dst_dims[5], dilates[3], padding_l[3], padding_r[3];
+  mkldnn_memory_desc_t src_any, weight_any, dst_any;
+  mkldnn_dim_t src_dims[5], weight_dims[6], bias_dims[1], dst_dims[5];
   weight_dims[0]=group;
   for(int i=0;i<ndims+2;i++){
     src_dims[i]=input_X_dims[i];
     weight_dims[i+1]=input_W_dims[i];
     dst_dims[i]=output_Y_dims[i];
   }
-  if(input_B!=NULL)
+  if(has_bias)
     bias_dims[0] = input_B_dims[0];
   weight_dims[1]/=weight_dims[0];
+
+  mkldnn_format_tag_t data_tag, weight_tag;
   switch(ndims){
     case 1:
-      mkldnn_memory_desc_init_by_tag(&src_desc, ndims+2, src_dims, mkldnn_f32, mkldnn_ncw);
-      mkldnn_memory_desc_init_by_tag(&weight_desc, ndims+3, weight_dims, mkldnn_f32, mkldnn_goiw);
-      mkldnn_memory_desc_init_by_tag(&dst_desc, ndims+2, dst_dims, mkldnn_f32, mkldnn_ncw);
+      data_tag = mkldnn_ncw;
+      weight_tag = mkldnn_goiw;
       break;
     case 2:
-      mkldnn_memory_desc_init_by_tag(&src_desc, ndims+2, src_dims, mkldnn_f32, mkldnn_nchw);
-      mkldnn_memory_desc_init_by_tag(&weight_desc, ndims+3, weight_dims, mkldnn_f32, mkldnn_goihw);
-      mkldnn_memory_desc_init_by_tag(&dst_desc, ndims+2, dst_dims, mkldnn_f32, mkldnn_nchw);
+      data_tag = mkldnn_nchw;
+      weight_tag = mkldnn_goihw;
       break;
-    case 3:
-      mkldnn_memory_desc_init_by_tag(&src_desc, ndims+2, src_dims, mkldnn_f32, mkldnn_ncdhw);
-      mkldnn_memory_desc_init_by_tag(&weight_desc, ndims+3, weight_dims, mkldnn_f32, mkldnn_goidhw);
-      mkldnn_memory_desc_init_by_tag(&dst_desc, ndims+2, dst_dims, mkldnn_f32, mkldnn_ncdhw);
+    default:
+      data_tag = mkldnn_ncdhw;
+      weight_tag = mkldnn_goidhw;
       break;
   }
-  if(input_B!=NULL){
-    mkldnn_memory_desc_init_by_strides(&bias_desc , 1, bias_dims, mkldnn_f32, NULL);
+  mkldnn_memory_desc_init_by_tag(&src_desc, ndims+2, src_dims, mkldnn_f32, data_tag);
+  mkldnn_memory_desc_init_by_tag(&weight_desc, ndims+3, weight_dims, mkldnn_f32, weight_tag);
+  mkldnn_memory_desc_init_by_tag(&dst_desc, ndims+2, dst_dims, mkldnn_f32, data_tag);
+  mkldnn_memory_desc_init_by_tag(&src_any, ndims+2, src_dims, mkldnn_f32, mkldnn_format_tag_any);
+  mkldnn_memory_desc_init_by_tag(&weight_any, ndims+3, weight_dims, mkldnn_f32, mkldnn_format_tag_any);
+  mkldnn_memory_desc_init_by_tag(&dst_any, ndims+2, dst_dims, mkldnn_f32, mkldnn_format_tag_any);
+  if(has_bias){
+    mkldnn_memory_desc_init_by_tag(&bias_desc, 1, bias_dims, mkldnn_f32, mkldnn_x);
   }
+
   mkldnn_dim_t dilation_dim[3], strides_dim[3], padding_l_dim[3], padding_r_dim[3];
   for(int i=0;i<ndims;i++){
     dilation_dim[i] = dilations[i]-1;
@@ -163,39 +170,151 @@ void ONNC_RUNTIME_conv_float(
     padding_l_dim[i] = pads[i];
     padding_r_dim[i] = pads[i+ndims];
   }
-  if(input_B!=NULL)
-    mkldnn_dilated_convolution_forward_desc_init(&conv_any_desc, mkldnn_forward,
-          mkldnn_convolution_direct, &src_desc, &weight_desc,
-          &bias_desc, &dst_desc, strides_dim, dilation_dim, padding_l_dim,
-          padding_r_dim);
-  else
-    mkldnn_dilated_convolution_forward_desc_init(&conv_any_desc, mkldnn_forward,
-          mkldnn_convolution_direct, &src_desc, &weight_desc,
-          NULL, &dst_desc, strides_dim, dilation_dim, padding_l_dim,
-          padding_r_dim);
+
+  mkldnn_convolution_desc_t conv_any_desc;
+  mkldnn_dilated_convolution_forward_desc_init(&conv_any_desc, mkldnn_forward,
+        mkldnn_convolution_direct, &src_any, &weight_any,
+        (has_bias ? &bias_desc : NULL), &dst_any, strides_dim, dilation_dim,
+        padding_l_dim, padding_r_dim);
 
   mkldnn_primitive_desc_t conv_pd;
+  if (mkldnn_primitive_desc_create(&conv_pd, &conv_any_desc, NULL,
+                                   context->engine, NULL) != mkldnn_success) {
+    return NULL;
+  }
+
+  MKLDNNPrimitive *primitive =
+      ONNC_RUNTIME_mkldnn_create_primitive(context, key, key_size);
+  if (primitive == NULL) {
+    mkldnn_primitive_desc_destroy(conv_pd);
+    return NULL;
+  }
+
+  const mkldnn_memory_desc_t *src_md =
+      mkldnn_primitive_desc_query_md(conv_pd, mkldnn_query_src_md, 0);
+  const mkldnn_memory_desc_t *weight_md =
+      mkldnn_primitive_desc_query_md(conv_pd, mkldnn_query_weights_md, 0);
+  const mkldnn_memory_desc_t *dst_md =
+      mkldnn_primitive_desc_query_md(conv_pd, mkldnn_query_dst_md, 0);
+
+  bool ok = true;
+  mkldnn_memory_t src_memory = ONNC_RUNTIME_mkldnn_create_memory(
+      context, primitive, CONV_SRC_USER, &src_desc, false);
+  if (!mkldnn_memory_desc_equal(src_md, &src_desc)) {
+    mkldnn_memory_t user = src_memory;
+    src_memory = ONNC_RUNTIME_mkldnn_create_memory(
+        context, primitive, CONV_SRC, src_md, true);
+    ok = ok && ONNC_RUNTIME_mkldnn_add_reorder(context, primitive, user, src_memory);
+  }
+
+  mkldnn_memory_t weight_memory = ONNC_RUNTIME_mkldnn_create_memory(
+      context, primitive, CONV_WEIGHTS_USER, &weight_desc, false);
+  if (!mkldnn_memory_desc_equal(weight_md, &weight_desc)) {
+    weight_memory = ONNC_RUNTIME_mkldnn_create_memory(
+        context, primitive, CONV_WEIGHTS, weight_md, false);
+  }
+
+  mkldnn_memory_t dst_user = ONNC_RUNTIME_mkldnn_create_memory(
+      context, primitive, CONV_DST_USER, &dst_desc, false);
+  mkldnn_memory_t dst_memory = dst_user;
+  if (!mkldnn_memory_desc_equal(dst_md, &dst_desc)) {
+    dst_memory = ONNC_RUNTIME_mkldnn_create_memory(
+        context, primitive, CONV_DST, dst_md, true);
+  }
 
-  mkldnn_primitive_desc_create(
-        &conv_pd, &conv_any_desc, NULL, engine, NULL);
-  mkldnn_memory_t src_memory, weight_memory, dst_memory, bias_memory;
-  mkldnn_memory_create(&src_memory, &src_desc, engine, (void*)input_X);
-  mkldnn_memory_create(&weight_memory, &weight_desc, engine, (void*)input_W);
-  mkldnn_memory_create(&bias_memory, &bias_desc, engine, (void*)input_B);
-  mkldnn_memory_create(&dst_memory, &src_desc, engine, (void*)output_Y);
-  mkldnn_primitive_t conv;
-  mkldnn_primitive_create(&conv, conv_pd);
-
-  args_t args;
-  prepare_arg_node(&args, 4);
-  set_arg(&args.args[0], MKLDNN_ARG_SRC, src_memory);
-  set_arg(&args.args[1], MKLDNN_ARG_WEIGHTS, weight_memory);
-  set_arg(&args.args[2], MKLDNN_ARG_BIAS, bias_memory);
-  set_arg(&args.args[3], MKLDNN_ARG_DST, dst_memory);
-  mkldnn_primitive_execute(conv, stream, args.nargs, args.args);
-  mkldnn_stream_wait(stream);
-
-  mkldnn_stream_destroy(stream);
-  mkldnn_engine_destroy(engine);
+  MKLDNNStep *conv = ok ? ONNC_RUNTIME_mkldnn_add_step(primitive, conv_pd) : NULL;
+  mkldnn_primitive_desc_destroy(conv_pd);
+  if (conv == NULL) {
+    ONNC_RUNTIME_mkldnn_destroy_primitive(context, primitive);
+    return NULL;
+  }
+  ONNC_RUNTIME_mkldnn_add_arg(conv, MKLDNN_ARG_SRC, src_memory);
+  ONNC_RUNTIME_mkldnn_add_arg(conv, MKLDNN_ARG_WEIGHTS, weight_memory);
+  if (has_bias) {
+    ONNC_RUNTIME_mkldnn_add_arg(conv, MKLDNN_ARG_BIAS,
+        ONNC_RUNTIME_mkldnn_create_memory(context, primitive, CONV_BIAS,
+                                          &bias_desc, false));
+  }
+  ONNC_RUNTIME_mkldnn_add_arg(conv, MKLDNN_ARG_DST, dst_memory);
+
+  if (dst_memory != dst_user &&
+      !ONNC_RUNTIME_mkldnn_add_reorder(context, primitive, dst_memory, dst_user)) {
+    ONNC_RUNTIME_mkldnn_destroy_primitive(context, primitive);
+    return NULL;
+  }
+  return primitive;
+}
 
+void ONNC_RUNTIME_conv_float(
+  void * restrict onnc_runtime_context
+  ,const float * restrict input_X
+  ,int32_t input_X_ndim, const int32_t * restrict input_X_dims
+  ,const float * restrict input_W
+  ,int32_t input_W_ndim, const int32_t * restrict input_W_dims
+  ,const float * restrict input_B
+  ,int32_t input_B_ndim, const int32_t * restrict input_B_dims
+  ,float * restrict output_Y
+  ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
+  ,const char * restrict auto_pad
+  ,int32_t * restrict dilations
+  ,int32_t number_of_dilations
+  ,int32_t group
+  ,int32_t * restrict kernel_shape
+  ,int32_t number_of_kernel_shape
+  ,int32_t * restrict pads
+  ,int32_t number_of_pads
+  ,int32_t * restrict strides
+  ,int32_t number_of_strides
+) {
+  MKLDNNContext *context = ONNC_RUNTIME_mkldnn_get_context(onnc_runtime_context);
+  if (context == NULL || input_X_ndim < 3 || input_X_ndim > 5) {
+    fprintf(stderr, "ONNC_RUNTIME_conv_float: unsupported convolution\n");
+    return;
+  }
+
+  // The shapes and the attributes select the cached convolution.
+  int ndims = input_X_ndim - 2;
+  bool has_bias = (input_B != NULL);
+  int64_t key[ONNC_RUNTIME_MKLDNN_MAX_KEY];
+  int32_t key_size = 0;
+  key[key_size++] = ONNC_RUNTIME_MKLDNN_CONV;
+  key[key_size++] = input_X_ndim;
+  key[key_size++] = group;
+  key[key_size++] = has_bias;
+  for (int i = 0; i < input_X_ndim; ++i) {
+    key[key_size++] = input_X_dims[i];
+    key[key_size++] = input_W_dims[i];
+    key[key_size++] = output_Y_dims[i];
+  }
+  for (int i = 0; i < ndims; ++i) {
+    key[key_size++] = dilations[i];
+    key[key_size++] = strides[i];
+    key[key_size++] = pads[i];
+    key[key_size++] = pads[i + ndims];
+  }
+
+  MKLDNNPrimitive *primitive =
+      ONNC_RUNTIME_mkldnn_find_primitive(context, key, key_size);
+  if (primitive == NULL) {
+    primitive = create_conv(context, key, key_size,
+                            input_X_ndim, input_X_dims, input_W_dims,
+                            has_bias, input_B_dims, output_Y_dims,
+                            dilations, group, pads, strides);
+    if (primitive == NULL) {
+      fprintf(stderr, "ONNC_RUNTIME_conv_float: can not create primitive\n");
+      return;
+    }
+  }
+
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, CONV_SRC_USER, input_X);
+  if (!ONNC_RUNTIME_mkldnn_set_weights(context, primitive, CONV_WEIGHTS_USER,
+                                       CONV_WEIGHTS, input_W)) {
+    fprintf(stderr, "ONNC_RUNTIME_conv_float: can not reorder weights\n");
+    return;
+  }
+  if (has_bias) {
+    ONNC_RUNTIME_mkldnn_set_handle(primitive, CONV_BIAS, input_B);
+  }
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, CONV_DST_USER, output_Y);
+  ONNC_RUNTIME_mkldnn_execute(context, primitive);
 }
@@ -0,0 +1,104 @@
+#include <onnc/Runtime/operatorMKLDNN/context.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ONNC_RUNTIME_relu_float ONNC_RUNTIME_relu_float_reference
+#include <onnc/Runtime/operator/relu.h>
+#undef ONNC_RUNTIME_relu_float
+
+#define ONNC_RUNTIME_sigmoid_float ONNC_RUNTIME_sigmoid_float_reference
+#include <onnc/Runtime/operator/sigmoid.h>
+#undef ONNC_RUNTIME_sigmoid_float
+
+#define ONNC_RUNTIME_tanh_float ONNC_RUNTIME_tanh_float_reference
+#include <onnc/Runtime/operator/tanh.h>
+#undef ONNC_RUNTIME_tanh_float
+
+// Run the eltwise operator on the tensor as a flat array.
+static bool run_eltwise(void * restrict onnc_runtime_context,
+                        mkldnn_alg_kind_t algorithm,
+                        const float * restrict input,
+                        int32_t ndim, const int32_t * restrict dims,
+                        float * restrict output) {
+  MKLDNNContext *context = ONNC_RUNTIME_mkldnn_get_context(onnc_runtime_context);
+  if (context == NULL) {
+    return false;
+  }
+
+  int32_t size = 1;
+  for (int32_t i = 0; i < ndim; ++i) {
+    size *= dims[i];
+  }
+
+  int64_t key[] = { ONNC_RUNTIME_MKLDNN_ELTWISE, algorithm, size };
+  int32_t key_size = sizeof(key) / sizeof(key[0]);
+  MKLDNNPrimitive *primitive =
+      ONNC_RUNTIME_mkldnn_find_primitive(context, key, key_size);
+  if (primitive == NULL) {
+    mkldnn_memory_desc_t md;
+    mkldnn_eltwise_desc_t desc;
+    if (!ONNC_RUNTIME_mkldnn_init_plain_desc(&md, 1, &size) ||
+        mkldnn_eltwise_forward_desc_init(&desc, mkldnn_forward_inference,
+                                         algorithm, &md, 0.f, 0.f) != mkldnn_success) {
+      return false;
+    }
+    primitive = ONNC_RUNTIME_mkldnn_create_unary(context, key, key_size,
+                                                 &desc, &md, &md);
+    if (primitive == NULL) {
+      return false;
+    }
+  }
+
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_SRC, input);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_DST, output);
+  ONNC_RUNTIME_mkldnn_execute(context, primitive);
+  return true;
+}
+
+void ONNC_RUNTIME_relu_float(
+  void * restrict onnc_runtime_context
+  ,const float * restrict input_X
+  ,int32_t input_X_ndim, const int32_t * restrict input_X_dims
+  ,float * restrict output_Y
+  ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
+) {
+  if (!run_eltwise(onnc_runtime_context, mkldnn_eltwise_relu,
+                   input_X, input_X_ndim, input_X_dims, output_Y)) {
+    ONNC_RUNTIME_relu_float_reference(onnc_runtime_context,
+                                      input_X, input_X_ndim, input_X_dims,
+                                      output_Y, output_Y_ndim, output_Y_dims);
+  }
+}
+
+void ONNC_RUNTIME_sigmoid_float(
+  void * restrict onnc_runtime_context
+  ,const float * restrict input_X
+  ,int32_t input_X_ndim, const int32_t * restrict input_X_dims
+  ,float * restrict output_Y
+  ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
+) {
+  if (!run_eltwise(onnc_runtime_context, mkldnn_eltwise_logistic,
+                   input_X, input_X_ndim, input_X_dims, output_Y)) {
+    ONNC_RUNTIME_sigmoid_float_reference(onnc_runtime_context,
+                                         input_X, input_X_ndim, input_X_dims,
+                                         output_Y, output_Y_ndim, output_Y_dims);
+  }
+}
+
+void ONNC_RUNTIME_tanh_float(
+  void * restrict onnc_runtime_context
+  ,const float * restrict input_input
+  ,int32_t input_input_ndim, const int32_t * restrict input_input_dims
+  ,float * restrict output_output
+  ,int32_t output_output_ndim, const int32_t * restrict output_output_dims
+) {
+  if (!run_eltwise(onnc_runtime_context, mkldnn_eltwise_tanh,
+                   input_input, input_input_ndim, input_input_dims,
+                   output_output)) {
+    ONNC_RUNTIME_tanh_float_reference(onnc_runtime_context,
+                                      input_input, input_input_ndim,
+                                      input_input_dims, output_output,
+                                      output_output_ndim, output_output_dims);
+  }
+}
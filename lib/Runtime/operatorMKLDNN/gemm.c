@@ -1,9 +1,88 @@
 #include <onnc/Runtime/operatorMKLDNN/gemm.h>
+#include <onnc/Runtime/operatorMKLDNN/context.h>
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
 
-mkldnn_engine_t engine;
-mkldnn_stream_t stream;
+// memory slots of a cached inner product
+enum {
+  IP_SRC = ONNC_RUNTIME_MKLDNN_UNARY_SRC,
+  IP_DST = ONNC_RUNTIME_MKLDNN_UNARY_DST,
+  IP_WEIGHTS_USER = ONNC_RUNTIME_MKLDNN_UNARY_SLOTS,
+  IP_WEIGHTS,
+  IP_BIAS
+};
+
+// A fully connected layer, Y = A * B^T + C with C of shape (N), runs as an
+// inner product, which keeps B reordered in the layout MKL-DNN prefers.
+static bool run_inner_product(void* restrict context,
+    const float* restrict A, const int32_t* restrict Ashape,
+    const float* restrict B, const int32_t* restrict Bshape,
+    const float* restrict C, float* restrict Y)
+{
+  MKLDNNContext *mkldnn = ONNC_RUNTIME_mkldnn_get_context(context);
+  if (mkldnn == NULL) {
+    return false;
+  }
+
+  int32_t M = Ashape[0], K = Ashape[1], N = Bshape[0];
+  int64_t key[] = { ONNC_RUNTIME_MKLDNN_INNER_PRODUCT, M, K, N };
+  int32_t key_size = sizeof(key) / sizeof(key[0]);
+  MKLDNNPrimitive *primitive =
+      ONNC_RUNTIME_mkldnn_find_primitive(mkldnn, key, key_size);
+  if (primitive == NULL) {
+    int32_t dst_dims[2] = { M, N };
+    mkldnn_memory_desc_t src_md, weight_desc, weight_any, bias_md, dst_md;
+    mkldnn_dim_t weight_dims[2] = { N, K };
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&src_md, 2, Ashape);
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&weight_desc, 2, Bshape);
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&bias_md, 1, &N);
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&dst_md, 2, dst_dims);
+    mkldnn_memory_desc_init_by_tag(&weight_any, 2, weight_dims, mkldnn_f32,
+                                   mkldnn_format_tag_any);
+
+    mkldnn_inner_product_desc_t desc;
+    if (mkldnn_inner_product_forward_desc_init(&desc, mkldnn_forward_inference,
+                                               &src_md, &weight_any, &bias_md,
+                                               &dst_md) != mkldnn_success) {
+      return false;
+    }
+    primitive = ONNC_RUNTIME_mkldnn_create_unary(mkldnn, key, key_size,
+                                                 &desc, &src_md, &dst_md);
+    if (primitive == NULL) {
+      return false;
+    }
+
+    mkldnn_primitive_desc_t pd;
+    mkldnn_primitive_desc_create(&pd, &desc, NULL, mkldnn->engine, NULL);
+    const mkldnn_memory_desc_t *weight_md =
+        mkldnn_primitive_desc_query_md(pd, mkldnn_query_weights_md, 0);
+    mkldnn_memory_t weight_memory = ONNC_RUNTIME_mkldnn_create_memory(
+        mkldnn, primitive, IP_WEIGHTS_USER, &weight_desc, false);
+    if (!mkldnn_memory_desc_equal(weight_md, &weight_desc)) {
+      weight_memory = ONNC_RUNTIME_mkldnn_create_memory(
+          mkldnn, primitive, IP_WEIGHTS, weight_md, false);
+    }
+    mkldnn_primitive_desc_destroy(pd);
+
+    MKLDNNStep *step = &primitive->steps[0];
+    ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_WEIGHTS, weight_memory);
+    ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_BIAS,
+        ONNC_RUNTIME_mkldnn_create_memory(mkldnn, primitive, IP_BIAS,
+                                          &bias_md, false));
+  }
+
+  if (!ONNC_RUNTIME_mkldnn_set_weights(mkldnn, primitive, IP_WEIGHTS_USER,
+                                       IP_WEIGHTS, B)) {
+    return false;
+  }
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, IP_SRC, A);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, IP_BIAS, C);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, IP_DST, Y);
+  ONNC_RUNTIME_mkldnn_execute(mkldnn, primitive);
+  return true;
+}
 
 void ONNC_RUNTIME_gemm_float(void* restrict context,
     const float* restrict A, int32_t Adim, const int32_t* restrict Ashape,
@@ -12,9 +91,13 @@ void ONNC_RUNTIME_gemm_float(void* restrict context,
     float* restrict Y, int32_t Ydim, const int32_t* restrict Yshape,
     float alpha, float beta, int32_t transA, int32_t transB)
 {
-  mkldnn_engine_create(&engine, mkldnn_cpu, 0);
-  mkldnn_stream_create(&stream, engine, mkldnn_stream_default_flags); 
+  if (Adim == 2 && Bdim == 2 && !transA && transB && alpha == 1.f &&
+      beta == 1.f && C != NULL && Cdim == 1 && Cshape[0] == Bshape[0] &&
+      run_inner_product(context, A, Ashape, B, Bshape, C, Y)) {
+    return;
+  }
 
+  // mkldnn_sgemm runs without an engine or a stream.
   mkldnn_dim_t M = Yshape[0];
   mkldnn_dim_t N = Yshape[1];
   mkldnn_dim_t K = Yshape[0]+Ashape[1]-M;
@@ -30,6 +113,4 @@ void ONNC_RUNTIME_gemm_float(void* restrict context,
     }
   }
   mkldnn_sgemm( (transA?'T':'N'),(transB?'T':'N'), M, N, K, alpha, A, (transA?M:K), B, (transB?K:M), beta, Y, N);
-  mkldnn_stream_destroy(stream);
-  mkldnn_engine_destroy(engine);
 }
@@ -0,0 +1,62 @@
+#include <onnc/Runtime/operatorMKLDNN/context.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ONNC_RUNTIME_lrn_float ONNC_RUNTIME_lrn_float_reference
+#include <onnc/Runtime/operator/lrn.h>
+#undef ONNC_RUNTIME_lrn_float
+
+void ONNC_RUNTIME_lrn_float(
+  void * restrict onnc_runtime_context
+  ,const float * restrict input_X
+  ,int32_t input_X_ndim, const int32_t * restrict input_X_dims
+  ,float * restrict output_Y
+  ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
+  ,float alpha
+  ,float beta
+  ,float bias
+  ,int32_t size
+) {
+  MKLDNNContext *context = ONNC_RUNTIME_mkldnn_get_context(onnc_runtime_context);
+  MKLDNNPrimitive *primitive = NULL;
+  if (context != NULL && input_X_ndim <= ONNC_RUNTIME_MKLDNN_MAX_NDIM) {
+    int64_t key[ONNC_RUNTIME_MKLDNN_MAX_KEY];
+    int32_t key_size = 0;
+    key[key_size++] = ONNC_RUNTIME_MKLDNN_LRN;
+    key[key_size++] = size;
+    key[key_size++] = ONNC_RUNTIME_mkldnn_float_key(alpha);
+    key[key_size++] = ONNC_RUNTIME_mkldnn_float_key(beta);
+    key[key_size++] = ONNC_RUNTIME_mkldnn_float_key(bias);
+    key[key_size++] = input_X_ndim;
+    for (int32_t i = 0; i < input_X_ndim; ++i) {
+      key[key_size++] = input_X_dims[i];
+    }
+
+    primitive = ONNC_RUNTIME_mkldnn_find_primitive(context, key, key_size);
+    if (primitive == NULL) {
+      // Like ONNX, MKL-DNN divides alpha by the size of the window.
+      mkldnn_memory_desc_t md;
+      mkldnn_lrn_desc_t desc;
+      if (ONNC_RUNTIME_mkldnn_init_plain_desc(&md, input_X_ndim, input_X_dims) &&
+          mkldnn_lrn_forward_desc_init(&desc, mkldnn_forward_inference,
+                                       mkldnn_lrn_across_channels, &md, size,
+                                       alpha, beta, bias) == mkldnn_success) {
+        primitive = ONNC_RUNTIME_mkldnn_create_unary(context, key, key_size,
+                                                     &desc, &md, &md);
+      }
+    }
+  }
+
+  if (primitive == NULL) {
+    ONNC_RUNTIME_lrn_float_reference(onnc_runtime_context,
+                                     input_X, input_X_ndim, input_X_dims,
+                                     output_Y, output_Y_ndim, output_Y_dims,
+                                     alpha, beta, bias, size);
+    return;
+  }
+
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_SRC, input_X);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_DST, output_Y);
+  ONNC_RUNTIME_mkldnn_execute(context, primitive);
+}
@@ -0,0 +1,151 @@
+#include <onnc/Runtime/operatorMKLDNN/context.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ONNC_RUNTIME_maxpool_float ONNC_RUNTIME_maxpool_float_reference
+#include <onnc/Runtime/operator/maxpool.h>
+#undef ONNC_RUNTIME_maxpool_float
+
+#define ONNC_RUNTIME_averagepool_float ONNC_RUNTIME_averagepool_float_reference
+#include <onnc/Runtime/operator/averagepool.h>
+#undef ONNC_RUNTIME_averagepool_float
+
+// MKL-DNN pools 2D and 3D tensors.
+static bool run_pooling(void * restrict onnc_runtime_context,
+                        int64_t kind, mkldnn_alg_kind_t algorithm,
+                        const float * restrict input_X,
+                        int32_t input_X_ndim, const int32_t * restrict input_X_dims,
+                        float * restrict output_Y,
+                        const int32_t * restrict output_Y_dims,
+                        const int32_t * restrict kernel_shape,
+                        const int32_t * restrict pads,
+                        const int32_t * restrict strides) {
+  if (input_X_ndim != 4 && input_X_ndim != 5) {
+    return false;
+  }
+
+  MKLDNNContext *context = ONNC_RUNTIME_mkldnn_get_context(onnc_runtime_context);
+  if (context == NULL) {
+    return false;
+  }
+
+  int32_t ndims = input_X_ndim - 2;
+  int64_t key[ONNC_RUNTIME_MKLDNN_MAX_KEY];
+  int32_t key_size = 0;
+  key[key_size++] = kind;
+  key[key_size++] = algorithm;
+  key[key_size++] = input_X_ndim;
+  for (int32_t i = 0; i < input_X_ndim; ++i) {
+    key[key_size++] = input_X_dims[i];
+    key[key_size++] = output_Y_dims[i];
+  }
+  for (int32_t i = 0; i < ndims; ++i) {
+    key[key_size++] = kernel_shape[i];
+    key[key_size++] = strides[i];
+    key[key_size++] = pads[i];
+    key[key_size++] = pads[i + ndims];
+  }
+
+  MKLDNNPrimitive *primitive =
+      ONNC_RUNTIME_mkldnn_find_primitive(context, key, key_size);
+  if (primitive == NULL) {
+    mkldnn_memory_desc_t src_md, dst_md;
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&src_md, input_X_ndim, input_X_dims);
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&dst_md, input_X_ndim, output_Y_dims);
+
+    mkldnn_dim_t kernel_dim[3], strides_dim[3], padding_l_dim[3], padding_r_dim[3];
+    for (int32_t i = 0; i < ndims; ++i) {
+      kernel_dim[i] = kernel_shape[i];
+      strides_dim[i] = strides[i];
+      padding_l_dim[i] = pads[i];
+      padding_r_dim[i] = pads[i + ndims];
+    }
+
+    mkldnn_pooling_desc_t desc;
+    if (mkldnn_pooling_forward_desc_init(&desc, mkldnn_forward_inference,
+                                         algorithm, &src_md, &dst_md,
+                                         strides_dim, kernel_dim,
+                                         padding_l_dim, padding_r_dim) != mkldnn_success) {
+      return false;
+    }
+    primitive = ONNC_RUNTIME_mkldnn_create_unary(context, key, key_size,
+                                                 &desc, &src_md, &dst_md);
+    if (primitive == NULL) {
+      return false;
+    }
+  }
+
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_SRC, input_X);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_DST, output_Y);
+  ONNC_RUNTIME_mkldnn_execute(context, primitive);
+  return true;
+}
+
+void ONNC_RUNTIME_maxpool_float(
+  void * restrict onnc_runtime_context
+  ,const float * restrict input_X
+  ,int32_t input_X_ndim, const int32_t * restrict input_X_dims
+  ,float * restrict output_Y
+  ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
+  ,float * restrict output_Indices
+  ,int32_t output_Indices_ndim, const int32_t * restrict output_Indices_dims
+  ,const char * restrict auto_pad
+  ,int32_t * restrict kernel_shape
+  ,int32_t number_of_kernel_shape
+  ,int32_t * restrict pads
+  ,int32_t number_of_pads
+  ,int32_t storage_order
+  ,int32_t * restrict strides
+  ,int32_t number_of_strides
+) {
+  // MKL-DNN does not give the indices.
+  if (output_Indices == NULL &&
+      run_pooling(onnc_runtime_context, ONNC_RUNTIME_MKLDNN_MAXPOOL,
+                  mkldnn_pooling_max, input_X, input_X_ndim, input_X_dims,
+                  output_Y, output_Y_dims, kernel_shape, pads, strides)) {
+    return;
+  }
+
+  ONNC_RUNTIME_maxpool_float_reference(onnc_runtime_context,
+                                       input_X, input_X_ndim, input_X_dims,
+                                       output_Y, output_Y_ndim, output_Y_dims,
+                                       output_Indices, output_Indices_ndim,
+                                       output_Indices_dims, auto_pad,
+                                       kernel_shape, number_of_kernel_shape,
+                                       pads, number_of_pads, storage_order,
+                                       strides, number_of_strides);
+}
+
+void ONNC_RUNTIME_averagepool_float(
+  void * restrict onnc_runtime_context
+  ,const float * restrict input_X
+  ,int32_t input_X_ndim, const int32_t * restrict input_X_dims
+  ,float * restrict output_Y
+  ,int32_t output_Y_ndim, const int32_t * restrict output_Y_dims
+  ,const char * restrict auto_pad
+  ,int32_t count_include_pad
+  ,int32_t * restrict kernel_shape
+  ,int32_t number_of_kernel_shape
+  ,int32_t * restrict pads
+  ,int32_t number_of_pads
+  ,int32_t * restrict strides
+  ,int32_t number_of_strides
+) {
+  mkldnn_alg_kind_t algorithm = count_include_pad
+                                    ? mkldnn_pooling_avg_include_padding
+                                    : mkldnn_pooling_avg_exclude_padding;
+  if (run_pooling(onnc_runtime_context, ONNC_RUNTIME_MKLDNN_AVERAGEPOOL,
+                  algorithm, input_X, input_X_ndim, input_X_dims,
+                  output_Y, output_Y_dims, kernel_shape, pads, strides)) {
+    return;
+  }
+
+  ONNC_RUNTIME_averagepool_float_reference(onnc_runtime_context,
+                                           input_X, input_X_ndim, input_X_dims,
+                                           output_Y, output_Y_ndim, output_Y_dims,
+                                           auto_pad, count_include_pad,
+                                           kernel_shape, number_of_kernel_shape,
+                                           pads, number_of_pads,
+                                           strides, number_of_strides);
+}
@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_averagepool_float ONNC_RUNTIME_averagepool_float_reference
+#include "../../operator/averagepool.c"
+// vim: ft=c
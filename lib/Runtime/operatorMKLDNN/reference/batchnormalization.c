@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_batchnormalization_float ONNC_RUNTIME_batchnormalization_float_reference
+#include "../../operator/batchnormalization.c"
+// vim: ft=c
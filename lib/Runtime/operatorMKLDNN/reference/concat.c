@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_concat_float ONNC_RUNTIME_concat_float_reference
+#include "../../operator/concat.c"
+// vim: ft=c
@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_lrn_float ONNC_RUNTIME_lrn_float_reference
+#include "../../operator/lrn.c"
+// vim: ft=c
@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_maxpool_float ONNC_RUNTIME_maxpool_float_reference
+#include "../../operator/maxpool.c"
+// vim: ft=c
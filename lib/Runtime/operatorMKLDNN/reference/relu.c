@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_relu_float ONNC_RUNTIME_relu_float_reference
+#include "../../operator/relu.c"
+// vim: ft=c
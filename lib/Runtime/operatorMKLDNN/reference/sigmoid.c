@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_sigmoid_float ONNC_RUNTIME_sigmoid_float_reference
+#include "../../operator/sigmoid.c"
+// vim: ft=c
@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_softmax_float ONNC_RUNTIME_softmax_float_reference
+#include "../../operator/softmax.c"
+// vim: ft=c
@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_sum_float ONNC_RUNTIME_sum_float_reference
+#include "../../operator/sum.c"
+// vim: ft=c
@@ -0,0 +1,4 @@
+/* The reference kernel, which the MKL-DNN kernel falls back to */
+#define ONNC_RUNTIME_tanh_float ONNC_RUNTIME_tanh_float_reference
+#include "../../operator/tanh.c"
+// vim: ft=c
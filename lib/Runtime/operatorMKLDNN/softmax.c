@@ -0,0 +1,54 @@
+#include <onnc/Runtime/operatorMKLDNN/context.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ONNC_RUNTIME_softmax_float ONNC_RUNTIME_softmax_float_reference
+#include <onnc/Runtime/operator/softmax.h>
+#undef ONNC_RUNTIME_softmax_float
+
+void ONNC_RUNTIME_softmax_float(
+  void * restrict onnc_runtime_context
+  ,const float * restrict input_input
+  ,int32_t input_input_ndim, const int32_t * restrict input_input_dims
+  ,float * restrict output_output
+  ,int32_t output_output_ndim, const int32_t * restrict output_output_dims
+  ,int32_t axis
+) {
+  // ONNX coerces the input into a 2D tensor at the axis.
+  int32_t dims[2] = { 1, 1 };
+  for (int32_t i = 0; i < input_input_ndim; ++i) {
+    dims[i < axis ? 0 : 1] *= input_input_dims[i];
+  }
+
+  MKLDNNContext *context = ONNC_RUNTIME_mkldnn_get_context(onnc_runtime_context);
+  MKLDNNPrimitive *primitive = NULL;
+  if (context != NULL) {
+    int64_t key[] = { ONNC_RUNTIME_MKLDNN_SOFTMAX, dims[0], dims[1] };
+    int32_t key_size = sizeof(key) / sizeof(key[0]);
+    primitive = ONNC_RUNTIME_mkldnn_find_primitive(context, key, key_size);
+    if (primitive == NULL) {
+      mkldnn_memory_desc_t md;
+      mkldnn_softmax_desc_t desc;
+      if (ONNC_RUNTIME_mkldnn_init_plain_desc(&md, 2, dims) &&
+          mkldnn_softmax_forward_desc_init(&desc, mkldnn_forward_inference,
+                                           &md, 1) == mkldnn_success) {
+        primitive = ONNC_RUNTIME_mkldnn_create_unary(context, key, key_size,
+                                                     &desc, &md, &md);
+      }
+    }
+  }
+
+  if (primitive == NULL) {
+    ONNC_RUNTIME_softmax_float_reference(onnc_runtime_context,
+                                         input_input, input_input_ndim,
+                                         input_input_dims, output_output,
+                                         output_output_ndim, output_output_dims,
+                                         axis);
+    return;
+  }
+
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_SRC, input_input);
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, ONNC_RUNTIME_MKLDNN_UNARY_DST, output_output);
+  ONNC_RUNTIME_mkldnn_execute(context, primitive);
+}
@@ -0,0 +1,114 @@
+#include <onnc/Runtime/operatorMKLDNN/context.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ONNC_RUNTIME_sum_float ONNC_RUNTIME_sum_float_reference
+#include <onnc/Runtime/operator/sum.h>
+#undef ONNC_RUNTIME_sum_float
+
+// at most one argument of a step is the destination
+#define MAX_INPUTS (ONNC_RUNTIME_MKLDNN_MAX_ARGS - 1)
+
+// Sum of inputs of the shape of the output, without broadcasting.
+static bool run_sum(void * restrict onnc_runtime_context,
+                    const float * const * restrict input_data_0,
+                    int32_t input_data_0_ntensor,
+                    const int32_t * input_data_0_ndim,
+                    const int32_t * const * restrict input_data_0_dims,
+                    float * restrict output_sum,
+                    int32_t output_sum_ndim,
+                    const int32_t * restrict output_sum_dims) {
+  if (input_data_0_ntensor < 1 || input_data_0_ntensor > MAX_INPUTS) {
+    return false;
+  }
+  for (int32_t t = 0; t < input_data_0_ntensor; ++t) {
+    if (input_data_0_ndim[t] != output_sum_ndim) {
+      return false;
+    }
+    for (int32_t i = 0; i < output_sum_ndim; ++i) {
+      if (input_data_0_dims[t][i] != output_sum_dims[i]) {
+        return false;
+      }
+    }
+  }
+
+  MKLDNNContext *context = ONNC_RUNTIME_mkldnn_get_context(onnc_runtime_context);
+  if (context == NULL) {
+    return false;
+  }
+
+  int32_t size = 1;
+  for (int32_t i = 0; i < output_sum_ndim; ++i) {
+    size *= output_sum_dims[i];
+  }
+
+  int64_t key[] = { ONNC_RUNTIME_MKLDNN_SUM, input_data_0_ntensor, size };
+  int32_t key_size = sizeof(key) / sizeof(key[0]);
+  MKLDNNPrimitive *primitive =
+      ONNC_RUNTIME_mkldnn_find_primitive(context, key, key_size);
+  if (primitive == NULL) {
+    mkldnn_memory_desc_t md;
+    mkldnn_memory_desc_t src_mds[MAX_INPUTS];
+    float scales[MAX_INPUTS];
+    ONNC_RUNTIME_mkldnn_init_plain_desc(&md, 1, &size);
+    for (int32_t t = 0; t < input_data_0_ntensor; ++t) {
+      src_mds[t] = md;
+      scales[t] = 1.f;
+    }
+
+    mkldnn_primitive_desc_t pd;
+    if (mkldnn_sum_primitive_desc_create(&pd, &md, input_data_0_ntensor,
+                                         scales, src_mds, NULL,
+                                         context->engine) != mkldnn_success) {
+      return false;
+    }
+    primitive = ONNC_RUNTIME_mkldnn_create_primitive(context, key, key_size);
+    if (primitive == NULL) {
+      mkldnn_primitive_desc_destroy(pd);
+      return false;
+    }
+    MKLDNNStep *step = ONNC_RUNTIME_mkldnn_add_step(primitive, pd);
+    mkldnn_primitive_desc_destroy(pd);
+    if (step == NULL) {
+      ONNC_RUNTIME_mkldnn_destroy_primitive(context, primitive);
+      return false;
+    }
+
+    // slot t is the input t, the last slot is the output
+    for (int32_t t = 0; t < input_data_0_ntensor; ++t) {
+      ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_MULTIPLE_SRC + t,
+          ONNC_RUNTIME_mkldnn_create_memory(context, primitive, t, &md, false));
+    }
+    ONNC_RUNTIME_mkldnn_add_arg(step, MKLDNN_ARG_DST,
+        ONNC_RUNTIME_mkldnn_create_memory(context, primitive, MAX_INPUTS,
+                                          &md, false));
+  }
+
+  for (int32_t t = 0; t < input_data_0_ntensor; ++t) {
+    ONNC_RUNTIME_mkldnn_set_handle(primitive, t, input_data_0[t]);
+  }
+  ONNC_RUNTIME_mkldnn_set_handle(primitive, MAX_INPUTS, output_sum);
+  ONNC_RUNTIME_mkldnn_execute(context, primitive);
+  return true;
+}
+
+void ONNC_RUNTIME_sum_float(
+  void * restrict onnc_runtime_context
+  ,const float * const * restrict input_data_0
+  ,int32_t input_data_0_ntensor
+  ,const int32_t * input_data_0_ndim, const int32_t * const * restrict input_data_0_dims
+  ,float * restrict output_sum
+  ,int32_t output_sum_ndim, const int32_t * restrict output_sum_dims
+) {
+  if (run_sum(onnc_runtime_context, input_data_0, input_data_0_ntensor,
+              input_data_0_ndim, input_data_0_dims,
+              output_sum, output_sum_ndim, output_sum_dims)) {
+    return;
+  }
+
+  ONNC_RUNTIME_sum_float_reference(onnc_runtime_context,
+                                   input_data_0, input_data_0_ntensor,
+                                   input_data_0_ndim, input_data_0_dims,
+                                   output_sum, output_sum_ndim, output_sum_dims);
+}
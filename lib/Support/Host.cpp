@@ -9,6 +9,11 @@
 #include <onnc/Config/Config.h>
 #include <onnc/IR/Quadruple.h>
 
+#include <cstdio>
+#if defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
 using namespace onnc;
 
 //===----------------------------------------------------------------------===//
@@ -21,3 +26,22 @@ std::string onnc::sys::GetHostQuadruple()
   quadruple.canonical(result);
   return result;
 }
+
+long onnc::sys::GetResidentSetSize()
+{
+#if defined(__linux__) && defined(HAVE_UNISTD_H)
+  // the second field of statm is the number of resident pages.
+  FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (nullptr == statm)
+    return 0;
+
+  long size = 0, resident = 0;
+  int matched = std::fscanf(statm, "%ld %ld", &size, &resident);
+  std::fclose(statm);
+  if (2 != matched)
+    return 0;
+  return resident * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
@@ -63,7 +63,7 @@
 #include <onnc/Transforms/TensorSel/Standards/GlobalLpPoolLower.h>
 #include <onnc/Transforms/TensorSel/Standards/GlobalMaxPoolLower.h>
 #include <onnc/Transforms/TensorSel/Standards/GreaterLower.h>
-// TODO: #include <onnc/Transforms/TensorSel/Standards/GruLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GRULower.h>
 // TODO: #include <onnc/Transforms/TensorSel/Standards/GruUnitLower.h>
 #include <onnc/Transforms/TensorSel/Standards/HardSigmoidLower.h>
 #include <onnc/Transforms/TensorSel/Standards/HardmaxLower.h>
@@ -79,7 +79,7 @@
 #include <onnc/Transforms/TensorSel/Standards/LRNLower.h>
 #include <onnc/Transforms/TensorSel/Standards/LpNormalizationLower.h>
 #include <onnc/Transforms/TensorSel/Standards/LpPoolLower.h>
-// TODO: #include <onnc/Transforms/TensorSel/Standards/LSTMLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LSTMLower.h>
 #include <onnc/Transforms/TensorSel/Standards/MatMulLower.h>
 #include <onnc/Transforms/TensorSel/Standards/MaxLower.h>
 #include <onnc/Transforms/TensorSel/Standards/MaxPoolLower.h>
@@ -113,7 +113,7 @@
 #include <onnc/Transforms/TensorSel/Standards/ReduceSumSquareLower.h>
 #include <onnc/Transforms/TensorSel/Standards/ReluLower.h>
 #include <onnc/Transforms/TensorSel/Standards/ReshapeLower.h>
-// TODO: #include <onnc/Transforms/TensorSel/Standards/RnnLower.h>
+#include <onnc/Transforms/TensorSel/Standards/RNNLower.h>
 #include <onnc/Transforms/TensorSel/Standards/ScaleLower.h>
 #include <onnc/Transforms/TensorSel/Standards/ScaledTanhLower.h>
 // TODO: #include <onnc/Transforms/TensorSel/Standards/ScanLower.h>
@@ -175,6 +175,16 @@ void CLangBackend::addTensorSel(PassManager& pPM)
   // adds your ONNC IR operators.
 }
 
+void CLangBackend::addOnncIrOptimization(PassManager& pPM, OptimizationOptions& options)
+{
+  // Merge duplicated nodes and weights before LiveIntervals, so that they
+  // take no buffer and are emitted once.
+  options.defaultEnable(OptimizationOption::eliminate_common_subexpression);
+  options.defaultEnable(OptimizationOption::eliminate_duplicate_initializer);
+
+  TargetBackend::addOnncIrOptimization(pPM, options);
+}
+
 void CLangBackend::addTensorSched(PassManager& pPM)
 {
   // After method AddTensorSel, operators have been scheduled in an
@@ -247,7 +257,7 @@ void CLangBackend::RegisterLowers(LowerRegistry& pRegistry) const
   pRegistry.emplace<GlobalLpPoolLower>();
   pRegistry.emplace<GlobalMaxPoolLower>();
   pRegistry.emplace<GreaterLower>();
-  // TODO: pRegistry.emplace<GruLower>();
+  pRegistry.emplace<GRULower>();
   // TODO: pRegistry.emplace<GruUnitLower>();
   pRegistry.emplace<HardmaxLower>();
   pRegistry.emplace<HardSigmoidLower>();
@@ -263,7 +273,7 @@ void CLangBackend::RegisterLowers(LowerRegistry& pRegistry) const
   pRegistry.emplace<LpNormalizationLower>();
   pRegistry.emplace<LpPoolLower>();
   pRegistry.emplace<LRNLower>();
-  // TODO: pRegistry.emplace<LSTMLower>();
+  pRegistry.emplace<LSTMLower>();
   pRegistry.emplace<MatMulLower>();
   pRegistry.emplace<MaxLower>();
   pRegistry.emplace<MaxPoolLower>();
@@ -297,7 +307,7 @@ void CLangBackend::RegisterLowers(LowerRegistry& pRegistry) const
   pRegistry.emplace<ReduceSumSquareLower>();
   pRegistry.emplace<ReluLower>();
   pRegistry.emplace<ReshapeLower>();
-  // TODO: pRegistry.emplace<RNNLower>();
+  pRegistry.emplace<RNNLower>();
   pRegistry.emplace<ScaleLower>();
   pRegistry.emplace<ScaledTanhLower>();
   // TODO: pRegistry.emplace<ScanLower>();
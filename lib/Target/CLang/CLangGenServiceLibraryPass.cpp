@@ -6,6 +6,7 @@
 #include <onnc/ADT/StringRef.h>
 #include <onnc/IR/Module.h>
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <iostream>
@@ -46,11 +47,78 @@ CLangGenServiceLibraryPass::ReturnType CLangGenServiceLibraryPass::runOnModule(M
   addIncludeDirectives(file);
   addMacroDefinitions(file);
   removeMacroDefinitions(file);
+  addModelPrepareDefinition(file);
   addModelMainDefinition(file, module);
 
   return kModuleNoChanged;
 }
 
+void CLangGenServiceLibraryPass::addModelPrepareDefinition(stream_type& stream)
+{
+  using namespace internal;
+
+  // The prepared model owns the runtime the operators share, so they can
+  // reuse the data they derive from the weights, e.g. the reordered MKL-DNN
+  // weights, and the 16-bit weights are widened once. The caller keeps it in
+  // ONNC_RUNTIME_inference_context::model across model_main() calls.
+  const auto numOfWeights = meta.packedWeightMemoryBlocks.size();
+  stream << "struct ONNC_RUNTIME_model\n";
+  stream << "{\n";
+  stream << "  void* runtime;\n";
+  stream << "  float* weights[" << std::max<std::size_t>(numOfWeights, 1) << "];\n";
+  stream << "};\n\n";
+
+  stream << "void model_release(struct ONNC_RUNTIME_model* model)\n";
+  stream << "{\n";
+
+  constexpr const Indent indent{1};
+  stream << indent << "if (model == NULL) {\n";
+  stream << indent + 1 << "return;\n";
+  stream << indent << "}\n\n";
+  stream << indent << "ONNC_RUNTIME_shutdown_runtime(model->runtime);\n";
+  stream << indent << "free(model);\n"
+         << "}\n\n";
+
+  stream << "struct ONNC_RUNTIME_model* model_prepare(struct ONNC_RUNTIME_tensor_file* weight)\n";
+  stream << "{\n";
+  stream << indent << "struct ONNC_RUNTIME_model* const model = calloc(1, sizeof(struct ONNC_RUNTIME_model));\n";
+  stream << indent << "if (model == NULL) {\n";
+  stream << indent + 1 << "return NULL;\n";
+  stream << indent << "}\n\n";
+
+  stream << indent << "model->runtime = ONNC_RUNTIME_init_runtime();\n";
+  stream << indent << "if (model->runtime == NULL) {\n";
+  stream << indent + 1 << "model_release(model);\n";
+  stream << indent + 1 << "return NULL;\n";
+  stream << indent << "}\n\n";
+
+  stream << indent << "for (uint64_t i = 0; i < " << numOfWeights << "; ++i) {\n";
+  stream << indent + 1 << "model->weights[i] = ONNC_RUNTIME_read_tensor(weight, i).data;\n";
+  stream << indent << "}\n";
+
+  // the weight file keeps 16-bit floats, but the kernels read float.
+  for (std::size_t idx = 0; idx < numOfWeights; ++idx) {
+    const auto kind = meta.packedWeightMemoryBlocks[idx].first->kind();
+    if (kind != Value::kFloat16 && kind != Value::kBFloat16) {
+      continue;
+    }
+    stream << indent << "model->weights[" << idx << "] = "
+           << (kind == Value::kFloat16 ? "ONNC_RUNTIME_widen_float16" : "ONNC_RUNTIME_widen_bfloat16")
+           << "(model->runtime, ONNC_RUNTIME_read_tensor(weight, " << idx << "));\n";
+    stream << indent << "if (model->weights[" << idx << "] == NULL) {\n";
+    stream << indent + 1 << "model_release(model);\n";
+    stream << indent + 1 << "return NULL;\n";
+    stream << indent << "}\n";
+  }
+
+  // a weight which is not recorded is only read as it is
+  stream << indent << "for (uint64_t i = 0; i < " << numOfWeights << "; ++i) {\n";
+  stream << indent + 1 << "ONNC_RUNTIME_add_constant(model->runtime, model->weights[i]);\n";
+  stream << indent << "}\n";
+  stream << indent << "return model;\n"
+         << "}\n\n";
+}
+
 void CLangGenServiceLibraryPass::addModelMainDefinition(std::ostream& stream, const Module& module)
 {
   using namespace internal;
@@ -62,15 +130,39 @@ void CLangGenServiceLibraryPass::addModelMainDefinition(std::ostream& stream, co
 
   constexpr const Indent indent{1};
 
+  // without a prepared model, prepare one for this call only
+  const identifier_type model = "model";
+  stream << indent << "struct ONNC_RUNTIME_model* const " << model << " =\n";
+  stream << indent + 1 << context << "->model != NULL ? " << context << "->model : model_prepare(" << context
+         << "->weight);\n";
+  stream << indent << "if (" << model << " == NULL) {\n";
+  stream << indent + 1 << "return -1;\n";
+  stream << indent << "}\n\n";
+
   // allocate internal memory
-  const identifier_type memory = "memory";
-  stream << indent << "char * const " << memory << " = calloc(" << getInternalMemorySize() << ", 1);\n";
+  const identifier_type memory       = "memory";
+  const auto            internalSize  = getInternalMemorySize();
+  stream << indent << "char * const " << memory << " = calloc(" << internalSize << ", 1);\n";
+  if (internalSize != 0) {
+    stream << indent << "if (" << memory << " == NULL) {\n";
+    stream << indent + 1 << "if (" << model << " != " << context << "->model) {\n";
+    stream << indent + 2 << "model_release(" << model << ");\n";
+    stream << indent + 1 << "}\n";
+    stream << indent + 1 << "return -1;\n";
+    stream << indent << "}\n";
+  }
+
+  const identifier_type runtime = "runtime";
+  stream << indent << "void * const " << runtime << " = " << model << "->runtime;\n";
 
-  CLangOperatorInvokeVisitor visitor{meta, stream, indent, memory, context};
+  CLangOperatorInvokeVisitor visitor{meta, stream, indent, memory, context, runtime, model + "->weights"};
   visitor.visit(module);
 
   // release internal memory
   stream << indent << "free(" << memory << ");\n";
+  stream << indent << "if (" << model << " != " << context << "->model) {\n";
+  stream << indent + 1 << "model_release(" << model << ");\n";
+  stream << indent << "}\n";
   stream << indent << "return 0;\n"
          << "}\n";
 }
@@ -26,6 +26,7 @@ public:
   ~CLangGenServiceLibraryPass()                                       = default;
 
   ReturnType runOnModule(Module& module) override;
+  void       addModelPrepareDefinition(stream_type& stream);
   void       addModelMainDefinition(stream_type& stream, const Module& module);
 
 private:
@@ -27,6 +27,15 @@ CLangGenWeightFilePass::ReturnType CLangGenWeightFilePass::runOnModule(Module& m
       const auto& int64Tensor = static_cast<const Int64Tensor&>(tensor);
       return reinterpret_cast<result_type>(int64Tensor.getValues().data());
     }
+    // the runtime widens 16-bit floats when it loads them.
+    case Value::kFloat16: {
+      const auto& float16Tensor = static_cast<const Float16Tensor&>(tensor);
+      return reinterpret_cast<result_type>(float16Tensor.getValues().data());
+    }
+    case Value::kBFloat16: {
+      const auto& bfloat16Tensor = static_cast<const BFloat16Tensor&>(tensor);
+      return reinterpret_cast<result_type>(bfloat16Tensor.getValues().data());
+    }
     default:
       assert(false && "unsupported tensor type");
     }
@@ -55,12 +64,18 @@ CLangGenWeightFilePass::ReturnType CLangGenWeightFilePass::runOnModule(Module& m
   file.write(reinterpret_cast<const char_type*>(table), table_size);
   free(table);
 
-  // 2. write tensor data into file
+  // 2. write tensor data into file, padding the gaps between aligned tensors
+  CLangMemoryBlock::address_type position = 0;
   for (const auto& entry : meta.packedWeightMemoryBlocks) {
     const auto* const tensor      = entry.first;
     const auto&       memoryBlock = entry.second;
 
+    assert(position <= memoryBlock.offset);
+    const std::vector<char_type> padding(memoryBlock.offset - position, 0);
+    file.write(padding.data(), padding.size());
+
     file.write(getData(*tensor), memoryBlock.length);
+    position = memoryBlock.offset + memoryBlock.length;
   }
 
   outs() << "[Clang] created model weight file: " << outputFile.native() << std::endl;
@@ -24,6 +24,18 @@
 
 using namespace onnc;
 
+namespace {
+
+/// The weight file keeps every tensor aligned like the buffer it is read into.
+constexpr CLangMemoryBlock::size_type kWeightAlignment = 16;
+
+bool is16BitFloat(const Tensor& pTensor)
+{
+  return pTensor.kind() == Value::kFloat16 || pTensor.kind() == Value::kBFloat16;
+}
+
+} // anonymous namespace
+
 CLangMemInfoPass::CLangMemInfoPass(CLangMeta& pMeta) noexcept
   : m_pMeta(pMeta)
 {}
@@ -41,13 +53,17 @@ Pass::ReturnType CLangMemInfoPass::runOnModule(Module& pModule)
           std::make_pair(tensor, CLangMemoryBlock{packedInputMemorySize, mem->length()}));
         packedInputMemorySize += mem->length();
       } else if (mem->isWeight()) {
+        packedWeightMemorySize = (packedWeightMemorySize + kWeightAlignment - 1) / kWeightAlignment * kWeightAlignment;
         m_pMeta.packedWeightMemoryBlocks.emplace_back(
           std::make_pair(tensor, CLangMemoryBlock{packedWeightMemorySize, mem->length()}));
         packedWeightMemorySize += mem->length();
       } else {
+        // the 16-bit weights are widened when loaded, but the kernels write
+        // the other 16-bit tensors as float directly.
+        const CLangMemoryBlock::size_type length = is16BitFloat(*tensor) ? 2 * mem->length() : mem->length();
         m_pMeta.packedInternalMemoryBlocks.emplace_back(
-          std::make_pair(tensor, CLangMemoryBlock{packedInternalMemorySize, mem->length()}));
-        packedInternalMemorySize += mem->length();
+          std::make_pair(tensor, CLangMemoryBlock{packedInternalMemorySize, length}));
+        packedInternalMemorySize += length;
       }
     }
   }
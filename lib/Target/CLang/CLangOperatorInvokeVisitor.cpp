@@ -359,8 +359,7 @@ identifier_type PP_GEN_CLASS_NAME()::defineTensor(internal::Indent indent, const
              << getInputIndex(meta, tensor) << ").data";
       break;
     case MemoryType::weight:
-      stream << "ONNC_RUNTIME_read_tensor(" << getIdentifier(context, ContextMember::weight) << ", "
-             << getWeightIndex(meta, tensor) << ").data";
+      stream << weights << "[" << getWeightIndex(meta, tensor) << "]";
       break;
     case MemoryType::internal:
       stream << castExpr<float*>(memory + " + " + toExpr(getInternalOffset(meta, tensor)));
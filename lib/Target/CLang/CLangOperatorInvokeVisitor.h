@@ -66,12 +66,15 @@ public:
 
   CLangOperatorInvokeVisitor();
   CLangOperatorInvokeVisitor(const CLangMeta& meta, stream_type& stream, internal::Indent indent,
-                             identifier_type memory, identifier_type context)
+                             identifier_type memory, identifier_type context, identifier_type runtime,
+                             identifier_type weights)
     : meta{meta}
     , stream{stream}
     , indent_{indent}
     , memory{std::move(memory)}
     , context{std::move(context)}
+    , runtime{std::move(runtime)}
+    , weights{std::move(weights)}
   {}
 
   CLangOperatorInvokeVisitor(const CLangOperatorInvokeVisitor&) = delete;
@@ -113,6 +116,8 @@ private:
   const internal::Indent indent_;
   const identifier_type  memory;
   const identifier_type  context;
+  const identifier_type  runtime;
+  const identifier_type  weights;
   memory_types_type      memoryTypes;
   memory_sizes_type      memorySizes;
 };
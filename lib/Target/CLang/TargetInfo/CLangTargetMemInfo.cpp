@@ -24,6 +24,7 @@ MemSize CLangTargetMemInfo::getTensorMemorySize(const Tensor& pVal)
   case kUint16:
   case kInt16:
   case kFloat16:
+  case Value::kBFloat16:
     align = 16, size = 2;
     break;
 
@@ -12,6 +12,7 @@
 #include "Compute/NvDlaShuffle.h"
 
 #include <onnc/ADT/Color.h>
+#include <onnc/Config/Config.h>
 #include <onnc/Diagnostic/MsgHandling.h>
 #include <onnc/IR/Compute/Add.h>
 #include <onnc/IR/Compute/AveragePool.h>
@@ -42,6 +43,7 @@
 #include <algorithm>
 #include <iterator>
 #include <sstream>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -71,6 +73,9 @@
   void CodeEmitVisitor::visit(const type& op)                                     \
   {                                                                               \
     DEBUG_STMTS(outs() << op << "\n";);                                           \
+    if (m_pMeta.isFusedIntoConv(op))                                              \
+      return; /* emitted along with the convolution */                            \
+    m_pEmittingOperator = &op;                                                    \
     visitImpl(op);                                                                \
   }                                                                               \
   void CodeEmitVisitor::visitImpl(const type& op)
@@ -103,79 +108,6 @@ std::ostream& operator<<(std::ostream& stream, const ComputeOperator& op)
 
 namespace internal {
 
-enum class BroadcastCategory : std::int8_t
-{
-  UNSUPPORT = -1,
-  LAYER     = 0,
-  CHANNEL   = 1,
-  ELEMENT   = 2,
-};
-
-BroadcastCategory getBroadcastCategory(const Tensor& fromTensor, const Tensor& toTensor)
-{
-  const Tensor::Dimensions& fromDims = fromTensor.getDimensions();
-  const Tensor::Dimensions& toDims   = toTensor.getDimensions();
-
-  if (!isConstant(fromTensor) && !isConstant(toTensor)) {
-    if (size(fromDims) == 4 && size(toDims) == 4) {
-      return (equal(fromDims, begin(toDims)) ? BroadcastCategory::ELEMENT : BroadcastCategory::UNSUPPORT);
-    } else {
-      return BroadcastCategory::UNSUPPORT;
-    }
-    // only constant tensor can broadcast to non-constant tensor
-  } else if (!isConstant(fromTensor) || isConstant(toTensor)) {
-    return BroadcastCategory::UNSUPPORT;
-  }
-
-  assert(size(toDims) == 4);
-
-  using Any     = MatchAny<Tensor::Dimension>;
-  using AnyList = std::vector<Any>;
-
-  using std::begin;
-  switch (size(fromDims)) {
-  case 4: {
-    assert(toDims[0] == 1);
-
-    const Tensor::Dimension c = toDims[1];
-    const Tensor::Dimension h = toDims[2];
-    const Tensor::Dimension w = toDims[3];
-
-    if (equal({1, 1, 1, 1}, begin(fromDims))) {
-      return BroadcastCategory::LAYER;
-    } else if (equal(asRange<AnyList>(1, c, 1, 1), begin(fromDims))) {
-      return BroadcastCategory::CHANNEL;
-    } else if (equal(asRange<AnyList>(1, c, h, w), begin(fromDims))) {
-      return BroadcastCategory::ELEMENT;
-    } else {
-      return BroadcastCategory::UNSUPPORT;
-    }
-  } break;
-  case 3: {
-    const Tensor::Dimension c = toDims[1];
-
-    if (equal({1, 1, 1}, begin(fromDims))) {
-      return BroadcastCategory::LAYER;
-    } else if (equal(asRange<AnyList>(c, 1, 1), begin(fromDims))) {
-      return BroadcastCategory::CHANNEL;
-    } else {
-      return BroadcastCategory::UNSUPPORT;
-    }
-  } break;
-  case 2: {
-    if (equal({1, 1}, begin(fromDims))) {
-      return BroadcastCategory::LAYER;
-    } else {
-      return BroadcastCategory::UNSUPPORT;
-    }
-  } break;
-  case 1:
-    return (fromDims[0] == 1 ? BroadcastCategory::LAYER : BroadcastCategory::UNSUPPORT);
-  default:
-    return BroadcastCategory::UNSUPPORT;
-  }
-}
-
 std::uint8_t getSdpOpMode(BroadcastCategory category)
 {
   assert(category != BroadcastCategory::UNSUPPORT);
@@ -319,6 +251,32 @@ private:
   dla_data_cube& cube_;
 };
 
+/// Call body(begin, end) on disjoint ranges which cover [0, size). Ranges
+/// run on worker threads when there are at least two grains of work.
+template <typename Body>
+void parallelFor(std::size_t size, std::size_t grain, Body body)
+{
+  std::size_t numWorkers = 1;
+#if defined(HAVE_PTHREAD)
+  const std::size_t numGrains = size / std::max<std::size_t>(1, grain);
+  numWorkers                  = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), numGrains);
+#endif
+  if (numWorkers <= 1) {
+    body(std::size_t(0), size);
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  workers.reserve(numWorkers - 1);
+  const std::size_t chunk = DIV_ROUNDUP(size, numWorkers);
+  for (std::size_t begin = chunk; begin < size; begin += chunk)
+    workers.emplace_back(body, begin, std::min(begin + chunk, size));
+
+  body(std::size_t(0), std::min(chunk, size));
+  for (std::thread& worker : workers)
+    worker.join();
+}
+
 } // namespace internal
 
 using namespace internal;
@@ -367,6 +325,13 @@ MemoryListEntryId CodeEmitVisitor::packWeight(span<const float> weight, const Te
                                               Tensor::Dimension outputChannelOffset)
 {
   assert(size(weight) == srcDims.size());
+  assert(weightTensor != nullptr);
+
+  // Split or tiled convolutions pack the same slice of a weight repeatedly.
+  const PackedWeightKey key{weightTensor, srcDims, destDims, numFrontPaddingChannels, outputChannelOffset};
+  const auto            packed = m_PackedWeights.find(key);
+  if (packed != m_PackedWeights.end())
+    return packed->second;
 
   std::string blob_name = "tb-" + std::to_string(m_pMeta.m_NumBlobs++);
 
@@ -385,7 +350,7 @@ MemoryListEntryId CodeEmitVisitor::packWeight(span<const float> weight, const Te
   NvU8* blob_data = new NvU8[b.size];
   memset(blob_data, 0, b.size);
 
-  const auto* srcData = weight.data();
+  const std::uint16_t* srcData = getFloat16Values(*weightTensor, weight);
 
   using weight_type           = nv_weight_t<nvdla::ConfigSet::nv_full>;
   weight_type* const destData = reinterpret_cast<weight_type*>(blob_data);
@@ -402,9 +367,22 @@ MemoryListEntryId CodeEmitVisitor::packWeight(span<const float> weight, const Te
   memory.contents.push_back(blob_name);
   memory.offsets.push_back(0);
 
+  m_PackedWeights.emplace(key, memoryId);
   return memoryId;
 }
 
+const std::uint16_t* CodeEmitVisitor::getFloat16Values(const Tensor& tensor, span<const float> values)
+{
+  auto converted = m_Float16Values.find(&tensor);
+  if (converted == m_Float16Values.end()) {
+    converted = m_Float16Values.emplace(&tensor, std::vector<std::uint16_t>(size(values))).first;
+    f2float16_ieee(values.data(), size(values), converted->second.data());
+  }
+
+  assert(converted->second.size() == size(values));
+  return converted->second.data();
+}
+
 MemoryListEntryId CodeEmitVisitor::packBias(const Tensor& bias, Tensor::Dimension numDestChannels,
                                             Tensor::Dimension srcChannelOffset)
 {
@@ -446,54 +424,57 @@ MemoryListEntryId CodeEmitVisitor::packBias(const Tensor& bias, Tensor::Dimensio
 
 template <typename Type>
 void CodeEmitVisitor::packWeightImpl(Type* destData, NvDlaDims destDimsWithFrontPadding, const Tensor* tensor,
-                                     const float* srcData, NvDlaDims srcDims, Tensor::Dimension numFrontPaddingChannels,
-                                     Tensor::Dimension outputChannelOffset)
+                                     const std::uint16_t* srcData, NvDlaDims srcDims,
+                                     Tensor::Dimension numFrontPaddingChannels, Tensor::Dimension outputChannelOffset)
 {
   const NvDlaDims::value_type N = destDimsWithFrontPadding.n;
   const NvDlaDims::value_type C = destDimsWithFrontPadding.c;
   const NvDlaDims::value_type H = destDimsWithFrontPadding.h;
   const NvDlaDims::value_type W = destDimsWithFrontPadding.w;
 
-  const int channel_per_cube = WEIGHT_ATOM_CUBE_SIZE / ELEMENT_SIZE;
-  const int w_stride_kgrp    = MAC_ATOMIC_K * C * H * W;
-
-  using weight_t = typename std::decay<decltype(*destData)>::type;
-
-  for (Tensor::Dimension n = 0; n < (N / MAC_ATOMIC_K + 1); n++) {
-    int n_size        = (N - n * MAC_ATOMIC_K >= MAC_ATOMIC_K) ? MAC_ATOMIC_K : N - n * MAC_ATOMIC_K;
-    int w_stride_surf = W * H * n_size * channel_per_cube;
-    for (Tensor::Dimension h = 0; h < H; h++) {
-      for (Tensor::Dimension w = 0; w < W; w++) {
-        for (int n_ofs = 0; n_ofs < n_size; n_ofs++) {
-          for (Tensor::Dimension c = 0; c < C; c++) {
-            int surf_ofs  = c / channel_per_cube;
-            int ch_ofs    = c % channel_per_cube;
-            int cube_size = (C - surf_ofs * channel_per_cube) >= channel_per_cube ? channel_per_cube
-                                                                                  : (C - surf_ofs * channel_per_cube);
-            int w_stride_line = W * n_size * cube_size;
-
-            int dest_ofs = (n * w_stride_kgrp) + (surf_ofs * w_stride_surf) + (h * w_stride_line) +
-                           w * n_size * cube_size + (n_ofs * cube_size) + ch_ofs;
-
-            const Tensor::Dimension srcChannel = c - numFrontPaddingChannels;
-            int src_ofs = ((n * MAC_ATOMIC_K + n_ofs + outputChannelOffset) * srcDims.c * srcDims.h * srcDims.w) +
-                          (srcChannel * (srcDims.h * srcDims.w)) + (h * srcDims.w) + w;
-
-            // fill zero at front if necessary
-            if (c < numFrontPaddingChannels) {
-              *(destData + dest_ofs) = 0;
-              continue;
+  const NvDlaDims::value_type channel_per_cube = WEIGHT_ATOM_CUBE_SIZE / ELEMENT_SIZE;
+  const NvDlaDims::value_type w_stride_kgrp    = MAC_ATOMIC_K * C * H * W;
+  const NvDlaDims::value_type src_stride_c     = srcDims.h * srcDims.w;
+  const NvDlaDims::value_type src_stride_k     = srcDims.c * src_stride_c;
+  const NvDlaDims::value_type num_kgrp         = DIV_ROUNDUP(N, MAC_ATOMIC_K);
+
+  // Kernel groups occupy disjoint ranges of the blob, and a kernel group is
+  // laid out as (channel cube, h, w, kernel, channel), so the destination
+  // offset only moves forward.
+  const auto packKernelGroups = [&](std::size_t kgrp_begin, std::size_t kgrp_end) {
+    for (NvDlaDims::value_type n = kgrp_begin; n < static_cast<NvDlaDims::value_type>(kgrp_end); n++) {
+      const NvDlaDims::value_type n_size = std::min<NvDlaDims::value_type>(N - n * MAC_ATOMIC_K, MAC_ATOMIC_K);
+      const std::uint16_t* const  src_kgrp = srcData + (n * MAC_ATOMIC_K + outputChannelOffset) * src_stride_k;
+
+      Type* dest = destData + n * w_stride_kgrp;
+      for (NvDlaDims::value_type surf_c = 0; surf_c < C; surf_c += channel_per_cube) {
+        const NvDlaDims::value_type cube_size = std::min(C - surf_c, channel_per_cube);
+        for (NvDlaDims::value_type h = 0; h < H; h++) {
+          for (NvDlaDims::value_type w = 0; w < W; w++) {
+            for (NvDlaDims::value_type n_ofs = 0; n_ofs < n_size; n_ofs++) {
+              const std::uint16_t* const src = src_kgrp + n_ofs * src_stride_k + h * srcDims.w + w;
+              for (NvDlaDims::value_type c = surf_c; c < surf_c + cube_size; c++, dest++) {
+                // fill zero at front if necessary
+                if (c < numFrontPaddingChannels) {
+                  *dest = 0;
+                  continue;
+                }
+
+                const NvDlaDims::value_type srcChannel = c - numFrontPaddingChannels;
+                assert(srcChannel < srcDims.c);
+                *dest = src[srcChannel * src_stride_c];
+              }
             }
-
-            assert(srcChannel < srcDims.c);
-            assert(src_ofs < srcDims.size());
-
-            *(destData + dest_ofs) = f2float16_ieee(*(srcData + src_ofs));
           }
         }
       }
     }
-  }
+  };
+
+  // give every worker at least 64K elements, or the threads cost more than
+  // they save.
+  parallelFor(num_kgrp, std::max<std::size_t>(1, (1u << 16) / std::max<std::size_t>(1, w_stride_kgrp)),
+              packKernelGroups);
 }
 
 template <typename Type>
@@ -542,28 +523,40 @@ void CodeEmitVisitor::issueEmuOp(NvDlaEmuOperation* op)
 }
 
 AddressListEntryId CodeEmitVisitor::issueDlaAddr(const Tensor& tensor, const NvDlaCubeInfo& cube,
-                                                 Tensor::Dimension channelOffset, NvDlaBackendMeta::Offset hOffset)
+                                                 Tensor::Dimension channelOffset, NvDlaBackendMeta::Offset hOffset,
+                                                 NvDlaBackendMeta::Offset wOffset)
 {
   using offset_type = NvDlaBackendMeta::Offset;
 
   const offset_type h_offset     = hOffset * cube.stride_line;
-  const offset_type memoryOffset = (channelOffset * (cube.dim_h * cube.dim_w * ELEMENT_SIZE)) + h_offset;
+  const offset_type w_offset     = wOffset * FEATURE_ATOM_CUBE_SIZE;
+  const offset_type memoryOffset = (channelOffset * (cube.dim_h * cube.dim_w * ELEMENT_SIZE)) + h_offset + w_offset;
 
-  return m_pMeta.acquireMemory(m_pMeta.getMemoryListEntryId(tensor), memoryOffset);
+  // pooled tensors start at an offset of the shared memory entry
+  return m_pMeta.acquireMemory(m_pMeta.getMemoryListEntryId(tensor), m_pMeta.getMemoryOffset(tensor) + memoryOffset,
+                               m_pMeta.getMemoryListEntrySize(tensor));
 }
 
 AddressListEntryId CodeEmitVisitor::issueDlaAddr(const Tensor& tensor, const NvDlaCubeInfo& cube)
 {
   const MemoryListEntryId memoryId = m_pMeta.getMemoryListEntryId(tensor);
 
-  return m_pMeta.acquireMemory(memoryId, 0);
+  return m_pMeta.acquireMemory(memoryId, m_pMeta.getMemoryOffset(tensor), m_pMeta.getMemoryListEntrySize(tensor));
 }
 
 AddressListEntryId CodeEmitVisitor::issueSDPOperand(const Tensor& tensor, const NvDlaCubeInfo& cube,
                                                     MemoryListEntryId& memoryId)
 {
   if (isConstant(tensor)) {
-    memoryId = packSDPOperand(&tensor, nullptr, cube);
+    // every tile or split of a convolution reads the same operand.
+    const auto key   = std::make_pair(&tensor, cube.mode);
+    const auto found = m_PackedSDPOperands.find(key);
+    if (found != m_PackedSDPOperands.end()) {
+      memoryId = found->second;
+    } else {
+      memoryId = packSDPOperand(&tensor, nullptr, cube);
+      m_PackedSDPOperands.emplace(key, memoryId);
+    }
     return issueDlaAddr(memoryId, cube);
   }
 
@@ -611,6 +604,7 @@ void CodeEmitVisitor::issueDlaOp(NvDlaDlaOperation* op, NvDlaDlaOperation* op_fu
                                                 : m_pMeta.m_DlaNetworkDesc.op_head[op_type];
 
   m_pMeta.m_DLAOperationList.push_back(op);
+  m_pMeta.m_DLAOperationNodes.push_back(getNodeName(*m_pEmittingOperator));
   m_pMeta.m_pDepOp[op_type] = op;
 
   m_pMeta.appendOperationMeta(m_pMeta.m_DLAOperationList.size() - 1,
@@ -647,6 +641,7 @@ void CodeEmitVisitor::issueDlaOp(NvDlaDlaOperation* op, NvDlaDlaOperation* op_fu
                                                        : m_pMeta.m_DlaNetworkDesc.op_head[op_fuse_type];
 
     m_pMeta.m_DLAOperationList.push_back(op_fuse);
+    m_pMeta.m_DLAOperationNodes.push_back(getFusedNodeNames());
     m_pMeta.m_pPrevOp = op_fuse;
 
     m_pMeta.appendOperationMeta(m_pMeta.m_DLAOperationList.size() - 1,
@@ -732,7 +727,7 @@ void CodeEmitVisitor::emitSdp(const ComputeOperator& op, const Tensor& first, co
     const NvDlaCubeInfo secondCubeInfo = makeCubeInfo(*this, getSdpXSingleCubeType(second, DLA_PRECISION), second);
     NvDlaDataCubeModifier(surface.x1_data, NvDlaMemType::mc)
       .setAddress(issueSDPOperand(second, secondCubeInfo, memoryId))
-      .setSize(m_pMeta.getMemoryListEntrySize(memoryId))
+      .setSize(isConstant(second) ? m_pMeta.getMemoryListEntrySize(memoryId) : m_pMeta.getMemoryListEntrySize(second))
       .setInfo(secondCubeInfo);
   }
 
@@ -745,8 +740,115 @@ void CodeEmitVisitor::emitSdp(const ComputeOperator& op, const Tensor& first, co
   issueDlaOp(std::move(operation));
 }
 
-void CodeEmitVisitor::packSDPOperandImpl(NvU8* blob, const Tensor* aluTensor, const float* aluData,
-                                         const Tensor* mulTensor, const float* mulData, const NvDlaCubeInfo& cubeInfo)
+std::string CodeEmitVisitor::getFusedNodeNames() const
+{
+  std::string result = getNodeName(*m_pEmittingOperator);
+
+  const auto* const                       conv  = dyn_cast<Conv>(m_pEmittingOperator);
+  const NvDlaBackendMeta::FusedOperators* fused = (conv == nullptr ? nullptr : m_pMeta.getFusedOperators(*conv));
+  if (fused != nullptr) {
+    for (const ComputeOperator* op : *fused)
+      result += "+" + getNodeName(*op);
+  }
+  return result;
+}
+
+const Tensor& CodeEmitVisitor::emitFusedSdpStages(const Conv& conv, dla_sdp_op_desc& desc,
+                                                  dla_sdp_surface_desc& surface, const NvDlaCubeInfo& outputCube,
+                                                  Tensor::Dimension channelOffset, NvDlaBackendMeta::Offset hOffset,
+                                                  NvDlaBackendMeta::Offset wOffset)
+{
+  const Tensor* result = conv.getOutput(0);
+
+  const NvDlaBackendMeta::FusedOperators* fused = m_pMeta.getFusedOperators(conv);
+  if (fused == nullptr)
+    return *result;
+
+  dla_sdp_op* const    stages[]     = {&desc.x1_op, &desc.x2_op, &desc.y_op};
+  dla_data_cube* const stageCubes[] = {&surface.x1_data, &surface.x2_data, &surface.y_data};
+  unsigned             numStages    = desc.x1_op.enable ? 1 : 0;
+
+  const auto resetStage = [&](unsigned idx) {
+    dla_sdp_op& stage            = *stages[idx];
+    stage.enable                 = 1;
+    stage.alu_type               = SDP_ALU_OP_SUM;
+    stage.type                   = SDP_OP_NONE;
+    stage.mode                   = SDP_OP_PER_LAYER;
+    stage.act                    = ACTIVATION_NONE;
+    stage.shift_value            = 0;
+    stage.truncate               = 0;
+    stage.precision              = DLA_PRECISION;
+    stage.alu_operand            = 0;
+    stage.mul_operand            = 1;
+    stage.cvt.alu_cvt.scale      = 0;
+    stage.cvt.alu_cvt.truncate   = 0;
+    stage.cvt.alu_cvt.enable     = 0;
+    stage.cvt.alu_cvt.offset     = 0;
+    stage.cvt.mul_cvt.scale      = 0;
+    stage.cvt.mul_cvt.truncate   = 0;
+    stage.cvt.mul_cvt.enable     = 0;
+    stage.cvt.mul_cvt.offset     = 0;
+    NvDlaDataCubeModifier(*stageCubes[idx], NvDlaMemType::hw).setAddress(-1);
+  };
+
+  for (const ComputeOperator* op : *fused) {
+    if (isa<Relu>(op)) {
+      // apply ReLU on the last stage, or on a pass-through one.
+      if (numStages == 0)
+        resetStage(numStages++);
+      stages[numStages - 1]->act = ACTIVATION_RELU;
+    } else {
+      assert((isa<Add>(op) || isa<Mul>(op)) && numStages < 3);
+
+      const Tensor& operand =
+        *static_cast<const Tensor*>(op->getInput(0) == result ? op->getInput(1) : op->getInput(0));
+      const BroadcastCategory category =
+        (isConstant(operand) ? getBroadcastCategory(operand, *result) : BroadcastCategory::ELEMENT);
+
+      const unsigned idx = numStages++;
+      resetStage(idx);
+      dla_sdp_op& stage = *stages[idx];
+      stage.type        = isa<Mul>(op) ? SDP_OP_MUL : SDP_OP_ALU;
+      stage.mode        = getSdpOpMode(category);
+      stage.mul_operand = 0;
+
+      dla_data_cube& cube = *stageCubes[idx];
+      if (category == BroadcastCategory::LAYER) {
+        const auto value = to_<std::vector<float>>(operand);
+        assert(size(value) == 1);
+
+        if (stage.type == SDP_OP_MUL)
+          stage.mul_operand = f2float16_ieee(*begin(value));
+        else
+          stage.alu_operand = f2float16_ieee(*begin(value));
+      } else if (isConstant(operand)) {
+        MemoryListEntryId   memoryId;
+        const NvDlaCubeInfo operandCube = makeCubeInfo(*this, getSdpXSingleCubeType(operand, DLA_PRECISION), operand);
+        NvDlaDataCubeModifier(cube, NvDlaMemType::mc)
+          .setAddress(issueSDPOperand(operand, operandCube, memoryId))
+          .setSize(m_pMeta.getMemoryListEntrySize(memoryId))
+          .setInfo(operandCube);
+      } else {
+        // the operand has the shape of the output, read the part of this tile.
+        NvDlaDataCubeModifier(cube, NvDlaMemType::mc)
+          .setAddress(issueDlaAddr(operand, outputCube, channelOffset, hOffset, wOffset))
+          .setSize(m_pMeta.getMemoryListEntrySize(operand))
+          .setInfo(outputCube);
+        cube.width   = surface.src_data.width;
+        cube.height  = surface.src_data.height;
+        cube.channel = surface.src_data.channel;
+      }
+    }
+
+    result = static_cast<const Tensor*>(op->getOutput(0));
+  }
+
+  return *result;
+}
+
+void CodeEmitVisitor::packSDPOperandImpl(NvU8* blob, const Tensor* aluTensor, const std::uint16_t* aluData,
+                                         const Tensor* mulTensor, const std::uint16_t* mulData,
+                                         const NvDlaCubeInfo& cubeInfo)
 {
   int64_t tmpdims[4];
   tmpdims[0] = cubeInfo.dim_n;
@@ -755,8 +857,8 @@ void CodeEmitVisitor::packSDPOperandImpl(NvU8* blob, const Tensor* aluTensor, co
   tmpdims[3] = cubeInfo.dim_w;
   NvDlaDims srcDims(tmpdims);
 
-  const float*  srcData = nullptr;
-  const Tensor* srcTensor;
+  const std::uint16_t* srcData = nullptr;
+  const Tensor*        srcTensor;
   if (cubeInfo.mode == NVDLA_CUBE_SDP_X_ALU_OR_MUL_ONE_BYTE || cubeInfo.mode == NVDLA_CUBE_SDP_Y_ALU_OR_MUL_ONE_BYTE ||
       cubeInfo.mode == NVDLA_CUBE_SDP_X_ALU_OR_MUL_TWO_BYTE || cubeInfo.mode == NVDLA_CUBE_SDP_Y_ALU_OR_MUL_TWO_BYTE) {
     if (aluData != nullptr) {
@@ -796,7 +898,7 @@ void CodeEmitVisitor::packSDPOperandImpl(NvU8* blob, const Tensor* aluTensor, co
         case NVDLA_CUBE_SDP_X_ALU_OR_MUL_TWO_BYTE:
         case NVDLA_CUBE_SDP_Y_ALU_OR_MUL_TWO_BYTE:
           uint16_t data;
-          data = (uint16_t)f2float16_ieee(*(srcData + src_ofs));
+          data = *(srcData + src_ofs);
           // NVDLA uses little endian to interpret data in cube.
           *(blob + 2 * blob_ofs)     = (NvU8)(data & 0xFF);
           *(blob + 2 * blob_ofs + 1) = (NvU8)((data >> 8) & 0xFF);
@@ -806,8 +908,8 @@ void CodeEmitVisitor::packSDPOperandImpl(NvU8* blob, const Tensor* aluTensor, co
         case NVDLA_CUBE_SDP_Y_BOTH_TWO_BYTE:
           uint16_t alu;
           uint16_t mul;
-          alu = (uint16_t)f2float16_ieee(*(aluData + src_ofs));
-          mul = (uint16_t)f2float16_ieee(*(mulData + src_ofs));
+          alu = *(aluData + src_ofs);
+          mul = *(mulData + src_ofs);
 
           if (cubeInfo.mode == NVDLA_CUBE_SDP_X_BOTH_TWO_BYTE) {
             *(blob + 4 * blob_ofs)     = (NvU8)(alu & 0xFF);
@@ -870,16 +972,16 @@ MemoryListEntryId CodeEmitVisitor::packSDPOperand(const Tensor* aluTensor, const
   NvDlaDims srcDims(tmpdims);
 
   // Get data of ALU and/or MUL.
-  const float* aluData;
-  const float* mulData;
+  const std::uint16_t* aluData = nullptr;
+  const std::uint16_t* mulData = nullptr;
   if (aluTensor != nullptr) {
     if (const FloatTensor* floatTensor = dynamic_cast<const FloatTensor*>(aluTensor)) {
-      aluData = reinterpret_cast<const float*>(floatTensor->getValues().data());
+      aluData = getFloat16Values(*floatTensor, floatTensor->getValues());
     }
   }
   if (mulTensor != nullptr) {
     if (const FloatTensor* floatTensor = dynamic_cast<const FloatTensor*>(mulTensor)) {
-      mulData = reinterpret_cast<const float*>(floatTensor->getValues().data());
+      mulData = getFloat16Values(*floatTensor, floatTensor->getValues());
     }
   }
 
@@ -898,8 +1000,9 @@ MemoryListEntryId CodeEmitVisitor::packSDPOperand(const Tensor* aluTensor, const
 }
 
 template <typename Type>
-void CodeEmitVisitor::packImageWeightImpl(Type* blob, NvDlaDims blobDims, const Tensor* tensor, const float* srcData,
-                                          NvDlaDims srcDims, Tensor::Dimension outputChannelOffset)
+void CodeEmitVisitor::packImageWeightImpl(Type* blob, NvDlaDims blobDims, const Tensor* tensor,
+                                          const std::uint16_t* srcData, NvDlaDims srcDims,
+                                          Tensor::Dimension outputChannelOffset)
 {
   assert((blobDims.c == 4) && "Kernel channel must be 4 in image mode.");
 
@@ -916,7 +1019,7 @@ void CodeEmitVisitor::packImageWeightImpl(Type* blob, NvDlaDims blobDims, const
           int src_ofs  = getONNXInitializerOffset(outputChannelOffset + k, c, h, w, srcDims);
           int blob_ofs = getBlobOffsetForImageWeight(k, c, h, w, blobDims);
 
-          *(blob + blob_ofs) = (weight_t)f2float16_ieee(*(srcData + src_ofs));
+          *(blob + blob_ofs) = *(srcData + src_ofs);
         }
       }
     }
@@ -942,7 +1045,7 @@ MemoryListEntryId CodeEmitVisitor::packImageWeight(const Tensor& weight, NvDlaDi
 
   // Pack weights here.
   if (const FloatTensor* floatTensor = dynamic_cast<const FloatTensor*>(&weight)) {
-    const auto* srcData = reinterpret_cast<const float*>(floatTensor->getValues().data());
+    const std::uint16_t* srcData = getFloat16Values(*floatTensor, floatTensor->getValues());
 
     packImageWeightImpl(reinterpret_cast<nv_weight_t<nvdla::ConfigSet::nv_full>*>(blob_data), destDims, &weight,
                         srcData, NvDlaDims(weight), outputChannelOffset);
@@ -1054,5 +1157,51 @@ std::pair<unsigned, bool> CodeEmitVisitor::tryAllocateDataAndWeightsIntoCBuf(con
   return std::make_pair(minNumNeededDataBanks, shouldReuseWeight);
 }
 
+int CodeEmitVisitor::getAffordableConvOutputWidth(const NvDlaCubeInfo& data, const NvDlaCubeInfo& weight,
+                                                  int outputWidth, int kernelWidth, int strideX,
+                                                  Tensor::Dimension yDilation) const
+{
+  unsigned minNumNeededDataBanks = 0;
+  if (m_CbufAllocTypeGetter(data, weight, yDilation, minNumNeededDataBanks) != CbufAllocType::kUnfeasible) {
+    return outputWidth;
+  }
+
+  // a tile of n output columns reads at most (kernelWidth + strideX * (n - 1)) input columns
+  for (int tileWidth = outputWidth - 1; 0 < tileWidth; --tileWidth) {
+    const int           inputWidth = std::min<int>(kernelWidth + strideX * (tileWidth - 1), data.dim_w);
+    const NvDlaCubeInfo tile(*this, NVDLA_CUBE_FEATURE, data.dim_n, data.dim_c, data.dim_h, inputWidth);
+    if (m_CbufAllocTypeGetter(tile, weight, yDilation, minNumNeededDataBanks) != CbufAllocType::kUnfeasible) {
+      return tileWidth;
+    }
+  }
+
+  return outputWidth;
+}
+
+std::vector<CodeEmitVisitor::ConvTile> CodeEmitVisitor::getConvTiles(const NvDlaCubeInfo& data,
+                                                                     const NvDlaCubeInfo& weight, int outputWidth,
+                                                                     int kernelWidth, int strideX, int padLeft,
+                                                                     int padRight, Tensor::Dimension yDilation) const
+{
+  const int tileOutputWidth =
+    getAffordableConvOutputWidth(data, weight, outputWidth, kernelWidth, strideX, yDilation);
+  if (tileOutputWidth == outputWidth) {
+    return {ConvTile{0, outputWidth, 0, data.dim_w, padLeft, padRight}};
+  }
+
+  std::vector<ConvTile> tiles;
+  for (int outputBegin = 0; outputBegin < outputWidth; outputBegin += tileOutputWidth) {
+    const int tileWidth = std::min(tileOutputWidth, outputWidth - outputBegin);
+
+    // the input columns [begin, end) feed the output columns of the tile, those outside the input are padding.
+    const int begin      = strideX * outputBegin - padLeft;
+    const int end        = begin + kernelWidth + strideX * (tileWidth - 1);
+    const int inputBegin = std::max(begin, 0);
+    tiles.push_back(ConvTile{outputBegin, tileWidth, inputBegin, std::min<int>(end, data.dim_w) - inputBegin,
+                             std::max(-begin, 0), std::max<int>(end - data.dim_w, 0)});
+  }
+  return tiles;
+}
+
 } // namespace nvdla
 } // namespace onnc
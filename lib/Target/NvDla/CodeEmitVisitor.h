@@ -12,6 +12,7 @@
 #include "NvDlaMeta.h"
 #include "Compute/NvDlaShuffle.h"
 
+#include <onnc/IR/Compute/Conv.h>
 #include <onnc/IR/Compute/Initializer.h>
 #include <onnc/IR/Compute/InputOperator.h>
 #include <onnc/IR/Compute/OutputOperator.h>
@@ -20,7 +21,13 @@
 #include <onnc/Support/Preprocessor.h>
 #include <onnc/Support/Span.h>
 
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #ifndef PP_NVDLA_OP_LIST
 #  define PP_NVDLA_OP_LIST                                                                              \
@@ -43,6 +50,18 @@ public:
   using CbufAllocTypeGetter =
     std::function<CbufAllocType(const NvDlaCubeInfo&, const NvDlaCubeInfo&, Tensor::Dimension, unsigned&)>;
 
+public:
+  // The output columns of a convolution tile, and the input columns they read.
+  struct ConvTile
+  {
+    int outputBegin;
+    int outputWidth;
+    int inputBegin; // the first input column, padding excluded
+    int inputWidth;
+    int padLeft;
+    int padRight;
+  };
+
 public:
   CodeEmitVisitor(const NvDlaConstants& constants, NvDlaBackendMeta& meta, CbufAllocTypeGetter cbufAllocTypeGetter,
                   unsigned verboseLevel) noexcept
@@ -50,6 +69,7 @@ public:
     , m_pMeta{meta}
     , m_CbufAllocTypeGetter{std::move(cbufAllocTypeGetter)}
     , m_VerboseLevel{verboseLevel}
+    , m_pEmittingOperator{nullptr}
   {}
 
   PP_LIST_FOR_EACH(PP_DECL_VISIT, PP_UNWRAP(PP_NVDLA_OP_LIST))
@@ -58,10 +78,25 @@ public:
   void visit(const NvDlaShuffle&);
   void visitImpl(const NvDlaShuffle&);
 
-private:
+  // Split a convolution along width into tiles whose kernel-high window of
+  // input rows fits in CBUF with the weights. Return one tile if the
+  // convolution fits without tiling or if even one output column does not fit.
+  std::vector<ConvTile> getConvTiles(const NvDlaCubeInfo& data, const NvDlaCubeInfo& weight, int outputWidth,
+                                     int kernelWidth, int strideX, int padLeft, int padRight,
+                                     Tensor::Dimension yDilation) const;
+
+  // Pack the kernels [outputChannelOffset, outputChannelOffset + destDims.n)
+  // of a weight into a blob laid out for the direct or the image convolution.
+  // Return the memory entry of the blob.
   MemoryListEntryId packWeight(const Tensor& weight, NvDlaDims destDims, Tensor::Dimension numFrontPaddingChannels,
                                Tensor::Dimension outputChannelOffset);
   MemoryListEntryId packImageWeight(const Tensor& weight, NvDlaDims destDims, Tensor::Dimension outputChannelOffset);
+
+private:
+  // Return the number of output columns a convolution tile may have.
+  int getAffordableConvOutputWidth(const NvDlaCubeInfo& data, const NvDlaCubeInfo& weight, int outputWidth,
+                                   int kernelWidth, int strideX, Tensor::Dimension yDilation) const;
+
   MemoryListEntryId packBias(const Tensor& bias, Tensor::Dimension numDestChannels,
                              Tensor::Dimension srcChannelOffset = 0);
   MemoryListEntryId packSDPOperand(const Tensor* aluTensor, const Tensor* mulTensor, const NvDlaCubeInfo& cubeInfo);
@@ -72,7 +107,7 @@ private:
   void               issueDlaOp(NvDlaDlaOperation* op, NvDlaDlaOperation* op_fuse, NvDlaDlaOperation* op_prev);
   void               issueDlaOp(std::unique_ptr<NvDlaDlaOperation> op);
   AddressListEntryId issueDlaAddr(const Tensor& tensor, const NvDlaCubeInfo& cube, Tensor::Dimension channelOffset,
-                                  NvDlaBackendMeta::Offset hOffset);
+                                  NvDlaBackendMeta::Offset hOffset, NvDlaBackendMeta::Offset wOffset = 0);
   AddressListEntryId issueDlaAddr(const Tensor& tensor, const NvDlaCubeInfo& cube);
   AddressListEntryId issueDlaAddr(MemoryListEntryId memoryId, const NvDlaCubeInfo& cube);
   AddressListEntryId issueSDPOperand(const Tensor& tensor, const NvDlaCubeInfo& cube, MemoryListEntryId& memoryId);
@@ -86,6 +121,17 @@ private:
   //   2. SDP_OP_MUL
   //
   void emitSdp(const ComputeOperator& op, const Tensor& first, const Tensor& second, const Tensor& output);
+
+  // Program the operators fused into 'conv' into the SDP stages left after
+  // the bias, for the output tile at the given offsets. Return the tensor the
+  // SDP operation writes, which is the output of the last fused operator.
+  const Tensor& emitFusedSdpStages(const Conv& conv, dla_sdp_op_desc& desc, dla_sdp_surface_desc& surface,
+                                   const NvDlaCubeInfo& outputCube, Tensor::Dimension channelOffset,
+                                   NvDlaBackendMeta::Offset hOffset, NvDlaBackendMeta::Offset wOffset);
+  // Return the ONNX node names of the operator being emitted and of the
+  // operators fused into it, joined by '+'.
+  std::string getFusedNodeNames() const;
+
   std::pair<unsigned, bool> tryAllocateDataAndWeightsIntoCBuf(const NvDlaCubeInfo& data, NvDlaCubeInfo& weight,
                                                               Tensor::Dimension yDilation) const;
 
@@ -97,24 +143,37 @@ private:
   MemoryListEntryId packWeight(const Tensor& weight, NvDlaDims srcDims, NvDlaDims destDims,
                                Tensor::Dimension numFrontPaddingChannels, Tensor::Dimension outputChannelOffset);
 
+  /// @return the FP16 bits of @ref values, converted once per tensor.
+  const std::uint16_t* getFloat16Values(const Tensor& tensor, span<const float> values);
+
   template <typename Type>
-  void packWeightImpl(Type* destData, NvDlaDims destDimsWithFrontPadding, const Tensor* tensor, const float* srcData,
-                      NvDlaDims srcDims, Tensor::Dimension numFrontPaddingChannels,
+  void packWeightImpl(Type* destData, NvDlaDims destDimsWithFrontPadding, const Tensor* tensor,
+                      const std::uint16_t* srcData, NvDlaDims srcDims, Tensor::Dimension numFrontPaddingChannels,
                       Tensor::Dimension outputChannelOffset);
 
   template <typename Type>
-  void packImageWeightImpl(Type* blob, NvDlaDims blobDims, const Tensor* tensor, const float* srcData,
+  void packImageWeightImpl(Type* blob, NvDlaDims blobDims, const Tensor* tensor, const std::uint16_t* srcData,
                            NvDlaDims srcDims, Tensor::Dimension outputChannelOffset);
   template <typename Type>
   void packBiasImpl(Type* destData, Tensor::Dimension numDestChannels, const Tensor* tensor, const float* srcData,
                     Tensor::Dimension srcChannelOffset);
-  void packSDPOperandImpl(NvU8* blob, const Tensor* aluTensor, const float* aluData, const Tensor* mulTensor,
-                          const float* mulData, const NvDlaCubeInfo& cubeInfo);
+  void packSDPOperandImpl(NvU8* blob, const Tensor* aluTensor, const std::uint16_t* aluData,
+                          const Tensor* mulTensor, const std::uint16_t* mulData, const NvDlaCubeInfo& cubeInfo);
 
 private:
-  NvDlaBackendMeta&         m_pMeta;
-  const CbufAllocTypeGetter m_CbufAllocTypeGetter;
-  const unsigned            m_VerboseLevel;
+  // weight, source dimensions, destination dimensions, front padding
+  // channels, output channel offset
+  using PackedWeightKey =
+    std::tuple<const Tensor*, NvDlaDims, NvDlaDims, Tensor::Dimension, Tensor::Dimension>;
+
+  NvDlaBackendMeta&                                   m_pMeta;
+  const CbufAllocTypeGetter                           m_CbufAllocTypeGetter;
+  const unsigned                                      m_VerboseLevel;
+  // the operator whose DLA operations are being issued
+  const ComputeOperator*                              m_pEmittingOperator;
+  std::map<const Tensor*, std::vector<std::uint16_t>> m_Float16Values;
+  std::map<PackedWeightKey, MemoryListEntryId>        m_PackedWeights;
+  std::map<std::pair<const Tensor*, nvdla_cube_type>, MemoryListEntryId> m_PackedSDPOperands;
 };
 
 } // namespace nvdla
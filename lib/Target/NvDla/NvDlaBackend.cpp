@@ -13,9 +13,12 @@
 #include "LegalizeReduceMeanPass.h"
 #include "NvDlaCalibrateAveragePoolResultPass.h"
 #include "NvDlaCollectReshapeInfoPass.h"
+#include "NvDlaEstimatePerformancePass.h"
 #include "NvDlaFileGenPass.h"
+#include "NvDlaFilterLiveIntervalsPass.h"
 #include "NvDlaIdentifyShufflePass.h"
 #include "NvDlaMemInfoPass.h"
+#include "NvDlaPlanFusionPass.h"
 #include "NvDlaTaskSubmitPass.h"
 #include "NvDlaUtil.h"
 #include "ReplaceFlattenByReshape.h"
@@ -103,7 +106,8 @@ NvDlaBackend::NvDlaBackend(const TargetOptions& pOptions)
                                 std::placeholders::_3, std::placeholders::_4),
                       m_VerboseLevel)
 {
-  m_pMemInfo = std::make_unique<NvDlaTargetMemInfo>();
+  const NvDlaConstants& constants = *this;
+  m_pMemInfo = std::make_unique<NvDlaTargetMemInfo>(constants);
 }
 
 void NvDlaBackend::addTensorSel(PassManager& passManager)
@@ -162,6 +166,8 @@ void NvDlaBackend::addOnncIrOptimization(PassManager& passManager, OptimizationO
   options.defaultEnable(OptimizationOption::expand_batch_normalization);
   options.defaultEnable(OptimizationOption::replace_gemm_by_conv);
   options.defaultEnable(OptimizationOption::eliminate_identity);
+  options.defaultEnable(OptimizationOption::eliminate_common_subexpression);
+  options.defaultEnable(OptimizationOption::eliminate_duplicate_initializer);
 
   TargetBackend::addOnncIrOptimization(passManager, options);
 
@@ -176,6 +182,10 @@ void NvDlaBackend::addOnncIrOptimization(PassManager& passManager, OptimizationO
     .add<SplitGroupConvPass>()
     .add<NvDlaCollectReshapeInfoPass>(m_pMeta)
     ;
+
+  if (options.isEnabled(OptimizationOption::fuse_sdp_into_conv, true)) {
+    passManager.add<NvDlaPlanFusionPass>(m_pMeta);
+  }
 }
 
 void NvDlaBackend::addTensorSched(PassManager& passManager)
@@ -192,6 +202,9 @@ void NvDlaBackend::addMemAlloc(PassManager& passManager)
   // Output: LiveIntervals
   addStandardCreateLiveIntervals(passManager);
 
+  // Only the feature tensors placed in the shared pool are planned.
+  passManager.add<NvDlaFilterLiveIntervalsPass>(m_pMeta);
+
   // Input: LiveIntervals
   // Output: MemAllocs
   addStandardMemoryAllocation(passManager, *this);
@@ -211,6 +224,11 @@ void NvDlaBackend::addCodeEmit(PassManager& passManager, const Path& pOutput)
     .add<NvDlaTaskSubmitPass>(&m_pMeta, BLOB_DLA_VERSION, BLOB_EMU_VERSION)
     .add<NvDlaFileGenPass>(&m_pMeta, LOADABLE_VERSION)
     ;
+
+  if (options().shouldEstimatePerformance()) {
+    const NvDlaConstants& constants = *this;
+    passManager.add<NvDlaEstimatePerformancePass>(constants, &m_pMeta);
+  }
 }
 
 void NvDlaBackend::RegisterLowers(LowerRegistry& pRegistry) const
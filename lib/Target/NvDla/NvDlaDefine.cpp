@@ -15,6 +15,11 @@
 #include <cmath>
 #include <limits>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  include <immintrin.h>
+#  define NVDLA_HAS_F16C_CONVERSION 1
+#endif
+
 namespace onnc {
 
 bool operator==(const NvDlaDims& lhs, const NvDlaDims& rhs)
@@ -24,8 +29,42 @@ bool operator==(const NvDlaDims& lhs, const NvDlaDims& rhs)
 
 bool operator!=(const NvDlaDims& lhs, const NvDlaDims& rhs) { return !(lhs == rhs); }
 
+bool operator<(const NvDlaDims& lhs, const NvDlaDims& rhs)
+{
+  return std::tie(lhs.n, lhs.c, lhs.h, lhs.w) < std::tie(rhs.n, rhs.c, rhs.h, rhs.w);
+}
+
 std::uint16_t f2float16_ieee(float param) { return half_float::detail::float2half<std::round_toward_zero>(param); }
 
+#ifdef NVDLA_HAS_F16C_CONVERSION
+// VCVTPS2PH truncating gives the same bits as the scalar conversion, except
+// for the payload of NaNs.
+__attribute__((target("avx,f16c"))) static std::size_t f2float16_f16c(const float* params, std::size_t size,
+                                                                       std::uint16_t* results)
+{
+  std::size_t idx = 0;
+  for (; idx + 8 <= size; idx += 8) {
+    const __m256  values = _mm256_loadu_ps(params + idx);
+    const __m128i halves = _mm256_cvtps_ph(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(results + idx), halves);
+  }
+  return idx;
+}
+#endif
+
+void f2float16_ieee(const float* params, std::size_t size, std::uint16_t* results)
+{
+  std::size_t idx = 0;
+#ifdef NVDLA_HAS_F16C_CONVERSION
+  static const bool hasF16C = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+  if (hasF16C)
+    idx = f2float16_f16c(params, size, results);
+#endif
+
+  for (; idx < size; ++idx)
+    results[idx] = f2float16_ieee(params[idx]);
+}
+
 std::int8_t f2int8_ieee(float param)
 {
   unsigned int param_bit = *((unsigned int*)(&param));
@@ -81,6 +81,7 @@ struct NvDlaDims
 
 bool operator==(const NvDlaDims& lhs, const NvDlaDims& rhs);
 bool operator!=(const NvDlaDims& lhs, const NvDlaDims& rhs);
+bool operator<(const NvDlaDims& lhs, const NvDlaDims& rhs);
 
 struct NvDlaPoint
 {
@@ -111,6 +112,8 @@ struct NvDlaRect
 };
 
 std::uint16_t f2float16_ieee(float param);
+// convert params[0, size) into results, with F16C if the host supports it.
+void          f2float16_ieee(const float* params, std::size_t size, std::uint16_t* results);
 std::int8_t   f2int8_ieee(float param);
 std::int16_t  f2int16_ieee(float param);
 
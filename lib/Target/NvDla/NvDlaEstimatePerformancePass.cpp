@@ -0,0 +1,241 @@
+//===- NvDlaEstimatePerformancePass.cpp -----------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "NvDlaEstimatePerformancePass.h"
+
+#include <onnc/Support/IOStream.h>
+
+#include <algorithm>
+#include <iomanip>
+
+namespace onnc {
+
+// Reference numbers of the nv_full configuration.
+static constexpr unsigned kClockMHz            = 1000;
+static constexpr unsigned kDramBytesPerCycle   = 64; // 512-bit DBBIF
+static constexpr unsigned kProgramCycles       = 256;
+static constexpr unsigned kSdpElementsPerCycle = 16;
+static constexpr unsigned kPdpElementsPerCycle = 8;
+static constexpr unsigned kCdpElementsPerCycle = 8;
+
+static const char* GetOpTypeName(std::uint8_t opType)
+{
+  switch (opType) {
+  case DLA_OP_BDMA:
+    return "BDMA";
+  case DLA_OP_CONV:
+    return "CONV";
+  case DLA_OP_SDP:
+    return "SDP";
+  case DLA_OP_PDP:
+    return "PDP";
+  case DLA_OP_CDP:
+    return "CDP";
+  case DLA_OP_RUBIK:
+    return "RUBIK";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+static std::uint64_t GetNumOfElements(const dla_data_cube& cube)
+{
+  return static_cast<std::uint64_t>(cube.width) * cube.height * cube.channel;
+}
+
+/// @return the bytes moved through DRAM (or CV-SRAM) for @ref cube.
+static std::uint64_t GetMemoryBytes(const dla_data_cube& cube)
+{
+  return cube.type == DLA_MEM_HW ? 0 : cube.size;
+}
+
+static std::uint64_t DivRoundUp(std::uint64_t dividend, std::uint64_t divisor)
+{
+  return (dividend + divisor - 1) / divisor;
+}
+
+//===----------------------------------------------------------------------===//
+// NvDlaEstimatePerformancePass
+//===----------------------------------------------------------------------===//
+NvDlaEstimatePerformancePass::NvDlaEstimatePerformancePass(const NvDlaConstants& constants,
+                                                           const NvDlaBackendMeta* pMeta) noexcept
+  : NvDlaConstants{constants}
+  , m_pMeta{pMeta}
+  , m_Estimates{}
+  , m_NumEmuOperations{0}
+  , m_TotalCycles{0}
+{}
+
+Pass::ReturnType NvDlaEstimatePerformancePass::runOnModule(Module& pModule)
+{
+  using OperationCategory = NvDlaBackendMeta::OperationMeta::Category;
+
+  m_Estimates.clear();
+  m_NumEmuOperations = 0;
+  for (const auto& meta : m_pMeta->m_OperationMetas) {
+    if (meta.category == OperationCategory::emu) {
+      ++m_NumEmuOperations;
+      continue;
+    }
+    m_Estimates.emplace_back(estimate(meta.index, *m_pMeta->m_DLAOperationList[meta.index]));
+  }
+
+  // A fused chain costs as much as its slowest member.
+  std::vector<std::size_t>   chainOf(m_pMeta->m_DLAOperationList.size());
+  std::vector<std::uint64_t> chainCycles(m_pMeta->m_DLAOperationList.size(), 0);
+  for (const Estimate& estimate : m_Estimates) {
+    const std::size_t chain = (estimate.fusedParent < 0) ? estimate.index : chainOf[estimate.fusedParent];
+    chainOf[estimate.index] = chain;
+    chainCycles[chain]      = std::max(chainCycles[chain], estimate.cycles);
+  }
+
+  m_TotalCycles = 0;
+  for (const Estimate& estimate : m_Estimates) {
+    if (estimate.fusedParent < 0)
+      m_TotalCycles += chainCycles[estimate.index];
+  }
+
+  print(errs());
+  return Pass::kModuleNoChanged;
+}
+
+NvDlaEstimatePerformancePass::Estimate NvDlaEstimatePerformancePass::estimate(std::size_t                index,
+                                                                              const NvDlaDlaOperation& operation) const
+{
+  Estimate result;
+  result.index          = index;
+  result.opType         = operation.op_dep.op_type;
+  result.fusedParent    = operation.op_dep.fused_parent.index;
+  result.computeCycles  = 0;
+  result.dramBytes      = 0;
+  result.macUtilization = 0.0;
+  result.cbufBanks      = 0;
+  result.node           = m_pMeta->m_DLAOperationNodes[index];
+
+  switch (result.opType) {
+  case DLA_OP_BDMA: {
+    const dla_bdma_surface_desc& surface = operation.op_surf.bdma_surface;
+    for (unsigned idx = 0; idx < surface.num_transfers; ++idx) {
+      const dla_bdma_transfer_desc& transfer = surface.transfers[idx];
+      // read and write back
+      result.dramBytes +=
+        2 * static_cast<std::uint64_t>(transfer.line_size) * transfer.line_repeat * transfer.surface_repeat;
+    }
+    break;
+  }
+  case DLA_OP_CONV: {
+    const dla_conv_op_desc&      desc    = operation.op_desc.conv_op;
+    const dla_conv_surface_desc& surface = operation.op_surf.conv_surface;
+
+    const std::uint64_t numOfPixels   = static_cast<std::uint64_t>(desc.input_width_cmac) * desc.input_height_cmac;
+    const std::uint64_t kernelSize    = static_cast<std::uint64_t>(desc.kernel_width_csc) * desc.kernel_height_csc;
+    const std::uint64_t inputChannel  = desc.kernel_channel_csc;
+    const std::uint64_t outputChannel = surface.dst_data.channel;
+
+    // each cycle CMAC finishes one atomic operation of MAC_ATOMIC_C input
+    // channels and MAC_ATOMIC_K kernels.
+    result.computeCycles = DivRoundUp(inputChannel, MAC_ATOMIC_C) * DivRoundUp(outputChannel, MAC_ATOMIC_K) *
+                           numOfPixels * kernelSize;
+    if (0 < result.computeCycles)
+      result.macUtilization = static_cast<double>(inputChannel * outputChannel * numOfPixels * kernelSize) /
+                              (result.computeCycles * MAC_ATOMIC_C * MAC_ATOMIC_K);
+    result.cbufBanks = desc.data_bank + desc.weight_bank;
+
+    if (!desc.data_reuse)
+      result.dramBytes += GetMemoryBytes(surface.src_data);
+    if (!desc.weight_reuse)
+      result.dramBytes += GetMemoryBytes(surface.weight_data);
+    result.dramBytes += GetMemoryBytes(surface.dst_data);
+
+    // CSC can not start before the first kernel group arrives.
+    if (!desc.weight_reuse)
+      result.computeCycles += getTransferCycles(static_cast<std::uint64_t>(desc.bytes_per_kernel) * MAC_ATOMIC_K);
+    break;
+  }
+  case DLA_OP_SDP: {
+    const dla_sdp_op_desc&      desc    = operation.op_desc.sdp_op;
+    const dla_sdp_surface_desc& surface = operation.op_surf.sdp_surface;
+
+    result.computeCycles = DivRoundUp(GetNumOfElements(surface.dst_data), kSdpElementsPerCycle);
+    result.dramBytes     = GetMemoryBytes(surface.src_data) + GetMemoryBytes(surface.dst_data);
+    if (desc.x1_op.enable)
+      result.dramBytes += GetMemoryBytes(surface.x1_data);
+    if (desc.x2_op.enable)
+      result.dramBytes += GetMemoryBytes(surface.x2_data);
+    if (desc.y_op.enable)
+      result.dramBytes += GetMemoryBytes(surface.y_data);
+    break;
+  }
+  case DLA_OP_PDP: {
+    const dla_pdp_surface_desc& surface = operation.op_surf.pdp_surface;
+
+    // the line buffer reads every input element once.
+    result.computeCycles = DivRoundUp(GetNumOfElements(surface.src_data), kPdpElementsPerCycle);
+    result.dramBytes     = GetMemoryBytes(surface.src_data) + GetMemoryBytes(surface.dst_data);
+    break;
+  }
+  case DLA_OP_CDP: {
+    const dla_cdp_surface_desc& surface = operation.op_surf.cdp_surface;
+
+    result.computeCycles = DivRoundUp(GetNumOfElements(surface.src_data), kCdpElementsPerCycle);
+    result.dramBytes     = GetMemoryBytes(surface.src_data) + GetMemoryBytes(surface.dst_data);
+    break;
+  }
+  case DLA_OP_RUBIK: {
+    const dla_rubik_surface_desc& surface = operation.op_surf.rubik_surface;
+
+    // RUBIK only moves data around.
+    result.dramBytes = GetMemoryBytes(surface.src_data) + GetMemoryBytes(surface.dst_data);
+    break;
+  }
+  default:
+    break;
+  }
+
+  result.cycles = kProgramCycles + std::max(result.computeCycles, getTransferCycles(result.dramBytes));
+  return result;
+}
+
+std::uint64_t NvDlaEstimatePerformancePass::getTransferCycles(std::uint64_t bytes) const
+{
+  return DivRoundUp(bytes, kDramBytesPerCycle);
+}
+
+void NvDlaEstimatePerformancePass::print(OStream& pOS) const
+{
+  std::ios::fmtflags flags(pOS.flags());
+  pOS << "===---------------------------------------------------------===\n"
+      << "                NVDLA performance estimation\n"
+      << "===---------------------------------------------------------===\n"
+      << "  Total: " << m_TotalCycles << " cycles, " << std::fixed << std::setprecision(3)
+      << m_TotalCycles / (kClockMHz * 1e3) << " ms at " << kClockMHz << " MHz\n";
+  if (0 < m_NumEmuOperations)
+    pOS << "  " << m_NumEmuOperations << " EMU operation(s) not included\n";
+  pOS << '\n'
+      << std::setw(6) << "Index" << std::setw(7) << "Type" << std::setw(7) << "Fused" << std::setw(12) << "Cycles"
+      << std::setw(12) << "Compute" << std::setw(12) << "DRAM (B)" << std::setw(8) << "MAC%" << std::setw(7)
+      << "Banks" << "  Node\n";
+  for (const Estimate& estimate : m_Estimates) {
+    pOS << std::setw(6) << estimate.index << std::setw(7) << GetOpTypeName(estimate.opType) << std::setw(7);
+    if (estimate.fusedParent < 0)
+      pOS << "-";
+    else
+      pOS << estimate.fusedParent;
+    pOS << std::setw(12) << estimate.cycles << std::setw(12) << estimate.computeCycles << std::setw(12)
+        << estimate.dramBytes;
+    if (estimate.opType == DLA_OP_CONV)
+      pOS << std::setw(8) << std::setprecision(1) << 100.0 * estimate.macUtilization << std::setw(7)
+          << estimate.cbufBanks;
+    else
+      pOS << std::setw(8) << "-" << std::setw(7) << "-";
+    pOS << "  " << estimate.node << '\n';
+  }
+  pOS << std::flush;
+  pOS.flags(flags);
+}
+
+} // namespace onnc
@@ -0,0 +1,86 @@
+//===- NvDlaEstimatePerformancePass.h -------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_TARGET_NVDLA_NVDLA_ESTIMATE_PERFORMANCE_PASS_H_INCLUDED
+#define ONNC_TARGET_NVDLA_NVDLA_ESTIMATE_PERFORMANCE_PASS_H_INCLUDED
+
+#include "NvDlaDefine.h"
+#include "NvDlaMeta.h"
+
+#include <onnc/Core/CustomPass.h>
+#include <onnc/Support/OStream.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace onnc {
+
+/** \class NvDlaEstimatePerformancePass
+ *  \brief Estimate the latency of the submitted operations with an analytic
+ *         model of NVDLA and print the report.
+ *
+ *  Every DLA operation costs a fixed programming overhead plus the larger of
+ *  its compute cycles and its DRAM transfer cycles. Convolution computes one
+ *  MAC_ATOMIC_C x MAC_ATOMIC_K atomic operation per cycle, so partially
+ *  filled atomics show up as a lower MAC utilization. Operands kept in CBUF
+ *  (data_reuse, weight_reuse) or streamed from another sub-module (fused
+ *  operations) move no DRAM bytes. A fused operation runs along with its
+ *  parent, so a fused chain costs as much as its slowest member. EMU
+ *  operations run on the CPU and are not modeled.
+ *
+ *  Each operation is reported along with the ONNX node it is emitted for.
+ *  The SDP operation fused into a convolution lists the convolution and the
+ *  nodes folded into it, e.g. `conv1+relu1`.
+ */
+class NvDlaEstimatePerformancePass : public CustomPass<NvDlaEstimatePerformancePass>, private NvDlaConstants
+{
+public:
+  struct Estimate
+  {
+    std::size_t   index;
+    std::uint8_t  opType;
+    int           fusedParent;
+    std::uint64_t computeCycles;
+    std::uint64_t dramBytes;
+    std::uint64_t cycles;
+    double        macUtilization; // convolution only
+    unsigned      cbufBanks;      // convolution only
+    std::string   node;           // the ONNX node(s) the operation runs
+  };
+
+  using EstimateList = std::vector<Estimate>;
+
+public:
+  NvDlaEstimatePerformancePass(const NvDlaConstants& constants, const NvDlaBackendMeta* pMeta) noexcept;
+
+  ReturnType runOnModule(Module& pModule) override;
+
+  StringRef getPassName() const override { return "NvDlaEstimatePerformancePass"; }
+
+  const EstimateList& getEstimates() const noexcept { return m_Estimates; }
+
+  /// @return the latency of the whole network in cycles.
+  std::uint64_t getTotalCycles() const noexcept { return m_TotalCycles; }
+
+  void print(OStream& pOS) const;
+
+private:
+  Estimate estimate(std::size_t index, const NvDlaDlaOperation& operation) const;
+
+  std::uint64_t getTransferCycles(std::uint64_t bytes) const;
+
+private:
+  const NvDlaBackendMeta* m_pMeta;
+  EstimateList            m_Estimates;
+  std::size_t             m_NumEmuOperations;
+  std::uint64_t           m_TotalCycles;
+};
+
+} // namespace onnc
+
+#endif
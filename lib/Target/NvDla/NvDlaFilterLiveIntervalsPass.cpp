@@ -0,0 +1,91 @@
+//===- NvDlaFilterLiveIntervalsPass.cpp -----------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "NvDlaFilterLiveIntervalsPass.h"
+
+#include "NvDlaUtil.h"
+
+#include <onnc/CodeGen/LiveIntervalsData.h>
+#include <onnc/Core/PassAnalysisSupport.h>
+#include <onnc/IR/Compute/Add.h>
+#include <onnc/IR/Compute/AveragePool.h>
+#include <onnc/IR/Compute/Conv.h>
+#include <onnc/IR/Compute/LRN.h>
+#include <onnc/IR/Compute/Max.h>
+#include <onnc/IR/Compute/MaxPool.h>
+#include <onnc/IR/Compute/Min.h>
+#include <onnc/IR/Compute/Mul.h>
+#include <onnc/IR/Compute/Relu.h>
+#include <onnc/IR/Compute/Sum.h>
+#include <onnc/Support/Casting.h>
+
+namespace onnc {
+
+/// The code emitters of these operators address their operands through the
+/// tensor, so they honour the offset of a tensor in the pool. The others
+/// (Concat, Split, NvDlaShuffle, Softmax, ...) address whole memory entries.
+static bool IsPoolAware(const ComputeOperator* pOp)
+{
+  return isa<Conv>(pOp) || isa<Relu>(pOp) || isa<LRN>(pOp) || isa<Add>(pOp) || isa<Mul>(pOp) || isa<Max>(pOp) ||
+         isa<Min>(pOp) || isa<Sum>(pOp) || isa<MaxPool>(pOp) || isa<AveragePool>(pOp);
+}
+
+//===----------------------------------------------------------------------===//
+// NvDlaFilterLiveIntervalsPass
+//===----------------------------------------------------------------------===//
+Pass::ReturnType NvDlaFilterLiveIntervalsPass::runOnModule(Module& pModule)
+{
+  LiveIntervalsData* liveIntervals = getAnalysis<LiveIntervalsData>();
+
+  for (ComputeOperator& cm : *pModule.getRootComputeGraph()) {
+    for (unsigned idx = 0; idx < cm.getNumOfOutputs(); ++idx) {
+      const Tensor* output = static_cast<const Tensor*>(cm.getOutput(idx));
+      if (liveIntervals->hasInterval(output) && !isPoolable(*output))
+        liveIntervals->removeLiveInterval(output);
+    }
+
+    const Conv* conv = dyn_cast<Conv>(&cm);
+    if (conv == nullptr)
+      continue;
+
+    if (const NvDlaBackendMeta::FusedOperators* fused = m_Meta.getFusedOperators(*conv)) {
+      const Value* output = fused->back()->getOutput(0);
+      if (liveIntervals->hasInterval(output))
+        liveIntervals->removeLiveInterval(output);
+    }
+  }
+
+  return Pass::kModuleNoChanged;
+}
+
+void NvDlaFilterLiveIntervalsPass::getAnalysisUsage(AnalysisUsage& pUsage) const
+{
+  pUsage.addRequired<LiveIntervalsData>();
+}
+
+bool NvDlaFilterLiveIntervalsPass::isPoolable(const Tensor& pTensor)
+{
+  // the cube layout only describes tensors up to 4 dimensions.
+  if (4 < pTensor.getNumOfDimensions())
+    return false;
+
+  // weights are packed into their own blobs, and a Reshape output aliases
+  // the memory of its input, so neither may be moved into the pool.
+  if (!IsPoolAware(getProducer(pTensor)))
+    return false;
+
+  // network outputs are consumed by OutputOperator and rejected here, since
+  // they are bound to a tensor descriptor of their own.
+  for (const Use& use : pTensor.getUses()) {
+    if (!IsPoolAware(use.getUser()))
+      return false;
+  }
+
+  return !pTensor.getUses().empty();
+}
+
+} // namespace onnc
@@ -0,0 +1,54 @@
+//===- NvDlaFilterLiveIntervalsPass.h -------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_TARGET_NVDLA_NVDLA_FILTER_LIVE_INTERVALS_PASS_H_INCLUDED
+#define ONNC_TARGET_NVDLA_NVDLA_FILTER_LIVE_INTERVALS_PASS_H_INCLUDED
+
+#include "NvDlaMeta.h"
+
+#include <onnc/Core/CustomPass.h>
+#include <onnc/IR/Compute/Tensor.h>
+
+namespace onnc {
+
+/** \class NvDlaFilterLiveIntervalsPass
+ *  \brief Keep only the live intervals of feature tensors which can be placed
+ *         in the shared feature memory pool.
+ *
+ *  Memory allocation then plans the pool offsets with liveness, and
+ *  NvDlaMemInfoPass binds every allocated tensor into the pool. The other
+ *  tensors (weights, network inputs and outputs, Reshape operands and the
+ *  operands of operators which address memory entries directly) still own a
+ *  memory entry each.
+ *
+ *  The convolution of a fused chain (see NvDlaPlanFusionPass) writes the
+ *  output of the last fused operator before the live interval of that tensor
+ *  starts, so such an output keeps its own memory entry too.
+ */
+class NvDlaFilterLiveIntervalsPass : public CustomPass<NvDlaFilterLiveIntervalsPass>
+{
+public:
+  NvDlaFilterLiveIntervalsPass(const NvDlaBackendMeta& pMeta) noexcept
+    : m_Meta(pMeta)
+  {}
+
+  ReturnType runOnModule(Module& pModule) override;
+
+  void getAnalysisUsage(AnalysisUsage& pUsage) const override;
+
+  StringRef getPassName() const override { return "NvDlaFilterLiveIntervalsPass"; }
+
+  /// @return true if @ref pTensor can live in the shared feature memory pool.
+  static bool isPoolable(const Tensor& pTensor);
+
+private:
+  const NvDlaBackendMeta& m_Meta;
+};
+
+} // namespace onnc
+
+#endif
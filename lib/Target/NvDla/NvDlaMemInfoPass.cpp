@@ -9,13 +9,17 @@
 
 #include "NvDlaUtil.h"
 
+#include <onnc/CodeGen/MemAllocData.h>
+#include <onnc/Core/PassAnalysisSupport.h>
 #include <onnc/IR/Compute/InputOperator.h>
 #include <onnc/IR/Compute/OutputOperator.h>
 #include <onnc/IR/Compute/Tensor.h>
 #include <onnc/Support/Casting.h>
 #include <onnc/Support/IOStream.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <unordered_set>
 
 using namespace ::nvdla::loadable;
@@ -66,6 +70,28 @@ Pass::ReturnType NvDlaMemInfoPass::runOnModule(Module& pModule)
     return outputTensors.find(tensor) != end(outputTensors);
   };
 
+  // [1] entry is the pool shared by the feature tensors allocated by
+  // LinearScanMemAlloc. Tensors placed at overlapping offsets are never live
+  // at the same time.
+  const MemAllocData* memAllocs = getAnalysis<MemAllocData>();
+  const auto          isPooled  = [memAllocs, &isOutput](const Tensor* tensor) {
+    return memAllocs->hasAlloc(tensor) && !isConstant(*tensor) && !isOutput(tensor) &&
+           !isa<InputOperator>(getProducer(*tensor));
+  };
+
+  std::uint64_t poolSize = 0;
+  for (const Tensor* tensor : tensors) {
+    if (isPooled(tensor)) {
+      const MemAllocData::AllocEntry alloc = memAllocs->getAlloc(tensor);
+      poolSize                             = std::max(poolSize, alloc.startAddr + alloc.size);
+    }
+  }
+
+  MemoryListEntryId poolId = NvDlaBackendMeta::getInvalidMemoryListEntryId();
+  if (0 < poolSize) {
+    poolId = m_pMeta->allocateMemory(ILoadable::MemoryDomain_SYSMEM, ILoadable::MemoryFlags_ALLOC, poolSize);
+  }
+
   for (const Tensor* tensor : tensors) {
     if (isConstant(*tensor)) {
       continue;
@@ -87,7 +113,15 @@ Pass::ReturnType NvDlaMemInfoPass::runOnModule(Module& pModule)
       dims[idx++] = i;
 
     const NvDlaCubeInfo cubeinfo(*this, NVDLA_CUBE_FEATURE, dims[0], dims[1], dims[2], dims[3], 0, 0);
-   
+
+    if (isPooled(tensor)) {
+      const MemAllocData::AllocEntry alloc = memAllocs->getAlloc(tensor);
+      assert(cubeinfo.size <= alloc.size && "allocated region is smaller than the feature cube");
+
+      m_pMeta->bindMemoryFor(*tensor, poolId, alloc.startAddr, cubeinfo.size);
+      continue;
+    }
+
     const bool isInput = isa<InputOperator>(getProducer(*tensor));
     if (isInput && !m_pMeta->hasMemoryListEntry(*tensor)) {
       const MemoryListEntryId memoryId =
@@ -171,4 +205,6 @@ Pass::ReturnType NvDlaMemInfoPass::runOnModule(Module& pModule)
 
   return Pass::kModuleNoChanged;
 }
+
+void NvDlaMemInfoPass::getAnalysisUsage(AnalysisUsage& pUsage) const { pUsage.addRequired<MemAllocData>(); }
 } // namespace onnc
@@ -17,6 +17,10 @@ namespace onnc {
 
 /** \class NvDlaMemInfoPass
  *  \brief Allocate memory for tensors
+ *
+ *  Feature tensors allocated by the memory allocation pass share one memory
+ *  entry, at the offsets it planned with liveness. Every other tensor owns a
+ *  memory entry.
  */
 class NvDlaMemInfoPass : public CustomPass<NvDlaMemInfoPass>, private NvDlaConstants
 {
@@ -25,6 +29,10 @@ public:
 
   ReturnType runOnModule(Module& pModule) override;
 
+  void getAnalysisUsage(AnalysisUsage& pUsage) const override;
+
+  StringRef getPassName() const override { return "NvDlaMemInfoPass"; }
+
 private:
   NvDlaBackendMeta* m_pMeta;
 };
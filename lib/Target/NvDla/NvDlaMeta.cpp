@@ -176,6 +176,16 @@ NvDlaBackendMeta::MemoryListEntry& NvDlaBackendMeta::getMemoryListEntry(MemoryLi
 
 NvDlaBackendMeta::MemoryListEntrySize NvDlaBackendMeta::getMemoryListEntrySize(const Tensor& tensor) const
 {
+  // a pooled tensor only owns its own region of the shared memory entry
+  const Tensor& source = isReshaped(tensor) ? getReshapeSource(tensor) : tensor;
+
+  using std::end;
+
+  const auto found = m_PoolTable.find(&source);
+  if (found != end(m_PoolTable)) {
+    return found->second.second;
+  }
+
   return getMemoryListEntry(tensor).size;
 }
 
@@ -218,6 +228,31 @@ void NvDlaBackendMeta::markAsReshaped(const Tensor& input, const Tensor& output)
   assert(result.second && "cannot bind Reshape output with different input");
 }
 
+void NvDlaBackendMeta::fuseIntoConv(const Conv& conv, FusedOperators operators)
+{
+  for (const ComputeOperator* op : operators) {
+    const auto result = m_FusedIntoConv.emplace(op);
+    assert(result.second && "cannot fuse an operator into different convolutions");
+  }
+
+  m_FusedOperators[&conv] = std::move(operators);
+}
+
+const NvDlaBackendMeta::FusedOperators* NvDlaBackendMeta::getFusedOperators(const Conv& conv) const noexcept
+{
+  using std::end;
+
+  const auto found = m_FusedOperators.find(&conv);
+  return found == end(m_FusedOperators) ? nullptr : &found->second;
+}
+
+bool NvDlaBackendMeta::isFusedIntoConv(const ComputeOperator& op) const noexcept
+{
+  using std::end;
+
+  return m_FusedIntoConv.find(&op) != end(m_FusedIntoConv);
+}
+
 bool NvDlaBackendMeta::shouldOwnMemory(const Tensor& tensor)
 {
   return !isReshaped(tensor);
@@ -232,8 +267,8 @@ AddressListEntryId NvDlaBackendMeta::acquireMemory(MemoryListEntryId memoryId, O
 {
   assert(hasMemoryListEntry(memoryId));
 
-  if (hasAddressListEntry(memoryId, offset)) {
-    return getAddressListEntryId(memoryId, offset);
+  if (hasAddressListEntry(memoryId, offset, size)) {
+    return getAddressListEntryId(memoryId, offset, size);
   }
 
   AddressListEntry address;
@@ -246,7 +281,7 @@ AddressListEntryId NvDlaBackendMeta::acquireMemory(MemoryListEntryId memoryId, O
   m_AddressListEntries.emplace_back(address);
   assert(m_AddressListEntries.size() < std::numeric_limits<std::int16_t>::max());
 
-  m_AddressListEntryIds[memoryId].emplace(offset, address.id);
+  m_AddressListEntryIds[memoryId].emplace(std::make_pair(offset, size), address.id);
 
   return address.id;
 }
@@ -289,6 +324,34 @@ MemoryListEntryId NvDlaBackendMeta::tryAllocateMemoryFor(const Tensor& tensor, M
   return allocateMemoryFor(tensor, domain, flags, size, isOutput);
 }
 
+MemoryListEntryId NvDlaBackendMeta::bindMemoryFor(const Tensor& tensor, MemoryListEntryId memoryId, Offset offset,
+                                                  Size size)
+{
+  assert(hasMemoryListEntry(memoryId));
+  assert(offset + size <= getMemoryListEntrySize(memoryId) && "tensor exceeds the memory entry");
+
+  const auto result = m_MemIdxTable.emplace(&tensor, memoryId);
+  assert(result.second && "already allocated memory for this tensor");
+
+  m_PoolTable.emplace(&tensor, std::make_pair(offset, size));
+
+  return memoryId;
+}
+
+NvDlaBackendMeta::Offset NvDlaBackendMeta::getMemoryOffset(const Tensor& tensor) const noexcept
+{
+  using std::end;
+
+  const Tensor& source = isReshaped(tensor) ? getReshapeSource(tensor) : tensor;
+
+  const auto found = m_PoolTable.find(&source);
+  if (found == end(m_PoolTable)) {
+    return 0;
+  }
+
+  return found->second.first;
+}
+
 bool NvDlaBackendMeta::hasLutId(const LutParams& params) const
 {
   using std::end;
@@ -361,7 +424,7 @@ bool NvDlaBackendMeta::isLastDlaOperationInTaskEntry(const NvDlaDlaOperation& op
 
 MemoryListEntryId NvDlaBackendMeta::getInvalidMemoryListEntryId() { return static_cast<MemoryListEntryId>(-1); }
 
-bool NvDlaBackendMeta::hasAddressListEntry(MemoryListEntryId memoryId, Offset offset) const
+bool NvDlaBackendMeta::hasAddressListEntry(MemoryListEntryId memoryId, Offset offset, Size size) const
 {
   using std::end;
 
@@ -371,12 +434,13 @@ bool NvDlaBackendMeta::hasAddressListEntry(MemoryListEntryId memoryId, Offset of
   }
 
   const auto& offsetList = memoryOffsetListPair->second;
-  return offsetList.find(offset) != end(offsetList);
+  return offsetList.find(std::make_pair(offset, size)) != end(offsetList);
 }
 
-AddressListEntryId NvDlaBackendMeta::getAddressListEntryId(MemoryListEntryId memoryId, Offset offset) const
+AddressListEntryId NvDlaBackendMeta::getAddressListEntryId(MemoryListEntryId memoryId, Offset offset,
+                                                           Size size) const
 {
-  assert(hasAddressListEntry(memoryId, offset));
+  assert(hasAddressListEntry(memoryId, offset, size));
 
   using std::end;
 
@@ -386,7 +450,7 @@ AddressListEntryId NvDlaBackendMeta::getAddressListEntryId(MemoryListEntryId mem
   }
 
   const auto& offsetList = memoryOffsetListPair->second;
-  return offsetList.find(offset)->second;
+  return offsetList.find(std::make_pair(offset, size))->second;
 }
 
 //===----------------------------------------------------------------------===//
@@ -26,8 +26,11 @@
 #include <iomanip>
 #include <map>
 #include <sstream>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #ifndef UNIT_ALIGNMENT
 #  define UNIT_ALIGNMENT(x, unit) (((x) + ((unit)-1)) & ~((unit)-1))
@@ -93,6 +96,7 @@ public:
 class NvDlaBackendMeta : private NvDlaConstants
 {
 public:
+  friend class NvDlaEstimatePerformancePass;
   friend class NvDlaMemInfoPass;
   friend class NvDlaTaskSubmitPass;
 
@@ -103,9 +107,12 @@ public:
   using Size                = decltype(std::declval<AddressListEntry>().size);
   using MemoryDomain        = ILoadable::MemoryDomain;
   using MemoryFlags         = NvU8;
+  using PoolTable           = std::unordered_map<const Tensor*, std::pair<Offset, Size>>;
   using LutParams =
     std::tuple<float, float, float, std::int32_t, std::int8_t>; // alpha, beta, bias, size, lrn_exp_shift
   using LutId = std::int16_t;
+  // operators executed by the SDP stages of a convolution, in order
+  using FusedOperators = std::vector<const ComputeOperator*>;
 
   struct OperationMeta
   {
@@ -152,6 +159,9 @@ public:
   bool                   isReshaped(const Tensor& tensor) const noexcept;
   const Tensor&          getReshapeSource(const Tensor& tensor) const;
   void                   markAsReshaped(const Tensor& input, const Tensor& output);
+  void                   fuseIntoConv(const Conv& conv, FusedOperators operators);
+  const FusedOperators*  getFusedOperators(const Conv& conv) const noexcept;
+  bool                   isFusedIntoConv(const ComputeOperator& op) const noexcept;
   bool                   shouldOwnMemory(const Tensor& tensor);
   AddressListEntryId     acquireMemory(MemoryListEntryId memoryId, Offset offset);
   AddressListEntryId     acquireMemory(MemoryListEntryId memoryId, Offset offset, Size size);
@@ -160,6 +170,9 @@ public:
                                            bool isOutput = false);
   MemoryListEntryId      tryAllocateMemoryFor(const Tensor& tensor, MemoryDomain domain, MemoryFlags flags, Size size,
                                               bool isOutput = false);
+  // place tensor at [offset, offset + size) of a shared memory entry
+  MemoryListEntryId      bindMemoryFor(const Tensor& tensor, MemoryListEntryId memoryId, Offset offset, Size size);
+  Offset                 getMemoryOffset(const Tensor& tensor) const noexcept;
   bool                   hasLutId(const LutParams& params) const;
   LutId                  getLutId(const LutParams& params) const;
   bool                   addLutId(const LutParams& params, LutId id);
@@ -190,6 +203,8 @@ public:
   struct dla_network_desc         m_DlaNetworkDesc;
   int                             m_NumLUTs;
   std::vector<NvDlaDlaOperation*> m_DLAOperationList;
+  // the ONNX node each DLA operation is emitted for
+  std::vector<std::string>        m_DLAOperationNodes;
   std::vector<dla_lut_param*>     m_LUTList;
   NvDlaDlaOperation*              m_pDepOp[DLA_OP_NUM];
   NvDlaDlaOperation*              m_pPrevOp;
@@ -198,16 +213,21 @@ public:
   std::vector<NvDlaEmuOperation*> m_EMUOperationList;
 
 private:
-  bool hasAddressListEntry(MemoryListEntryId memoryId, Offset offset) const;
-  AddressListEntryId getAddressListEntryId(MemoryListEntryId memoryId, Offset offset) const;
+  bool hasAddressListEntry(MemoryListEntryId memoryId, Offset offset, Size size) const;
+  AddressListEntryId getAddressListEntryId(MemoryListEntryId memoryId, Offset offset, Size size) const;
 
 private:
   MemoryIdxTable                                   m_MemIdxTable;
+  PoolTable                                        m_PoolTable;
   RemapTable                                       m_ReshapeTable;
+  std::unordered_map<const Conv*, FusedOperators>  m_FusedOperators;
+  std::unordered_set<const ComputeOperator*>       m_FusedIntoConv;
   std::map<LutParams, LutId>                       m_LutIds;
+  // pooled tensors with disjoint lifetimes may share an offset, so an entry is
+  // keyed on its size as well
   std::map<
     MemoryListEntryId,
-    std::unordered_map<Offset, AddressListEntryId>
+    std::map<std::pair<Offset, Size>, AddressListEntryId>
   >                                                m_AddressListEntryIds;
   std::vector<OperationMeta>                       m_OperationMetas;
 
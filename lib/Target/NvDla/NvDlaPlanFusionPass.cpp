@@ -0,0 +1,134 @@
+//===- NvDlaPlanFusionPass.cpp --------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "NvDlaPlanFusionPass.h"
+
+#include "NvDlaUtil.h"
+
+#include <onnc/IR/Compute/Add.h>
+#include <onnc/IR/Compute/Initializer.h>
+#include <onnc/IR/Compute/InputOperator.h>
+#include <onnc/IR/Compute/Mul.h>
+#include <onnc/IR/Compute/OutputOperator.h>
+#include <onnc/IR/Compute/Relu.h>
+#include <onnc/Support/Casting.h>
+
+#include <vector>
+
+namespace onnc {
+
+// X1, X2 and Y
+static constexpr unsigned kNumSdpStages = 3;
+
+/// @return true if @ref pOp emits no DLA operation of its own.
+static bool IsPseudoOperator(const ComputeOperator& pOp)
+{
+  return isa<Initializer>(&pOp) || isa<InputOperator>(&pOp) || isa<OutputOperator>(&pOp);
+}
+
+/// @return the input of binary operator @ref pOp which is not @ref pResult,
+/// or nullptr if @ref pResult is not exactly one of its inputs.
+static const Tensor* GetOtherOperand(const ComputeOperator& pOp, const Tensor& pResult)
+{
+  if (pOp.getNumOfInputs() != 2)
+    return nullptr;
+
+  const Tensor* const first  = static_cast<const Tensor*>(pOp.getInput(0));
+  const Tensor* const second = static_cast<const Tensor*>(pOp.getInput(1));
+  if (first == &pResult && second != &pResult)
+    return second;
+  if (second == &pResult && first != &pResult)
+    return first;
+  return nullptr;
+}
+
+//===----------------------------------------------------------------------===//
+// NvDlaPlanFusionPass
+//===----------------------------------------------------------------------===//
+NvDlaPlanFusionPass::NvDlaPlanFusionPass(NvDlaBackendMeta& pMeta) noexcept
+  : m_Meta(pMeta)
+{}
+
+Pass::ReturnType NvDlaPlanFusionPass::runOnModule(Module& pModule)
+{
+  // CodeEmitVisitor emits DLA operations in this order.
+  std::vector<const ComputeOperator*> operators;
+  OrderMap                            order;
+  for (const ComputeOperator& cm : *pModule.getRootComputeGraph()) {
+    if (IsPseudoOperator(cm))
+      continue;
+    order.emplace(&cm, operators.size());
+    operators.push_back(&cm);
+  }
+
+  for (std::size_t idx = 0; idx < operators.size(); ++idx) {
+    const Conv* const conv = dyn_cast<Conv>(operators[idx]);
+    if (conv == nullptr || isGroupConv(*conv))
+      continue;
+
+    NvDlaBackendMeta::FusedOperators fused;
+    unsigned                         numStages = conv->hasBias() ? 1 : 0;
+    const Tensor*                    result    = conv->getOutput(0);
+
+    // Only the operators right after the convolution are fused, so nothing
+    // scheduled in between may reuse the memory of the final result, which
+    // is now written earlier.
+    for (std::size_t next = idx + 1; next < operators.size(); ++next) {
+      const ComputeOperator& op = *operators[next];
+      if (result->getUses().size() != 1 || result->getUses().front().getUser() != &op)
+        break;
+
+      if (isa<Relu>(&op)) {
+        // a ReLU without any stage before needs a pass-through stage.
+        if (numStages == 0)
+          numStages = 1;
+      } else if (isa<Add>(&op) || isa<Mul>(&op)) {
+        const Tensor* const operand = GetOtherOperand(op, *result);
+        if (numStages == kNumSdpStages || operand == nullptr || !isFusibleOperand(*operand, *result, *conv, order))
+          break;
+        ++numStages;
+      } else {
+        break;
+      }
+
+      fused.push_back(&op);
+      result = static_cast<const Tensor*>(op.getOutput(0));
+    }
+
+    if (!fused.empty()) {
+      idx += fused.size();
+      m_Meta.fuseIntoConv(*conv, std::move(fused));
+    }
+  }
+
+  return Pass::kModuleNoChanged;
+}
+
+bool NvDlaPlanFusionPass::isFusibleOperand(const Tensor& pOperand, const Tensor& pResult, const Conv& pConv,
+                                           const OrderMap& pOrder) const
+{
+  if (pResult.getNumOfDimensions() != 4)
+    return false;
+
+  const BroadcastCategory category = getBroadcastCategory(pOperand, pResult);
+  if (isConstant(pOperand))
+    return category == BroadcastCategory::LAYER || category == BroadcastCategory::CHANNEL;
+
+  if (category != BroadcastCategory::ELEMENT || m_Meta.isReshaped(pOperand))
+    return false;
+
+  // the SDP of the convolution reads the operand.
+  const ComputeOperator* const producer = getProducer(pOperand);
+  if (isa<InputOperator>(producer))
+    return true;
+
+  using std::end;
+  const auto producerOrder = pOrder.find(producer);
+  return producerOrder != end(pOrder) && producerOrder->second < pOrder.at(&pConv);
+}
+
+} // namespace onnc
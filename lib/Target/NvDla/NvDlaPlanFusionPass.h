@@ -0,0 +1,57 @@
+//===- NvDlaPlanFusionPass.h ----------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_TARGET_NVDLA_NVDLA_PLAN_FUSION_PASS_H_INCLUDED
+#define ONNC_TARGET_NVDLA_NVDLA_PLAN_FUSION_PASS_H_INCLUDED
+
+#include "NvDlaMeta.h"
+
+#include <onnc/Core/CustomPass.h>
+
+#include <unordered_map>
+
+namespace onnc {
+
+/** \class NvDlaPlanFusionPass
+ *  \brief Find the operators which can run on the SDP stages of the
+ *         preceding convolution.
+ *
+ *  A convolution always streams its result through SDP, whose X1, X2 and Y
+ *  stages each apply one ALU or multiplier operation and an optional ReLU.
+ *  X1 adds the bias. The rest take, in emission order, the Relu, Add and Mul
+ *  operators that directly follow the convolution and consume its result
+ *  alone, so the intermediate results never go through DRAM. An Add or Mul
+ *  operand must be a per-layer or per-channel constant, or a feature map of
+ *  the same shape which is computed before the convolution.
+ *
+ *  CodeEmitVisitor programs the fused operators into the SDP operation of
+ *  the convolution and emits nothing for them.
+ */
+class NvDlaPlanFusionPass : public CustomPass<NvDlaPlanFusionPass>
+{
+public:
+  NvDlaPlanFusionPass(NvDlaBackendMeta& pMeta) noexcept;
+
+  ReturnType runOnModule(Module& pModule) override;
+
+  StringRef getPassName() const override { return "NvDlaPlanFusionPass"; }
+
+private:
+  using OrderMap = std::unordered_map<const ComputeOperator*, std::size_t>;
+
+  /// @return true if @ref pOperand can feed an SDP stage which updates
+  /// @ref pResult, the running result of convolution @ref pConv.
+  bool isFusibleOperand(const Tensor& pOperand, const Tensor& pResult, const Conv& pConv,
+                        const OrderMap& pOrder) const;
+
+private:
+  NvDlaBackendMeta& m_Meta;
+};
+
+} // namespace onnc
+
+#endif
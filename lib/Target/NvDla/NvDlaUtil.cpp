@@ -8,10 +8,14 @@
 
 #include "NvDlaUtil.h"
 
+#include <onnc/Config/ONNX.h>
 #include <onnc/IR/Compute/Initializer.h>
+#include <onnc/Support/Algorithm.h>
 #include <onnc/Support/Casting.h>
+#include <onnc/Support/Match.h>
 
 #include <cassert>
+#include <vector>
 
 namespace onnc {
 
@@ -37,6 +41,84 @@ bool isConstant(const Tensor& tensor)
   return isa<Initializer>(producer);
 }
 
+std::string getNodeName(const ComputeOperator& op)
+{
+  for (unsigned idx = 0; idx < op.getNumOfGraphOperators(); ++idx) {
+    const xNode* node = op.getGraphOperator(idx);
+    if (node->has_name())
+      return node->name();
+  }
+
+  if (0 < op.getNumOfOutputs())
+    return op.getOutput(0)->getName();
+  return op.name().str();
+}
+
+BroadcastCategory getBroadcastCategory(const Tensor& fromTensor, const Tensor& toTensor)
+{
+  const Tensor::Dimensions& fromDims = fromTensor.getDimensions();
+  const Tensor::Dimensions& toDims   = toTensor.getDimensions();
+
+  if (!isConstant(fromTensor) && !isConstant(toTensor)) {
+    if (size(fromDims) == 4 && size(toDims) == 4) {
+      return (equal(fromDims, begin(toDims)) ? BroadcastCategory::ELEMENT : BroadcastCategory::UNSUPPORT);
+    } else {
+      return BroadcastCategory::UNSUPPORT;
+    }
+    // only constant tensor can broadcast to non-constant tensor
+  } else if (!isConstant(fromTensor) || isConstant(toTensor)) {
+    return BroadcastCategory::UNSUPPORT;
+  }
+
+  assert(size(toDims) == 4);
+
+  using Any     = MatchAny<Tensor::Dimension>;
+  using AnyList = std::vector<Any>;
+
+  using std::begin;
+  switch (size(fromDims)) {
+  case 4: {
+    assert(toDims[0] == 1);
+
+    const Tensor::Dimension c = toDims[1];
+    const Tensor::Dimension h = toDims[2];
+    const Tensor::Dimension w = toDims[3];
+
+    if (equal({1, 1, 1, 1}, begin(fromDims))) {
+      return BroadcastCategory::LAYER;
+    } else if (equal(asRange<AnyList>(1, c, 1, 1), begin(fromDims))) {
+      return BroadcastCategory::CHANNEL;
+    } else if (equal(asRange<AnyList>(1, c, h, w), begin(fromDims))) {
+      return BroadcastCategory::ELEMENT;
+    } else {
+      return BroadcastCategory::UNSUPPORT;
+    }
+  } break;
+  case 3: {
+    const Tensor::Dimension c = toDims[1];
+
+    if (equal({1, 1, 1}, begin(fromDims))) {
+      return BroadcastCategory::LAYER;
+    } else if (equal(asRange<AnyList>(c, 1, 1), begin(fromDims))) {
+      return BroadcastCategory::CHANNEL;
+    } else {
+      return BroadcastCategory::UNSUPPORT;
+    }
+  } break;
+  case 2: {
+    if (equal({1, 1}, begin(fromDims))) {
+      return BroadcastCategory::LAYER;
+    } else {
+      return BroadcastCategory::UNSUPPORT;
+    }
+  } break;
+  case 1:
+    return (fromDims[0] == 1 ? BroadcastCategory::LAYER : BroadcastCategory::UNSUPPORT);
+  default:
+    return BroadcastCategory::UNSUPPORT;
+  }
+}
+
 bool isBroadcastable(const Tensor& fromTensor, const Tensor& toTensor)
 {
   return isBroadcastable(fromTensor.getDimensions(), toTensor.getDimensions());
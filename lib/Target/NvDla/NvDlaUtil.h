@@ -14,8 +14,10 @@
 #include <onnc/IR/Compute/Tensor.h>
 #include <onnc/Support/Range.h>
 
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
+#include <string>
 #include <type_traits>
 
 namespace onnc {
@@ -28,6 +30,21 @@ bool isGroupConv(const Conv& conv);
 bool isDepthwiseConv(const Conv& conv);
 bool isConstant(const Tensor& tensor);
 
+/// @return the name of the ONNX node @ref op is lowered from. An operator
+/// added by the backend is named after its first output.
+std::string getNodeName(const ComputeOperator& op);
+
+enum class BroadcastCategory : std::int8_t
+{
+  UNSUPPORT = -1,
+  LAYER     = 0,
+  CHANNEL   = 1,
+  ELEMENT   = 2,
+};
+
+/// @return how the SDP broadcasts @ref fromTensor to the shape of @ref toTensor.
+BroadcastCategory getBroadcastCategory(const Tensor& fromTensor, const Tensor& toTensor);
+
 template <typename FromSizedRange, typename ToSizedRange>
 bool isBroadcastable(const FromSizedRange& fromRange, const ToSizedRange& toRange)
 {
@@ -7,12 +7,28 @@
 //===----------------------------------------------------------------------===//
 #include "NvDlaTargetMemInfo.h"
 
+#include "NvDlaMeta.h"
+
 #include <onnc/IR/Compute/Tensor.h>
 
 using namespace onnc;
 
+NvDlaTargetMemInfo::NvDlaTargetMemInfo(const NvDlaConstants& constants)
+  : NvDlaConstants{constants}
+{}
+
 MemSize NvDlaTargetMemInfo::getTensorMemorySize(const Tensor& pVal)
 {
+  if (pVal.getNumOfDimensions() <= 4) {
+    int dims[4] = {1, 1, 1, 1};
+    int idx     = 0;
+    for (auto i : pVal.getDimensions())
+      dims[idx++] = i;
+
+    const NvDlaCubeInfo cubeinfo(*this, NVDLA_CUBE_FEATURE, dims[0], dims[1], dims[2], dims[3], 0, 0);
+    return MemSize(FEATURE_ATOM_CUBE_SIZE, cubeinfo.size);
+  }
+
   uint64_t align, size;
   switch (pVal.kind()) {
   case kUint8:
@@ -7,12 +7,18 @@
 //===----------------------------------------------------------------------===//
 #ifndef ONNC_TARGET_NVDLA_MEM_INFO_H
 #define ONNC_TARGET_NVDLA_MEM_INFO_H
+#include "NvDlaDefine.h"
+
 #include <onnc/Target/TargetMemInfo.h>
 
 namespace onnc {
-class NvDlaTargetMemInfo : public TargetMemInfo
+class NvDlaTargetMemInfo : public TargetMemInfo, private NvDlaConstants
 {
 public:
+  explicit NvDlaTargetMemInfo(const NvDlaConstants& constants);
+
+  /// Feature tensors are sized by their cube layout, so that the allocated
+  /// regions can be used as offsets in the shared feature memory pool.
   MemSize getTensorMemorySize(const Tensor& pVal) override;
 };
 
@@ -37,7 +37,6 @@
 #include "Lowers/TransposeLower.h"
 #include "Lowers/UpsampleLower.h"
 #include "TG.h"
-#include <google/protobuf/text_format.h>
 #include <onnc/Analysis/UpdateGraphOutputSize.h>
 #include <onnc/IR/ONNCModulePrinter.h>
 #include <onnc/Support/Casting.h>
@@ -143,36 +142,25 @@ bool BM1880Backend::isNativeTensorType(xTensorProtoDataType pType)
 
 void BM1880Backend::setCtableProto(const std::string &pTextString)
 {
-  ::google::protobuf::TextFormat::ParseFromString(pTextString,
-                                                  &m_NetCtableParam);
+  m_Ctable.parse(pTextString);
 }
 
 BM1880Backend::LayerCtable *
 BM1880Backend::getMutableLayerCtable(const std::string &pName)
 {
-  for (int i = 0; i < m_NetCtableParam.layer_size(); i++) {
-    tg::bm1880::LayerCalibrationParameter *layer =
-        m_NetCtableParam.mutable_layer(i);
-    if (layer->name() == pName) {
-      return layer;
-    }
-  }
-  return nullptr;
+  return m_Ctable.getMutableLayer(pName);
 }
 
 const BM1880Backend::LayerCtable *
 BM1880Backend::getLayerCtable(const std::string &pName) const
 {
-  for (int i = 0; i < m_NetCtableParam.layer_size(); i++) {
-    const tg::bm1880::LayerCalibrationParameter &layer =
-        m_NetCtableParam.layer(i);
-    for (int j = 0; j < layer.blob_param_size(); j++) {
-      if (layer.blob_param(j).name() == pName) {
-        return &layer;
-      }
-    }
-  }
-  return nullptr;
+  return m_Ctable.getLayerOfBlob(pName);
+}
+
+bool BM1880Backend::getThreshold(const std::string &pName,
+                                 float &pThreshold) const
+{
+  return m_Ctable.getThreshold(pName, pThreshold);
 }
 
 std::unique_ptr<TGFuseOptimizer> BM1880Backend::getFuseOptimizr()
@@ -182,6 +170,10 @@ std::unique_ptr<TGFuseOptimizer> BM1880Backend::getFuseOptimizr()
 
 void BM1880Backend::RegisterLowers(LowerRegistry& pRegistry) const
 {
+  // TODO: SlicedConvLower is not registered, and nothing lowers the
+  // SplitGraph tilings into SlicedConv with local addresses from
+  // MemoryAllocation. Double-buffering the Load/SlicedConv/Store runs of
+  // tiled operators waits on that lowering.
   pRegistry.emplace<onnc::AddLower>();
   pRegistry.emplace<BM188X::AveragePoolLower>();
   pRegistry.emplace<onnc::BatchNormalizationLower>();
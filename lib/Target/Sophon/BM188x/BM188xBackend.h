@@ -12,6 +12,7 @@
 //===---------------------------------------------------------------------===//
 #ifndef BM188X_BACKEND_H
 #define BM188X_BACKEND_H
+#include "CalibrationTable.h"
 #include "TGBackend.h"
 #include <memory>
 #include <onnc/Target/Sophon/BM188x/common_calibration2.pb.h>
@@ -50,10 +51,21 @@ public:
 
   void setCtableProto(const std::string &pTextString) override;
 
+  /// @return the layer named @ref pName.
   LayerCtable* getMutableLayerCtable(const std::string &pName);
 
+  /// @return the layer which has a blob named @ref pName.
   const LayerCtable *getLayerCtable(const std::string &pName) const;
 
+  /// Find the threshold of blob @ref pName.
+  /// @retval false No such blob.
+  bool getThreshold(const std::string &pName, float &pThreshold) const;
+
+  const BM188X::CalibrationTable &getCalibrationTable() const
+  {
+    return m_Ctable;
+  }
+
   const TargetTransformInfo *getTTI() const override { return m_pTTI; }
 
   std::unique_ptr<TGFuseOptimizer> getFuseOptimizr() override;
@@ -61,16 +73,17 @@ public:
   /// register lowers for TensorSel.
   void RegisterLowers(LowerRegistry& pRegistry) const override;
 
+  /// Changes through the returned proto drop the index of the ctable.
   tg::bm1880::NetCalibrationParameter &getBackendCtable()
   {
-    return m_NetCtableParam;
+    return m_Ctable.getMutableProto();
   }
   std::shared_ptr<std::ostream> get_OSAsm();
   void set_OSAsm(std::shared_ptr<std::ostream> pOS);
 
 private:
   std::shared_ptr<std::ostream> m_OSAsm;
-  tg::bm1880::NetCalibrationParameter m_NetCtableParam;
+  BM188X::CalibrationTable m_Ctable;
   TargetTransformInfo *m_pTTI; // NOLINT
 };
 
@@ -17,23 +17,6 @@
 
 namespace onnc {
 
-static bool
-getTensorThreshold(const tg::bm1880::LayerCalibrationParameter *pLayerCtable,
-                   std::string pName, float *pThres)
-{
-  bool is_find_thres = false;
-  for (int i = 0; i < pLayerCtable->blob_param_size(); i++) {
-    DEBUG(dbgs() << "pName = " << pName << ", blob_name = "
-                 << pLayerCtable->blob_param(i).name() << "\n";);
-    if (pName == pLayerCtable->blob_param(i).name()) {
-      *pThres = pLayerCtable->blob_param(i).threshold_y();
-      is_find_thres = true;
-      break;
-    }
-  }
-  return is_find_thres;
-}
-
 xNode *BM188xFuseOptimizer::FuseConvScale(xGraph *pGraph,
                                           xNode *pConvNode,
                                           xNode *pScaleNode)
@@ -41,11 +24,9 @@ xNode *BM188xFuseOptimizer::FuseConvScale(xGraph *pGraph,
   // keep conv layer's output threshold because FuseConvScale will change output
   // name
   const std::string conv_output_name = pConvNode->output()->uniqueName();
-  const auto *conv_output_ctable =
-      m_p1880backend->getLayerCtable(conv_output_name);
   float conv_output_threshold;
-  if (!getTensorThreshold(conv_output_ctable, conv_output_name,
-                          &conv_output_threshold)) {
+  if (!m_p1880backend->getThreshold(conv_output_name,
+                                    conv_output_threshold)) {
     errs() << "count not find threshold in: " << conv_output_name << "\n";
     assert(0);
   }
@@ -246,6 +246,12 @@ uint64_t BM188xTargetTransformInfo::getOperatorCost(const xNode *pNode,
   return -1;
 }
 
+uint64_t BM188xTargetTransformInfo::getTransferCost(uint64_t pBytes) const
+{
+  // sync to LoadOpCost
+  return pBytes / (BUS_BITWIDTH >> 3);
+}
+
 int BM188xTargetTransformInfo::getWarpSize() const { return NPU_NUM; }
 
 int BM188xTargetTransformInfo::getProcessingUnitCount() const { return EU_NUM; }
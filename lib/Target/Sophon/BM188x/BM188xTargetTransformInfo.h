@@ -31,6 +31,8 @@ public:
   uint64_t getOperatorCost(const xNode *pNode,
                            unsigned pKind) const override;
 
+  uint64_t getTransferCost(uint64_t pBytes) const override;
+
   int getWarpSize() const override;
 
   int getProcessingUnitCount() const override;
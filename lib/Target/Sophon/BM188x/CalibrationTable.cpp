@@ -0,0 +1,125 @@
+//===- CalibrationTable.cpp -----------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "CalibrationTable.h"
+#include <google/protobuf/text_format.h>
+#include <cassert>
+
+using namespace onnc;
+using namespace onnc::BM188X;
+
+//===----------------------------------------------------------------------===//
+// CalibrationTable
+//===----------------------------------------------------------------------===//
+CalibrationTable::CalibrationTable()
+    : m_Proto(), m_LayerIndex(), m_BlobIndex(), m_IsIndexValid(false)
+{
+}
+
+bool CalibrationTable::parse(const std::string &pTextString)
+{
+  m_Proto.Clear();
+  m_IsIndexValid = false;
+  const bool result =
+      ::google::protobuf::TextFormat::ParseFromString(pTextString, &m_Proto);
+  buildIndexIfNeeded();
+  return result;
+}
+
+CalibrationTable::NetCtable &CalibrationTable::getMutableProto()
+{
+  m_IsIndexValid = false;
+  return m_Proto;
+}
+
+const CalibrationTable::LayerCtable *
+CalibrationTable::getLayer(const std::string &pName) const
+{
+  buildIndexIfNeeded();
+  auto layer = m_LayerIndex.find(pName);
+  if (layer == m_LayerIndex.end())
+    return nullptr;
+  assert(getLayer(layer->second)->name() == pName &&
+         "a layer was renamed through getMutableLayer()");
+  return getLayer(layer->second);
+}
+
+CalibrationTable::LayerCtable *
+CalibrationTable::getMutableLayer(const std::string &pName)
+{
+  buildIndexIfNeeded();
+  auto layer = m_LayerIndex.find(pName);
+  if (layer == m_LayerIndex.end())
+    return nullptr;
+  assert(getLayer(layer->second)->name() == pName &&
+         "a layer was renamed through getMutableLayer()");
+  return m_Proto.mutable_layer(layer->second);
+}
+
+const CalibrationTable::LayerCtable *
+CalibrationTable::getLayerOfBlob(const std::string &pBlobName) const
+{
+  buildIndexIfNeeded();
+  auto blob = m_BlobIndex.find(pBlobName);
+  if (blob == m_BlobIndex.end())
+    return nullptr;
+  assert(isBlobAt(pBlobName, blob->second) &&
+         "a blob was changed through getMutableLayer()");
+  return getLayer(blob->second.first);
+}
+
+const CalibrationTable::BlobCtable *
+CalibrationTable::getBlob(const std::string &pBlobName) const
+{
+  buildIndexIfNeeded();
+  auto blob = m_BlobIndex.find(pBlobName);
+  if (blob == m_BlobIndex.end())
+    return nullptr;
+  assert(isBlobAt(pBlobName, blob->second) &&
+         "a blob was changed through getMutableLayer()");
+  return &getLayer(blob->second.first)->blob_param(blob->second.second);
+}
+
+bool CalibrationTable::getThreshold(const std::string &pBlobName,
+                                    float &pThreshold) const
+{
+  const BlobCtable *blob = getBlob(pBlobName);
+  if (nullptr == blob)
+    return false;
+  pThreshold = blob->threshold_y();
+  return true;
+}
+
+void CalibrationTable::buildIndexIfNeeded() const
+{
+  if (m_IsIndexValid)
+    return;
+
+  m_LayerIndex.clear();
+  m_BlobIndex.clear();
+  m_LayerIndex.reserve(m_Proto.layer_size());
+  for (int i = 0; i < m_Proto.layer_size(); ++i) {
+    const LayerCtable &layer = m_Proto.layer(i);
+    m_LayerIndex.emplace(layer.name(), i);
+    for (int j = 0; j < layer.blob_param_size(); ++j)
+      m_BlobIndex.emplace(layer.blob_param(j).name(), BlobPosition(i, j));
+  }
+  m_IsIndexValid = true;
+}
+
+const CalibrationTable::LayerCtable *CalibrationTable::getLayer(int pIdx) const
+{
+  return &m_Proto.layer(pIdx);
+}
+
+bool CalibrationTable::isBlobAt(const std::string &pBlobName,
+                                const BlobPosition &pPosition) const
+{
+  const LayerCtable *layer = getLayer(pPosition.first);
+  return pPosition.second < layer->blob_param_size() &&
+         layer->blob_param(pPosition.second).name() == pBlobName;
+}
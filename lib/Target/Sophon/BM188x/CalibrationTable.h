@@ -0,0 +1,87 @@
+//===- CalibrationTable.h -------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_TARGET_SOPHON_BM188X_CALIBRATION_TABLE_H
+#define ONNC_TARGET_SOPHON_BM188X_CALIBRATION_TABLE_H
+#include <onnc/Target/Sophon/BM188x/common_calibration2.pb.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace onnc {
+namespace BM188X {
+
+/** \class CalibrationTable
+ *  \brief The calibration table (ctable) of a network, indexed by layer name
+ *  and by blob name.
+ *
+ *  Quantization, fusion and emission look up the ctable once per tensor, so
+ *  every query is a hash lookup. The index is built when the table is set.
+ *  Changes made through getMutableProto() may rename or reorder anything, so
+ *  they drop the index, and the next query rebuilds it.
+ *
+ *  Like the proto, a name maps to its first occurrence.
+ */
+class CalibrationTable
+{
+public:
+  using NetCtable = tg::bm1880::NetCalibrationParameter;
+  using LayerCtable = tg::bm1880::LayerCalibrationParameter;
+  using BlobCtable = tg::bm1880::BlobParameter;
+
+public:
+  CalibrationTable();
+
+  /// Replace the table with the text format proto @ref pTextString.
+  /// @retval false The text can not be parsed.
+  bool parse(const std::string &pTextString);
+
+  const NetCtable &getProto() const { return m_Proto; }
+
+  /// Allow arbitrary changes. Invalidate the index.
+  NetCtable &getMutableProto();
+
+  /// @return the layer named @ref pName.
+  const LayerCtable *getLayer(const std::string &pName) const;
+
+  /// Changes through the returned layer keep the index, so they must not
+  /// rename the layer, nor rename, add or remove its blobs. Make those
+  /// through getMutableProto(). Lookups assert the names still match.
+  LayerCtable *getMutableLayer(const std::string &pName);
+
+  /// @return the layer which has a blob named @ref pBlobName.
+  const LayerCtable *getLayerOfBlob(const std::string &pBlobName) const;
+
+  const BlobCtable *getBlob(const std::string &pBlobName) const;
+
+  /// Find the threshold of blob @ref pBlobName.
+  /// @retval false No such blob.
+  bool getThreshold(const std::string &pBlobName, float &pThreshold) const;
+
+private:
+  // layer index, blob index
+  using BlobPosition = std::pair<int, int>;
+
+  void buildIndexIfNeeded() const;
+
+  const LayerCtable *getLayer(int pIdx) const;
+
+  /// @return Whether blob @ref pBlobName is still at @ref pPosition.
+  bool isBlobAt(const std::string &pBlobName,
+                const BlobPosition &pPosition) const;
+
+private:
+  NetCtable m_Proto;
+  mutable std::unordered_map<std::string, int> m_LayerIndex;
+  mutable std::unordered_map<std::string, BlobPosition> m_BlobIndex;
+  mutable bool m_IsIndexValid;
+};
+
+} // namespace BM188X
+} // namespace onnc
+
+#endif
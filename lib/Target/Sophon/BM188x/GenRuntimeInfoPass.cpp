@@ -357,15 +357,8 @@ void GenRuntimeInfoPass::GenRest(json::Object& pOutput, const xGraph& pG)
 
 float GenRuntimeInfoPass::getThreshold(const std::string &pName)
 {
-  const tg::bm1880::LayerCalibrationParameter &ctable =
-      *backend()->getLayerCtable(pName);
   float threshold = 0.0;
-  for (int j = 0; j < ctable.blob_param_size(); j++) {
-    if (ctable.blob_param(j).name() == pName) {
-      threshold = ctable.blob_param(j).threshold_y();
-      break;
-    }
-  }
+  backend()->getThreshold(pName, threshold);
   return threshold;
 }
 
@@ -95,11 +95,12 @@ Pass::ReturnType ONNXDumpQuantized::runOnModule(Module &pModule)
 
   if (outputFile == std::string("-")) {
     // export ctable for stdout.
-    std::cout << m_pBackend->getBackendCtable().DebugString() << std::endl;
+    std::cout << m_pBackend->getCalibrationTable().getProto().DebugString()
+              << std::endl;
   } else {
     // export latest ctable
     pModule.getMetaData()["bm1880_ctable"] =
-        m_pBackend->getBackendCtable().DebugString();
+        m_pBackend->getCalibrationTable().getProto().DebugString();
 
     ExportONNX("quantized-" + outputFile, pModule);
   }
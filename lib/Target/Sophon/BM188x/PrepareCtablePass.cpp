@@ -11,10 +11,13 @@
 //
 //===---------------------------------------------------------------------===//
 #include "BM188xBackend.h"
+#include "CalibrationTable.h"
 #include <onnc/Core/CustomPass.h>
 #include <onnc/Core/PassSupport.h>
 #include <onnc/Target/Sophon/BM188x/common_calibration2.pb.h>
 #include <onnc/Config/ONNX.h>
+#include <fstream>
+#include <sstream>
 
 using namespace onnc;
 
@@ -32,8 +35,10 @@ public:
   Pass::ReturnType runOnModule(Module &pModule) override;
 
 private:
-  // insert ctable into backend
-  std::string getDummyCtable(xGraph *pGraph);
+  /// Build the default ctable of @ref pGraph, and take everything
+  /// @ref pGiven provides, such as the thresholds of a calibration run.
+  std::string getDefaultCtable(xGraph *pGraph,
+                               const BM188X::CalibrationTable *pGiven);
 
 private:
   BM1880Backend *m_pBackend; // NOLINT
@@ -44,13 +49,26 @@ private:
 Pass::ReturnType PrepareCtable::runOnModule(Module &pModule)
 {
   auto ctable = m_pBackend->getCtable(pModule);
-  if (m_pBackend->options().shouldUseDummyCTable()) {
+  const Path &ctableFile = m_pBackend->options().calibrationTable();
+  if (!ctableFile.empty()) {
+    // A calibration run may provide only the thresholds. Fill the rest with
+    // the defaults.
+    std::ifstream file(ctableFile.native());
+    std::stringstream text;
+    text << file.rdbuf();
+    BM188X::CalibrationTable given;
+    if (!file.good() || !given.parse(text.str())) {
+      std::cerr << "error: can not read ctable " << ctableFile << std::endl;
+      exit(1);
+    }
+    ctable = getDefaultCtable(pModule.getGraphIR().get(), &given);
+  } else if (m_pBackend->options().shouldUseDummyCTable()) {
     if (!ctable.empty()) {
       std::cerr << "error: ctable exist!" << std::endl;
       exit(1);
     }
     xGraph *graph = pModule.getGraphIR().get();
-    ctable = getDummyCtable(graph);
+    ctable = getDefaultCtable(graph, nullptr);
   } else {
     if (ctable.empty()) {
       std::cerr << "error: ctable not found!" << std::endl;
@@ -61,7 +79,9 @@ Pass::ReturnType PrepareCtable::runOnModule(Module &pModule)
   return Pass::kModuleNoChanged;
 }
 
-std::string PrepareCtable::getDummyCtable(xGraph *pGraph)
+std::string
+PrepareCtable::getDefaultCtable(xGraph *pGraph,
+                                const BM188X::CalibrationTable *pGiven)
 {
   tg::bm1880::NetCalibrationParameter net_ctable_param;
   net_ctable_param.set_name(pGraph->name());
@@ -159,6 +179,35 @@ std::string PrepareCtable::getDummyCtable(xGraph *pGraph)
     }
   }
 
+  if (nullptr != pGiven) {
+    for (int i = 0; i < net_ctable_param.layer_size(); ++i) {
+      tg::bm1880::LayerCalibrationParameter *layer =
+          net_ctable_param.mutable_layer(i);
+      const auto *given = pGiven->getLayer(layer->name());
+      if (nullptr == given)
+        continue;
+      // blobs are matched by name, since a layer may own blobs the given
+      // table does not know about (e.g. the "sq" blob of LRN).
+      for (const auto &blob : given->blob_param()) {
+        tg::bm1880::BlobParameter *target = nullptr;
+        for (int j = 0; j < layer->blob_param_size(); ++j) {
+          if (layer->blob_param(j).name() == blob.name()) {
+            target = layer->mutable_blob_param(j);
+            break;
+          }
+        }
+        if (nullptr == target)
+          target = layer->add_blob_param();
+        target->CopyFrom(blob);
+      }
+      tg::bm1880::LayerCalibrationParameter rest(*given);
+      rest.clear_blob_param();
+      if (0 < rest.threshold_x_quantized_size())
+        layer->clear_threshold_x_quantized();
+      layer->MergeFrom(rest);
+    }
+  }
+
   return net_ctable_param.DebugString();
 }
 
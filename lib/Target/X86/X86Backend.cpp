@@ -57,7 +57,7 @@
 #include <onnc/Transforms/TensorSel/Standards/GlobalLpPoolLower.h>
 #include <onnc/Transforms/TensorSel/Standards/GlobalMaxPoolLower.h>
 #include <onnc/Transforms/TensorSel/Standards/GreaterLower.h>
-// TODO: #include <onnc/Transforms/TensorSel/Standards/GruLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GRULower.h>
 // TODO: #include <onnc/Transforms/TensorSel/Standards/GruUnitLower.h>
 #include <onnc/Transforms/TensorSel/Standards/HardmaxLower.h>
 #include <onnc/Transforms/TensorSel/Standards/HardSigmoidLower.h>
@@ -73,7 +73,7 @@
 #include <onnc/Transforms/TensorSel/Standards/LpNormalizationLower.h>
 #include <onnc/Transforms/TensorSel/Standards/LpPoolLower.h>
 #include <onnc/Transforms/TensorSel/Standards/LRNLower.h>
-// TODO: #include <onnc/Transforms/TensorSel/Standards/LSTMLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LSTMLower.h>
 #include <onnc/Transforms/TensorSel/Standards/MatMulLower.h>
 #include <onnc/Transforms/TensorSel/Standards/MaxLower.h>
 #include <onnc/Transforms/TensorSel/Standards/MaxPoolLower.h>
@@ -107,7 +107,7 @@
 #include <onnc/Transforms/TensorSel/Standards/ReduceSumSquareLower.h>
 #include <onnc/Transforms/TensorSel/Standards/ReluLower.h>
 #include <onnc/Transforms/TensorSel/Standards/ReshapeLower.h>
-// TODO: #include <onnc/Transforms/TensorSel/Standards/RnnLower.h>
+#include <onnc/Transforms/TensorSel/Standards/RNNLower.h>
 #include <onnc/Transforms/TensorSel/Standards/ScaleLower.h>
 #include <onnc/Transforms/TensorSel/Standards/ScaledTanhLower.h>
 // TODO: #include <onnc/Transforms/TensorSel/Standards/ScanLower.h>
@@ -164,6 +164,16 @@ void X86Backend::addTensorSel(PassManager& pPM)
   }
 }
 
+void X86Backend::addOnncIrOptimization(PassManager& pPM, OptimizationOptions& options)
+{
+  // Merge duplicated nodes and weights before LiveIntervals, so that they
+  // take no buffer.
+  options.defaultEnable(OptimizationOption::eliminate_common_subexpression);
+  options.defaultEnable(OptimizationOption::eliminate_duplicate_initializer);
+
+  NPUTargetBackend::addOnncIrOptimization(pPM, options);
+}
+
 void X86Backend::addMemAlloc(PassManager& pPM)
 {
   // Fuse inplace value pairs before liveness analysis, because this pass may
@@ -236,7 +246,7 @@ void X86Backend::RegisterLowers(LowerRegistry& pRegistry) const
   pRegistry.emplace<GlobalLpPoolLower>();
   pRegistry.emplace<GlobalMaxPoolLower>();
   pRegistry.emplace<GreaterLower>();
-  // TODO: pRegistry.emplace<GruLower>();
+  pRegistry.emplace<GRULower>();
   // TODO: pRegistry.emplace<GruUnitLower>();
   pRegistry.emplace<HardmaxLower>();
   pRegistry.emplace<HardSigmoidLower>();
@@ -252,7 +262,7 @@ void X86Backend::RegisterLowers(LowerRegistry& pRegistry) const
   pRegistry.emplace<LpNormalizationLower>();
   pRegistry.emplace<LpPoolLower>();
   pRegistry.emplace<LRNLower>();
-  // TODO: pRegistry.emplace<LSTMLower>();
+  pRegistry.emplace<LSTMLower>();
   pRegistry.emplace<MatMulLower>();
   pRegistry.emplace<MaxLower>();
   pRegistry.emplace<MaxPoolLower>();
@@ -286,7 +296,7 @@ void X86Backend::RegisterLowers(LowerRegistry& pRegistry) const
   pRegistry.emplace<ReduceSumSquareLower>();
   pRegistry.emplace<ReluLower>();
   pRegistry.emplace<ReshapeLower>();
-  // TODO: pRegistry.emplace<RNNLower>();
+  pRegistry.emplace<RNNLower>();
   pRegistry.emplace<ScaleLower>();
   pRegistry.emplace<ScaledTanhLower>();
   // TODO: pRegistry.emplace<ScanLower>();
@@ -21,6 +21,8 @@ public:
 
   void addTensorSel(PassManager& pPM) override;
 
+  void addOnncIrOptimization(PassManager& pPM, OptimizationOptions& options) override;
+
   void addMemAlloc(PassManager& pPM) override;
 
   void addCodeEmit(PassManager& pPM, const Path& pOutput) override;
@@ -0,0 +1,144 @@
+//===- EliminateCommonSubexpression.cpp -----------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Core/PassSupport.h>
+#include <onnc/IR/Compute/Constant.h>
+#include <onnc/IR/Compute/Dropout.h>
+#include <onnc/IR/Compute/If.h>
+#include <onnc/IR/Compute/Initializer.h>
+#include <onnc/IR/Compute/InputOperator.h>
+#include <onnc/IR/Compute/Loop.h>
+#include <onnc/IR/Compute/Multinomial.h>
+#include <onnc/IR/Compute/OutputOperator.h>
+#include <onnc/IR/Compute/RandomNormal.h>
+#include <onnc/IR/Compute/RandomNormalLike.h>
+#include <onnc/IR/Compute/RandomUniform.h>
+#include <onnc/IR/Compute/RandomUniformLike.h>
+#include <onnc/IR/Compute/Scan.h>
+#include <onnc/Transforms/Optimizations/EliminateCommonSubexpression.h>
+
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+using namespace onnc;
+
+/// Operators which must not be merged even if they look the same.
+static bool IsMergeable(const ComputeOperator& pOp)
+{
+  // graph boundaries and weights. Initializers are merged by
+  // EliminateDuplicateInitializer.
+  if (isa<InputOperator>(&pOp) || isa<OutputOperator>(&pOp) ||
+      isa<Initializer>(&pOp) || isa<Constant>(&pOp))
+    return false;
+
+  // every execution produces different values.
+  if (isa<RandomNormal>(&pOp) || isa<RandomNormalLike>(&pOp) ||
+      isa<RandomUniform>(&pOp) || isa<RandomUniformLike>(&pOp) ||
+      isa<Multinomial>(&pOp) || isa<Dropout>(&pOp))
+    return false;
+
+  // subgraph attributes print only their names, so the printed attributes
+  // can not tell two bodies apart.
+  if (isa<If>(&pOp) || isa<Loop>(&pOp) || isa<Scan>(&pOp))
+    return false;
+
+  return !pOp.isOutputEmpty();
+}
+
+static bool IsGraphOutput(const ComputeOperator& pOp)
+{
+  for (unsigned int i = 0; i < pOp.getNumOfOutputs(); ++i)
+    for (const Use& use : pOp.getOutput(i)->getUses())
+      if (isa<OutputOperator>(use.getUser()))
+        return true;
+  return false;
+}
+
+//===----------------------------------------------------------------------===//
+// EliminateCommonSubexpression
+//===----------------------------------------------------------------------===//
+Pass::ReturnType EliminateCommonSubexpression::runOnModule(Module& pModule)
+{
+  Pass::ReturnType    ret = Pass::kModuleNoChanged;
+  Module::cg_iterator cg, cgEnd = pModule.cgEnd();
+  for (cg = pModule.cgBegin(); cg != cgEnd; ++cg) {
+    ret |= runOnComputeGraph(*cg->value());
+  }
+
+  if (ret != Pass::kModuleNoChanged) {
+    pModule.eraseUnusedValues();
+  }
+
+  return ret;
+}
+
+Pass::ReturnType EliminateCommonSubexpression::runOnComputeGraph(ComputeGraph& pCG)
+{
+  // Operators are visited in topological order, so the inputs of an operator
+  // have been merged before the operator itself is hashed.
+  std::unordered_map<std::string, ComputeOperator*> available;
+  std::vector<ComputeOperator*> listOfDuplicatedNodes;
+  for (ComputeOperator& node : pCG) {
+    std::string key;
+    if (!GetKey(node, key))
+      continue;
+
+    auto found = available.find(key);
+    if (found == available.end()) {
+      available.emplace(std::move(key), &node);
+      continue;
+    }
+
+    // keep the names of the graph outputs.
+    if (IsGraphOutput(node))
+      continue;
+
+    ComputeOperator* pOrigin = found->second;
+    for (unsigned int i = 0; i < node.getNumOfOutputs(); ++i)
+      node.getOutput(i)->replaceAllUsesWith(*pOrigin->getOutput(i));
+    listOfDuplicatedNodes.emplace_back(&node);
+  }
+
+  // Early return
+  if (listOfDuplicatedNodes.empty()) {
+    return Pass::kModuleNoChanged;
+  }
+
+  for (ComputeOperator* pNode : listOfDuplicatedNodes) {
+    pNode->removeAllInputs();
+    pNode->removeAllOutputs();
+    pCG.erase(*pNode);
+  }
+
+  pCG.topologicalSort();
+  return Pass::kModuleChanged;
+}
+
+bool EliminateCommonSubexpression::GetKey(const ComputeOperator& pOp,
+                                          std::string& pKey)
+{
+  if (!IsMergeable(pOp))
+    return false;
+
+  // Attributes are compared by their printed form. Print floating point
+  // values with full precision, so that different values never collide.
+  std::ostringstream attributes;
+  attributes.precision(std::numeric_limits<double>::max_digits10);
+  pOp.printAttributes(attributes);
+  if (attributes.str() == "<unimplemented>")
+    return false;
+
+  std::ostringstream key;
+  key << pOp.getID() << ':' << pOp.getNumOfOutputs() << ':' << attributes.str();
+  for (unsigned int i = 0; i < pOp.getNumOfInputs(); ++i)
+    key << ':' << static_cast<const void*>(pOp.getInput(i));
+
+  pKey = key.str();
+  return true;
+}
@@ -0,0 +1,187 @@
+//===- EliminateDuplicateInitializer.cpp ----------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Core/PassSupport.h>
+#include <onnc/IR/Compute/Initializer.h>
+#include <onnc/IR/Compute/OutputOperator.h>
+#include <onnc/Transforms/Optimizations/EliminateDuplicateInitializer.h>
+#include <onnc/Transforms/Optimizations/OptimizationsUtils.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+using namespace onnc;
+
+namespace {
+
+/// Hash the values of a tensor by their bytes.
+class HashValues
+{
+public:
+  explicit HashValues(size_t& pHash) : m_Hash(pHash) { }
+
+  template <typename TensorType>
+  void operator()(const TensorType* pTensor) const {
+    // FNV-1a over the bytes, without copying the weight.
+    const auto& values = pTensor->getValues();
+    const unsigned char* bytes =
+        reinterpret_cast<const unsigned char*>(values.data());
+    const size_t size = values.size() * sizeof(typename TensorType::ValueType);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i)
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    combine(static_cast<size_t>(hash));
+  }
+
+  void operator()(const BooleanTensor* pTensor) const {
+    for (bool value : pTensor->getValues())
+      combine(value);
+  }
+
+  void operator()(const StringTensor* pTensor) const {
+    for (const std::string& value : pTensor->getValues())
+      combine(std::hash<std::string>()(value));
+  }
+
+private:
+  void combine(size_t pValue) const {
+    m_Hash ^= pValue + 0x9e3779b9 + (m_Hash << 6) + (m_Hash >> 2);
+  }
+
+private:
+  size_t& m_Hash;
+};
+
+/// Compare the values of two tensors of the same kind. Floating point values
+/// are compared by their bytes, so 0.0 and -0.0 differ and NaNs are equal.
+class SameValues
+{
+public:
+  SameValues(const Tensor& pOther, bool& pResult)
+    : m_Other(pOther), m_Result(pResult) {
+  }
+
+  template <typename TensorType>
+  void operator()(const TensorType* pTensor) const {
+    const auto& lhs = pTensor->getValues();
+    const auto& rhs = static_cast<const TensorType&>(m_Other).getValues();
+    m_Result = (lhs.size() == rhs.size()) &&
+        (0 == std::memcmp(lhs.data(), rhs.data(),
+                          lhs.size() * sizeof(typename TensorType::ValueType)));
+  }
+
+  void operator()(const BooleanTensor* pTensor) const {
+    m_Result = (pTensor->getValues() ==
+                static_cast<const BooleanTensor&>(m_Other).getValues());
+  }
+
+  void operator()(const StringTensor* pTensor) const {
+    m_Result = (pTensor->getValues() ==
+                static_cast<const StringTensor&>(m_Other).getValues());
+  }
+
+private:
+  const Tensor& m_Other;
+  bool& m_Result;
+};
+
+} // anonymous namespace
+
+static size_t GetHash(const Tensor& pTensor)
+{
+  size_t hash = std::hash<int>()(pTensor.kind());
+  for (Tensor::Dimension dim : pTensor.getDimensions())
+    hash = hash * 31 + std::hash<Tensor::Dimension>()(dim);
+  internal::visitTensorWithFunc<PP_UNWRAP(ALL_TENSORTYPE_LIST)>(&pTensor, HashValues(hash));
+  return hash;
+}
+
+static bool IsSame(const Tensor& pA, const Tensor& pB)
+{
+  if (pA.kind() != pB.kind() || pA.getDimensions() != pB.getDimensions())
+    return false;
+
+  bool result = false;
+  internal::visitTensorWithFunc<PP_UNWRAP(ALL_TENSORTYPE_LIST)>(&pA, SameValues(pB, result));
+  return result;
+}
+
+static bool IsGraphOutput(const Value& pValue)
+{
+  for (const Use& use : pValue.getUses())
+    if (isa<OutputOperator>(use.getUser()))
+      return true;
+  return false;
+}
+
+//===----------------------------------------------------------------------===//
+// EliminateDuplicateInitializer
+//===----------------------------------------------------------------------===//
+Pass::ReturnType EliminateDuplicateInitializer::runOnModule(Module& pModule)
+{
+  Pass::ReturnType    ret = Pass::kModuleNoChanged;
+  Module::cg_iterator cg, cgEnd = pModule.cgEnd();
+  for (cg = pModule.cgBegin(); cg != cgEnd; ++cg) {
+    ret |= runOnComputeGraph(*cg->value());
+  }
+
+  if (ret != Pass::kModuleNoChanged) {
+    pModule.eraseUnusedValues();
+  }
+
+  return ret;
+}
+
+Pass::ReturnType EliminateDuplicateInitializer::runOnComputeGraph(ComputeGraph& pCG)
+{
+  std::unordered_multimap<size_t, Initializer*> available;
+  std::vector<Initializer*> listOfDuplicatedNodes;
+  for (ComputeOperator& node : pCG) {
+    Initializer* pInit = dyn_cast<Initializer>(&node);
+    if (nullptr == pInit || pInit->isOutputEmpty())
+      continue;
+
+    Tensor* pTensor = pInit->getTensor<Tensor>();
+    const size_t hash = GetHash(*pTensor);
+
+    Initializer* pOrigin = nullptr;
+    auto range = available.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (IsSame(*it->second->getTensor<Tensor>(), *pTensor)) {
+        pOrigin = it->second;
+        break;
+      }
+    }
+
+    if (nullptr == pOrigin) {
+      available.emplace(hash, pInit);
+      continue;
+    }
+
+    // keep the names of the graph outputs.
+    if (IsGraphOutput(*pTensor))
+      continue;
+
+    pTensor->replaceAllUsesWith(*pOrigin->getTensor<Tensor>());
+    listOfDuplicatedNodes.emplace_back(pInit);
+  }
+
+  // Early return
+  if (listOfDuplicatedNodes.empty()) {
+    return Pass::kModuleNoChanged;
+  }
+
+  for (Initializer* pNode : listOfDuplicatedNodes) {
+    pNode->removeAllOutputs();
+    pCG.erase(*pNode);
+  }
+
+  return Pass::kModuleChanged;
+}
@@ -54,12 +54,16 @@ Pass::ReturnType TensorSel::runOnGraphs(xGraph& pTG, ComputeGraph& pCG)
       fatal(no_corre_lower) << detail::getDisplayName(**tg_node);
       return Pass::kPassFailure;
     }
-    if (nullptr == lower->activate(pCG, **tg_node)) {
+    ComputeOperator* op = lower->activate(pCG, **tg_node);
+    if (nullptr == op) {
       errs() << "Failed to lowering: ";
       if (tg_node->has_name())
         errs() << tg_node->name() << ", ";
       errs() << "node type = " << tg_node->kind().toString() << "\n";
+      continue;
     }
+    // remember the ONNX node, so that backends report the operator by its name
+    op->connect(**tg_node);
   }
   return Pass::kModuleChanged;
 }
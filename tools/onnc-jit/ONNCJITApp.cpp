@@ -62,8 +62,15 @@ int ONNCJITApp::run()
   backend->addMemAlloc(pm);
   backend->addCodeEmit(pm, options().output());
 
+  PassTimingInfo timing;
+  if (options().timePasses())
+    pm.setTimingInfo(&timing);
+
   pm.run(module);
 
+  if (options().timePasses())
+    timing.print(errs(), options().timePassesFormat());
+
   // TODO: just-in-time interpreter starts from here
   return EXIT_SUCCESS;
 }
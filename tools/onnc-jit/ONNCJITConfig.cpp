@@ -13,7 +13,8 @@ using namespace onnc;
 // ONNCJITConfig
 //===----------------------------------------------------------------------===//
 ONNCJITConfig::ONNCJITConfig()
-  : m_Input(), m_Output(), m_Quadruple(), m_Arch(), m_TargetOptions() {
+  : m_Input(), m_Output(), m_Quadruple(), m_Arch(), m_TargetOptions(),
+    m_TimePasses(false), m_TimePassesFormat(PassTimingInfo::kTable) {
 }
 
 ONNCJITConfig::~ONNCJITConfig()
@@ -8,6 +8,7 @@
 #ifndef ONNC_JUST_IN_TIME_INTERPRETER_ONNC_CONFIG_H
 #define ONNC_JUST_IN_TIME_INTERPRETER_ONNC_CONFIG_H
 #include <onnc/Core/Application.h>
+#include <onnc/Core/PassTimingInfo.h>
 #include <onnc/Support/Path.h>
 #include <onnc/IR/Quadruple.h>
 #include <onnc/Target/TargetOptions.h>
@@ -59,6 +60,14 @@ public:
 
   unsigned int verbose() const { return m_Verbose; }
 
+  void setTimePasses(bool pEnable) { m_TimePasses = pEnable; }
+
+  bool timePasses() const { return m_TimePasses; }
+
+  void setTimePassesFormat(onnc::PassTimingInfo::Format pFormat) { m_TimePassesFormat = pFormat; }
+
+  onnc::PassTimingInfo::Format timePassesFormat() const { return m_TimePassesFormat; }
+
 private:
   onnc::Path m_Input;
   onnc::Path m_Output;
@@ -66,6 +75,8 @@ private:
   std::string m_Arch;
   onnc::TargetOptions m_TargetOptions;
   unsigned int m_Verbose;
+  bool m_TimePasses;
+  onnc::PassTimingInfo::Format m_TimePassesFormat;
 };
 
 #endif
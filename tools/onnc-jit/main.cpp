@@ -64,6 +64,18 @@ static cl::opt<std::string> OptQuadruple("mquadruple", cl::kShort, cl::kOptional
 static cl::opt<std::string> OptMArch("march", cl::kShort, cl::kOptional,
     cl::kValueRequired, cl::desc("target architecture"), cl::about(g_About));
 
+static cl::opt<bool>
+OptTimePasses("time-passes", cl::kLong, cl::kOptional, cl::kValueDisallowed,
+    cl::init(false),
+    cl::desc("Time each pass and print the report to stderr."),
+    cl::about(g_About));
+
+static cl::opt<bool>
+OptTimePassesJSON("time-passes-json", cl::kLong, cl::kOptional,
+    cl::kValueDisallowed, cl::init(false),
+    cl::desc("Print the --time-passes report in JSON."),
+    cl::about(g_About));
+
 //===----------------------------------------------------------------------===//
 // Main Procedure
 //===----------------------------------------------------------------------===//
@@ -83,6 +95,11 @@ int main(int pArgc, char* pArgv[])
   if (OptQuiet)
     jit.options().setVerbose(0);
 
+  // --time-passes
+  jit.options().setTimePasses(OptTimePasses || OptTimePassesJSON);
+  if (OptTimePassesJSON)
+    jit.options().setTimePassesFormat(PassTimingInfo::kJSON);
+
   // --help
   if (OptHelp) {
     g_About.print(outs(), ONNCJITConfig::kNormal < jit.options().verbose());
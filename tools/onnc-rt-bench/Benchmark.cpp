@@ -0,0 +1,187 @@
+//===- Benchmark.cpp ------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+using namespace onnc;
+using namespace onnc::bench;
+
+//===----------------------------------------------------------------------===//
+// Tensor
+//===----------------------------------------------------------------------===//
+Tensor::Tensor(const Dims& pDims)
+  : m_Dims(pDims) {
+  size_t size = 1;
+  for (int32_t dim : m_Dims)
+    size *= dim;
+  m_Data.resize(size);
+
+  // A linear congruential generator, so that every run sees the same data.
+  uint32_t state = 0x9e3779b9u ^ size;
+  for (float& value : m_Data) {
+    state = state * 1664525u + 1013904223u;
+    value = ((state >> 8) + 0.5f) / (1u << 24);
+  }
+}
+
+TensorPtr bench::MakeTensor(const Tensor::Dims& pDims)
+{
+  return std::make_shared<Tensor>(pDims);
+}
+
+//===----------------------------------------------------------------------===//
+// Case
+//===----------------------------------------------------------------------===//
+std::string Case::name() const
+{
+  return op + "/" + variant + "/" + shape;
+}
+
+//===----------------------------------------------------------------------===//
+// Suite
+//===----------------------------------------------------------------------===//
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/// @return The duration of @ref pCalls calls, in nanoseconds.
+double TimeCalls(const Case& pCase, unsigned long pCalls)
+{
+  const Clock::time_point start = Clock::now();
+  for (unsigned long i = 0; i < pCalls; ++i)
+    pCase.run();
+  const Clock::duration elapsed = Clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+void PrintJSONString(OStream& pOS, const std::string& pString)
+{
+  pOS << '"';
+  for (char c : pString) {
+    if ('"' == c || '\\' == c)
+      pOS << '\\';
+    pOS << c;
+  }
+  pOS << '"';
+}
+
+} // anonymous namespace
+
+Suite::Suite()
+  : m_Cases(), m_Results(), m_Warmup(3), m_Repeat(10), m_MinTime(10.0),
+    m_Filter() {
+}
+
+bool Suite::isSelected(const Case& pCase) const
+{
+  return m_Filter.empty() ||
+         std::string::npos != pCase.name().find(m_Filter);
+}
+
+void Suite::run(OStream& pLog)
+{
+  m_Results.clear();
+  for (const Case& c : m_Cases) {
+    if (!isSelected(c))
+      continue;
+    pLog << "running " << c.name() << std::endl;
+    m_Results.push_back(measure(c));
+  }
+}
+
+Result Suite::measure(const Case& pCase) const
+{
+  // The first call also builds the cached primitives of MKL-DNN.
+  double single = 0.0;
+  for (unsigned int i = 0; i < std::max(m_Warmup, 1u); ++i)
+    single = TimeCalls(pCase, 1);
+
+  const double minTime = m_MinTime * 1e6;
+  unsigned long calls = 1;
+  if (single > 0.0 && single < minTime)
+    calls = static_cast<unsigned long>(std::ceil(minTime / single));
+
+  std::vector<double> samples;
+  for (unsigned int i = 0; i < std::max(m_Repeat, 1u); ++i)
+    samples.push_back(TimeCalls(pCase, calls) / calls);
+  std::sort(samples.begin(), samples.end());
+
+  Result result;
+  result.target = &pCase;
+  result.samples = samples.size();
+  result.calls = calls * samples.size();
+  result.min = samples.front();
+
+  const size_t half = samples.size() / 2;
+  result.median = (0 == samples.size() % 2) ?
+                  (samples[half - 1] + samples[half]) / 2 : samples[half];
+
+  double sum = 0.0;
+  for (double s : samples)
+    sum += s;
+  result.mean = sum / samples.size();
+
+  double squares = 0.0;
+  for (double s : samples)
+    squares += (s - result.mean) * (s - result.mean);
+  result.stddev = (1 < samples.size()) ?
+                  std::sqrt(squares / (samples.size() - 1)) : 0.0;
+  return result;
+}
+
+void Suite::print(OStream& pOS, Format pFormat) const
+{
+  std::ios::fmtflags flags(pOS.flags());
+
+  if (kJSON == pFormat) {
+    pOS << "[" << std::setprecision(6);
+    for (std::vector<Result>::const_iterator r = m_Results.begin();
+         r != m_Results.end(); ++r) {
+      pOS << (r == m_Results.begin() ? "\n" : ",\n") << "  { \"op\": ";
+      PrintJSONString(pOS, r->target->op);
+      pOS << ", \"variant\": ";
+      PrintJSONString(pOS, r->target->variant);
+      pOS << ", \"shape\": ";
+      PrintJSONString(pOS, r->target->shape);
+      pOS << ", \"flops\": " << r->target->flops
+          << ", \"bytes\": " << r->target->bytes
+          << ", \"samples\": " << r->samples
+          << ", \"calls\": " << r->calls
+          << ", \"min-ns\": " << r->min
+          << ", \"median-ns\": " << r->median
+          << ", \"mean-ns\": " << r->mean
+          << ", \"stddev-ns\": " << r->stddev
+          << ", \"gflops\": " << r->gflops()
+          << ", \"gbytes-per-s\": " << r->gbytes() << " }";
+    }
+    pOS << "\n]" << std::endl;
+    pOS.flags(flags);
+    return;
+  }
+
+  pOS << "===---------------------------------------------------------===\n"
+      << "                  Runtime kernel benchmark report\n"
+      << "===---------------------------------------------------------===\n"
+      << std::setw(12) << "Median (us)" << std::setw(9) << "+-%"
+      << std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s"
+      << "  Name\n" << std::fixed;
+  for (const Result& r : m_Results) {
+    pOS << std::setw(12) << std::setprecision(3) << r.median / 1e3
+        << std::setw(8) << std::setprecision(1)
+        << (0.0 == r.mean ? 0.0 : 100.0 * r.stddev / r.mean) << '%'
+        << std::setw(10) << std::setprecision(2) << r.gflops()
+        << std::setw(10) << r.gbytes()
+        << "  " << r.target->name() << '\n';
+  }
+  pOS << std::flush;
+  pOS.flags(flags);
+}
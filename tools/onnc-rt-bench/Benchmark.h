@@ -0,0 +1,154 @@
+//===- Benchmark.h --------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_RT_BENCH_BENCHMARK_H
+#define ONNC_RT_BENCH_BENCHMARK_H
+#include <onnc/Support/OStream.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace onnc {
+namespace bench {
+
+/** \class Tensor
+ *  \brief A dense float tensor in the layout the runtime passes around,
+ *         filled with reproducible values in (0, 1).
+ *
+ *  (0, 1) is in the domain of every kernel, e.g. Log, Sqrt and Acos.
+ */
+class Tensor
+{
+public:
+  typedef std::vector<int32_t> Dims;
+
+public:
+  explicit Tensor(const Dims& pDims);
+
+  float* data() { return m_Data.data(); }
+
+  int32_t ndim() const { return m_Dims.size(); }
+
+  const int32_t* dims() const { return m_Dims.data(); }
+
+  /// @return The number of elements.
+  size_t size() const { return m_Data.size(); }
+
+  /// @return The number of bytes.
+  double bytes() const { return sizeof(float) * size(); }
+
+private:
+  Dims m_Dims;
+  std::vector<float> m_Data;
+};
+
+typedef std::shared_ptr<Tensor> TensorPtr;
+
+/// Create a tensor which is shared by the kernel calls of a case.
+TensorPtr MakeTensor(const Tensor::Dims& pDims);
+
+/** \class Case
+ *  \brief One kernel entry point on one shape.
+ *
+ *  @ref flops and @ref bytes are the nominal work of one call: the
+ *  multiply-adds count as two operations, an element-wise function as one,
+ *  and every input and output is read or written once.
+ */
+struct Case
+{
+  std::string op;
+  std::string variant;
+  std::string shape;
+  double flops;
+  double bytes;
+  std::function<void()> run;
+
+  /// @return "op/variant/shape", the name @ref Suite filters by.
+  std::string name() const;
+};
+
+/** \class Result
+ *  \brief The statistics of the time per call of a case, in nanoseconds.
+ */
+struct Result
+{
+  const Case* target;
+  unsigned int samples;
+  unsigned long calls;
+  double min;
+  double median;
+  double mean;
+  double stddev;
+
+  double gflops() const { return target->flops / median; }
+
+  double gbytes() const { return target->bytes / median; }
+};
+
+/** \class Suite
+ *  \brief Measure each case by a few warmup calls, then by repeated samples.
+ *
+ *  A sample times enough consecutive calls to last @ref setMinTime, so that
+ *  the clock resolution does not matter for short kernels. The time per call
+ *  of a sample is the sample divided by its calls.
+ */
+class Suite
+{
+public:
+  enum Format {
+    kText,
+    kJSON
+  };
+
+public:
+  Suite();
+
+  void add(const Case& pCase) { m_Cases.push_back(pCase); }
+
+  const std::vector<Case>& cases() const { return m_Cases; }
+
+  void setWarmup(unsigned int pWarmup) { m_Warmup = pWarmup; }
+
+  void setRepeat(unsigned int pRepeat) { m_Repeat = pRepeat; }
+
+  /// Set the minimal duration of a sample, in milliseconds.
+  void setMinTime(double pMinTime) { m_MinTime = pMinTime; }
+
+  /// Only run the cases whose name contains @ref pFilter.
+  void setFilter(const std::string& pFilter) { m_Filter = pFilter; }
+
+  bool isSelected(const Case& pCase) const;
+
+  /// Run the selected cases. The progress is reported to @ref pLog.
+  void run(OStream& pLog);
+
+  void print(OStream& pOS, Format pFormat) const;
+
+private:
+  Result measure(const Case& pCase) const;
+
+private:
+  std::vector<Case> m_Cases;
+  std::vector<Result> m_Results;
+  unsigned int m_Warmup;
+  unsigned int m_Repeat;
+  double m_MinTime;
+  std::string m_Filter;
+};
+
+/// Add the cases of every benchmarked kernel.
+/// @param pContext The ONNC Runtime Context passed to every kernel.
+void AddKernels(Suite& pSuite, void* pContext);
+
+} // namespace of bench
+} // namespace of onnc
+
+#endif
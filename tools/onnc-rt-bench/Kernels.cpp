@@ -0,0 +1,818 @@
+//===- Kernels.cpp --------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "Benchmark.h"
+
+#include <initializer_list>
+#include <sstream>
+
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/onnc-runtime.h>
+#include <onnc/Runtime/operator/abs.h>
+#include <onnc/Runtime/operator/acos.h>
+#include <onnc/Runtime/operator/add.h>
+#include <onnc/Runtime/operator/and.h>
+#include <onnc/Runtime/operator/asin.h>
+#include <onnc/Runtime/operator/atan.h>
+#include <onnc/Runtime/operator/averagepool.h>
+#include <onnc/Runtime/operator/batchnormalization.h>
+#include <onnc/Runtime/operator/ceil.h>
+#include <onnc/Runtime/operator/clip.h>
+#include <onnc/Runtime/operator/concat.h>
+#include <onnc/Runtime/operator/conv.h>
+#include <onnc/Runtime/operator/cos.h>
+#include <onnc/Runtime/operator/div.h>
+#include <onnc/Runtime/operator/elu.h>
+#include <onnc/Runtime/operator/equal.h>
+#include <onnc/Runtime/operator/exp.h>
+#include <onnc/Runtime/operator/floor.h>
+#include <onnc/Runtime/operator/gemm.h>
+#include <onnc/Runtime/operator/globalaveragepool.h>
+#include <onnc/Runtime/operator/globalmaxpool.h>
+#include <onnc/Runtime/operator/greater.h>
+#include <onnc/Runtime/operator/gru.h>
+#include <onnc/Runtime/operator/instancenormalization.h>
+#include <onnc/Runtime/operator/leakyrelu.h>
+#include <onnc/Runtime/operator/less.h>
+#include <onnc/Runtime/operator/log.h>
+#include <onnc/Runtime/operator/logsoftmax.h>
+#include <onnc/Runtime/operator/lpnormalization.h>
+#include <onnc/Runtime/operator/lrn.h>
+#include <onnc/Runtime/operator/lstm.h>
+#include <onnc/Runtime/operator/matmul.h>
+#include <onnc/Runtime/operator/max.h>
+#include <onnc/Runtime/operator/maxpool.h>
+#include <onnc/Runtime/operator/mean.h>
+#include <onnc/Runtime/operator/min.h>
+#include <onnc/Runtime/operator/mul.h>
+#include <onnc/Runtime/operator/neg.h>
+#include <onnc/Runtime/operator/not.h>
+#include <onnc/Runtime/operator/or.h>
+#include <onnc/Runtime/operator/pow.h>
+#include <onnc/Runtime/operator/reciprocal.h>
+#include <onnc/Runtime/operator/reducel1.h>
+#include <onnc/Runtime/operator/reducel2.h>
+#include <onnc/Runtime/operator/reducelogsum.h>
+#include <onnc/Runtime/operator/reducelogsumexp.h>
+#include <onnc/Runtime/operator/reducemax.h>
+#include <onnc/Runtime/operator/reducemean.h>
+#include <onnc/Runtime/operator/reducemin.h>
+#include <onnc/Runtime/operator/reduceprod.h>
+#include <onnc/Runtime/operator/reducesum.h>
+#include <onnc/Runtime/operator/reducesumsquare.h>
+#include <onnc/Runtime/operator/relu.h>
+#include <onnc/Runtime/operator/rnn.h>
+#include <onnc/Runtime/operator/sigmoid.h>
+#include <onnc/Runtime/operator/sin.h>
+#include <onnc/Runtime/operator/softmax.h>
+#include <onnc/Runtime/operator/softplus.h>
+#include <onnc/Runtime/operator/softsign.h>
+#include <onnc/Runtime/operator/sqrt.h>
+#include <onnc/Runtime/operator/sub.h>
+#include <onnc/Runtime/operator/sum.h>
+#include <onnc/Runtime/operator/tan.h>
+#include <onnc/Runtime/operator/tanh.h>
+#include <onnc/Runtime/operator/topk.h>
+#include <onnc/Runtime/operator/transpose.h>
+#include <onnc/Runtime/operator/xor.h>
+}
+#undef restrict
+
+using namespace onnc;
+using namespace onnc::bench;
+
+//===----------------------------------------------------------------------===//
+// Variants
+//===----------------------------------------------------------------------===//
+// With MKL-DNN, lib/Runtime/operatorMKLDNN/reference/ compiles the reference
+// kernels of the operators it overrides as *_float_reference, and the
+// reference Conv and Gemm are not built.  Runtime_MKLDNN checks that these
+// symbols link.
+#ifdef ONNC_BENCH_MKLDNN
+#define ONNC_BENCH_DECLARE_REFERENCE(op) \
+  extern "C" decltype(ONNC_RUNTIME_##op##_float) ONNC_RUNTIME_##op##_float_reference;
+
+ONNC_BENCH_DECLARE_REFERENCE(averagepool)
+ONNC_BENCH_DECLARE_REFERENCE(batchnormalization)
+ONNC_BENCH_DECLARE_REFERENCE(concat)
+ONNC_BENCH_DECLARE_REFERENCE(lrn)
+ONNC_BENCH_DECLARE_REFERENCE(maxpool)
+ONNC_BENCH_DECLARE_REFERENCE(relu)
+ONNC_BENCH_DECLARE_REFERENCE(sigmoid)
+ONNC_BENCH_DECLARE_REFERENCE(softmax)
+ONNC_BENCH_DECLARE_REFERENCE(sum)
+ONNC_BENCH_DECLARE_REFERENCE(tanh)
+
+#define ONNC_BENCH_VARIANTS(op) \
+  Variants<decltype(ONNC_RUNTIME_##op##_float)>{ \
+    { "mkldnn", &ONNC_RUNTIME_##op##_float }, \
+    { "reference", &ONNC_RUNTIME_##op##_float_reference } }
+
+#define ONNC_BENCH_MKLDNN_ONLY(op) \
+  Variants<decltype(ONNC_RUNTIME_##op##_float)>{ \
+    { "mkldnn", &ONNC_RUNTIME_##op##_float } }
+#else
+#define ONNC_BENCH_VARIANTS(op) \
+  Variants<decltype(ONNC_RUNTIME_##op##_float)>{ \
+    { "reference", &ONNC_RUNTIME_##op##_float } }
+
+#define ONNC_BENCH_MKLDNN_ONLY(op) ONNC_BENCH_VARIANTS(op)
+#endif
+
+/// A kernel without another implementation.
+#define ONNC_BENCH_KERNEL(op) \
+  Variants<decltype(ONNC_RUNTIME_##op##_float)>{ \
+    { "reference", &ONNC_RUNTIME_##op##_float } }
+
+namespace {
+
+template<typename Kernel>
+struct Variant
+{
+  const char* name;
+  Kernel* kernel;
+};
+
+template<typename Kernel>
+using Variants = std::vector<Variant<Kernel> >;
+
+typedef decltype(ONNC_RUNTIME_abs_float) UnaryKernel;
+typedef decltype(ONNC_RUNTIME_add_float) BinaryKernel;
+typedef decltype(ONNC_RUNTIME_sum_float) VariadicKernel;
+typedef decltype(ONNC_RUNTIME_reducesum_float) ReduceKernel;
+
+/// @return The dimensions joined by 'x', e.g. "1x64x56x56".
+std::string Dims(const Tensor::Dims& pDims)
+{
+  std::ostringstream os;
+  for (size_t i = 0; i < pDims.size(); ++i)
+    os << (0 == i ? "" : "x") << pDims[i];
+  return os.str();
+}
+
+std::string Dims(const TensorPtr& pTensor)
+{
+  return Dims(Tensor::Dims(pTensor->dims(), pTensor->dims() + pTensor->ndim()));
+}
+
+/// Add a case which reads or writes every tensor of @ref pTensors once.
+void AddCase(Suite& pSuite, const std::string& pOp, const char* pVariant,
+             const std::string& pShape, double pFlops,
+             std::initializer_list<TensorPtr> pTensors,
+             const std::function<void()>& pRun)
+{
+  Case c;
+  c.op = pOp;
+  c.variant = pVariant;
+  c.shape = pShape;
+  c.flops = pFlops;
+  c.bytes = 0.0;
+  for (const TensorPtr& tensor : pTensors)
+    c.bytes += tensor->bytes();
+  c.run = pRun;
+  pSuite.add(c);
+}
+
+/// The feature map of the common CNN activations.
+const Tensor::Dims g_FeatureMap = { 1, 64, 112, 112 };
+
+//===----------------------------------------------------------------------===//
+// Convolution and matrix multiplication
+//===----------------------------------------------------------------------===//
+struct ConvShape
+{
+  const char* layer;
+  int32_t n, c, h, w, m, k, stride, pad, group;
+};
+
+const ConvShape g_ConvShapes[] = {
+  { "resnet50.conv1",      1,   3, 224, 224,  64, 7, 2, 3,  1 },
+  { "resnet50.res2a_3x3",  1,  64,  56,  56,  64, 3, 1, 1,  1 },
+  { "resnet50.res2a_1x1",  1, 256,  56,  56,  64, 1, 1, 0,  1 },
+  { "resnet50.res4a_3x3",  1, 256,  14,  14, 256, 3, 1, 1,  1 },
+  { "mobilenet.conv2_dw",  1,  32, 112, 112,  32, 3, 1, 1, 32 },
+};
+
+void AddConv(Suite& pSuite, void* pContext)
+{
+  for (const ConvShape& s : g_ConvShapes) {
+    const int32_t oh = (s.h + 2 * s.pad - s.k) / s.stride + 1;
+    const int32_t ow = (s.w + 2 * s.pad - s.k) / s.stride + 1;
+    TensorPtr x = MakeTensor({ s.n, s.c, s.h, s.w });
+    TensorPtr w = MakeTensor({ s.m, s.c / s.group, s.k, s.k });
+    TensorPtr b = MakeTensor({ s.m });
+    TensorPtr y = MakeTensor({ s.n, s.m, oh, ow });
+    const double flops = 2.0 * y->size() * (s.c / s.group) * s.k * s.k;
+    ONNC_RUNTIME_add_constant(pContext, w->data());
+
+    for (auto v : ONNC_BENCH_MKLDNN_ONLY(conv)) {
+      AddCase(pSuite, "conv", v.name, s.layer, flops, { x, w, b, y },
+              [=]() {
+        int32_t kernel[] = { s.k, s.k };
+        int32_t pads[] = { s.pad, s.pad, s.pad, s.pad };
+        int32_t strides[] = { s.stride, s.stride };
+        int32_t dilations[] = { 1, 1 };
+        v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+                 w->data(), w->ndim(), w->dims(),
+                 b->data(), b->ndim(), b->dims(),
+                 y->data(), y->ndim(), y->dims(),
+                 "NOTSET", dilations, 2, s.group, kernel, 2, pads, 4,
+                 strides, 2);
+      });
+    }
+  }
+}
+
+struct GemmShape
+{
+  const char* layer;
+  int32_t m, n, k, transB;
+};
+
+const GemmShape g_GemmShapes[] = {
+  { "resnet50.fc1000",     1, 1000, 2048, 1 },
+  { "mlp.batch64",        64, 1024, 1024, 0 },
+  { "lstm.gates_batch32", 32, 1024,  256, 1 },
+};
+
+void AddGemm(Suite& pSuite, void* pContext)
+{
+  for (const GemmShape& s : g_GemmShapes) {
+    TensorPtr a = MakeTensor({ s.m, s.k });
+    TensorPtr b = s.transB ? MakeTensor({ s.n, s.k }) : MakeTensor({ s.k, s.n });
+    TensorPtr c = MakeTensor({ s.n });
+    TensorPtr y = MakeTensor({ s.m, s.n });
+    const double flops = 2.0 * s.m * s.n * s.k;
+    ONNC_RUNTIME_add_constant(pContext, b->data());
+
+    for (auto v : ONNC_BENCH_MKLDNN_ONLY(gemm)) {
+      AddCase(pSuite, "gemm", v.name, s.layer, flops, { a, b, c, y }, [=]() {
+        v.kernel(pContext, a->data(), a->ndim(), a->dims(),
+                 b->data(), b->ndim(), b->dims(),
+                 c->data(), c->ndim(), c->dims(),
+                 y->data(), y->ndim(), y->dims(), 1.0f, 1.0f, 0, s.transB);
+      });
+    }
+  }
+
+  const Tensor::Dims matmuls[][3] = {
+    { { 128, 256 }, { 256, 256 }, { 128, 256 } },
+    { { 8, 64, 64 }, { 8, 64, 64 }, { 8, 64, 64 } },
+  };
+  for (const auto& dims : matmuls) {
+    TensorPtr a = MakeTensor(dims[0]);
+    TensorPtr b = MakeTensor(dims[1]);
+    TensorPtr y = MakeTensor(dims[2]);
+    const double flops = 2.0 * y->size() * dims[0].back();
+
+    for (auto v : ONNC_BENCH_KERNEL(matmul)) {
+      AddCase(pSuite, "matmul", v.name, Dims(a) + "," + Dims(b), flops,
+              { a, b, y }, [=]() {
+        v.kernel(pContext, a->data(), a->ndim(), a->dims(),
+                 b->data(), b->ndim(), b->dims(),
+                 y->data(), y->ndim(), y->dims());
+      });
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Pooling and normalization
+//===----------------------------------------------------------------------===//
+struct PoolShape
+{
+  const char* layer;
+  int32_t n, c, h, w, k, stride, pad;
+};
+
+const PoolShape g_MaxPoolShapes[] = {
+  { "resnet50.pool1",   1,  64, 112, 112, 3, 2, 1 },
+  { "vgg16.pool1",      1,  64, 224, 224, 2, 2, 0 },
+  { "googlenet.pool3",  1, 480,  28,  28, 3, 1, 1 },
+};
+
+const PoolShape g_AveragePoolShapes[] = {
+  { "inception.branch", 1, 256,  28,  28, 3, 1, 1 },
+  { "densenet.trans1",  1, 128,  56,  56, 2, 2, 0 },
+};
+
+template<typename Kernel, typename Call>
+void AddPool(Suite& pSuite, const char* pOp, const PoolShape& pShape,
+             const Variants<Kernel>& pVariants, Call pCall)
+{
+  const PoolShape s = pShape;
+  const int32_t oh = (s.h + 2 * s.pad - s.k) / s.stride + 1;
+  const int32_t ow = (s.w + 2 * s.pad - s.k) / s.stride + 1;
+  TensorPtr x = MakeTensor({ s.n, s.c, s.h, s.w });
+  TensorPtr y = MakeTensor({ s.n, s.c, oh, ow });
+  const double flops = static_cast<double>(y->size()) * s.k * s.k;
+
+  for (auto v : pVariants) {
+    Kernel* kernel = v.kernel;
+    AddCase(pSuite, pOp, v.name, s.layer, flops, { x, y }, [=]() {
+      int32_t window[] = { s.k, s.k };
+      int32_t pads[] = { s.pad, s.pad, s.pad, s.pad };
+      int32_t strides[] = { s.stride, s.stride };
+      pCall(kernel, x, y, window, pads, strides);
+    });
+  }
+}
+
+void AddPooling(Suite& pSuite, void* pContext)
+{
+  for (const PoolShape& s : g_MaxPoolShapes) {
+    AddPool(pSuite, "maxpool", s, ONNC_BENCH_VARIANTS(maxpool),
+            [=](decltype(ONNC_RUNTIME_maxpool_float)* pKernel,
+                const TensorPtr& x, const TensorPtr& y,
+                int32_t* window, int32_t* pads, int32_t* strides) {
+      pKernel(pContext, x->data(), x->ndim(), x->dims(),
+              y->data(), y->ndim(), y->dims(), NULL, 0, NULL,
+              "NOTSET", window, 2, pads, 4, 0, strides, 2);
+    });
+  }
+
+  for (const PoolShape& s : g_AveragePoolShapes) {
+    AddPool(pSuite, "averagepool", s, ONNC_BENCH_VARIANTS(averagepool),
+            [=](decltype(ONNC_RUNTIME_averagepool_float)* pKernel,
+                const TensorPtr& x, const TensorPtr& y,
+                int32_t* window, int32_t* pads, int32_t* strides) {
+      pKernel(pContext, x->data(), x->ndim(), x->dims(),
+              y->data(), y->ndim(), y->dims(),
+              "NOTSET", 0, window, 2, pads, 4, strides, 2);
+    });
+  }
+
+  // The global pooling before the classifier of ResNet-50.
+  TensorPtr x = MakeTensor({ 1, 2048, 7, 7 });
+  TensorPtr y = MakeTensor({ 1, 2048, 1, 1 });
+  const std::string shape = Dims(x);
+  const std::pair<const char*, UnaryKernel*> globals[] = {
+    { "globalaveragepool", &ONNC_RUNTIME_globalaveragepool_float },
+    { "globalmaxpool", &ONNC_RUNTIME_globalmaxpool_float },
+  };
+  for (const auto& global : globals) {
+    UnaryKernel* kernel = global.second;
+    AddCase(pSuite, global.first, "reference", shape, x->size(), { x, y },
+            [=]() {
+      kernel(pContext, x->data(), x->ndim(), x->dims(),
+             y->data(), y->ndim(), y->dims());
+    });
+  }
+}
+
+void AddNormalization(Suite& pSuite, void* pContext)
+{
+  TensorPtr x = MakeTensor(g_FeatureMap);
+  TensorPtr y = MakeTensor(g_FeatureMap);
+  TensorPtr scale = MakeTensor({ g_FeatureMap[1] });
+  TensorPtr bias = MakeTensor({ g_FeatureMap[1] });
+  TensorPtr mean = MakeTensor({ g_FeatureMap[1] });
+  TensorPtr var = MakeTensor({ g_FeatureMap[1] });
+  const std::string shape = Dims(x);
+
+  // Inference folds the statistics into one multiply-add per element.
+  for (auto v : ONNC_BENCH_VARIANTS(batchnormalization)) {
+    AddCase(pSuite, "batchnormalization", v.name, shape, 2.0 * x->size(),
+            { x, y }, [=]() {
+      v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+               scale->data(), scale->ndim(), scale->dims(),
+               bias->data(), bias->ndim(), bias->dims(),
+               mean->data(), mean->ndim(), mean->dims(),
+               var->data(), var->ndim(), var->dims(),
+               y->data(), y->ndim(), y->dims(),
+               NULL, 0, NULL, NULL, 0, NULL, NULL, 0, NULL, NULL, 0, NULL,
+               1e-5f, 0.9f, 1);
+    });
+  }
+
+  // InstanceNormalization computes the statistics of each channel first: a
+  // sum, then a sum of squared deviations, then a multiply-add per element.
+  for (auto v : ONNC_BENCH_KERNEL(instancenormalization)) {
+    AddCase(pSuite, "instancenormalization", v.name, shape, 6.0 * x->size(),
+            { x, y }, [=]() {
+      v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+               scale->data(), scale->ndim(), scale->dims(),
+               bias->data(), bias->ndim(), bias->dims(),
+               y->data(), y->ndim(), y->dims(), 1e-5f);
+    });
+  }
+
+  // The first LRN of AlexNet: a sum of squares over 5 channels, then a
+  // power and a division per element.
+  TensorPtr lx = MakeTensor({ 1, 96, 55, 55 });
+  TensorPtr ly = MakeTensor({ 1, 96, 55, 55 });
+  for (auto v : ONNC_BENCH_VARIANTS(lrn)) {
+    AddCase(pSuite, "lrn", v.name, Dims(lx) + ",size5",
+            (2.0 * 5 + 2) * lx->size(), { lx, ly }, [=]() {
+      v.kernel(pContext, lx->data(), lx->ndim(), lx->dims(),
+               ly->data(), ly->ndim(), ly->dims(), 1e-4f, 0.75f, 1.0f, 5);
+    });
+  }
+
+  TensorPtr nx = MakeTensor({ 64, 1024 });
+  TensorPtr ny = MakeTensor({ 64, 1024 });
+  for (auto v : ONNC_BENCH_KERNEL(lpnormalization)) {
+    AddCase(pSuite, "lpnormalization", v.name, Dims(nx) + ",p2",
+            3.0 * nx->size(), { nx, ny }, [=]() {
+      v.kernel(pContext, nx->data(), nx->ndim(), nx->dims(),
+               ny->data(), ny->ndim(), ny->dims(), -1, 2);
+    });
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Softmax
+//===----------------------------------------------------------------------===//
+void AddSoftmax(Suite& pSuite, void* pContext)
+{
+  // The classifier of ImageNet models, and the attention scores of a
+  // transformer with 8 heads and 128 tokens.
+  const Tensor::Dims shapes[] = { { 64, 1000 }, { 1024, 128 } };
+
+  for (const Tensor::Dims& dims : shapes) {
+    TensorPtr x = MakeTensor(dims);
+    TensorPtr y = MakeTensor(dims);
+    // A maximum, an exponential, a sum and a division per element.
+    const double flops = 4.0 * x->size();
+
+    for (auto v : ONNC_BENCH_VARIANTS(softmax)) {
+      AddCase(pSuite, "softmax", v.name, Dims(x), flops, { x, y }, [=]() {
+        v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+                 y->data(), y->ndim(), y->dims(), 1);
+      });
+    }
+    for (auto v : ONNC_BENCH_KERNEL(logsoftmax)) {
+      AddCase(pSuite, "logsoftmax", v.name, Dims(x), flops, { x, y }, [=]() {
+        v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+                 y->data(), y->ndim(), y->dims(), 1);
+      });
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Element-wise
+//===----------------------------------------------------------------------===//
+void AddElementwise(Suite& pSuite, void* pContext)
+{
+  TensorPtr x = MakeTensor(g_FeatureMap);
+  TensorPtr y = MakeTensor(g_FeatureMap);
+  const std::string shape = Dims(x);
+  const double flops = x->size();
+
+  // Unary kernels with another implementation.
+  const Variants<UnaryKernel> activations[] = {
+    ONNC_BENCH_VARIANTS(relu),
+    ONNC_BENCH_VARIANTS(sigmoid),
+    ONNC_BENCH_VARIANTS(tanh),
+  };
+  const char* activationNames[] = { "relu", "sigmoid", "tanh" };
+  for (size_t i = 0; i < sizeof(activationNames) / sizeof(activationNames[0]); ++i) {
+    for (auto v : activations[i]) {
+      AddCase(pSuite, activationNames[i], v.name, shape, flops, { x, y },
+              [=]() {
+        v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+                 y->data(), y->ndim(), y->dims());
+      });
+    }
+  }
+
+  const std::pair<const char*, UnaryKernel*> unaries[] = {
+    { "abs", &ONNC_RUNTIME_abs_float },
+    { "acos", &ONNC_RUNTIME_acos_float },
+    { "asin", &ONNC_RUNTIME_asin_float },
+    { "atan", &ONNC_RUNTIME_atan_float },
+    { "ceil", &ONNC_RUNTIME_ceil_float },
+    { "cos", &ONNC_RUNTIME_cos_float },
+    { "exp", &ONNC_RUNTIME_exp_float },
+    { "floor", &ONNC_RUNTIME_floor_float },
+    { "log", &ONNC_RUNTIME_log_float },
+    { "neg", &ONNC_RUNTIME_neg_float },
+    { "not", &ONNC_RUNTIME_not_float },
+    { "reciprocal", &ONNC_RUNTIME_reciprocal_float },
+    { "sin", &ONNC_RUNTIME_sin_float },
+    { "softplus", &ONNC_RUNTIME_softplus_float },
+    { "softsign", &ONNC_RUNTIME_softsign_float },
+    { "sqrt", &ONNC_RUNTIME_sqrt_float },
+    { "tan", &ONNC_RUNTIME_tan_float },
+  };
+  for (const auto& unary : unaries) {
+    UnaryKernel* kernel = unary.second;
+    AddCase(pSuite, unary.first, "reference", shape, flops, { x, y }, [=]() {
+      kernel(pContext, x->data(), x->ndim(), x->dims(),
+             y->data(), y->ndim(), y->dims());
+    });
+  }
+
+  AddCase(pSuite, "leakyrelu", "reference", shape, flops, { x, y }, [=]() {
+    ONNC_RUNTIME_leakyrelu_float(pContext, x->data(), x->ndim(), x->dims(),
+                                 y->data(), y->ndim(), y->dims(), 0.01f);
+  });
+  AddCase(pSuite, "elu", "reference", shape, flops, { x, y }, [=]() {
+    ONNC_RUNTIME_elu_float(pContext, x->data(), x->ndim(), x->dims(),
+                           y->data(), y->ndim(), y->dims(), 1.0f);
+  });
+  AddCase(pSuite, "clip", "reference", shape, flops, { x, y }, [=]() {
+    ONNC_RUNTIME_clip_float(pContext, x->data(), x->ndim(), x->dims(),
+                            y->data(), y->ndim(), y->dims(), 0.75f, 0.25f);
+  });
+
+  // The residual addition of ResNet-50, and the bias or scale of a channel.
+  TensorPtr a = MakeTensor({ 1, 256, 56, 56 });
+  TensorPtr c = MakeTensor({ 1, 256, 56, 56 });
+  TensorPtr same = MakeTensor({ 1, 256, 56, 56 });
+  TensorPtr channel = MakeTensor({ 1, 256, 1, 1 });
+  const std::pair<const char*, BinaryKernel*> binaries[] = {
+    { "add", &ONNC_RUNTIME_add_float },
+    { "sub", &ONNC_RUNTIME_sub_float },
+    { "mul", &ONNC_RUNTIME_mul_float },
+    { "div", &ONNC_RUNTIME_div_float },
+    { "pow", &ONNC_RUNTIME_pow_float },
+    { "and", &ONNC_RUNTIME_and_float },
+    { "or", &ONNC_RUNTIME_or_float },
+    { "xor", &ONNC_RUNTIME_xor_float },
+    { "equal", &ONNC_RUNTIME_equal_float },
+    { "greater", &ONNC_RUNTIME_greater_float },
+    { "less", &ONNC_RUNTIME_less_float },
+  };
+  for (const auto& binary : binaries) {
+    BinaryKernel* kernel = binary.second;
+    for (const TensorPtr& b : { same, channel }) {
+      AddCase(pSuite, binary.first, "reference", Dims(a) + "," + Dims(b),
+              a->size(), { a, b, c }, [=]() {
+        kernel(pContext, a->data(), a->ndim(), a->dims(),
+               b->data(), b->ndim(), b->dims(),
+               c->data(), c->ndim(), c->dims());
+      });
+    }
+  }
+
+  // Variadic kernels of three inputs, e.g. the merge of three branches.
+  TensorPtr inputs[] = { a, same, MakeTensor({ 1, 256, 56, 56 }) };
+  const std::pair<const char*, Variants<VariadicKernel> > variadics[] = {
+    { "sum", ONNC_BENCH_VARIANTS(sum) },
+    { "max", ONNC_BENCH_KERNEL(max) },
+    { "min", ONNC_BENCH_KERNEL(min) },
+    { "mean", ONNC_BENCH_KERNEL(mean) },
+  };
+  for (const auto& variadic : variadics) {
+    for (auto v : variadic.second) {
+      AddCase(pSuite, variadic.first, v.name, "3x" + Dims(a), 2.0 * a->size(),
+              { inputs[0], inputs[1], inputs[2], c }, [=]() {
+        const float* data[] = {
+          inputs[0]->data(), inputs[1]->data(), inputs[2]->data()
+        };
+        const int32_t ndims[] = {
+          inputs[0]->ndim(), inputs[1]->ndim(), inputs[2]->ndim()
+        };
+        const int32_t* dims[] = {
+          inputs[0]->dims(), inputs[1]->dims(), inputs[2]->dims()
+        };
+        v.kernel(pContext, data, 3, ndims, dims,
+                 c->data(), c->ndim(), c->dims());
+      });
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Data movement
+//===----------------------------------------------------------------------===//
+void AddDataMovement(Suite& pSuite, void* pContext)
+{
+  // The four branches of an Inception block.
+  const int32_t branches = 4;
+  std::vector<TensorPtr> parts;
+  for (int32_t i = 0; i < branches; ++i)
+    parts.push_back(MakeTensor({ 1, 64, 28, 28 }));
+  TensorPtr joined = MakeTensor({ 1, 64 * branches, 28, 28 });
+
+  // The parts are as large as the result.
+  for (auto v : ONNC_BENCH_VARIANTS(concat)) {
+    AddCase(pSuite, "concat", v.name, "4x" + Dims(parts[0]) + ",axis1", 0.0,
+            { joined, joined }, [=]() {
+      std::vector<const float*> data;
+      std::vector<int32_t> ndims;
+      std::vector<const int32_t*> dims;
+      for (const TensorPtr& part : parts) {
+        data.push_back(part->data());
+        ndims.push_back(part->ndim());
+        dims.push_back(part->dims());
+      }
+      v.kernel(pContext, data.data(), branches, ndims.data(), dims.data(),
+               joined->data(), joined->ndim(), joined->dims(), 1);
+    });
+  }
+
+  // NCHW to NHWC, and a square matrix.
+  struct {
+    Tensor::Dims from;
+    Tensor::Dims to;
+    std::vector<int32_t> perm;
+  } const transposes[] = {
+    { { 1, 64, 56, 56 }, { 1, 56, 56, 64 }, { 0, 2, 3, 1 } },
+    { { 1024, 1024 }, { 1024, 1024 }, { 1, 0 } },
+  };
+  for (const auto& t : transposes) {
+    TensorPtr x = MakeTensor(t.from);
+    TensorPtr y = MakeTensor(t.to);
+    std::vector<int32_t> perm = t.perm;
+    std::ostringstream shape;
+    shape << Dims(x) << ",perm" << Dims(perm);
+
+    for (auto v : ONNC_BENCH_KERNEL(transpose)) {
+      AddCase(pSuite, "transpose", v.name, shape.str(), 0.0, { x, y }, [=]() {
+        std::vector<int32_t> axes = perm;
+        v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+                 y->data(), y->ndim(), y->dims(), axes.data(), axes.size());
+      });
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Reductions and selection
+//===----------------------------------------------------------------------===//
+void AddReductions(Suite& pSuite, void* pContext)
+{
+  const std::pair<const char*, ReduceKernel*> reductions[] = {
+    { "reducel1", &ONNC_RUNTIME_reducel1_float },
+    { "reducel2", &ONNC_RUNTIME_reducel2_float },
+    { "reducelogsum", &ONNC_RUNTIME_reducelogsum_float },
+    { "reducelogsumexp", &ONNC_RUNTIME_reducelogsumexp_float },
+    { "reducemax", &ONNC_RUNTIME_reducemax_float },
+    { "reducemean", &ONNC_RUNTIME_reducemean_float },
+    { "reducemin", &ONNC_RUNTIME_reducemin_float },
+    { "reduceprod", &ONNC_RUNTIME_reduceprod_float },
+    { "reducesum", &ONNC_RUNTIME_reducesum_float },
+    { "reducesumsquare", &ONNC_RUNTIME_reducesumsquare_float },
+  };
+
+  // Over the spatial axes (squeeze-and-excitation), and over the channels.
+  TensorPtr x = MakeTensor({ 1, 256, 56, 56 });
+  TensorPtr spatial = MakeTensor({ 1, 256, 1, 1 });
+  TensorPtr channels = MakeTensor({ 1, 1, 56, 56 });
+  struct {
+    std::vector<int32_t> axes;
+    TensorPtr y;
+  } const shapes[] = {
+    { { 2, 3 }, spatial },
+    { { 1 }, channels },
+  };
+
+  for (const auto& reduction : reductions) {
+    ReduceKernel* kernel = reduction.second;
+    for (const auto& s : shapes) {
+      TensorPtr y = s.y;
+      std::vector<int32_t> axes = s.axes;
+      AddCase(pSuite, reduction.first, "reference",
+              Dims(x) + ",axes" + Dims(axes), x->size(), { x, y }, [=]() {
+        std::vector<int32_t> reduced = axes;
+        kernel(pContext, x->data(), x->ndim(), x->dims(),
+               y->data(), y->ndim(), y->dims(),
+               reduced.data(), reduced.size(), 1);
+      });
+    }
+  }
+
+  // The top-5 of a classifier, the top-10 of a vocabulary, and a large k.
+  struct {
+    Tensor::Dims dims;
+    int32_t k;
+  } const topks[] = {
+    { { 64, 1000 }, 5 },
+    { { 8, 32000 }, 10 },
+    { { 4, 16384 }, 4096 },
+  };
+  for (const auto& t : topks) {
+    TensorPtr tx = MakeTensor(t.dims);
+    TensorPtr values = MakeTensor({ t.dims[0], t.k });
+    TensorPtr indices = MakeTensor({ t.dims[0], t.k });
+    const int32_t k = t.k;
+    std::ostringstream shape;
+    shape << Dims(tx) << ",k" << k;
+
+    for (auto v : ONNC_BENCH_KERNEL(topk)) {
+      AddCase(pSuite, "topk", v.name, shape.str(), 0.0,
+              { tx, values, indices }, [=]() {
+        v.kernel(pContext, tx->data(), tx->ndim(), tx->dims(),
+                 values->data(), values->ndim(), values->dims(),
+                 indices->data(), indices->ndim(), indices->dims(), -1, k);
+      });
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Recurrent
+//===----------------------------------------------------------------------===//
+/// A sequence of 32 steps, a batch of 16, 256 inputs and 256 hidden units.
+struct RecurrentShape
+{
+  int32_t steps = 32;
+  int32_t batch = 16;
+  int32_t input = 256;
+  int32_t hidden = 256;
+
+  std::string str() const {
+    std::ostringstream os;
+    os << "seq" << steps << ",batch" << batch << ",input" << input
+       << ",hidden" << hidden;
+    return os.str();
+  }
+
+  /// @return The multiply-adds of @ref pGates gates over all steps.
+  double flops(int32_t pGates) const {
+    return 2.0 * steps * batch * pGates * hidden * (input + hidden);
+  }
+};
+
+void AddRecurrent(Suite& pSuite, void* pContext)
+{
+  const RecurrentShape s = RecurrentShape();
+  TensorPtr x = MakeTensor({ s.steps, s.batch, s.input });
+  TensorPtr y = MakeTensor({ s.steps, 1, s.batch, s.hidden });
+  TensorPtr h = MakeTensor({ 1, s.batch, s.hidden });
+
+  {
+    TensorPtr w = MakeTensor({ 1, 4 * s.hidden, s.input });
+    TensorPtr r = MakeTensor({ 1, 4 * s.hidden, s.hidden });
+    TensorPtr b = MakeTensor({ 1, 8 * s.hidden });
+    TensorPtr c = MakeTensor({ 1, s.batch, s.hidden });
+    for (auto v : ONNC_BENCH_KERNEL(lstm)) {
+      AddCase(pSuite, "lstm", v.name, s.str(), s.flops(4),
+              { x, w, r, b, y, h, c }, [=]() {
+        v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+                 w->data(), w->ndim(), w->dims(),
+                 r->data(), r->ndim(), r->dims(),
+                 b->data(), b->ndim(), b->dims(),
+                 NULL, 0, NULL, NULL, 0, NULL, NULL, 0, NULL, NULL, 0, NULL,
+                 y->data(), y->ndim(), y->dims(),
+                 h->data(), h->ndim(), h->dims(),
+                 c->data(), c->ndim(), c->dims(),
+                 NULL, 0, NULL, 0, NULL, 0, 0.0f, "forward", s.hidden, 0);
+      });
+    }
+  }
+
+  {
+    TensorPtr w = MakeTensor({ 1, 3 * s.hidden, s.input });
+    TensorPtr r = MakeTensor({ 1, 3 * s.hidden, s.hidden });
+    TensorPtr b = MakeTensor({ 1, 6 * s.hidden });
+    for (auto v : ONNC_BENCH_KERNEL(gru)) {
+      AddCase(pSuite, "gru", v.name, s.str(), s.flops(3),
+              { x, w, r, b, y, h }, [=]() {
+        v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+                 w->data(), w->ndim(), w->dims(),
+                 r->data(), r->ndim(), r->dims(),
+                 b->data(), b->ndim(), b->dims(),
+                 NULL, 0, NULL, NULL, 0, NULL,
+                 y->data(), y->ndim(), y->dims(),
+                 h->data(), h->ndim(), h->dims(),
+                 NULL, 0, NULL, 0, NULL, 0, 0.0f, "forward", s.hidden, 1);
+      });
+    }
+  }
+
+  {
+    TensorPtr w = MakeTensor({ 1, s.hidden, s.input });
+    TensorPtr r = MakeTensor({ 1, s.hidden, s.hidden });
+    TensorPtr b = MakeTensor({ 1, 2 * s.hidden });
+    for (auto v : ONNC_BENCH_KERNEL(rnn)) {
+      AddCase(pSuite, "rnn", v.name, s.str(), s.flops(1),
+              { x, w, r, b, y, h }, [=]() {
+        v.kernel(pContext, x->data(), x->ndim(), x->dims(),
+                 w->data(), w->ndim(), w->dims(),
+                 r->data(), r->ndim(), r->dims(),
+                 b->data(), b->ndim(), b->dims(),
+                 NULL, 0, NULL, NULL, 0, NULL,
+                 y->data(), y->ndim(), y->dims(),
+                 h->data(), h->ndim(), h->dims(),
+                 NULL, 0, NULL, 0, NULL, 0, 0.0f, "forward", s.hidden);
+      });
+    }
+  }
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// AddKernels
+//===----------------------------------------------------------------------===//
+void bench::AddKernels(Suite& pSuite, void* pContext)
+{
+  AddConv(pSuite, pContext);
+  AddGemm(pSuite, pContext);
+  AddPooling(pSuite, pContext);
+  AddNormalization(pSuite, pContext);
+  AddSoftmax(pSuite, pContext);
+  AddElementwise(pSuite, pContext);
+  AddDataMovement(pSuite, pContext);
+  AddReductions(pSuite, pContext);
+  AddRecurrent(pSuite, pContext);
+}
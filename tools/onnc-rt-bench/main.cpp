@@ -0,0 +1,133 @@
+//===- main.cpp -----------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "Benchmark.h"
+#include <onnc/ADT/Color.h>
+#include <onnc/Support/IOStream.h>
+#include <onnc/Support/OFStream.h>
+#include <onnc/Support/Path.h>
+#include <onnc/Option/CommandLine.h>
+#include <onnc/Config/AboutData.h>
+
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/onnc-runtime.h>
+}
+#undef restrict
+
+using namespace onnc;
+
+static AboutData g_About("onnc-rt-bench",
+                         "onnc-rt-bench",
+                         "0.1.0",
+                         AboutLicense::kPrivate,
+                         "Benchmark the kernels of the ONNC runtime");
+
+static cl::opt<std::string>
+OptFilter("filter", cl::kLong, cl::kOptional, cl::kValueRequired,
+    cl::kEqualSeparated,
+    cl::desc("Only run the cases whose op/variant/shape name contains "
+             "<text>."),
+    cl::about(g_About));
+
+static cl::opt<unsigned int>
+OptWarmup("warmup", cl::kLong, cl::kOptional, cl::kValueRequired,
+    cl::kEqualSeparated, cl::init(3),
+    cl::desc("Call each kernel <number> times before measuring "
+             "(default is 3)."),
+    cl::about(g_About));
+
+static cl::opt<unsigned int>
+OptRepeat("repeat", cl::kLong, cl::kOptional, cl::kValueRequired,
+    cl::kEqualSeparated, cl::init(10),
+    cl::desc("Measure <number> samples of each kernel (default is 10)."),
+    cl::about(g_About));
+
+static cl::opt<unsigned int>
+OptMinTime("min-time", cl::kLong, cl::kOptional, cl::kValueRequired,
+    cl::kEqualSeparated, cl::init(10),
+    cl::desc("Call a kernel for at least <number> ms in a sample "
+             "(default is 10)."),
+    cl::about(g_About));
+
+static cl::opt<bool>
+OptList("list", cl::kLong, cl::kOptional, cl::kValueDisallowed,
+    cl::init(false),
+    cl::desc("List the selected cases without running them."),
+    cl::about(g_About));
+
+static cl::opt<bool>
+OptJSON("json", cl::kLong, cl::kOptional, cl::kValueDisallowed,
+    cl::init(false),
+    cl::desc("Print the report in JSON."),
+    cl::about(g_About));
+
+static cl::opt<Path> OptOutput("o", cl::kShort, cl::kOptional,
+    cl::kValueRequired,
+    cl::desc("The report file (default is stdout)"),
+    cl::about(g_About));
+
+static cl::opt<bool> OptHelp("help", cl::kLong, cl::kOptional,
+    cl::kValueDisallowed, cl::init(false),
+    cl::desc("Show this manual."),
+    cl::about(g_About));
+
+static cl::alias HelpAliasH("h", cl::kShort, cl::trueopt(OptHelp));
+static cl::alias HelpAliasQ("?", cl::kShort, cl::trueopt(OptHelp));
+
+//===----------------------------------------------------------------------===//
+// Main Procedure
+//===----------------------------------------------------------------------===//
+int main(int pArgc, char* pArgv[])
+{
+  cl::ParseCommandLine(pArgc, pArgv);
+
+  // --help
+  if (OptHelp) {
+    g_About.print(outs());
+    return EXIT_SUCCESS;
+  }
+
+  // MKL-DNN keeps its engine and its primitives in the context.
+  void* context = ONNC_RUNTIME_init_runtime();
+
+  bench::Suite suite;
+  bench::AddKernels(suite, context);
+  suite.setWarmup(OptWarmup);
+  suite.setRepeat(OptRepeat);
+  suite.setMinTime(OptMinTime);
+  if (OptFilter.hasOccurrence())
+    suite.setFilter(OptFilter);
+
+  // --list
+  if (OptList) {
+    for (const bench::Case& c : suite.cases())
+      if (suite.isSelected(c))
+        outs() << c.name() << std::endl;
+    ONNC_RUNTIME_shutdown_runtime(context);
+    return EXIT_SUCCESS;
+  }
+
+  suite.run(errs());
+  ONNC_RUNTIME_shutdown_runtime(context);
+
+  const bench::Suite::Format format =
+      OptJSON ? bench::Suite::kJSON : bench::Suite::kText;
+  if (!OptOutput.hasOccurrence()) {
+    suite.print(outs(), format);
+    return EXIT_SUCCESS;
+  }
+
+  OFStream report(OptOutput);
+  if (!report.is_open()) {
+    errs() << Color::MAGENTA << "Fatal" << Color::RESET
+           << ": can not open the report file: " << OptOutput << std::endl;
+    return EXIT_FAILURE;
+  }
+  suite.print(report, format);
+  return EXIT_SUCCESS;
+}
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 #include "ONNCApp.h"
 
+#include <onnc/Config/Config.h>
 #include <onnc/Target/TargetSelect.h>
 #include <onnc/Target/TargetRegistry.h>
 #include <onnc/Target/TargetBackend.h>
@@ -15,12 +16,16 @@
 #include <onnc/IR/Module.h>
 #include <onnc/IR/ONNXUtils.h>
 #include <onnc/Core/PassManager.h>
+#include <onnc/Core/CompilationCache.h>
 #include <onnc/ADT/Color.h>
 #include <onnc/Support/IOStream.h>
+#include <onnc/Support/FileSystem.h>
 #include <onnc/Transforms/Optimizations/OptimizationOptions.h>
 
 #include <cstdlib>
 
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <string>
 
@@ -40,8 +45,85 @@ ONNCApp::~ONNCApp()
 {
 }
 
+/// Describe everything other than the model which affects the artifacts.
+/// @retval false A file the compilation reads can not be read.
+static bool GetCacheContext(const ONNCConfig& pOptions, std::string& pContext)
+{
+  std::string quadruple;
+  pOptions.quadruple().canonical(quadruple);
+
+  const TargetOptions& target = pOptions.target();
+  // artifacts of another compiler release may differ.
+  pContext = std::string(PACKAGE_VERSION) + '\n';
+  pContext += quadruple + '\n' + pOptions.getArchName() + '\n';
+  pContext += target.shouldIgnoreCalibrationStep() ? '1' : '0';
+  pContext += target.shouldUseDummyCTable() ? '1' : '0';
+  pContext += target.shouldUseDummyWeight() ? '1' : '0';
+  pContext += '\n' + target.optOnnxModel();
+  // artifacts may refer to each other by file name.
+  pContext += '\n' + pOptions.output().filename().native();
+
+  // the quantization follows the content of the calibration table.
+  pContext += '\n' + target.calibrationTable().native() + '\n';
+  if (!target.calibrationTable().empty()) {
+    std::ifstream table(target.calibrationTable().native(),
+                        std::ios::in | std::ios::binary);
+    if (!table.good())
+      return false;
+    pContext.append(std::istreambuf_iterator<char>(table),
+                    std::istreambuf_iterator<char>());
+    if (table.bad())
+      return false;
+  }
+  return true;
+}
+
+/// A warm start runs no pass, and restores only the files which the backend
+/// emits next to the output. Only the CLang and Sophon backends emit all of
+/// their artifacts there; the others print them or write nothing.
+static bool IsCacheable(const ONNCConfig& pOptions)
+{
+  if (pOptions.cacheDir().empty())
+    return false;
+
+  const Quadruple::ArchType arch = pOptions.quadruple().getArch();
+  if (Quadruple::clang != arch && Quadruple::sophon != arch)
+    return false;
+
+  // BM188x writes the optimized model to the path of -dump-opt-onnx.
+  if (!pOptions.target().optOnnxModel().empty())
+    return false;
+
+  // the module, the estimation and the timing are printed by the passes.
+  if (pOptions.target().shouldPrintBeforeTensorSel() ||
+      pOptions.target().shouldEstimatePerformance() ||
+      pOptions.timePasses())
+    return false;
+
+  // the standard output is not a file.
+  return "-" != pOptions.output().native();
+}
+
 int ONNCApp::compile()
 {
+  // Try a warm start before reading the model.
+  CompilationCache cache(options().cacheDir());
+  CompilationCache::Key key;
+  Path outputDir = options().output().parent();
+  if (outputDir.empty())
+    outputDir = Path(".");
+
+  std::string context;
+  bool cacheable = IsCacheable(options()) &&
+      GetCacheContext(options(), context) &&
+      cache.makeKey(key, options().input(), context);
+  if (cacheable && cache.lookup(key, outputDir)) {
+    if (ONNCConfig::kNormal < options().verbose())
+      errs() << "Reuse cached compilation "
+             << CompilationCache::ToString(key.hash) << std::endl;
+    return EXIT_SUCCESS;
+  }
+
   onnc::onnx::Reader reader;
   Module module;
   SystemError err = reader.parse(options().input(), module);
@@ -69,8 +151,43 @@ int ONNCApp::compile()
   backend->addOnncIrOptimization(pm, optOptions);
   backend->addTensorSched(pm);
   backend->addMemAlloc(pm);
-  backend->addCodeEmit(pm, options().output());
 
-  pm.run(module);
+  // On a cold start, emit the artifacts into the staging area of the cache
+  // and publish them after the compilation succeeds.
+  Path output = options().output();
+  Path staging;
+  if (cacheable) {
+    staging = cache.prepare(key);
+    if (!staging.empty()) {
+      output = staging;
+      output.append(options().output().filename());
+    }
+  }
+  backend->addCodeEmit(pm, output);
+
+  PassTimingInfo timing;
+  if (options().timePasses())
+    pm.setTimingInfo(&timing);
+
+  bool succeeded = pm.run(module);
+
+  if (options().timePasses())
+    timing.print(errs(), options().timePassesFormat());
+
+  // Never publish the artifacts of a failed compilation.
+  if (!succeeded) {
+    if (!staging.empty())
+      clean(staging);
+    errs() << Color::RED << "Error" << Color::RESET
+           << ": compilation of `" << options().input() << "` failed"
+           << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!staging.empty() && !cache.commit(key, staging, outputDir)) {
+    errs() << Color::RED << "Error" << Color::RESET
+           << ": can not write output to `" << outputDir << "`" << std::endl;
+    return EXIT_FAILURE;
+  }
   return EXIT_SUCCESS;
 }
@@ -13,7 +13,8 @@ using namespace onnc;
 // ONNCConfig
 //===----------------------------------------------------------------------===//
 ONNCConfig::ONNCConfig()
-  : m_Input(), m_Output(), m_Quadruple(), m_Arch(), m_TargetOptions() {
+  : m_Input(), m_Output(), m_Quadruple(), m_Arch(), m_TargetOptions(),
+    m_CacheDir(), m_TimePasses(false), m_TimePassesFormat(PassTimingInfo::kTable) {
 }
 
 ONNCConfig::~ONNCConfig()
@@ -8,6 +8,7 @@
 #ifndef ONNC_COMPILER_ONNC_CONFIG_H
 #define ONNC_COMPILER_ONNC_CONFIG_H
 #include <onnc/Core/Application.h>
+#include <onnc/Core/PassTimingInfo.h>
 #include <onnc/Support/Path.h>
 #include <onnc/IR/Quadruple.h>
 #include <onnc/Target/TargetOptions.h>
@@ -59,12 +60,28 @@ public:
 
   unsigned int verbose() const { return m_TargetOptions.getVerboseLevel(); }
 
+  /// The directory of the compilation cache. Empty if caching is disabled.
+  const onnc::Path& cacheDir() const { return m_CacheDir; }
+
+  void setCacheDir(const onnc::Path& pDir) { m_CacheDir = pDir; }
+
+  void setTimePasses(bool pEnable) { m_TimePasses = pEnable; }
+
+  bool timePasses() const { return m_TimePasses; }
+
+  void setTimePassesFormat(onnc::PassTimingInfo::Format pFormat) { m_TimePassesFormat = pFormat; }
+
+  onnc::PassTimingInfo::Format timePassesFormat() const { return m_TimePassesFormat; }
+
 private:
   onnc::Path m_Input;
   onnc::Path m_Output;
   onnc::Quadruple m_Quadruple;
   std::string m_Arch;
   onnc::TargetOptions m_TargetOptions;
+  onnc::Path m_CacheDir;
+  bool m_TimePasses;
+  onnc::PassTimingInfo::Format m_TimePassesFormat;
 };
 
 #endif
@@ -64,6 +64,31 @@ static cl::opt<std::string> OptQuadruple("mquadruple", cl::kShort, cl::kOptional
 static cl::opt<std::string> OptMArch("march", cl::kShort, cl::kOptional,
     cl::kValueRequired, cl::desc("target architecture"), cl::about(g_About));
 
+static cl::opt<std::string>
+OptCacheDir("cache-dir", cl::kLong, cl::kOptional, cl::kValueRequired,
+    cl::kEqualSeparated,
+    cl::desc("Reuse the artifacts of an identical compilation in <dir>. "
+             "Only the clang and sophon targets are cached."),
+    cl::about(g_About));
+
+static cl::opt<bool>
+OptTimePasses("time-passes", cl::kLong, cl::kOptional, cl::kValueDisallowed,
+    cl::init(false),
+    cl::desc("Time each pass and print the report to stderr."),
+    cl::about(g_About));
+
+static cl::opt<bool>
+OptTimePassesJSON("time-passes-json", cl::kLong, cl::kOptional,
+    cl::kValueDisallowed, cl::init(false),
+    cl::desc("Print the --time-passes report in JSON."),
+    cl::about(g_About));
+
+static cl::opt<bool>
+OptNvDlaEstimate("nvdla-estimate", cl::kLong, cl::kOptional,
+    cl::kValueDisallowed, cl::init(false),
+    cl::desc("Print the estimated NVDLA latency of each layer to stderr."),
+    cl::about(g_About));
+
 //===----------------------------------------------------------------------===//
 // Main Procedure
 //===----------------------------------------------------------------------===//
@@ -82,6 +107,11 @@ int main(int pArgc, char* pArgv[])
   if (OptQuiet)
     onnc.options().setVerbose(0);
 
+  // --time-passes
+  onnc.options().setTimePasses(OptTimePasses || OptTimePassesJSON);
+  if (OptTimePassesJSON)
+    onnc.options().setTimePassesFormat(PassTimingInfo::kJSON);
+
   // --help
   if (OptHelp) {
     g_About.print(outs(), ONNCConfig::kNormal < onnc.options().verbose());
@@ -119,5 +149,12 @@ int main(int pArgc, char* pArgv[])
       onnc.options().setArchName(OptMArch);
   }
 
+  // --nvdla-estimate
+  onnc.options().target().estimatePerformance(OptNvDlaEstimate);
+
+  // --cache-dir
+  if (OptCacheDir.hasOccurrence())
+    onnc.options().setCacheDir(OptCacheDir);
+
   return onnc.compile();
 }
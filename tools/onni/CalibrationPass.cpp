@@ -0,0 +1,348 @@
+//===- CalibrationPass.cpp ------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "CalibrationPass.h"
+#include "MemoryLayout.h"
+
+#include <onnc/ADT/Color.h>
+#include <onnc/Config/Config.h>
+#include <onnc/IR/Compute/Initializer.h>
+#include <onnc/IR/Compute/InputOperator.h>
+#include <onnc/IR/Compute/OutputOperator.h>
+#include <onnc/Support/Casting.h>
+#include <onnc/Support/IOStream.h>
+#include <onnc/Target/TargetBackend.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/onnc-runtime.h>
+}
+#undef restrict
+
+using namespace onnc;
+
+namespace {
+
+/// The number of histogram bins over [0, max]. 2048 bins keep enough
+/// resolution for the 128 positive levels of int8.
+constexpr std::size_t kNumOfBins = 2048;
+
+/// The number of positive int8 levels.
+constexpr std::size_t kNumOfLevels = 128;
+
+/// The fraction of the absolute values under the threshold of kPercentile.
+constexpr double kPercentileRank = 0.9999;
+
+/// @return true if the outputs of @ref pOp are observed.
+bool IsObserved(ComputeOperator& pOp)
+{
+  return !isa<Initializer>(&pOp) && !isa<OutputOperator>(&pOp);
+}
+
+std::size_t GetNumOfElements(const Tensor& pTensor)
+{
+  std::size_t size = 1;
+  for (const auto dimension : pTensor.getDimensions())
+    size *= dimension;
+  return size;
+}
+
+/// Escape @ref pText as a string of the protobuf text format.
+std::string Quote(const std::string& pText)
+{
+  std::string result("\"");
+  for (char c : pText) {
+    if ('"' == c || '\\' == c)
+      result += '\\';
+    result += c;
+  }
+  result += '"';
+  return result;
+}
+
+/// @return the KL divergence of the clipped distribution at @ref pNumOfBins
+/// bins and its int8 quantization.
+double GetKLDivergence(const std::vector<std::uint64_t>& pHistogram,
+                       std::size_t pNumOfBins)
+{
+  // the reference distribution: the outliers are clipped into the last bin.
+  std::vector<double> reference(pHistogram.begin(),
+                                pHistogram.begin() + pNumOfBins);
+  for (std::size_t i = pNumOfBins; i < pHistogram.size(); ++i)
+    reference.back() += pHistogram[i];
+
+  // the quantized distribution: merge the bins into kNumOfLevels levels, and
+  // expand each level evenly over its non-empty bins.
+  std::vector<double> quantized(pNumOfBins, 0.0);
+  for (std::size_t level = 0; level < kNumOfLevels; ++level) {
+    const std::size_t begin = level * pNumOfBins / kNumOfLevels;
+    const std::size_t end = (level + 1) * pNumOfBins / kNumOfLevels;
+    double sum = 0.0;
+    std::size_t nonEmpty = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+      sum += pHistogram[i];
+      nonEmpty += (0 != pHistogram[i]);
+    }
+    if (0 == nonEmpty)
+      continue;
+    for (std::size_t i = begin; i < end; ++i) {
+      if (0 != pHistogram[i])
+        quantized[i] = sum / nonEmpty;
+    }
+  }
+
+  double referenceSum = 0.0, quantizedSum = 0.0;
+  for (std::size_t i = 0; i < pNumOfBins; ++i) {
+    referenceSum += reference[i];
+    quantizedSum += quantized[i];
+  }
+  if (0.0 == referenceSum || 0.0 == quantizedSum)
+    return std::numeric_limits<double>::infinity();
+
+  // smooth the bins which the quantization leaves empty.
+  const double epsilon = 1e-4 / pNumOfBins;
+  double divergence = 0.0;
+  for (std::size_t i = 0; i < pNumOfBins; ++i) {
+    if (0.0 == reference[i])
+      continue;
+    const double p = reference[i] / referenceSum;
+    const double q = std::max(quantized[i] / quantizedSum, epsilon);
+    divergence += p * std::log(p / q);
+  }
+  return divergence;
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// CalibrationPass
+//===----------------------------------------------------------------------===//
+CalibrationPass::CalibrationPass(TargetBackend* pBackend, InputList pInputs,
+                                 Method pMethod, const Path& pOutput,
+                                 unsigned int pVerbose)
+  : m_pBackend(pBackend), m_Inputs(std::move(pInputs)), m_Method(pMethod),
+    m_Output(pOutput), m_Verbose(pVerbose) {
+}
+
+Pass::ReturnType CalibrationPass::runOnModule(Module& pModule)
+{
+  MemoryLayout layout;
+  layout.build(pModule);
+  if (!layout.isBindable())
+    return Pass::kPassFailure;
+
+  if (m_Inputs.empty()) {
+    errs() << Color::MAGENTA << "Fatal" << Color::RESET
+           << ": no calibration input" << std::endl;
+    return Pass::kPassFailure;
+  }
+
+  StatisticsMap statistics;
+  runRound(kRange, layout, pModule, statistics);
+  if (kMaxAbs != m_Method)
+    runRound(kHistogram, layout, pModule, statistics);
+
+  std::ofstream stream(m_Output.native());
+  if (!stream.is_open()) {
+    errs() << Color::MAGENTA << "Fatal" << Color::RESET
+           << ": cannot open file to write: " << m_Output << std::endl;
+    return Pass::kPassFailure;
+  }
+  print(stream, pModule, statistics);
+  if (m_Verbose >= 1)
+    outs() << "[v1] calibrated " << statistics.size() << " tensors with "
+           << m_Inputs.size() << " inputs into " << m_Output << std::endl;
+  return Pass::kModuleNoChanged;
+}
+
+void CalibrationPass::runRound(Round pRound, const MemoryLayout& pLayout,
+                               Module& pModule, StatisticsMap& pStatistics)
+{
+  std::size_t numOfWorkers = 1;
+#if defined(HAVE_PTHREAD)
+  numOfWorkers = std::min<std::size_t>(
+      std::max(1u, std::thread::hardware_concurrency()), m_Inputs.size());
+#endif
+
+  std::vector<StatisticsMap> results(numOfWorkers);
+  const std::size_t chunk = (m_Inputs.size() + numOfWorkers - 1) / numOfWorkers;
+  std::vector<std::thread> workers;
+  for (std::size_t w = 1; w < numOfWorkers; ++w) {
+    const std::size_t begin = std::min(w * chunk, m_Inputs.size());
+    const std::size_t end = std::min(begin + chunk, m_Inputs.size());
+    workers.emplace_back(&CalibrationPass::runInputs, this, pRound,
+                         std::cref(pLayout), std::ref(pModule), begin, end,
+                         std::cref(pStatistics), std::ref(results[w]));
+  }
+  runInputs(pRound, pLayout, pModule, 0, std::min(chunk, m_Inputs.size()),
+            pStatistics, results[0]);
+  for (std::thread& worker : workers)
+    worker.join();
+
+  for (const StatisticsMap& result : results) {
+    for (const auto& entry : result) {
+      Statistics& statistics = pStatistics[entry.first];
+      if (kRange == pRound) {
+        statistics.maxAbs = std::max(statistics.maxAbs, entry.second.maxAbs);
+        continue;
+      }
+      statistics.histogram.resize(kNumOfBins, 0);
+      for (std::size_t i = 0; i < kNumOfBins; ++i)
+        statistics.histogram[i] += entry.second.histogram[i];
+    }
+  }
+}
+
+void CalibrationPass::runInputs(Round pRound, const MemoryLayout& pLayout,
+                                Module& pModule, std::size_t pBegin,
+                                std::size_t pEnd, const StatisticsMap& pRanges,
+                                StatisticsMap& pResult) const
+{
+  if (pBegin == pEnd)
+    return;
+
+  std::unique_ptr<Interpreter> interpreter(
+      m_pBackend->createTargetInterpreter());
+  BasicInterpreter* basic = interpreter->getBasicInterpreter();
+
+  char* heap = pLayout.allocateHeap();
+  pLayout.bind(*basic, m_Inputs[pBegin].get(), heap);
+  for (std::size_t idx = pBegin; idx < pEnd; ++idx) {
+    basic->m_ATable[pLayout.input()] = m_Inputs[idx].get();
+
+    for (ComputeOperator& cm : *pModule.getRootComputeGraph()) {
+      cm.accept(interpreter->getVisitor());
+      if (!IsObserved(cm))
+        continue;
+
+      // the memory of an output may be reused later, so observe it now.
+      for (unsigned i = 0; i < cm.getNumOfOutputs(); ++i) {
+        const Tensor* output = static_cast<const Tensor*>(cm.getOutput(i));
+        auto address = basic->m_ATable.find(output);
+        if (Value::Type::kFloat != output->kind() ||
+            basic->m_ATable.end() == address)
+          continue;
+
+        const float* values = static_cast<const float*>(address->second);
+        const std::size_t size = GetNumOfElements(*output);
+        Statistics& statistics = pResult[output];
+        if (kRange == pRound) {
+          for (std::size_t j = 0; j < size; ++j)
+            statistics.maxAbs = std::max(statistics.maxAbs,
+                                         std::fabs(values[j]));
+          continue;
+        }
+
+        statistics.histogram.resize(kNumOfBins, 0);
+        auto range = pRanges.find(output);
+        if (pRanges.end() == range || 0.0f == range->second.maxAbs)
+          continue;
+        const float scale = kNumOfBins / range->second.maxAbs;
+        for (std::size_t j = 0; j < size; ++j) {
+          const std::size_t bin = std::min<std::size_t>(
+              static_cast<std::size_t>(std::fabs(values[j]) * scale),
+              kNumOfBins - 1);
+          ++statistics.histogram[bin];
+        }
+      }
+    }
+  }
+  ONNC_RUNTIME_shutdown_runtime(basic->m_pContext);
+
+  free(heap);
+}
+
+float CalibrationPass::GetThreshold(const Statistics& pStatistics,
+                                    Method pMethod)
+{
+  if (kMaxAbs == pMethod || pStatistics.histogram.empty() ||
+      0.0f == pStatistics.maxAbs)
+    return pStatistics.maxAbs;
+
+  const std::vector<std::uint64_t>& histogram = pStatistics.histogram;
+  const float binWidth = pStatistics.maxAbs / histogram.size();
+
+  if (kPercentile == pMethod) {
+    std::uint64_t total = 0;
+    for (std::uint64_t count : histogram)
+      total += count;
+    std::uint64_t accumulated = 0;
+    for (std::size_t i = 0; i < histogram.size(); ++i) {
+      accumulated += histogram[i];
+      if (kPercentileRank * total <= accumulated)
+        return std::min(pStatistics.maxAbs, (i + 1) * binWidth);
+    }
+    return pStatistics.maxAbs;
+  }
+
+  // kKLDivergence
+  std::size_t best = histogram.size();
+  double minDivergence = std::numeric_limits<double>::infinity();
+  for (std::size_t i = kNumOfLevels; i <= histogram.size(); ++i) {
+    const double divergence = GetKLDivergence(histogram, i);
+    if (divergence < minDivergence) {
+      minDivergence = divergence;
+      best = i;
+    }
+  }
+  return std::min(pStatistics.maxAbs, (best + 0.5f) * binWidth);
+}
+
+bool CalibrationPass::ParseMethod(const std::string& pName, Method& pMethod)
+{
+  if ("max" == pName)
+    pMethod = kMaxAbs;
+  else if ("percentile" == pName)
+    pMethod = kPercentile;
+  else if ("kl" == pName)
+    pMethod = kKLDivergence;
+  else
+    return false;
+  return true;
+}
+
+void CalibrationPass::print(std::ostream& pOS, Module& pModule,
+                            const StatisticsMap& pStatistics) const
+{
+  pOS << std::setprecision(9);
+  for (ComputeOperator& cm : *pModule.getRootComputeGraph()) {
+    if (!IsObserved(cm) || 0 == cm.getNumOfOutputs())
+      continue;
+
+    bool hasLayer = false;
+    for (unsigned i = 0; i < cm.getNumOfOutputs(); ++i) {
+      const Value* output = cm.getOutput(i);
+      auto statistics = pStatistics.find(output);
+      if (pStatistics.end() == statistics)
+        continue;
+
+      if (!hasLayer) {
+        pOS << "layer {\n  name: " << Quote(cm.getOutput(0)->getName())
+            << '\n';
+        hasLayer = true;
+      }
+      // a zero threshold leaves no scale to quantize with.
+      float threshold = GetThreshold(statistics->second, m_Method);
+      if (threshold <= 0.0f)
+        threshold = 1.0f;
+      pOS << "  blob_param {\n    name: " << Quote(output->getName())
+          << "\n    threshold_y: " << threshold << "\n  }\n";
+    }
+    if (hasLayer)
+      pOS << "}\n";
+  }
+}
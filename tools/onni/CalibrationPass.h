@@ -0,0 +1,102 @@
+//===- CalibrationPass.h --------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_CALIBRATION_PASS_H
+#define ONNC_CALIBRATION_PASS_H
+#include <onnc/Core/CustomPass.h>
+#include <onnc/IR/Compute/Tensor.h>
+#include <onnc/Runtime/Interpreter.h>
+#include <onnc/Support/Path.h>
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace onnc {
+
+class MemoryLayout;
+class TargetBackend;
+
+/** \class CalibrationPass
+ *  \brief Run the interpreter over a calibration dataset and write the
+ *         activation threshold of every tensor in a calibration table.
+ *
+ *  The first round records the maximum absolute value of each tensor, and
+ *  the second round, if the method needs one, fills a histogram of the
+ *  absolute values over [0, max]. The inputs are spread over worker threads,
+ *  and each worker owns an interpreter and a heap.
+ *
+ *  The table is a text format NetCalibrationParameter (the BM1880 ctable)
+ *  with one layer per operator, named after its first output, and one blob
+ *  per output. It only has thresholds; `onnx2tg -ctable` fills the other
+ *  quantization parameters.
+ */
+class CalibrationPass : public CustomPass<CalibrationPass>
+{
+public:
+  enum Method
+  {
+    kMaxAbs,        ///< the maximum absolute value
+    kPercentile,    ///< the 99.99th percentile of the absolute values
+    kKLDivergence   ///< the one which loses the least information in int8
+  };
+
+  typedef std::vector<std::unique_ptr<char[]> > InputList;
+
+  struct Statistics
+  {
+    float maxAbs = 0.0f;
+    std::vector<std::uint64_t> histogram;
+  };
+
+  typedef std::unordered_map<const Value*, Statistics> StatisticsMap;
+
+public:
+  CalibrationPass(TargetBackend* pBackend, InputList pInputs, Method pMethod,
+                  const Path& pOutput, unsigned int pVerbose);
+
+  ReturnType runOnModule(Module& pModule) override;
+
+  StringRef getPassName() const override { return "CalibrationPass"; }
+
+  /// @return the threshold of @ref pStatistics chosen by @ref pMethod.
+  static float GetThreshold(const Statistics& pStatistics, Method pMethod);
+
+  /// Parse the name of a method.
+  /// @retval false @ref pName is unknown.
+  static bool ParseMethod(const std::string& pName, Method& pMethod);
+
+private:
+  enum Round { kRange, kHistogram };
+
+  void runRound(Round pRound, const MemoryLayout& pLayout, Module& pModule,
+                StatisticsMap& pStatistics);
+
+  /// Run the inputs [pBegin, pEnd) on an interpreter of its own. The
+  /// histogram round bins the values over the ranges in @ref pRanges.
+  void runInputs(Round pRound, const MemoryLayout& pLayout, Module& pModule,
+                 std::size_t pBegin, std::size_t pEnd,
+                 const StatisticsMap& pRanges,
+                 StatisticsMap& pResult) const;
+
+  void print(std::ostream& pOS, Module& pModule,
+             const StatisticsMap& pStatistics) const;
+
+private:
+  TargetBackend* m_pBackend;
+  InputList m_Inputs;
+  Method m_Method;
+  Path m_Output;
+  unsigned int m_Verbose;
+};
+
+} // namespace of onnc
+
+#endif
@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "InterpreterPass.h"
+#include "MemoryLayout.h"
 
 #include <onnc/IR/Compute/Tensor.h>
 #include <onnc/IR/Compute/Initializer.h>
@@ -17,7 +18,7 @@
 #include <onnc/Target/TargetBackend.h>
 
 #include <algorithm>
-#include <cassert>
+#include <cstdlib>
 #include <iomanip>
 #include <sstream>
 #include <unordered_map>
@@ -74,36 +75,12 @@ InterpreterPass::InterpreterPass(TargetBackend *pBackend,
 
 Pass::ReturnType InterpreterPass::runOnModule(Module &pModule)
 {
-  std::unordered_map<Value *, int64_t> mem_start;
-  std::unordered_map<Value *, int64_t> mem_length;
-
-  // XXX: Use Pass or something to get internal memory size
-  uint64_t weight_memory_size = 0;
-  uint64_t internal_memory_size = 0;
-  for (ComputeOperand *co : pModule.getComputeOperands()) {
-    if (ComputeMemOperand *mem = dyn_cast<ComputeMemOperand>(co)) {
-      Value *v = co->getValue();
-      if (mem->isInput()) {
-        // XXX: Multiple inputs
-        m_pInterpreter->getBasicInterpreter()->m_ATable[v] = m_pInputMem.get();
-      } else if (mem->isWeight()) {
-        // XXX
-        FloatTensor *t = static_cast<FloatTensor *>(v);
-        m_pInterpreter->getBasicInterpreter()->m_ATable[v] = t->getValues().data();
-        weight_memory_size +=
-            t->getValues().size() * sizeof(FloatTensor::ValueList::value_type);
-      } else {
-        mem_start[co->getValue()] = mem->start();
-        mem_length[co->getValue()] = mem->length();
-        internal_memory_size =
-            std::max(internal_memory_size,
-                     static_cast<uint64_t>(mem->start()) + mem->length());
-      }
-    }
-  }
+  MemoryLayout layout;
+  layout.build(pModule);
+
   if (m_Verbose >= 1) {
-    outs() << "[v1] weight memory: " << weight_memory_size << std::endl;
-    outs() << "[v1] internal memory: " << internal_memory_size << std::endl;
+    outs() << "[v1] weight memory: " << layout.weightSize() << std::endl;
+    outs() << "[v1] internal memory: " << layout.heapSize() << std::endl;
   }
 
   if (m_Verbose >= 2) {
@@ -118,6 +95,13 @@ Pass::ReturnType InterpreterPass::runOnModule(Module &pModule)
   }
 
   if (m_Verbose >= 4) {
+    std::unordered_map<const Value *, int64_t> mem_start;
+    std::unordered_map<const Value *, int64_t> mem_length;
+    for (const MemoryLayout::Internal &internal : layout.internals()) {
+      mem_start[internal.value] = internal.start;
+      mem_length[internal.value] = internal.length;
+    }
+
     std::ostringstream os;
     // TODO: Refactor this. We need a table printer.
     size_t val_len = 8;
@@ -151,7 +135,7 @@ Pass::ReturnType InterpreterPass::runOnModule(Module &pModule)
         os << "[v4] " << std::setw(val_len) << v->getName() << sep
            << std::internal << std::hex << std::setfill('0')
            << "0x" << std::setw(ptr_len) << mem_start[v]
-           << (mem_end == internal_memory_size ? '*' : ' ')
+           << (mem_end == layout.heapSize() ? '*' : ' ')
            << "0x" << std::setw(ptr_len) << mem_end << ' '
            << std::right << std::dec << std::setfill(' ')
            << std::setw(ptr_len) << mem_length[v]
@@ -163,27 +147,12 @@ Pass::ReturnType InterpreterPass::runOnModule(Module &pModule)
 
 
   if (!m_DryRun) {
+    if (!layout.isBindable())
+      return Pass::kPassFailure;
+
     // XXX: Use onnc-runtime to handle memory
-    char *heap = NULL;
-
-    // TODO: aligned_alloc after c++17
-    // XXX: Refactor into interpreter
-    // TODO: posix_memalign(&interpreter.m_mem,
-    //                      backend->......,
-    //                      internal_memory_size)
-    int fail = posix_memalign(reinterpret_cast<void **>(&heap),
-                              16,
-                              internal_memory_size);
-    assert((!fail) && "posix_memalign failed!");
-
-    // Fixup memory address
-    for (ComputeOperand *co : pModule.getComputeOperands()) {
-      if (ComputeMemOperand *mem = dyn_cast<ComputeMemOperand>(co)) {
-        if (mem->isOutput() || mem->isInternal()) {
-          m_pInterpreter->getBasicInterpreter()->m_ATable[co->getValue()] = heap + mem->start();
-        }
-      }
-    }
+    char *heap = layout.allocateHeap();
+    layout.bind(*m_pInterpreter->getBasicInterpreter(), m_pInputMem.get(), heap);
 
     Pass::ReturnType r = runInterpreter(pModule);
 
@@ -198,9 +167,6 @@ Pass::ReturnType InterpreterPass::runOnModule(Module &pModule)
 
 Pass::ReturnType InterpreterPass::runInterpreter(Module &pModule)
 {
-  // TODO: Refactor into Interpreter
-  m_pInterpreter->getBasicInterpreter()->m_pContext = ONNC_RUNTIME_init_runtime();
-
   Timer::Interval total;
   // TODO: Timer can not nested. Should rewrite it.
   if (m_Verbose >= 1) total = ::ns();
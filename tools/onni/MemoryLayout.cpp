@@ -0,0 +1,94 @@
+//===- MemoryLayout.cpp ---------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "MemoryLayout.h"
+
+#include <onnc/ADT/Color.h>
+#include <onnc/IR/Compute/Tensor.h>
+#include <onnc/IR/ComputeMemOperand.h>
+#include <onnc/Support/Casting.h>
+#include <onnc/Support/IOStream.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <unordered_set>
+
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/onnc-runtime.h>
+}
+#undef restrict
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// MemoryLayout
+//===----------------------------------------------------------------------===//
+void MemoryLayout::build(Module& pModule)
+{
+  // a value has an operand per use.
+  std::unordered_set<const Value*> visited;
+  for (ComputeOperand* co : pModule.getComputeOperands()) {
+    ComputeMemOperand* mem = dyn_cast<ComputeMemOperand>(co);
+    Value* v = co->getValue();
+    if (nullptr == mem || !visited.insert(v).second)
+      continue;
+    if (mem->isInput()) {
+      ++m_NumOfInputs;
+      m_pInput = v;
+    } else if (mem->isWeight()) {
+      // XXX: only float weights
+      FloatTensor* t = static_cast<FloatTensor*>(v);
+      m_Weights.emplace_back(v, t->getValues().data());
+      m_WeightSize +=
+          t->getValues().size() * sizeof(FloatTensor::ValueList::value_type);
+    } else if (mem->isOutput() || mem->isInternal()) {
+      m_Internals.push_back(Internal{ v, mem->start(), mem->length() });
+      m_HeapSize = std::max(m_HeapSize,
+          static_cast<std::uint64_t>(mem->start()) + mem->length());
+    }
+  }
+}
+
+bool MemoryLayout::isBindable() const
+{
+  if (m_NumOfInputs > 1) {
+    errs() << Color::MAGENTA << "Fatal" << Color::RESET
+           << ": onni reads one input tensor, but the model has "
+           << m_NumOfInputs << " inputs" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void MemoryLayout::bind(BasicInterpreter& pInterpreter, void* pInput,
+                        char* pHeap) const
+{
+  if (nullptr != m_pInput)
+    pInterpreter.m_ATable[m_pInput] = pInput;
+  for (const auto& weight : m_Weights)
+    pInterpreter.m_ATable[weight.first] = weight.second;
+  for (const Internal& internal : m_Internals)
+    pInterpreter.m_ATable[internal.value] = pHeap + internal.start;
+
+  pInterpreter.m_pContext = ONNC_RUNTIME_init_runtime();
+
+  // the operators may keep the weights in the layouts they prefer.
+  for (const auto& weight : m_Weights)
+    ONNC_RUNTIME_add_constant(pInterpreter.m_pContext, weight.second);
+}
+
+char* MemoryLayout::allocateHeap() const
+{
+  // TODO: aligned_alloc after c++17
+  char* heap = NULL;
+  int fail = posix_memalign(reinterpret_cast<void**>(&heap), 16,
+                            std::max<std::uint64_t>(m_HeapSize, 16));
+  assert((!fail) && "posix_memalign failed!");
+  return heap;
+}
@@ -0,0 +1,76 @@
+//===- MemoryLayout.h -----------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_ONNI_MEMORY_LAYOUT_H
+#define ONNC_ONNI_MEMORY_LAYOUT_H
+#include <onnc/IR/Compute/Value.h>
+#include <onnc/IR/Module.h>
+#include <onnc/Runtime/Interpreter.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace onnc {
+
+/** \class MemoryLayout
+ *  \brief Where the interpreter finds every value of a module.
+ *
+ *  The weights stay in their tensors, the outputs and the internal values
+ *  live at an offset of a heap, and the input is read from a tensor file.
+ *  onni reads one tensor file per run, so a model with more than one input
+ *  cannot be bound.
+ */
+class MemoryLayout
+{
+public:
+  struct Internal
+  {
+    const Value* value;
+    std::int64_t start;
+    std::int64_t length;
+  };
+
+public:
+  /// Collect the layout of the memory operands of @ref pModule.
+  void build(Module& pModule);
+
+  /// @retval false The model has more than one input, which cannot be bound
+  ///               to one tensor file. An error is printed.
+  bool isBindable() const;
+
+  /// Bind the values to @ref pInput and @ref pHeap, start the runtime, and
+  /// register the weights as its constants. Shut the runtime down by
+  /// ONNC_RUNTIME_shutdown_runtime(pInterpreter.m_pContext).
+  void bind(BasicInterpreter& pInterpreter, void* pInput, char* pHeap) const;
+
+  /// Allocate a heap for the internal values. Release it by free().
+  char* allocateHeap() const;
+
+  const Value* input() const { return m_pInput; }
+
+  const std::vector<std::pair<const Value*, void*> >& weights() const
+  { return m_Weights; }
+
+  const std::vector<Internal>& internals() const { return m_Internals; }
+
+  std::uint64_t heapSize() const { return m_HeapSize; }
+
+  std::uint64_t weightSize() const { return m_WeightSize; }
+
+private:
+  const Value* m_pInput = nullptr;
+  unsigned int m_NumOfInputs = 0;
+  std::vector<std::pair<const Value*, void*> > m_Weights;
+  std::vector<Internal> m_Internals;
+  std::uint64_t m_HeapSize = 0;
+  std::uint64_t m_WeightSize = 0;
+};
+
+} // namespace of onnc
+
+#endif
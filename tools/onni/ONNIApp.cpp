@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 #include "ONNIApp.h"
 
+#include "CalibrationPass.h"
 #include "CountOperatorsPass.h"
 #include "InterpreterPass.h"
 
@@ -205,6 +206,35 @@ namespace internal {
 
     return TensorReadResult{std::move(data), length};
   }
+
+  /// Read the tensor files listed in @ref pListPath, one path per line.
+  /// Relative paths are relative to the list.
+  bool readCalibrationInputs(const Path& pListPath,
+                             CalibrationPass::InputList& pInputs)
+  {
+    std::ifstream stream(pListPath.native());
+    if (!stream.is_open()) {
+      errs() << Color::MAGENTA << "Fatal" << Color::RESET
+             << ": cannot open file file: " << pListPath
+             << std::endl;
+      return false;
+    }
+
+    std::string line;
+    while (std::getline(stream, line)) {
+      if (line.empty())
+        continue;
+      Path filePath(line);
+      const Path directory = pListPath.parent();
+      if (!filePath.isFromRoot() && !directory.empty())
+        filePath = directory + filePath;
+      auto result = readTensor(filePath);
+      if (!result)
+        return false;
+      pInputs.emplace_back(std::move(result.m_Data));
+    }
+    return true;
+  }
 } // namespace internal
 } // namespace onnc
 
@@ -252,6 +282,16 @@ int ONNIApp::run()
     pm.add<CountOperatorsPass>("[Statistics] ");
   }
 
+  if (!options().calibrationList().empty()) {
+    CalibrationPass::InputList inputs;
+    if (!readCalibrationInputs(options().calibrationList(), inputs))
+      return EXIT_FAILURE;
+    pm.add<CalibrationPass>(backend.get(), std::move(inputs),
+                            options().calibrationMethod(), options().output(),
+                            options().verbose());
+    return runPasses(pm, module);
+  }
+
   // FIXME: Use onnc-runtime to handle input
   std::unique_ptr<char[]> input;
   if (!options().dryRun()) {
@@ -277,7 +317,22 @@ int ONNIApp::run()
     options().dryRun()
   );
 
-  pm.run(module);
+  return runPasses(pm, module);
+}
+
+int ONNIApp::runPasses(PassManager& pPassManager, Module& pModule)
+{
+  PassTimingInfo timing;
+  if (options().timePasses())
+    pPassManager.setTimingInfo(&timing);
+
+  const bool succeeded = pPassManager.run(pModule);
+
+  if (options().timePasses())
+    timing.print(errs(), options().timePassesFormat());
+
+  if (!succeeded)
+    return EXIT_FAILURE;
 
   if (options().verbose() >= 3) {
     errs() << "==== print CountOperatorsPass result again ====\n";
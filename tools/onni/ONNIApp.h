@@ -8,6 +8,8 @@
 #ifndef ONNC_INTERPRETER_APPLICATION_H
 #define ONNC_INTERPRETER_APPLICATION_H
 #include <onnc/Core/Application.h>
+#include <onnc/Core/PassManager.h>
+#include <onnc/IR/Module.h>
 #include "ONNIConfig.h"
 
 class ONNIApp : public onnc::CoreApplication
@@ -21,6 +23,10 @@ public:
 
   int run();
 
+private:
+  /// Run @ref pPassManager on @ref pModule and print the requested reports.
+  int runPasses(onnc::PassManager& pPassManager, onnc::Module& pModule);
+
 private:
   ONNIConfig m_Options;
 };
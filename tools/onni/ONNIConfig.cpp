@@ -15,7 +15,9 @@ using namespace onnc;
 ONNIConfig::ONNIConfig()
   : m_Model(), m_Input(), m_Output(),
     m_Quadruple(), m_Arch(), m_TargetOptions(),
-    m_Verbose(), m_DryRun(), m_OnnxOpt() {
+    m_Verbose(), m_DryRun(), m_OnnxOpt(),
+    m_CalibrationList(), m_CalibrationMethod(CalibrationPass::kKLDivergence),
+    m_TimePasses(false), m_TimePassesFormat(PassTimingInfo::kTable) {
 }
 
 ONNIConfig::~ONNIConfig()
@@ -7,7 +7,10 @@
 //===----------------------------------------------------------------------===//
 #ifndef ONNC_INTERPRETER_ONNI_CONFIG_H
 #define ONNC_INTERPRETER_ONNI_CONFIG_H
+#include "CalibrationPass.h"
+
 #include <onnc/Core/Application.h>
+#include <onnc/Core/PassTimingInfo.h>
 #include <onnc/Support/Path.h>
 #include <onnc/IR/Quadruple.h>
 #include <onnc/Target/TargetOptions.h>
@@ -21,6 +24,8 @@ class ONNIConfig
 public:
   static constexpr const char* DefaultOutputName = "out.tsr";
 
+  static constexpr const char* DefaultCtableName = "out.ctable";
+
   enum VerboseLevel : int {
     kQuiet = 0,
     kNotice = 1,
@@ -71,6 +76,24 @@ public:
 
   bool onnxOpt() const { return m_OnnxOpt; }
 
+  /// The list of the calibration inputs, one tensor file per line. An empty
+  /// list runs the inference instead of the calibration.
+  const onnc::Path& calibrationList() const { return m_CalibrationList; }
+
+  void setCalibrationList(const onnc::Path& pFilePath) { m_CalibrationList = pFilePath; }
+
+  onnc::CalibrationPass::Method calibrationMethod() const { return m_CalibrationMethod; }
+
+  void setCalibrationMethod(onnc::CalibrationPass::Method pMethod) { m_CalibrationMethod = pMethod; }
+
+  void setTimePasses(bool pEnable) { m_TimePasses = pEnable; }
+
+  bool timePasses() const { return m_TimePasses; }
+
+  void setTimePassesFormat(onnc::PassTimingInfo::Format pFormat) { m_TimePassesFormat = pFormat; }
+
+  onnc::PassTimingInfo::Format timePassesFormat() const { return m_TimePassesFormat; }
+
 private:
   onnc::Path m_Model;
   onnc::Path m_Input;
@@ -81,6 +104,10 @@ private:
   unsigned int m_Verbose;
   bool m_DryRun;
   bool m_OnnxOpt;
+  onnc::Path m_CalibrationList;
+  onnc::CalibrationPass::Method m_CalibrationMethod;
+  bool m_TimePasses;
+  onnc::PassTimingInfo::Format m_TimePassesFormat;
 };
 
 #endif
@@ -82,6 +82,33 @@ static cl::opt<std::string> OptQuadruple("mquadruple", cl::kShort, cl::kOptional
 static cl::opt<std::string> OptMArch("march", cl::kShort, cl::kOptional,
     cl::kValueRequired, cl::desc("target architecture"), cl::about(g_About));
 
+static cl::opt<Path>
+OptCalibrate("calibrate", cl::kLong, cl::kOptional, cl::kValueRequired,
+    cl::kEqualSeparated,
+    cl::desc("Run the inputs listed in <file>, one tensor file per line, and "
+             "write the activation thresholds into the ctable file -o "
+             "(default is out.ctable)."),
+    cl::about(g_About));
+
+static cl::opt<std::string>
+OptCalibrationMethod("calibration-method", cl::kLong, cl::kOptional,
+    cl::kValueRequired, cl::kEqualSeparated,
+    cl::desc("Set the threshold of --calibrate to <max|percentile|kl> "
+             "(default is kl)."),
+    cl::about(g_About));
+
+static cl::opt<bool>
+OptTimePasses("time-passes", cl::kLong, cl::kOptional, cl::kValueDisallowed,
+    cl::init(false),
+    cl::desc("Time each pass and print the report to stderr."),
+    cl::about(g_About));
+
+static cl::opt<bool>
+OptTimePassesJSON("time-passes-json", cl::kLong, cl::kOptional,
+    cl::kValueDisallowed, cl::init(false),
+    cl::desc("Print the --time-passes report in JSON."),
+    cl::about(g_About));
+
 //===----------------------------------------------------------------------===//
 // Main Procedure
 //===----------------------------------------------------------------------===//
@@ -108,6 +135,11 @@ int main(int pArgc, char* pArgv[])
   // --onnx-optimizer
   onni.options().setOnnxOpt(OptOnnxOpt);
 
+  // --time-passes
+  onni.options().setTimePasses(OptTimePasses || OptTimePassesJSON);
+  if (OptTimePassesJSON)
+    onni.options().setTimePassesFormat(PassTimingInfo::kJSON);
+
   // --help
   if (OptHelp) {
     g_About.print(outs(), ONNIConfig::kNormal < onni.options().verbose());
@@ -131,9 +163,33 @@ int main(int pArgc, char* pArgv[])
   // set onnx input
   onni.options().setInput(OptInput);
 
+  // --calibrate=list
+  if (OptCalibrate.hasOccurrence()) {
+    if (!exists(OptCalibrate) || !is_regular(OptCalibrate)) {
+      errs() << Color::MAGENTA << "Fatal" << Color::RESET
+             << ": calibration list not found: " << OptCalibrate << std::endl;
+      return EXIT_FAILURE;
+    }
+    onni.options().setCalibrationList(OptCalibrate);
+  }
+
+  // --calibration-method=method
+  if (OptCalibrationMethod.hasOccurrence()) {
+    CalibrationPass::Method method;
+    if (!CalibrationPass::ParseMethod(OptCalibrationMethod, method)) {
+      errs() << Color::MAGENTA << "Fatal" << Color::RESET
+             << ": unknown calibration method: " << OptCalibrationMethod
+             << std::endl;
+      return EXIT_FAILURE;
+    }
+    onni.options().setCalibrationMethod(method);
+  }
+
   // check output
   if (OptOutput.hasOccurrence())
     onni.options().setOutput(OptOutput);
+  else if (OptCalibrate.hasOccurrence())
+    onni.options().setOutput(ONNIConfig::DefaultCtableName);
   else
     onni.options().setOutput(ONNIConfig::DefaultOutputName);
 
@@ -82,6 +82,12 @@ static cl::opt<bool> AddDummyWeight("add-dummy-weight", cl::kShort,
                                     cl::desc("add dummy weight if not found"),
                                     cl::about(g_About));
 
+static cl::opt<std::string>
+    CalibrationTable("ctable", cl::kShort, cl::kOptional, cl::kValueRequired,
+                     cl::desc("read the thresholds from a ctable file, "
+                              "e.g. the output of onni -calibrate"),
+                     cl::about(g_About));
+
 static cl::opt<bool> OptHelp("help", cl::kLong, cl::kOptional,
                              cl::kValueDisallowed, cl::init(false),
                              cl::desc("Show this manual."), cl::about(g_About));
@@ -126,6 +132,7 @@ int main(int pArgc, char *pArgv[])
   onnx2tg.options().target().ignoreCalibrationStep(IgnoreCalibrationStep);
   onnx2tg.options().target().useDummyCTable(AddDummyCTable);
   onnx2tg.options().target().useDummyWeight(AddDummyWeight);
+  onnx2tg.options().target().setCalibrationTable(Path(CalibrationTable));
   onnx2tg.options().target().optOnnxModel(OutputOptOnnx);
 
 #ifdef BMONNC_EXIST
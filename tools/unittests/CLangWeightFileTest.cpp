@@ -0,0 +1,110 @@
+//===- CLangWeightFileTest.cpp --------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "CLangGenWeightFilePass.h"
+#include "CLangMeta.h"
+#include "TargetInfo/CLangTargetMemInfo.h"
+#include "Optimizations/GraphUtils.h"
+#include <onnc/IR/Module.h>
+#include <onnc/Support/Float16.h>
+#define restrict
+#include <onnc/Runtime/onnc-runtime.h>
+#undef restrict
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace onnc;
+
+namespace {
+
+const char* kWeightFile = BUILDDIR "/CLangWeightFileTest.weight";
+
+/// Append @ref pTensor to @ref pMeta at the next 16-byte boundary, the way
+/// CLangMemInfoPass packs the weights.
+void AddWeight(CLangMeta& pMeta, const Tensor& pTensor)
+{
+  CLangMemoryBlock::address_type offset = 0;
+  if (!pMeta.packedWeightMemoryBlocks.empty()) {
+    const CLangMemoryBlock& last = pMeta.packedWeightMemoryBlocks.back().second;
+    offset = (last.offset + last.length + 15) / 16 * 16;
+  }
+
+  const MemSize size = CLangTargetMemInfo().getTensorMemorySize(pTensor);
+  pMeta.packedWeightMemoryBlocks.emplace_back(&pTensor, CLangMemoryBlock{offset, size.size});
+}
+
+std::vector<char> ReadFile(const char* pPath)
+{
+  std::ifstream file(pPath, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+}
+
+ONNC_RUNTIME_tensor_view GetTensor(std::vector<char>& pFile, uint64_t pIndex)
+{
+  const auto* table = reinterpret_cast<const ONNC_RUNTIME_tensor_offset_table*>(pFile.data());
+  const ONNC_RUNTIME_tensor_offset offset = table->tensor_offsets[pIndex];
+  return ONNC_RUNTIME_tensor_view{pFile.data() + offset.offset, offset.size};
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+SKYPAT_F(CLangWeightFileTest, float16_weights_take_two_bytes)
+{
+  onnc::Module module;
+  ComputeGraph& cg = BuildGraph(module, "top-level");
+
+  // odd element counts, so the tensors after them need padding.
+  const Float16Tensor::ValueList halves = {1.0f, -2.5f, 65504.0f, 5.9604645e-8f, 0.1f};
+  const BFloat16Tensor::ValueList brains = {3.0f, -0.15625f, 1e30f};
+  const FloatTensor::ValueList floats = {0.5f, 42.0f};
+  CreateWeightOperatorWithValues<Float16Tensor>(cg, "h", {5}, halves);
+  CreateWeightOperatorWithValues<BFloat16Tensor>(cg, "b", {3}, brains);
+  CreateWeightOperatorWithValues<FloatTensor>(cg, "f", {2}, floats);
+
+  CLangMeta meta;
+  AddWeight(meta, *cg.getValue<Tensor>("h"));
+  AddWeight(meta, *cg.getValue<Tensor>("b"));
+  AddWeight(meta, *cg.getValue<Tensor>("f"));
+  ASSERT_EQ(meta.packedWeightMemoryBlocks[0].second.length, 5 * 2);
+  ASSERT_EQ(meta.packedWeightMemoryBlocks[1].second.length, 3 * 2);
+
+  CLangGenWeightFilePass pass(meta, Path(kWeightFile));
+  pass.runOnModule(module);
+
+  // the table, then 16 bytes of halves, 16 bytes of bfloat16s and 2 floats.
+  std::vector<char> file = ReadFile(kWeightFile);
+  std::remove(kWeightFile);
+  const std::size_t tableSize =
+      sizeof(ONNC_RUNTIME_tensor_offset_table) + 3 * sizeof(ONNC_RUNTIME_tensor_offset);
+  ASSERT_EQ(file.size(), tableSize + 16 + 16 + 2 * sizeof(float));
+
+  void* runtime = ONNC_RUNTIME_init_runtime();
+
+  const float* h = ONNC_RUNTIME_widen_float16(runtime, GetTensor(file, 0));
+  ASSERT_TRUE(h != nullptr);
+  for (std::size_t i = 0; i < halves.size(); ++i)
+    EXPECT_EQ(h[i], float(halves[i]));
+
+  const float* b = ONNC_RUNTIME_widen_bfloat16(runtime, GetTensor(file, 1));
+  ASSERT_TRUE(b != nullptr);
+  for (std::size_t i = 0; i < brains.size(); ++i)
+    EXPECT_EQ(b[i], float(brains[i]));
+
+  const ONNC_RUNTIME_tensor_view f = GetTensor(file, 2);
+  ASSERT_EQ(f.size, 2 * sizeof(float));
+  EXPECT_EQ(static_cast<const float*>(f.data)[1], 42.0f);
+
+  ONNC_RUNTIME_shutdown_runtime(runtime);
+}
@@ -0,0 +1,117 @@
+//===- CalibrationTableTest.cpp -------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "CalibrationTable.h"
+
+#include <string>
+
+using namespace onnc;
+using namespace onnc::BM188X;
+
+// Layer "conv" appears twice, and blob "y" is owned by both "conv" and
+// "relu".
+static const char* g_Ctable = R"(
+name: "net"
+layer {
+  name: "data"
+  blob_param { name: "data" threshold_y: 1 }
+}
+layer {
+  name: "conv"
+  right_shift_width: 3
+  blob_param { name: "y" threshold_y: 2 }
+  blob_param { name: "z" threshold_y: 3 }
+}
+layer {
+  name: "relu"
+  blob_param { name: "y" threshold_y: 4 }
+}
+layer {
+  name: "conv"
+  right_shift_width: 5
+  blob_param { name: "w" threshold_y: 6 }
+}
+)";
+
+//===----------------------------------------------------------------------===//
+// CalibrationTable Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(CalibrationTableTest, first_occurrence)
+{
+  CalibrationTable table;
+  ASSERT_TRUE(table.parse(g_Ctable));
+
+  const CalibrationTable::LayerCtable* conv = table.getLayer("conv");
+  ASSERT_TRUE(nullptr != conv);
+  EXPECT_EQ(conv->right_shift_width(), 3);
+
+  float threshold = 0;
+  ASSERT_TRUE(table.getThreshold("y", threshold));
+  EXPECT_EQ(threshold, 2);
+  EXPECT_TRUE(table.getLayerOfBlob("y") == conv);
+
+  // the blob of the second "conv" is still indexed
+  ASSERT_TRUE(table.getThreshold("w", threshold));
+  EXPECT_EQ(threshold, 6);
+  EXPECT_TRUE(table.getLayerOfBlob("w") == &table.getProto().layer(3));
+
+  EXPECT_TRUE(nullptr == table.getLayer("pool"));
+  EXPECT_TRUE(nullptr == table.getBlob("pool"));
+  EXPECT_FALSE(table.getThreshold("pool", threshold));
+}
+
+SKYPAT_F(CalibrationTableTest, mutable_proto_drops_index)
+{
+  CalibrationTable table;
+  ASSERT_TRUE(table.parse(g_Ctable));
+
+  // rename a blob and move the first "conv" behind the second
+  CalibrationTable::NetCtable& proto = table.getMutableProto();
+  proto.mutable_layer(1)->mutable_blob_param(0)->set_name("y0");
+  proto.mutable_layer()->SwapElements(1, 3);
+
+  float threshold = 0;
+  ASSERT_TRUE(table.getThreshold("y", threshold));
+  EXPECT_EQ(threshold, 4);
+  ASSERT_TRUE(table.getThreshold("y0", threshold));
+  EXPECT_EQ(threshold, 2);
+  EXPECT_EQ(table.getLayer("conv")->right_shift_width(), 5);
+
+  // a new layer is found
+  CalibrationTable::LayerCtable* pool = table.getMutableProto().add_layer();
+  pool->set_name("pool");
+  pool->add_blob_param()->set_name("p");
+  EXPECT_TRUE(table.getLayer("pool") == pool);
+  EXPECT_TRUE(table.getLayerOfBlob("p") == pool);
+
+  // parse replaces the whole table
+  ASSERT_TRUE(table.parse(R"(name: "other")"));
+  EXPECT_TRUE(nullptr == table.getLayer("conv"));
+  EXPECT_TRUE(nullptr == table.getBlob("y"));
+}
+
+SKYPAT_F(CalibrationTableTest, mutable_layer_keeps_index)
+{
+  CalibrationTable table;
+  ASSERT_TRUE(table.parse(g_Ctable));
+
+  CalibrationTable::LayerCtable* relu = table.getMutableLayer("relu");
+  ASSERT_TRUE(nullptr != relu);
+  relu->add_threshold_x_quantized(7);
+  relu->mutable_blob_param(0)->set_threshold_y(8);
+
+  EXPECT_EQ(table.getLayer("relu")->threshold_x_quantized_size(), 1);
+  EXPECT_EQ(table.getProto().layer(2).blob_param(0).threshold_y(), 8);
+
+  // "y" still resolves to the first "conv"
+  float threshold = 0;
+  ASSERT_TRUE(table.getThreshold("y", threshold));
+  EXPECT_EQ(threshold, 2);
+
+  EXPECT_TRUE(nullptr == table.getMutableLayer("pool"));
+}
@@ -0,0 +1,77 @@
+//===- CalibrationTest.cpp ------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "CalibrationPass.h"
+
+#include <cmath>
+
+using namespace onnc;
+
+static CalibrationPass::Statistics
+MakeStatistics(float pMaxAbs, std::size_t pNumOfBins)
+{
+  CalibrationPass::Statistics statistics;
+  statistics.maxAbs = pMaxAbs;
+  statistics.histogram.assign(pNumOfBins, 0);
+  return statistics;
+}
+
+//===----------------------------------------------------------------------===//
+// CalibrationPass Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(CalibrationTest, max_abs)
+{
+  CalibrationPass::Statistics statistics = MakeStatistics(3.5f, 2048);
+  statistics.histogram[0] = 100;
+  EXPECT_EQ(CalibrationPass::GetThreshold(statistics,
+                                          CalibrationPass::kMaxAbs), 3.5f);
+
+  // the methods fall back to the maximum without a histogram.
+  CalibrationPass::Statistics range = MakeStatistics(3.5f, 0);
+  EXPECT_EQ(CalibrationPass::GetThreshold(range,
+                                          CalibrationPass::kPercentile), 3.5f);
+  EXPECT_EQ(CalibrationPass::GetThreshold(range,
+                                          CalibrationPass::kKLDivergence), 3.5f);
+
+  CalibrationPass::Statistics zero = MakeStatistics(0.0f, 2048);
+  EXPECT_EQ(CalibrationPass::GetThreshold(zero,
+                                          CalibrationPass::kKLDivergence), 0.0f);
+}
+
+SKYPAT_F(CalibrationTest, percentile)
+{
+  // one bin per unit, 100000 values in [0, 100) and one outlier at 2048.
+  CalibrationPass::Statistics statistics = MakeStatistics(2048.0f, 2048);
+  for (std::size_t i = 0; i < 100; ++i)
+    statistics.histogram[i] = 1000;
+  statistics.histogram[2047] = 1;
+
+  EXPECT_EQ(CalibrationPass::GetThreshold(statistics,
+                                          CalibrationPass::kPercentile), 100.0f);
+}
+
+SKYPAT_F(CalibrationTest, kl_divergence)
+{
+  // without outliers, clipping loses information, so the whole range is kept.
+  CalibrationPass::Statistics uniform = MakeStatistics(2048.0f, 2048);
+  for (std::uint64_t& count : uniform.histogram)
+    count = 100;
+  EXPECT_GE(CalibrationPass::GetThreshold(uniform,
+                                          CalibrationPass::kKLDivergence),
+            2000.0f);
+
+  // a few far outliers are clipped rather than waste the int8 levels.
+  CalibrationPass::Statistics outliers = MakeStatistics(2048.0f, 2048);
+  for (std::size_t i = 0; i < 256; ++i)
+    outliers.histogram[i] = 10000 - 30 * i;
+  outliers.histogram[2047] = 1;
+  const float threshold =
+      CalibrationPass::GetThreshold(outliers, CalibrationPass::kKLDivergence);
+  EXPECT_GE(threshold, 128.0f);
+  EXPECT_LE(threshold, 512.0f);
+}
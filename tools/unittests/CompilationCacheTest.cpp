@@ -0,0 +1,166 @@
+//===- CompilationCacheTest.cpp -------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Core/CompilationCache.h>
+#include <onnc/Support/FileSystem.h>
+
+#include <fstream>
+#include <string>
+
+using namespace onnc;
+
+static Path GetModel()
+{
+  Path model(TOPDIR);
+  model.append("tools/unittests/data/statistics.json");
+  return model;
+}
+
+static void WriteFile(const Path& pPath, const std::string& pContent)
+{
+  std::ofstream ofs(pPath.native());
+  ofs << pContent;
+}
+
+static std::string ReadFile(const Path& pPath)
+{
+  std::ifstream ifs(pPath.native());
+  return std::string(std::istreambuf_iterator<char>(ifs),
+                     std::istreambuf_iterator<char>());
+}
+
+//===----------------------------------------------------------------------===//
+// CompilationCache Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(CompilationCacheTest, key)
+{
+  CompilationCache cache(Path("/tmp/onnc-cache-test"));
+
+  CompilationCache::Key k1, k2, k3;
+  ASSERT_TRUE(cache.makeKey(k1, GetModel(), "x86_64-unknown-linux-gnu"));
+  ASSERT_TRUE(cache.makeKey(k2, GetModel(), "x86_64-unknown-linux-gnu"));
+  ASSERT_TRUE(cache.makeKey(k3, GetModel(), "nvdla-unknown-unknown-unknown"));
+  EXPECT_TRUE(k1 == k2);
+  EXPECT_FALSE(k1 == k3);
+
+  CompilationCache::Key k4;
+  ASSERT_FALSE(cache.makeKey(k4, Path("/tmp/no-such-model.onnx"), ""));
+
+  EXPECT_TRUE(CompilationCache::ToString(0x2a) == "000000000000002a");
+}
+
+SKYPAT_F(CompilationCacheTest, cold_and_warm_start)
+{
+  Path dir("/tmp/onnc-cache-test");
+  Path output("/tmp/onnc-cache-test-output");
+  clean(dir);
+  clean(output);
+  ASSERT_TRUE(mkdir(output, 0755).isGood());
+
+  CompilationCache cache(dir);
+  CompilationCache::Key key;
+  ASSERT_TRUE(cache.makeKey(key, GetModel(), "context"));
+
+  // cold start
+  ASSERT_FALSE(cache.lookup(key, output));
+  Path staging = cache.prepare(key);
+  ASSERT_FALSE(staging.empty());
+
+  Path artifact(staging);
+  artifact.append("a.out");
+  WriteFile(artifact, "code");
+  Path weight(staging);
+  weight.append("a.weight");
+  WriteFile(weight, "weight");
+
+  ASSERT_TRUE(cache.commit(key, staging, output));
+  EXPECT_FALSE(exists(staging));
+  EXPECT_TRUE(is_directory(cache.getEntryPath(key)));
+
+  Path result(output);
+  result.append("a.out");
+  EXPECT_TRUE(ReadFile(result) == "code");
+
+  // warm start
+  clean(output);
+  ASSERT_TRUE(mkdir(output, 0755).isGood());
+  ASSERT_TRUE(cache.lookup(key, output));
+  EXPECT_TRUE(ReadFile(result) == "code");
+  Path resultWeight(output);
+  resultWeight.append("a.weight");
+  EXPECT_TRUE(ReadFile(resultWeight) == "weight");
+
+  cache.erase(key);
+  EXPECT_FALSE(cache.lookup(key, output));
+
+  clean(dir);
+  clean(output);
+}
+
+SKYPAT_F(CompilationCacheTest, empty_staging)
+{
+  Path dir("/tmp/onnc-cache-test");
+  Path output("/tmp/onnc-cache-test-output");
+  clean(dir);
+  clean(output);
+  ASSERT_TRUE(mkdir(output, 0755).isGood());
+
+  CompilationCache cache(dir);
+  CompilationCache::Key key;
+  ASSERT_TRUE(cache.makeKey(key, GetModel(), "context"));
+
+  // a backend which emits nothing, or writes its artifacts elsewhere,
+  // compiles successfully but leaves nothing to publish.
+  Path staging = cache.prepare(key);
+  ASSERT_FALSE(staging.empty());
+  EXPECT_TRUE(cache.commit(key, staging, output));
+  EXPECT_FALSE(exists(staging));
+  EXPECT_FALSE(exists(cache.getEntryPath(key)));
+  EXPECT_FALSE(cache.lookup(key, output));
+
+  clean(dir);
+  clean(output);
+}
+
+SKYPAT_F(CompilationCacheTest, hash_collision)
+{
+  Path dir("/tmp/onnc-cache-test");
+  Path output("/tmp/onnc-cache-test-output");
+  clean(dir);
+  clean(output);
+  ASSERT_TRUE(mkdir(output, 0755).isGood());
+
+  CompilationCache cache(dir);
+  CompilationCache::Key key;
+  ASSERT_TRUE(cache.makeKey(key, GetModel(), "context"));
+
+  Path staging = cache.prepare(key);
+  ASSERT_FALSE(staging.empty());
+  Path artifact(staging);
+  artifact.append("a.out");
+  WriteFile(artifact, "code");
+  ASSERT_TRUE(cache.commit(key, staging, output));
+
+  // the record of the key is not an artifact
+  Path result(output);
+  result.append("a.out");
+  EXPECT_TRUE(exists(result));
+  Path record(output);
+  record.append("onnc-cache-key");
+  EXPECT_FALSE(exists(record));
+
+  // another model or context whose hash collides with the entry
+  CompilationCache::Key other = key;
+  other.identity += "x";
+  EXPECT_TRUE(cache.getEntryPath(other) == cache.getEntryPath(key));
+  EXPECT_FALSE(cache.lookup(other, output));
+  EXPECT_TRUE(cache.lookup(key, output));
+
+  clean(dir);
+  clean(output);
+}
@@ -0,0 +1,69 @@
+//===- Float16Test.cpp ------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Support/Float16.h>
+
+#include <limits>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+SKYPAT_F(Float16Test, storage_size)
+{
+  ASSERT_EQ(sizeof(Float16), 2);
+  ASSERT_EQ(sizeof(BFloat16), 2);
+}
+
+SKYPAT_F(Float16Test, float16_round_trip)
+{
+  // every non-NaN bit pattern survives widening and narrowing.
+  for (unsigned bits = 0; bits < 0x10000; ++bits) {
+    if (0x7C00 == (bits & 0x7C00) && 0 != (bits & 0x3FF))
+      continue;
+    float value = Float16::ToFloat(bits);
+    ASSERT_EQ(Float16::FromFloat(value), bits);
+  }
+}
+
+SKYPAT_F(Float16Test, float16_rounding)
+{
+  EXPECT_EQ(Float16(1.0f).bits(), 0x3C00);
+  EXPECT_EQ(Float16(-2.0f).bits(), 0xC000);
+  EXPECT_EQ(Float16(65504.0f).bits(), 0x7BFF);
+  EXPECT_EQ(Float16(65520.0f).bits(), 0x7C00);
+  // halfway between 1 and the next half: round to even.
+  EXPECT_EQ(Float16(1.0f + 1.0f / 2048).bits(), 0x3C00);
+  EXPECT_EQ(Float16(1.0f + 3.0f / 2048).bits(), 0x3C02);
+  // smallest subnormal.
+  EXPECT_EQ(Float16(5.9604645e-8f).bits(), 0x0001);
+  EXPECT_TRUE(float(Float16(std::numeric_limits<float>::quiet_NaN())) !=
+              float(Float16(std::numeric_limits<float>::quiet_NaN())));
+}
+
+SKYPAT_F(Float16Test, bfloat16_rounding)
+{
+  EXPECT_EQ(BFloat16(1.0f).bits(), 0x3F80);
+  EXPECT_EQ(float(BFloat16(3.0f)), 3.0f);
+  EXPECT_EQ(BFloat16(1.0f + 1.0f / 256).bits(), 0x3F80);
+  EXPECT_EQ(BFloat16(1.0f + 3.0f / 256).bits(), 0x3F82);
+  EXPECT_TRUE(float(BFloat16(std::numeric_limits<float>::quiet_NaN())) !=
+              float(BFloat16(std::numeric_limits<float>::quiet_NaN())));
+}
+
+SKYPAT_F(Float16Test, arithmetic)
+{
+  Float16 value = 1.5f;
+  value += 1.0f;
+  EXPECT_EQ(float(value), 2.5f);
+  value *= 2;
+  EXPECT_EQ(float(value), 5.0f);
+  value = value / 4;
+  EXPECT_EQ(float(value), 1.25f);
+}
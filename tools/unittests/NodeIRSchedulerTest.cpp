@@ -0,0 +1,144 @@
+//===- NodeIRSchedulerTest.cpp --------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Analysis/NodeIRScheduler.h>
+#include <onnc/ADT/StringList.h>
+#include <onnc/IR/IRBuilder.h>
+#include <onnc/IR/Module.h>
+#include <onnc/Target/DLATargetBackend.h>
+#include <onnc/Target/TargetOptions.h>
+#include <onnc/Target/TargetTransformInfo.h>
+#include <string>
+#include <vector>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Virtual Target
+//===----------------------------------------------------------------------===//
+// One DMA engine moves the values between the global and the local memory,
+// one compute engine runs the rest.
+static const ExeResource kDMA = { 1, "DMA" };
+static const ExeResource kCompute = { 1, "Compute" };
+
+class SchedTargetTransformInfo : public TargetTransformInfo
+{
+public:
+  uint64_t getOperatorCost(const xNode *pNode, unsigned pKind) const override {
+    const std::string kind = pNode->kind().toString();
+    if (kind == "Conv")
+      return 100;
+    if (kind == "Relu")
+      return 20;
+    return 10;
+  }
+
+  const ExeResource *queryExeResType(const xNode *pNode) const override {
+    const std::string kind = pNode->kind().toString();
+    return (kind == "Load" || kind == "Store") ? &kDMA : &kCompute;
+  }
+};
+
+class SchedTargetBackend : public DLATargetBackend
+{
+public:
+  explicit SchedTargetBackend(const TargetOptions& pOptions)
+    : DLATargetBackend(pOptions) {
+  }
+
+  const TargetTransformInfo* getTTI() const override { return &m_TTI; }
+
+private:
+  SchedTargetTransformInfo m_TTI;
+};
+
+//===----------------------------------------------------------------------===//
+// Create Graph Helper
+//===----------------------------------------------------------------------===//
+static void AddNode(IRBuilder& pBuilder, const std::string& pKind,
+                    const StringList& pInputNames, const std::string& pOutput)
+{
+  pBuilder.AddNode(pKind, pInputNames);
+  pBuilder.AddOutput(pOutput, {1, 16, 8, 8});
+}
+
+/// @return every value of @ref pGraph occupies @ref pSize bytes.
+static ValMemSizeMap GetValMemSizes(xGraph& pGraph, uint64_t pSize)
+{
+  ValMemSizeMap sizes;
+  for (xNode *n : pGraph.nodes())
+    for (xValue *v : n->outputs())
+      sizes[v] = MemSize(16, pSize);
+  return sizes;
+}
+
+/// @return the output names of the nodes of @ref pGraph in order.
+static std::vector<std::string> GetOrder(xGraph& pGraph)
+{
+  std::vector<std::string> order;
+  for (xNode *n : pGraph.nodes())
+    order.push_back(n->outputs()[0]->uniqueName());
+  return order;
+}
+
+//===----------------------------------------------------------------------===//
+// NodeIRScheduler Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(NodeIRSchedulerTest, load_just_in_time)
+{
+  Module module;
+  IRBuilder builder(module);
+  xGraph& graph = *builder.CreateTensorGraph("top-level");
+
+  AddNode(builder, "Load", {}, "w");
+  AddNode(builder, "Load", {}, "a");
+  AddNode(builder, "Relu", {"a"}, "b");
+  AddNode(builder, "Relu", {"b"}, "c");
+  AddNode(builder, "Conv", {"c", "w"}, "d");
+  AddNode(builder, "Store", {"d"}, "e");
+
+  TargetOptions options;
+  SchedTargetBackend backend(options);
+  NodeIRScheduler scheduler(&backend);
+  scheduler.runOnGraph(graph, GetValMemSizes(graph, 100), 1000);
+
+  // the weights are loaded while the last ReLU runs, the longer path first
+  const std::vector<std::string> expected = { "a", "b", "c", "w", "d", "e" };
+  ASSERT_TRUE(GetOrder(graph) == expected);
+}
+
+SKYPAT_F(NodeIRSchedulerTest, wait_for_memory)
+{
+  Module module;
+  IRBuilder builder(module);
+  xGraph& graph = *builder.CreateTensorGraph("top-level");
+
+  AddNode(builder, "Load", {}, "a");
+  AddNode(builder, "Conv", {"a"}, "b");
+  AddNode(builder, "Store", {"b"}, "c");
+  AddNode(builder, "Load", {}, "d");
+  AddNode(builder, "Relu", {"d"}, "e");
+  AddNode(builder, "Store", {"e"}, "f");
+
+  TargetOptions options;
+  SchedTargetBackend backend(options);
+  NodeIRScheduler scheduler(&backend);
+
+  // the second load overlaps the convolution
+  scheduler.runOnGraph(graph, GetValMemSizes(graph, 100), 1000);
+  const std::vector<std::string> overlapped = { "a", "b", "d", "c", "e", "f" };
+  ASSERT_TRUE(GetOrder(graph) == overlapped);
+  ASSERT_EQ(scheduler.getPeakMemUsage(), 300);
+
+  // the second load waits for the store, which issues first and releases
+  // the convolution result
+  scheduler.runOnGraph(graph, GetValMemSizes(graph, 100), 200);
+  const std::vector<std::string> serialized = { "a", "b", "c", "d", "e", "f" };
+  ASSERT_TRUE(GetOrder(graph) == serialized);
+  ASSERT_EQ(scheduler.getPeakMemUsage(), 200);
+}
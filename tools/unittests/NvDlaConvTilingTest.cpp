@@ -0,0 +1,112 @@
+//===- NvDlaConvTilingTest.cpp --------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "CodeEmitVisitor.h"
+#include "NvDlaMeta.h"
+#include <vector>
+
+using namespace onnc;
+
+using ConvTile = onnc::nvdla::CodeEmitVisitor::ConvTile;
+
+// A CBUF which holds the input cubes of at most pMaxInputWidth columns
+static onnc::nvdla::CodeEmitVisitor::CbufAllocTypeGetter CreateCbufAllocTypeGetter(unsigned pMaxInputWidth)
+{
+  return [pMaxInputWidth](const NvDlaCubeInfo& pData, const NvDlaCubeInfo&, Tensor::Dimension,
+                          unsigned& pMinNumNeededDataBanks) {
+    pMinNumNeededDataBanks = 0;
+    return (pData.dim_w <= pMaxInputWidth) ? CbufAllocType::kSplitDataMinimumWeight : CbufAllocType::kUnfeasible;
+  };
+}
+
+static const NvDlaConstants& GetConstants()
+{
+  static const NvDlaConstants constants =
+    getConfig(onnc::nvdla::ConfigSet::nv_full, onnc::nvdla::ExecutionMode::direct, false);
+  return constants;
+}
+
+static std::vector<ConvTile> GetConvTiles(unsigned pMaxInputWidth, int pInputWidth, int pOutputWidth,
+                                          int pKernelWidth, int pStrideX, int pPadLeft, int pPadRight)
+{
+  NvDlaBackendMeta meta(GetConstants());
+  onnc::nvdla::CodeEmitVisitor visitor(GetConstants(), meta, CreateCbufAllocTypeGetter(pMaxInputWidth), 0);
+
+  const NvDlaCubeInfo data(GetConstants(), NVDLA_CUBE_FEATURE, 1, 64, 32, pInputWidth);
+  const NvDlaCubeInfo weight(GetConstants(), NVDLA_CUBE_WEIGHT, 64, 64, 3, pKernelWidth);
+  return visitor.getConvTiles(data, weight, pOutputWidth, pKernelWidth, pStrideX, pPadLeft, pPadRight, 1);
+}
+
+static bool IsTile(const ConvTile& pTile, const ConvTile& pExpected)
+{
+  return pTile.outputBegin == pExpected.outputBegin && pTile.outputWidth == pExpected.outputWidth &&
+         pTile.inputBegin == pExpected.inputBegin && pTile.inputWidth == pExpected.inputWidth &&
+         pTile.padLeft == pExpected.padLeft && pTile.padRight == pExpected.padRight;
+}
+
+// @return the data banks of the input rows of a tile
+static unsigned GetDataBanks(int pInputWidth)
+{
+  return NvDlaCubeInfo(GetConstants(), NVDLA_CUBE_FEATURE, 1, 64, 32, pInputWidth).banks;
+}
+
+//===----------------------------------------------------------------------===//
+// NvDla Convolution Tiling Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(NvDlaConvTilingTest, untiled)
+{
+  // the whole input fits, the tile keeps the pads of the convolution
+  std::vector<ConvTile> tiles = GetConvTiles(64, 64, 65, 3, 1, 1, 2);
+  ASSERT_EQ(tiles.size(), 1);
+  ASSERT_TRUE(IsTile(tiles[0], {0, 65, 0, 64, 1, 2}));
+
+  // not even one output column fits, the emitter reports the overflow
+  tiles = GetConvTiles(2, 64, 62, 3, 1, 0, 0);
+  ASSERT_EQ(tiles.size(), 1);
+  ASSERT_TRUE(IsTile(tiles[0], {0, 62, 0, 64, 0, 0}));
+}
+
+SKYPAT_F(NvDlaConvTilingTest, widest_tile)
+{
+  // a tile of n output columns reads 3 + (n - 1) input columns
+  ASSERT_EQ(GetConvTiles(20, 64, 62, 3, 1, 0, 0).front().outputWidth, 18);
+  ASSERT_EQ(GetConvTiles(3, 64, 62, 3, 1, 0, 0).front().outputWidth, 1);
+
+  // and 3 + 2 * (n - 1) with a stride of 2
+  ASSERT_EQ(GetConvTiles(20, 64, 31, 3, 2, 0, 0).front().outputWidth, 9);
+
+  // and 7 + 2 * (n - 1) with a 7-wide kernel
+  ASSERT_EQ(GetConvTiles(20, 224, 112, 7, 2, 0, 0).front().outputWidth, 7);
+}
+
+SKYPAT_F(NvDlaConvTilingTest, padded_tiles)
+{
+  // the pads are taken by the tiles at the edges, which read fewer columns
+  const std::vector<ConvTile> tiles = GetConvTiles(20, 64, 65, 3, 1, 1, 2);
+  ASSERT_EQ(tiles.size(), 4);
+  ASSERT_TRUE(IsTile(tiles[0], {0, 18, 0, 19, 1, 0}));
+  ASSERT_TRUE(IsTile(tiles[1], {18, 18, 17, 20, 0, 0}));
+  ASSERT_TRUE(IsTile(tiles[2], {36, 18, 35, 20, 0, 0}));
+  ASSERT_TRUE(IsTile(tiles[3], {54, 11, 53, 11, 0, 2}));
+
+  // the data banks of the widest input serve every tile
+  for (const ConvTile& tile : tiles)
+    ASSERT_TRUE(GetDataBanks(tile.inputWidth) <= GetDataBanks(20));
+}
+
+SKYPAT_F(NvDlaConvTilingTest, strided_tiles)
+{
+  const std::vector<ConvTile> tiles = GetConvTiles(20, 64, 32, 3, 2, 1, 1);
+  ASSERT_EQ(tiles.size(), 4);
+  ASSERT_TRUE(IsTile(tiles[0], {0, 9, 0, 18, 1, 0}));
+  ASSERT_TRUE(IsTile(tiles[1], {9, 9, 17, 19, 0, 0}));
+  ASSERT_TRUE(IsTile(tiles[2], {18, 9, 35, 19, 0, 0}));
+
+  // the right pad is not read, the last window ends at the last column
+  ASSERT_TRUE(IsTile(tiles[3], {27, 5, 53, 11, 0, 0}));
+}
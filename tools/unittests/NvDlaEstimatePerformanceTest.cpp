@@ -0,0 +1,119 @@
+//===- NvDlaEstimatePerformanceTest.cpp -----------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "NvDlaEstimatePerformancePass.h"
+#include "NvDlaUtil.h"
+#include <onnc/Config/ONNX.h>
+#include <onnc/IR/Compute/Conv.h>
+#include <onnc/IR/Compute/Relu.h>
+#include <onnc/IR/IRBuilder.h>
+#include <onnc/IR/Module.h>
+#include <onnc/Support/OStrStream.h>
+#include <algorithm>
+#include <string>
+
+using namespace onnc;
+
+static NvDlaDlaOperation* CreateOperation(std::uint8_t pType, int pFusedParent)
+{
+  NvDlaDlaOperation* operation = new NvDlaDlaOperation();
+  operation->op_dep.op_type = pType;
+  operation->op_dep.fused_parent.index = pFusedParent;
+  return operation;
+}
+
+static void SetCube(dla_data_cube& pCube, std::uint16_t pSize)
+{
+  pCube.type = DLA_MEM_MC;
+  pCube.width = pSize;
+  pCube.height = pSize;
+  pCube.channel = 64;
+  pCube.size = 2u * pSize * pSize * 64;
+}
+
+//===----------------------------------------------------------------------===//
+// NvDlaEstimatePerformancePass Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(NvDlaEstimatePerformanceTest, node_name)
+{
+  onnc::Module module;
+  IRBuilder builder(module);
+  builder.CreateTensorGraph("top-level");
+  xNode* node = builder.AddNode("Conv", {});
+  node->setName("conv1");
+
+  builder.CreateComputeGraph("top-level");
+  ComputeGraph& graph = *builder.getComputeGraph();
+
+  // an operator lowered from an ONNX node is named after the node
+  Conv* conv = builder.AddComputeOp<Conv>(*node);
+  conv->addOutput(*graph.addValue<FloatTensor>("conv1_Y"));
+  ASSERT_TRUE(getNodeName(*conv) == "conv1");
+
+  // an operator added by the backend is named after its output
+  Relu* relu = builder.AddComputeOp<Relu>();
+  relu->addOutput(*graph.addValue<FloatTensor>("relu1_Y"));
+  ASSERT_TRUE(getNodeName(*relu) == "relu1_Y");
+}
+
+SKYPAT_F(NvDlaEstimatePerformanceTest, report_by_node)
+{
+  using OperationCategory = NvDlaBackendMeta::OperationMeta::Category;
+
+  const NvDlaConstants constants =
+    getConfig(onnc::nvdla::ConfigSet::nv_full, onnc::nvdla::ExecutionMode::direct, false);
+  NvDlaBackendMeta meta(constants);
+
+  // a convolution with a fused ReLU, then a pooling
+  NvDlaDlaOperation* conv = CreateOperation(DLA_OP_CONV, -1);
+  conv->op_desc.conv_op.input_width_cmac = 16;
+  conv->op_desc.conv_op.input_height_cmac = 16;
+  conv->op_desc.conv_op.kernel_width_csc = 3;
+  conv->op_desc.conv_op.kernel_height_csc = 3;
+  conv->op_desc.conv_op.kernel_channel_csc = 64;
+  SetCube(conv->op_surf.conv_surface.src_data, 16);
+  SetCube(conv->op_surf.conv_surface.dst_data, 16);
+  conv->op_surf.conv_surface.dst_data.type = DLA_MEM_HW;
+
+  NvDlaDlaOperation* sdp = CreateOperation(DLA_OP_SDP, 0);
+  SetCube(sdp->op_surf.sdp_surface.src_data, 16);
+  sdp->op_surf.sdp_surface.src_data.type = DLA_MEM_HW;
+  SetCube(sdp->op_surf.sdp_surface.dst_data, 16);
+
+  NvDlaDlaOperation* pdp = CreateOperation(DLA_OP_PDP, -1);
+  SetCube(pdp->op_surf.pdp_surface.src_data, 16);
+  SetCube(pdp->op_surf.pdp_surface.dst_data, 8);
+
+  const char* nodes[] = { "conv1", "conv1+relu1", "pool1" };
+  NvDlaDlaOperation* operations[] = { conv, sdp, pdp };
+  for (unsigned i = 0; i < 3; ++i) {
+    meta.m_DLAOperationList.push_back(operations[i]);
+    meta.m_DLAOperationNodes.push_back(nodes[i]);
+    meta.appendOperationMeta(i, OperationCategory::dla);
+  }
+
+  NvDlaEstimatePerformancePass pass(constants, &meta);
+  onnc::Module module;
+  pass.runOnModule(module);
+
+  const NvDlaEstimatePerformancePass::EstimateList& estimates = pass.getEstimates();
+  ASSERT_EQ(estimates.size(), 3);
+  for (unsigned i = 0; i < 3; ++i)
+    ASSERT_TRUE(estimates[i].node == nodes[i]);
+
+  // the fused chain costs as much as its slowest member
+  ASSERT_EQ(pass.getTotalCycles(),
+            std::max(estimates[0].cycles, estimates[1].cycles) + estimates[2].cycles);
+
+  std::string report;
+  OStrStream os(report);
+  pass.print(os);
+  os.flush();
+  ASSERT_TRUE(report.find("conv1+relu1\n") != std::string::npos);
+  ASSERT_TRUE(report.find("pool1\n") != std::string::npos);
+}
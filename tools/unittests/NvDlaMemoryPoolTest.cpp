@@ -0,0 +1,125 @@
+//===- NvDlaMemoryPoolTest.cpp --------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "NvDlaFilterLiveIntervalsPass.h"
+#include "NvDlaMeta.h"
+#include "Optimizations/GraphUtils.h"
+#include <onnc/IR/Compute/Concat.h>
+#include <onnc/IR/Compute/Conv.h>
+#include <onnc/IR/Compute/Relu.h>
+#include <onnc/IR/Module.h>
+
+using namespace onnc;
+
+static bool IsPoolable(ComputeGraph& pCG, const StringRef& pName)
+{
+  return NvDlaFilterLiveIntervalsPass::isPoolable(*pCG.getValue<Tensor>(pName));
+}
+
+//===----------------------------------------------------------------------===//
+// NvDla Memory Pool Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(NvDlaMemoryPoolTest, poolable_tensors)
+{
+  onnc::Module module;
+  ComputeGraph& cg = BuildGraph(module, "top-level");
+
+  AddInput(cg, "x", {1, 16, 8, 8});
+  CreateFloatWeightOperator(cg, "w", {16, 16, 3, 3});
+  AddOperator<Conv>(cg, {"x", "w"}, "a", {1, 16, 8, 8});
+  AddOperator<Relu>(cg, {"a"}, "b", {1, 16, 8, 8});
+  AddOperator<Relu>(cg, {"b"}, "c", {1, 16, 8, 8});
+  AddOperator<Concat>(cg, {"b", "c"}, "d", {1, 32, 8, 8}, IntAttr(1));
+  AddOutput(cg, {"d"});
+
+  // produced and consumed by operators which honour the pool offset
+  ASSERT_TRUE(IsPoolable(cg, "a"));
+
+  // network inputs and weights
+  ASSERT_FALSE(IsPoolable(cg, "x"));
+  ASSERT_FALSE(IsPoolable(cg, "w"));
+
+  // Concat addresses whole memory entries, both as a user and as a producer
+  ASSERT_FALSE(IsPoolable(cg, "b"));
+  ASSERT_FALSE(IsPoolable(cg, "c"));
+  ASSERT_FALSE(IsPoolable(cg, "d"));
+
+  // the cube layout has no fifth dimension
+  AddInput(cg, "y", {1, 2, 16, 8, 8});
+  AddOperator<Relu>(cg, {"y"}, "e", {1, 2, 16, 8, 8});
+  AddOperator<Relu>(cg, {"e"}, "f", {1, 2, 16, 8, 8});
+  AddOperator<Relu>(cg, {"f"}, "g", {1, 2, 16, 8, 8});
+  ASSERT_FALSE(IsPoolable(cg, "f"));
+}
+
+SKYPAT_F(NvDlaMemoryPoolTest, bind_into_pool)
+{
+  onnc::Module module;
+  ComputeGraph& cg = BuildGraph(module, "top-level");
+
+  Tensor* a = CreateFloatComputeTensor(cg, "a", {1, 16, 8, 8});
+  Tensor* b = CreateFloatComputeTensor(cg, "b", {1, 16, 8, 8});
+  Tensor* c = CreateFloatComputeTensor(cg, "c", {1, 1024});
+  Tensor* d = CreateFloatComputeTensor(cg, "d", {1, 16, 8, 8});
+
+  NvDlaBackendMeta meta(getConfig(onnc::nvdla::ConfigSet::nv_full, onnc::nvdla::ExecutionMode::direct, false));
+  const MemoryListEntryId pool =
+    meta.allocateMemory(ILoadable::MemoryDomain_SYSMEM, ILoadable::MemoryFlags_ALLOC, 8192);
+  ASSERT_EQ(meta.bindMemoryFor(*a, pool, 0, 2048), pool);
+  ASSERT_EQ(meta.bindMemoryFor(*b, pool, 4096, 2048), pool);
+
+  // a Reshape output aliases the region of its input
+  meta.markAsReshaped(*b, *c);
+
+  // a tensor outside the pool owns a whole entry
+  const MemoryListEntryId own =
+    meta.allocateMemoryFor(*d, ILoadable::MemoryDomain_SYSMEM, ILoadable::MemoryFlags_ALLOC, 2048);
+  ASSERT_NE(own, pool);
+
+  ASSERT_EQ(meta.getMemoryListEntryId(*a), pool);
+  ASSERT_EQ(meta.getMemoryListEntryId(*b), pool);
+  ASSERT_EQ(meta.getMemoryOffset(*a), 0);
+  ASSERT_EQ(meta.getMemoryOffset(*b), 4096);
+  ASSERT_EQ(meta.getMemoryOffset(*c), 4096);
+  ASSERT_EQ(meta.getMemoryOffset(*d), 0);
+
+  // a pooled tensor only owns its own region
+  ASSERT_EQ(meta.getMemoryListEntrySize(*a), 2048);
+  ASSERT_EQ(meta.getMemoryListEntrySize(*c), 2048);
+  ASSERT_EQ(meta.getMemoryListEntrySize(pool), 8192);
+}
+
+SKYPAT_F(NvDlaMemoryPoolTest, shared_offset_keeps_own_size)
+{
+  onnc::Module module;
+  ComputeGraph& cg = BuildGraph(module, "top-level");
+
+  Tensor* a = CreateFloatComputeTensor(cg, "a", {1, 16, 8, 8});
+  Tensor* b = CreateFloatComputeTensor(cg, "b", {1, 16, 4, 4});
+
+  NvDlaBackendMeta meta(getConfig(onnc::nvdla::ConfigSet::nv_full, onnc::nvdla::ExecutionMode::direct, false));
+  const MemoryListEntryId pool =
+    meta.allocateMemory(ILoadable::MemoryDomain_SYSMEM, ILoadable::MemoryFlags_ALLOC, 8192);
+
+  // disjoint lifetimes, so the planner placed both at the same offset
+  ASSERT_EQ(meta.bindMemoryFor(*a, pool, 1024, 2048), pool);
+  ASSERT_EQ(meta.bindMemoryFor(*b, pool, 1024, 512), pool);
+
+  const AddressListEntryId aId =
+    meta.acquireMemory(pool, meta.getMemoryOffset(*a), meta.getMemoryListEntrySize(*a));
+  const AddressListEntryId bId =
+    meta.acquireMemory(pool, meta.getMemoryOffset(*b), meta.getMemoryListEntrySize(*b));
+  ASSERT_NE(aId, bId);
+  ASSERT_EQ(meta.m_AddressListEntries[aId].size, 2048);
+  ASSERT_EQ(meta.m_AddressListEntries[bId].size, 512);
+  ASSERT_EQ(meta.m_AddressListEntries[aId].offset, 1024);
+  ASSERT_EQ(meta.m_AddressListEntries[bId].offset, 1024);
+
+  // the same region still resolves to its existing entry
+  ASSERT_EQ(meta.acquireMemory(pool, 1024, 2048), aId);
+}
@@ -0,0 +1,121 @@
+//===- NvDlaPlanFusionTest.cpp --------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "NvDlaMeta.h"
+#include "NvDlaPlanFusionPass.h"
+#include "Optimizations/GraphUtils.h"
+#include <onnc/IR/Compute/Add.h>
+#include <onnc/IR/Compute/Conv.h>
+#include <onnc/IR/Compute/Mul.h>
+#include <onnc/IR/Compute/Relu.h>
+#include <onnc/IR/Module.h>
+#include <string>
+
+using namespace onnc;
+
+static Conv* AddConv(ComputeGraph& pCG, const StringRef& pInput, const StringRef& pOutput)
+{
+  const std::string weight = pOutput.str() + "_W";
+  CreateFloatWeightOperator(pCG, weight, {16, 16, 3, 3});
+  return AddOperator<Conv>(pCG, {pInput, weight}, pOutput, {1, 16, 8, 8});
+}
+
+static bool IsFusedAs(const NvDlaBackendMeta& pMeta, const Conv& pConv,
+                      const NvDlaBackendMeta::FusedOperators& pExpected)
+{
+  const NvDlaBackendMeta::FusedOperators* fused = pMeta.getFusedOperators(pConv);
+  return (fused != nullptr) && (*fused == pExpected);
+}
+
+//===----------------------------------------------------------------------===//
+// NvDlaPlanFusionPass Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(NvDlaPlanFusionTest, fuse_into_sdp_stages)
+{
+  onnc::Module module;
+  ComputeGraph& cg = BuildGraph(module, "top-level");
+
+  AddInput(cg, "x", {1, 16, 8, 8});
+  CreateFloatWeightOperator(cg, "w", {16, 16, 3, 3});
+  CreateFloatWeightOperator(cg, "bias", {16});
+  CreateFloatWeightOperator(cg, "k", {1, 16, 1, 1});
+  CreateFloatWeightOperator(cg, "s", {1});
+
+  // the bias takes X1, the Add X2 and the Mul Y, the ReLUs ride along
+  Conv* conv = AddOperator<Conv>(cg, {"x", "w", "bias"}, "a", {1, 16, 8, 8});
+  Relu* relu1 = AddOperator<Relu>(cg, {"a"}, "b", {1, 16, 8, 8});
+  Add* add1 = AddOperator<Add>(cg, {"k", "b"}, "c", {1, 16, 8, 8});
+  Mul* mul = AddOperator<Mul>(cg, {"c", "s"}, "d", {1, 16, 8, 8});
+  Relu* relu2 = AddOperator<Relu>(cg, {"d"}, "e", {1, 16, 8, 8});
+
+  // no stage is left
+  Add* add2 = AddOperator<Add>(cg, {"e", "k"}, "f", {1, 16, 8, 8});
+
+  // feature operands computed before the convolution, or network inputs
+  Relu* early = AddOperator<Relu>(cg, {"x"}, "g", {1, 16, 8, 8});
+  Conv* conv2 = AddConv(cg, "f", "h");
+  Add* add3 = AddOperator<Add>(cg, {"h", "g"}, "i", {1, 16, 8, 8});
+  Mul* mul2 = AddOperator<Mul>(cg, {"i", "x"}, "j", {1, 16, 8, 8});
+
+  NvDlaBackendMeta meta(getConfig(onnc::nvdla::ConfigSet::nv_full, onnc::nvdla::ExecutionMode::direct, false));
+  NvDlaPlanFusionPass pass(meta);
+  pass.runOnModule(module);
+
+  ASSERT_TRUE(IsFusedAs(meta, *conv, {relu1, add1, mul, relu2}));
+  ASSERT_TRUE(meta.isFusedIntoConv(*relu1));
+  ASSERT_TRUE(meta.isFusedIntoConv(*relu2));
+  ASSERT_FALSE(meta.isFusedIntoConv(*add2));
+  ASSERT_FALSE(meta.isFusedIntoConv(*early));
+
+  ASSERT_TRUE(IsFusedAs(meta, *conv2, {add3, mul2}));
+}
+
+SKYPAT_F(NvDlaPlanFusionTest, keep_unfusible)
+{
+  onnc::Module module;
+  ComputeGraph& cg = BuildGraph(module, "top-level");
+
+  AddInput(cg, "x", {1, 16, 8, 8});
+  CreateFloatWeightOperator(cg, "full", {1, 16, 8, 8});
+  CreateFloatWeightOperator(cg, "row", {1, 1, 1, 8});
+
+  // the convolution result has two consumers
+  Conv* conv1 = AddConv(cg, "x", "a");
+  Relu* relu1 = AddOperator<Relu>(cg, {"a"}, "b", {1, 16, 8, 8});
+  AddOperator<Relu>(cg, {"a"}, "c", {1, 16, 8, 8});
+
+  // constants which vary along width
+  Conv* conv2 = AddConv(cg, "b", "d");
+  AddOperator<Add>(cg, {"d", "full"}, "e", {1, 16, 8, 8});
+  Conv* conv3 = AddConv(cg, "c", "f");
+  AddOperator<Mul>(cg, {"f", "row"}, "g", {1, 16, 8, 8});
+
+  // a feature operand computed between the convolution and its user
+  Conv* conv4 = AddConv(cg, "e", "h");
+  AddOperator<Relu>(cg, {"g"}, "i", {1, 16, 8, 8});
+  Add* add2 = AddOperator<Add>(cg, {"h", "i"}, "j", {1, 16, 8, 8});
+
+  // the result used twice by the same operator
+  Conv* conv5 = AddConv(cg, "j", "k");
+  AddOperator<Add>(cg, {"k", "k"}, "l", {1, 16, 8, 8});
+
+  // a grouped convolution
+  Conv* conv6 = AddConv(cg, "l", "m");
+  conv6->setGroup(IntAttr(2));
+  AddOperator<Relu>(cg, {"m"}, "n", {1, 16, 8, 8});
+
+  NvDlaBackendMeta meta(getConfig(onnc::nvdla::ConfigSet::nv_full, onnc::nvdla::ExecutionMode::direct, false));
+  NvDlaPlanFusionPass pass(meta);
+  pass.runOnModule(module);
+
+  const Conv* convs[] = { conv1, conv2, conv3, conv4, conv5, conv6 };
+  for (const Conv* conv : convs)
+    ASSERT_TRUE(meta.getFusedOperators(*conv) == nullptr);
+  ASSERT_FALSE(meta.isFusedIntoConv(*relu1));
+  ASSERT_FALSE(meta.isFusedIntoConv(*add2));
+}
@@ -0,0 +1,270 @@
+//===- NvDlaWeightPackingTest.cpp -----------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "CodeEmitVisitor.h"
+#include "NvDlaDefine.h"
+#include "NvDlaMeta.h"
+#include "Optimizations/GraphUtils.h"
+#include <onnc/IR/Module.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace onnc;
+
+static const NvDlaConstants& GetConstants()
+{
+  static const NvDlaConstants constants =
+    getConfig(onnc::nvdla::ConfigSet::nv_full, onnc::nvdla::ExecutionMode::direct, false);
+  return constants;
+}
+
+// Deterministic values in [-4, 4), most of which FP16 can not represent.
+static FloatTensor::ValueList GetValues(std::size_t pSize)
+{
+  FloatTensor::ValueList values(pSize);
+  std::uint32_t          seed = 2463534242u;
+  for (float& value : values) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    value = static_cast<float>(seed) / 4294967296.0f * 8.0f - 4.0f;
+  }
+  return values;
+}
+
+static std::size_t GetBlobSize(NvDlaDims pDims)
+{
+  const NvDlaConstants& constants = GetConstants();
+  return UNIT_ALIGNMENT(pDims.size() * constants.ELEMENT_SIZE, constants.WEIGHT_ATOM_CUBE_SIZE) /
+         sizeof(std::uint16_t);
+}
+
+// The scalar direct weight packing, element by element, before the weights
+// were converted in bulk and packed per kernel group.
+static std::vector<std::uint16_t> PackWeight(const FloatTensor::ValueList& pSrc, NvDlaDims pSrcDims,
+                                             NvDlaDims pDestDims, Tensor::Dimension pNumFrontPaddingChannels,
+                                             Tensor::Dimension pOutputChannelOffset)
+{
+  const NvDlaConstants& constants = GetConstants();
+  const int             K         = constants.MAC_ATOMIC_K;
+
+  const NvDlaDims dims(pDestDims.n, pNumFrontPaddingChannels + pDestDims.c, pDestDims.h, pDestDims.w);
+  const int       N = dims.n, C = dims.c, H = dims.h, W = dims.w;
+
+  const int channel_per_cube = constants.WEIGHT_ATOM_CUBE_SIZE / constants.ELEMENT_SIZE;
+  const int w_stride_kgrp    = K * C * H * W;
+
+  std::vector<std::uint16_t> blob(GetBlobSize(dims), 0);
+  for (int n = 0; n < (N / K + 1); n++) {
+    int n_size        = (N - n * K >= K) ? K : N - n * K;
+    int w_stride_surf = W * H * n_size * channel_per_cube;
+    for (int h = 0; h < H; h++) {
+      for (int w = 0; w < W; w++) {
+        for (int n_ofs = 0; n_ofs < n_size; n_ofs++) {
+          for (int c = 0; c < C; c++) {
+            int surf_ofs      = c / channel_per_cube;
+            int ch_ofs        = c % channel_per_cube;
+            int cube_size     = std::min(C - surf_ofs * channel_per_cube, channel_per_cube);
+            int w_stride_line = W * n_size * cube_size;
+
+            int dest_ofs = (n * w_stride_kgrp) + (surf_ofs * w_stride_surf) + (h * w_stride_line) +
+                           w * n_size * cube_size + (n_ofs * cube_size) + ch_ofs;
+            if (c < pNumFrontPaddingChannels) {
+              blob[dest_ofs] = 0;
+              continue;
+            }
+
+            const int srcChannel = c - pNumFrontPaddingChannels;
+            int src_ofs = ((n * K + n_ofs + pOutputChannelOffset) * pSrcDims.c * pSrcDims.h * pSrcDims.w) +
+                          (srcChannel * (pSrcDims.h * pSrcDims.w)) + (h * pSrcDims.w) + w;
+            blob[dest_ofs] = f2float16_ieee(pSrc[src_ofs]);
+          }
+        }
+      }
+    }
+  }
+  return blob;
+}
+
+// The scalar image weight packing.
+static std::vector<std::uint16_t> PackImageWeight(const FloatTensor::ValueList& pSrc, NvDlaDims pSrcDims,
+                                                  NvDlaDims pDestDims, Tensor::Dimension pOutputChannelOffset)
+{
+  NvDlaConstants constants = GetConstants();
+
+  std::vector<std::uint16_t> blob(GetBlobSize(pDestDims), 0);
+  for (int k = 0; k < pDestDims.n; k++) {
+    for (int c = 0; c < pDestDims.c; c++) {
+      for (int h = 0; h < pDestDims.h; h++) {
+        for (int w = 0; w < pDestDims.w; w++) {
+          if (c >= pSrcDims.c)
+            continue;
+
+          int src_ofs    = constants.getONNXInitializerOffset(pOutputChannelOffset + k, c, h, w, pSrcDims);
+          int blob_ofs   = constants.getBlobOffsetForImageWeight(k, c, h, w, pDestDims);
+          blob[blob_ofs] = f2float16_ieee(pSrc[src_ofs]);
+        }
+      }
+    }
+  }
+  return blob;
+}
+
+static std::vector<std::uint16_t> GetBlob(NvDlaBackendMeta& pMeta, MemoryListEntryId pMemoryId)
+{
+  const ILoadable::MemoryListEntry& memory = pMeta.getMemoryListEntry(pMemoryId);
+
+  ILoadable::Blob blob;
+  NvU8*           data = nullptr;
+  if (memory.contents.empty() || !pMeta.m_Loadable.priv()->getSymbolContent(memory.contents.front(), blob, data))
+    return {};
+
+  const auto* values = reinterpret_cast<const std::uint16_t*>(data);
+  return std::vector<std::uint16_t>(values, values + blob.size / sizeof(std::uint16_t));
+}
+
+// Pack the kernels of group pGroup of a convolution as the Conv emitter does,
+// and compare the blob with the scalar packing.
+static bool PacksLikeScalar(const Tensor::Dimensions& pWeightDims, int pNumGroups, int pGroup)
+{
+  onnc::Module  module;
+  ComputeGraph& cg = BuildGraph(module, "top-level");
+
+  const FloatTensor::ValueList values = GetValues(pWeightDims[0] * pWeightDims[1] * pWeightDims[2] * pWeightDims[3]);
+  CreateFloatWeightOperatorWithValues(cg, "w", pWeightDims, values);
+  const Tensor& weight = *cg.getValue<Tensor>("w");
+
+  const NvDlaDims         srcDims(weight);
+  const NvDlaDims         destDims(srcDims.n / pNumGroups, srcDims.c, srcDims.h, srcDims.w);
+  const Tensor::Dimension K                       = GetConstants().MAC_ATOMIC_K;
+  const Tensor::Dimension inputChannelOffset      = pGroup * srcDims.c;
+  const Tensor::Dimension numFrontPaddingChannels = inputChannelOffset - (inputChannelOffset / K) * K;
+  const Tensor::Dimension outputChannelOffset     = pGroup * destDims.n;
+
+  NvDlaBackendMeta             meta(GetConstants());
+  onnc::nvdla::CodeEmitVisitor visitor(GetConstants(), meta, nullptr, 0);
+  const MemoryListEntryId      memoryId =
+    visitor.packWeight(weight, destDims, numFrontPaddingChannels, outputChannelOffset);
+
+  return GetBlob(meta, memoryId) == PackWeight(values, srcDims, destDims, numFrontPaddingChannels, outputChannelOffset);
+}
+
+static bool PacksImageLikeScalar(const Tensor::Dimensions& pWeightDims, int pNumGroups, int pGroup)
+{
+  onnc::Module  module;
+  ComputeGraph& cg = BuildGraph(module, "top-level");
+
+  const FloatTensor::ValueList values = GetValues(pWeightDims[0] * pWeightDims[1] * pWeightDims[2] * pWeightDims[3]);
+  CreateFloatWeightOperatorWithValues(cg, "w", pWeightDims, values);
+  const Tensor& weight = *cg.getValue<Tensor>("w");
+
+  // image mode reads 4 channels
+  const NvDlaDims         srcDims(weight);
+  const NvDlaDims         destDims(srcDims.n / pNumGroups, 4, srcDims.h, srcDims.w);
+  const Tensor::Dimension outputChannelOffset = pGroup * destDims.n;
+
+  NvDlaBackendMeta             meta(GetConstants());
+  onnc::nvdla::CodeEmitVisitor visitor(GetConstants(), meta, nullptr, 0);
+  const MemoryListEntryId      memoryId = visitor.packImageWeight(weight, destDims, outputChannelOffset);
+
+  return GetBlob(meta, memoryId) == PackImageWeight(values, srcDims, destDims, outputChannelOffset);
+}
+
+static bool IsFloat16NaN(std::uint16_t pValue) { return (pValue & 0x7c00) == 0x7c00 && (pValue & 0x03ff) != 0; }
+
+//===----------------------------------------------------------------------===//
+// NvDla Weight Packing Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(NvDlaWeightPackingTest, direct_weight)
+{
+  // a partial kernel group, below the parallel threshold
+  ASSERT_TRUE(PacksLikeScalar({3, 5, 3, 3}, 1, 0));
+  ASSERT_TRUE(PacksLikeScalar({40, 70, 1, 1}, 1, 0));
+
+  // several kernel groups of more than 64K elements
+  ASSERT_TRUE(PacksLikeScalar({250, 64, 3, 3}, 1, 0));
+  ASSERT_TRUE(PacksLikeScalar({256, 96, 5, 5}, 1, 0));
+}
+
+SKYPAT_F(NvDlaWeightPackingTest, grouped_weight)
+{
+  // the groups after the first start with front padding channels
+  ASSERT_TRUE(PacksLikeScalar({8, 5, 3, 3}, 2, 0));
+  ASSERT_TRUE(PacksLikeScalar({8, 5, 3, 3}, 2, 1));
+  ASSERT_TRUE(PacksLikeScalar({12, 20, 3, 3}, 3, 2));
+
+  ASSERT_TRUE(PacksLikeScalar({512, 20, 5, 5}, 2, 0));
+  ASSERT_TRUE(PacksLikeScalar({512, 20, 5, 5}, 2, 1));
+  ASSERT_TRUE(PacksLikeScalar({768, 36, 5, 5}, 3, 2));
+}
+
+SKYPAT_F(NvDlaWeightPackingTest, image_weight)
+{
+  ASSERT_TRUE(PacksImageLikeScalar({16, 3, 7, 7}, 1, 0));
+  ASSERT_TRUE(PacksImageLikeScalar({32, 3, 3, 3}, 2, 1));
+  ASSERT_TRUE(PacksImageLikeScalar({256, 3, 11, 11}, 1, 0));
+  ASSERT_TRUE(PacksImageLikeScalar({512, 1, 11, 11}, 2, 1));
+}
+
+SKYPAT_F(NvDlaWeightPackingTest, reuse_packed_weight)
+{
+  onnc::Module  module;
+  ComputeGraph& cg = BuildGraph(module, "top-level");
+  CreateFloatWeightOperatorWithValues(cg, "w", {8, 5, 3, 3}, GetValues(8 * 5 * 3 * 3));
+  const Tensor& weight = *cg.getValue<Tensor>("w");
+
+  NvDlaBackendMeta             meta(GetConstants());
+  onnc::nvdla::CodeEmitVisitor visitor(GetConstants(), meta, nullptr, 0);
+
+  const MemoryListEntryId first = visitor.packWeight(weight, NvDlaDims(4, 5, 3, 3), 0, 0);
+  ASSERT_EQ(visitor.packWeight(weight, NvDlaDims(4, 5, 3, 3), 0, 0), first);
+  ASSERT_NE(visitor.packWeight(weight, NvDlaDims(4, 5, 3, 3), 0, 4), first);
+  ASSERT_NE(visitor.packWeight(weight, NvDlaDims(4, 5, 3, 3), 3, 0), first);
+  ASSERT_EQ(meta.m_NumBlobs, 3);
+}
+
+SKYPAT_F(NvDlaWeightPackingTest, bulk_float16_conversion)
+{
+  // every exponent and sign, with the mantissas around the truncated bits,
+  // and a size which leaves a scalar tail after the F16C blocks.
+  std::vector<float> values;
+  for (std::uint32_t sign = 0; sign < 2; ++sign) {
+    for (std::uint32_t exponent = 0; exponent < 256; ++exponent) {
+      std::vector<std::uint32_t> mantissas = {0x0, 0x1, 0xfff, 0x1000, 0x1fff, 0x2000, 0x7fe000, 0x7fffff};
+      for (std::uint32_t mantissa = 0; mantissa < (1u << 23); mantissa += 1021)
+        mantissas.push_back(mantissa);
+
+      for (std::uint32_t mantissa : mantissas) {
+        const std::uint32_t bits = (sign << 31) | (exponent << 23) | mantissa;
+        float               value;
+        std::memcpy(&value, &bits, sizeof(value));
+        values.push_back(value);
+      }
+    }
+  }
+  values.push_back(1.0f);
+  ASSERT_NE(values.size() % 8, 0);
+
+  std::vector<std::uint16_t> results(values.size());
+  f2float16_ieee(values.data(), values.size(), results.data());
+
+  std::size_t mismatches = 0;
+  for (std::size_t idx = 0; idx < values.size(); ++idx) {
+    // the scalar conversion turns a NaN whose payload is only in the
+    // truncated bits into infinity
+    if (std::isnan(values[idx])) {
+      mismatches += IsFloat16NaN(results[idx]) ? 0 : 1;
+      continue;
+    }
+    mismatches += (results[idx] == f2float16_ieee(values[idx])) ? 0 : 1;
+  }
+  ASSERT_EQ(mismatches, 0);
+}
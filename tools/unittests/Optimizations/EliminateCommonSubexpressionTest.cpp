@@ -0,0 +1,98 @@
+//===- EliminateCommonSubexpressionTest.cpp -------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/IR/Compute/Add.h>
+#include <onnc/IR/Compute/Relu.h>
+#include <onnc/IR/Compute/Transpose.h>
+#include <onnc/Transforms/Optimizations/EliminateCommonSubexpression.h>
+#include <skypat/skypat.h>
+
+#include "GraphUtils.h"
+#include "TestUtils.h"
+
+static void createTwoTranspose0(Module &pM) {
+  ComputeGraph &cg = BuildGraph(pM, "two_transpose_0");
+  AddInput(cg, "input_0", {3, 1, 2});
+  AddOperator<Transpose>(cg, {"input_0"}, "transpose_0", {1, 2, 3}, IntsAttr::VectorType{1, 2, 0});
+  AddOperator<Transpose>(cg, {"input_0"}, "transpose_1", {1, 2, 3}, IntsAttr::VectorType{1, 2, 0});
+  AddOperator<Add>(cg, {"transpose_0", "transpose_1"}, "output_0", {1, 2, 3});
+  AddOutput(cg, {"output_0"});
+}
+
+static void createOneTranspose0(Module &pM) {
+  ComputeGraph &cg = BuildGraph(pM, "one_transpose_0");
+  AddInput(cg, "input_0", {3, 1, 2});
+  AddOperator<Transpose>(cg, {"input_0"}, "transpose_0", {1, 2, 3}, IntsAttr::VectorType{1, 2, 0});
+  AddOperator<Add>(cg, {"transpose_0", "transpose_0"}, "output_0", {1, 2, 3});
+  AddOutput(cg, {"output_0"});
+}
+
+static void createDiffTranspose0(Module &pM) {
+  ComputeGraph &cg = BuildGraph(pM, "diff_transpose_0");
+  AddInput(cg, "input_0", {2, 2, 2});
+  AddOperator<Transpose>(cg, {"input_0"}, "transpose_0", {2, 2, 2}, IntsAttr::VectorType{1, 2, 0});
+  AddOperator<Transpose>(cg, {"input_0"}, "transpose_1", {2, 2, 2}, IntsAttr::VectorType{2, 0, 1});
+  AddOperator<Add>(cg, {"transpose_0", "transpose_1"}, "output_0", {2, 2, 2});
+  AddOutput(cg, {"output_0"});
+}
+
+// the second Relu becomes a duplicate after the Transposes are merged.
+static void createTwoChains0(Module &pM) {
+  ComputeGraph &cg = BuildGraph(pM, "two_chains_0");
+  AddInput(cg, "input_0", {3, 1, 2});
+  AddOperator<Transpose>(cg, {"input_0"}, "transpose_0", {1, 2, 3}, IntsAttr::VectorType{1, 2, 0});
+  AddOperator<Relu>(cg, {"transpose_0"}, "relu_0", {1, 2, 3});
+  AddOperator<Transpose>(cg, {"input_0"}, "transpose_1", {1, 2, 3}, IntsAttr::VectorType{1, 2, 0});
+  AddOperator<Relu>(cg, {"transpose_1"}, "relu_1", {1, 2, 3});
+  AddOperator<Add>(cg, {"relu_0", "relu_1"}, "output_0", {1, 2, 3});
+  AddOutput(cg, {"output_0"});
+}
+
+static void createOneChain0(Module &pM) {
+  ComputeGraph &cg = BuildGraph(pM, "one_chain_0");
+  AddInput(cg, "input_0", {3, 1, 2});
+  AddOperator<Transpose>(cg, {"input_0"}, "transpose_0", {1, 2, 3}, IntsAttr::VectorType{1, 2, 0});
+  AddOperator<Relu>(cg, {"transpose_0"}, "relu_0", {1, 2, 3});
+  AddOperator<Add>(cg, {"relu_0", "relu_0"}, "output_0", {1, 2, 3});
+  AddOutput(cg, {"output_0"});
+}
+
+// graph outputs keep their names.
+static void createTwoOutputs0(Module &pM) {
+  ComputeGraph &cg = BuildGraph(pM, "two_outputs_0");
+  AddInput(cg, "input_0", {3, 1, 2});
+  AddOperator<Relu>(cg, {"input_0"}, "output_0", {3, 1, 2});
+  AddOperator<Relu>(cg, {"input_0"}, "output_1", {3, 1, 2});
+  AddOutput(cg, {"output_0", "output_1"});
+}
+
+//===----------------------------------------------------------------------===//
+// EliminateCommonSubexpression
+//===----------------------------------------------------------------------===//
+SKYPAT_F(EliminateCommonSubexpression, same_transpose) {
+  std::string ans = getNetworkString(createOneTranspose0);
+  testOptPassOnNetwork<EliminateCommonSubexpression>(createTwoTranspose0,
+                                                     Pass::kModuleChanged, ans);
+}
+
+SKYPAT_F(EliminateCommonSubexpression, different_attributes) {
+  std::string ans = getNetworkString(createDiffTranspose0);
+  testOptPassOnNetwork<EliminateCommonSubexpression>(createDiffTranspose0,
+                                                     Pass::kModuleNoChanged, ans);
+}
+
+SKYPAT_F(EliminateCommonSubexpression, chained) {
+  std::string ans = getNetworkString(createOneChain0);
+  testOptPassOnNetwork<EliminateCommonSubexpression>(createTwoChains0,
+                                                     Pass::kModuleChanged, ans);
+}
+
+SKYPAT_F(EliminateCommonSubexpression, graph_outputs) {
+  std::string ans = getNetworkString(createTwoOutputs0);
+  testOptPassOnNetwork<EliminateCommonSubexpression>(createTwoOutputs0,
+                                                     Pass::kModuleNoChanged, ans);
+}
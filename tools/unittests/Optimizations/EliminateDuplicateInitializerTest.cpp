@@ -0,0 +1,59 @@
+//===- EliminateDuplicateInitializerTest.cpp ------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/IR/Compute/Add.h>
+#include <onnc/Transforms/Optimizations/EliminateDuplicateInitializer.h>
+#include <skypat/skypat.h>
+
+#include "GraphUtils.h"
+#include "TestUtils.h"
+
+static void createTwoSameWeights0(Module &pM) {
+  ComputeGraph &cg = BuildGraph(pM, "two_same_weights_0");
+  AddInput(cg, "input_0", {2});
+  CreateFloatWeightOperatorWithValues(cg, "weight_0", {2}, {1.0f, 2.0f});
+  CreateFloatWeightOperatorWithValues(cg, "weight_1", {2}, {1.0f, 2.0f});
+  AddOperator<Add>(cg, {"input_0", "weight_0"}, "add_0", {2});
+  AddOperator<Add>(cg, {"add_0", "weight_1"}, "output_0", {2});
+  AddOutput(cg, {"output_0"});
+}
+
+static void createOneWeight0(Module &pM) {
+  ComputeGraph &cg = BuildGraph(pM, "one_weight_0");
+  AddInput(cg, "input_0", {2});
+  CreateFloatWeightOperatorWithValues(cg, "weight_0", {2}, {1.0f, 2.0f});
+  AddOperator<Add>(cg, {"input_0", "weight_0"}, "add_0", {2});
+  AddOperator<Add>(cg, {"add_0", "weight_0"}, "output_0", {2});
+  AddOutput(cg, {"output_0"});
+}
+
+static void createTwoDiffWeights0(Module &pM) {
+  ComputeGraph &cg = BuildGraph(pM, "two_diff_weights_0");
+  AddInput(cg, "input_0", {2});
+  CreateFloatWeightOperatorWithValues(cg, "weight_0", {2}, {1.0f, 2.0f});
+  CreateFloatWeightOperatorWithValues(cg, "weight_1", {2}, {1.0f, -2.0f});
+  CreateFloatWeightOperatorWithValues(cg, "weight_2", {1, 2}, {1.0f, 2.0f});
+  AddOperator<Add>(cg, {"input_0", "weight_0"}, "add_0", {2});
+  AddOperator<Add>(cg, {"add_0", "weight_1"}, "add_1", {2});
+  AddOperator<Add>(cg, {"add_1", "weight_2"}, "output_0", {1, 2});
+  AddOutput(cg, {"output_0"});
+}
+
+//===----------------------------------------------------------------------===//
+// EliminateDuplicateInitializer
+//===----------------------------------------------------------------------===//
+SKYPAT_F(EliminateDuplicateInitializer, same_weights) {
+  std::string ans = getNetworkString(createOneWeight0);
+  testOptPassOnNetwork<EliminateDuplicateInitializer>(createTwoSameWeights0,
+                                                      Pass::kModuleChanged, ans);
+}
+
+SKYPAT_F(EliminateDuplicateInitializer, different_weights) {
+  std::string ans = getNetworkString(createTwoDiffWeights0);
+  testOptPassOnNetwork<EliminateDuplicateInitializer>(createTwoDiffWeights0,
+                                                      Pass::kModuleNoChanged, ans);
+}
@@ -30,7 +30,7 @@ Tensor* CreateComputeTensor(ComputeGraph& pCG, const StringRef& pName,
   return t;
 }
 
-Tensor*
+inline Tensor*
 CreateFloatComputeTensor(ComputeGraph& pCG, const StringRef& pName,
                          const Tensor::Dimensions& pDims)
 {
@@ -56,7 +56,7 @@ void CreateWeightOperator(ComputeGraph &pCG, const std::string &pName,
   init->setTensor(*value);
 }
 
-void CreateFloatWeightOperator(ComputeGraph &pCG,
+inline void CreateFloatWeightOperator(ComputeGraph &pCG,
                                const std::string &pName,
                                const Tensor::Dimensions &pDims) {
   CreateWeightOperator<FloatTensor>(pCG, pName, pDims);
@@ -73,7 +73,7 @@ void CreateWeightOperatorWithValues(ComputeGraph &pCG, const std::string &pName,
   init->setTensor(*value);
 }
 
-void CreateFloatWeightOperatorWithValues(ComputeGraph &pCG,
+inline void CreateFloatWeightOperatorWithValues(ComputeGraph &pCG,
                                          const std::string &pName,
                                          const Tensor::Dimensions &pDims,
                                          const FloatTensor::ValueList& values) {
@@ -83,12 +83,12 @@ void CreateFloatWeightOperatorWithValues(ComputeGraph &pCG,
 //===----------------------------------------------------------------------===//
 // Second Layer Helper
 //===----------------------------------------------------------------------===//
-IntsAttr::VectorType GetInts(const IntsAttr::VectorType& pVec)
+inline IntsAttr::VectorType GetInts(const IntsAttr::VectorType& pVec)
 {
   return pVec;
 }
 
-ComputeGraph& BuildGraph(Module& pM, const StringRef& name)
+inline ComputeGraph& BuildGraph(Module& pM, const StringRef& name)
 {
   IRBuilder builder(pM);
   return *builder.CreateComputeGraph(name);
@@ -102,13 +102,14 @@ void AddInput(ComputeGraph &cg, const StringRef &name,
 }
 
 template <typename OpTy, typename TensorTy = FloatTensor, typename... NodeCtorParams>
-void AddOperator(ComputeGraph &cg,
-                 const StringList &pInputNames,
-                 const StringRef &outputName,
-                 const Tensor::Dimensions &outputDims,
-                 NodeCtorParams &&... pParams) {
-  CreateComputeOperator<OpTy>(cg, pInputNames, std::forward<NodeCtorParams>(pParams)...)
-    ->addOutput(*CreateComputeTensor<TensorTy>(cg, outputName, outputDims));
+OpTy* AddOperator(ComputeGraph &cg,
+                  const StringList &pInputNames,
+                  const StringRef &outputName,
+                  const Tensor::Dimensions &outputDims,
+                  NodeCtorParams &&... pParams) {
+  OpTy* op = CreateComputeOperator<OpTy>(cg, pInputNames, std::forward<NodeCtorParams>(pParams)...);
+  op->addOutput(*CreateComputeTensor<TensorTy>(cg, outputName, outputDims));
+  return op;
 }
 
 template <typename OpTy, typename TensorTy = FloatTensor, typename... NodeCtorParams>
@@ -124,7 +125,7 @@ void AddOperator(ComputeGraph &cg,
   }
 }
 
-void AddOutput(ComputeGraph &cg, const StringList &pOutputNames) {
+inline void AddOutput(ComputeGraph &cg, const StringList &pOutputNames) {
   CreateComputeOperator<OutputOperator>(cg, pOutputNames);
 }
 
@@ -13,6 +13,9 @@
 #include <onnc/Core/PassSupport.h>
 #include <onnc/Core/AnalysisUsage.h>
 #include <onnc/Core/PassManager.h>
+#include <onnc/Core/PassTimingInfo.h>
+#include <onnc/Analysis/GlobalStatistics.h>
+#include <onnc/Analysis/Statistics.h>
 #include <onnc/IR/Module.h>
 
 #include <memory>
@@ -476,3 +479,156 @@ SKYPAT_F(PassManagerTest, run_modifier_test)
   errs() << process << std::endl;
   ASSERT_TRUE(process == "P1 P2 M2 P3 ");
 }
+
+// Testcase:
+// Keep changes the module but preserves Ana.
+// Drop changes the module and invalidates everything.
+
+class Ana : public CustomPass<Ana>
+{
+public:
+  Ana() = default;
+  StringRef getPassName() const override { return "Ana "; }
+  ReturnType runOnModule(Module &pModule) override {
+    ++runs;
+    return kModuleNoChanged;
+  }
+  static int runs;
+};
+
+int Ana::runs = 0;
+
+INITIALIZE_PASS(Ana, "Ana")
+
+class UseAna : public CustomPass<UseAna>
+{
+public:
+  UseAna() = default;
+  StringRef getPassName() const override { return "UseAna "; }
+  ReturnType runOnModule(Module &pModule) override { return kModuleNoChanged; }
+  void getAnalysisUsage(AnalysisUsage& pUsage) const override {
+    pUsage.addRequired<Ana>();
+  }
+};
+
+INITIALIZE_PASS(UseAna, "UseAna")
+
+class Keep : public CustomPass<Keep>
+{
+public:
+  Keep() = default;
+  StringRef getPassName() const override { return "Keep "; }
+  ReturnType runOnModule(Module &pModule) override { return kModuleChanged; }
+  void getAnalysisUsage(AnalysisUsage& pUsage) const override {
+    pUsage.addPreserved<Ana>();
+  }
+};
+
+INITIALIZE_PASS(Keep, "Keep")
+
+class Drop : public CustomPass<Drop>
+{
+public:
+  Drop() = default;
+  StringRef getPassName() const override { return "Drop "; }
+  ReturnType runOnModule(Module &pModule) override { return kModuleChanged; }
+};
+
+INITIALIZE_PASS(Drop, "Drop")
+
+SKYPAT_F(PassManagerTest, preserved_analysis_test)
+{
+  PassRegistry registry;
+
+  InitializeAnaPass(registry);
+  InitializeUseAnaPass(registry);
+  InitializeKeepPass(registry);
+  InitializeDropPass(registry);
+
+  PassManager::State state;
+  PassManager pm(registry);
+
+  // exe queue = Ana UseAna Keep Ana UseAna Drop Ana UseAna
+  pm.add(new UseAna(), state);
+  pm.add(new Keep(), state);
+  pm.add(new UseAna(), state);
+  pm.add(new Drop(), state);
+  pm.add(new UseAna(), state);
+  ASSERT_EQ(state.execution.size(), 8);
+
+  Module module;
+  std::string process;
+  Ana::runs = 0;
+
+  pm.initRunState(module, state);
+  while (!state.execution.empty()) {
+    ASSERT_TRUE(pm.step(module, state));
+    if (state.executed)
+      process += state.pass->getPassName();
+  }
+
+  errs() << process << std::endl;
+  ASSERT_EQ(Ana::runs, 2);
+  ASSERT_TRUE(process == "Ana UseAna Keep UseAna Drop Ana UseAna ");
+}
+
+SKYPAT_F(PassManagerTest, time_passes_test)
+{
+  PassRegistry registry;
+
+  InitializeAnaPass(registry);
+  InitializeUseAnaPass(registry);
+  InitializeKeepPass(registry);
+  InitializeDropPass(registry);
+
+  Statistics stats;
+  PassTimingInfo timing(stats);
+
+  PassManager pm(registry);
+  pm.setTimingInfo(&timing);
+  ASSERT_TRUE(&timing == pm.getTimingInfo());
+
+  // exe queue = Ana UseAna Drop Ana UseAna
+  pm.add(new UseAna());
+  pm.add(new Drop());
+  pm.add(new UseAna());
+
+  Module module;
+  pm.run(module);
+
+  PassTimingInfo::RecordList records = timing.getRecords();
+  ASSERT_EQ(records.size(), 3);
+  for (const PassTimingInfo::Record& record : records) {
+    if ("Drop " == record.name)
+      EXPECT_EQ(record.runs, 1);
+    else
+      EXPECT_EQ(record.runs, 2);
+    EXPECT_TRUE(record.wall >= 0);
+  }
+
+  for (unsigned i = 1; i < records.size(); ++i)
+    EXPECT_TRUE(records[i - 1].wall >= records[i].wall);
+
+  timing.clear();
+  ASSERT_TRUE(timing.getRecords().empty());
+}
+
+SKYPAT_F(PassManagerTest, time_passes_private_stats_test)
+{
+  PassRegistry registry;
+
+  InitializeAnaPass(registry);
+  InitializeUseAnaPass(registry);
+
+  // the records stay out of the global statistics unless requested
+  PassTimingInfo timing;
+  PassManager pm(registry);
+  pm.setTimingInfo(&timing);
+  pm.add(new UseAna());
+
+  Module module;
+  pm.run(module);
+
+  ASSERT_EQ(timing.getRecords().size(), 2);
+  ASSERT_FALSE(global::stats().hasGroup("PassTiming"));
+}
@@ -0,0 +1,173 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/operator/and.h>
+#include <onnc/Runtime/operator/equal.h>
+#include <onnc/Runtime/operator/greater.h>
+#include <onnc/Runtime/operator/less.h>
+#include <onnc/Runtime/operator/max.h>
+#include <onnc/Runtime/operator/min.h>
+#include <onnc/Runtime/operator/or.h>
+#include <onnc/Runtime/operator/pow.h>
+#include <onnc/Runtime/operator/xor.h>
+}
+#undef restrict
+
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+typedef std::vector<std::int32_t> Shape;
+
+typedef decltype(ONNC_RUNTIME_and_float) BinaryKernel;
+typedef decltype(ONNC_RUNTIME_max_float) VariadicKernel;
+
+static std::size_t size(const Shape& shape)
+{
+    std::size_t result = 1;
+
+    for (std::int32_t dim : shape)
+        result *= dim;
+
+    return result;
+}
+
+/* The offset in a tensor of `shape` which broadcasts to element `index` of
+ * a tensor of `output`.
+ */
+static std::size_t broadcast(const Shape& shape, const Shape& output, std::size_t index)
+{
+    std::size_t offset = 0, stride = 1;
+
+    for (std::size_t i = 0; i < output.size(); ++i) {
+        std::size_t axis = output.size() - 1 - i;
+        std::size_t coordinate = index % output[axis];
+        index /= output[axis];
+
+        if (i < shape.size()) {
+            std::int32_t dim = shape[shape.size() - 1 - i];
+            offset += (dim == 1 ? 0 : coordinate) * stride;
+            stride *= dim;
+        }
+    }
+    return offset;
+}
+
+/* The values an operator is tested on */
+enum Domain {
+    kReal,     /* [-4, 4), by halves */
+    kPositive, /* [0.5, 8.5), by halves */
+    kLogical   /* { 0, 1 } */
+};
+
+static std::valarray<float> sample(const Shape& shape, unsigned seed, Domain domain)
+{
+    std::valarray<float> result(size(shape));
+
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        unsigned value = (i * 7 + seed * 5) % 16;
+        if (domain == kLogical)
+            result[i] = value % 2;
+        else
+            result[i] = value / 2.0f - (domain == kReal ? 4 : -0.5f);
+    }
+    return result;
+}
+
+static void test_binary(BinaryKernel* kernel, const std::function<float(float, float)>& op,
+                        const Shape& a_shape, const Shape& b_shape, const Shape& c_shape,
+                        Domain domain)
+{
+    const std::valarray<float> A = sample(a_shape, 1, domain);
+    const std::valarray<float> B = sample(b_shape, 2, domain == kLogical ? kLogical : kReal);
+    std::valarray<float> C(size(c_shape)), expected(size(c_shape));
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+        expected[i] = op(A[broadcast(a_shape, c_shape, i)], B[broadcast(b_shape, c_shape, i)]);
+
+    kernel(nullptr, &A[0], a_shape.size(), a_shape.data(), &B[0], b_shape.size(), b_shape.data(),
+           &C[0], c_shape.size(), c_shape.data());
+    EXPECT_TRUE(onnc::valarray::equal(C, expected));
+}
+
+/* The broadcasts of numpy: scalar, row, column, and both operands expanded */
+static void test_broadcasts(BinaryKernel* kernel, const std::function<float(float, float)>& op,
+                            Domain domain = kReal)
+{
+    test_binary(kernel, op, { 2, 3, 4 }, { 2, 3, 4 }, { 2, 3, 4 }, domain);
+    test_binary(kernel, op, { 2, 3, 4 }, { 1 }, { 2, 3, 4 }, domain);
+    test_binary(kernel, op, { 1 }, { 2, 3, 4 }, { 2, 3, 4 }, domain);
+    test_binary(kernel, op, { 2, 3, 4 }, { 4 }, { 2, 3, 4 }, domain);
+    test_binary(kernel, op, { 2, 3, 4 }, { 3, 1 }, { 2, 3, 4 }, domain);
+    test_binary(kernel, op, { 2, 1, 4 }, { 3, 1 }, { 2, 3, 4 }, domain);
+    test_binary(kernel, op, { 3, 1 }, { 2, 1, 5 }, { 2, 3, 5 }, domain);
+}
+
+SKYPAT_F(Operator_Binary, pow)
+{
+    test_broadcasts(ONNC_RUNTIME_pow_float, [](float a, float b) { return powf(a, b); }, kPositive);
+}
+
+SKYPAT_F(Operator_Binary, logical)
+{
+    test_broadcasts(ONNC_RUNTIME_and_float, [](float a, float b) -> float { return a && b; }, kLogical);
+    test_broadcasts(ONNC_RUNTIME_or_float, [](float a, float b) -> float { return a || b; }, kLogical);
+    test_broadcasts(ONNC_RUNTIME_xor_float, [](float a, float b) -> float { return !a != !b; }, kLogical);
+}
+
+SKYPAT_F(Operator_Binary, comparison)
+{
+    test_broadcasts(ONNC_RUNTIME_equal_float, [](float a, float b) -> float { return a == b; });
+    test_broadcasts(ONNC_RUNTIME_greater_float, [](float a, float b) -> float { return a > b; });
+    test_broadcasts(ONNC_RUNTIME_less_float, [](float a, float b) -> float { return a < b; });
+}
+
+/* The inputs are shifted by `shift`, so that a kernel which seeds its result
+ * with 0 rather than the first input fails.
+ */
+static void test_variadic(VariadicKernel* kernel, const std::function<float(float, float)>& op,
+                          float shift, const std::vector<Shape>& shapes, const Shape& output)
+{
+    std::vector<std::valarray<float>> inputs;
+    std::vector<const float*> data;
+    std::vector<std::int32_t> ndims;
+    std::vector<const std::int32_t*> dims;
+    for (std::size_t i = 0; i < shapes.size(); ++i) {
+        inputs.push_back(sample(shapes[i], i + 1, kReal));
+        inputs.back() += shift;
+    }
+    for (std::size_t i = 0; i < shapes.size(); ++i) {
+        data.push_back(&inputs[i][0]);
+        ndims.push_back(shapes[i].size());
+        dims.push_back(shapes[i].data());
+    }
+
+    std::valarray<float> result(size(output)), expected(size(output));
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        expected[i] = inputs[0][broadcast(shapes[0], output, i)];
+        for (std::size_t n = 1; n < shapes.size(); ++n)
+            expected[i] = op(expected[i], inputs[n][broadcast(shapes[n], output, i)]);
+    }
+
+    kernel(nullptr, data.data(), shapes.size(), ndims.data(), dims.data(),
+           &result[0], output.size(), output.data());
+    EXPECT_TRUE(onnc::valarray::equal(result, expected));
+}
+
+SKYPAT_F(Operator_Binary, max_and_min)
+{
+    auto max = [](float a, float b) { return std::fmax(a, b); };
+    auto min = [](float a, float b) { return std::fmin(a, b); };
+
+    test_variadic(ONNC_RUNTIME_max_float, max, -5, { { 2, 3 } }, { 2, 3 });
+    test_variadic(ONNC_RUNTIME_max_float, max, -5, { { 2, 3 }, { 2, 3 }, { 2, 3 } }, { 2, 3 });
+    test_variadic(ONNC_RUNTIME_max_float, max, -5, { { 3 }, { 2, 3 }, { 2, 1 } }, { 2, 3 });
+    test_variadic(ONNC_RUNTIME_max_float, max, -5, { { 1 }, { 4, 1, 5 }, { 3, 1 } }, { 4, 3, 5 });
+
+    test_variadic(ONNC_RUNTIME_min_float, min, 5, { { 2, 3 } }, { 2, 3 });
+    test_variadic(ONNC_RUNTIME_min_float, min, 5, { { 2, 3 }, { 2, 3 }, { 2, 3 } }, { 2, 3 });
+    test_variadic(ONNC_RUNTIME_min_float, min, 5, { { 3 }, { 2, 3 }, { 2, 1 } }, { 2, 3 });
+    test_variadic(ONNC_RUNTIME_min_float, min, 5, { { 1 }, { 4, 1, 5 }, { 3, 1 } }, { 4, 3, 5 });
+}
@@ -0,0 +1,33 @@
+#include <skypat/skypat.h>
+#include <vector>
+
+#define restrict __restrict__
+extern "C"{
+    #include <onnc/Runtime/onnc-runtime.h>
+}
+#undef restrict
+
+SKYPAT_F(Runtime_Constant, add_and_lookup){
+    void* runtime = ONNC_RUNTIME_init_runtime();
+    std::vector<float> buffer(1000);
+    // Register every other element, in a scrambled order.
+    for(int i = 0; i < 500; ++i){
+        int index = (i * 7) % 500 * 2;
+        ASSERT_TRUE(ONNC_RUNTIME_add_constant(runtime, &buffer[index]));
+    }
+    for(int i = 0; i < 1000; ++i){
+        EXPECT_EQ(ONNC_RUNTIME_is_constant(runtime, &buffer[i]), i % 2 == 0);
+    }
+    ONNC_RUNTIME_shutdown_runtime(runtime);
+}
+
+SKYPAT_F(Runtime_Constant, add_twice){
+    void* runtime = ONNC_RUNTIME_init_runtime();
+    float a = 0, b = 0;
+    EXPECT_FALSE(ONNC_RUNTIME_is_constant(runtime, &a));
+    ASSERT_TRUE(ONNC_RUNTIME_add_constant(runtime, &a));
+    ASSERT_TRUE(ONNC_RUNTIME_add_constant(runtime, &a));
+    EXPECT_TRUE(ONNC_RUNTIME_is_constant(runtime, &a));
+    EXPECT_FALSE(ONNC_RUNTIME_is_constant(runtime, &b));
+    ONNC_RUNTIME_shutdown_runtime(runtime);
+}
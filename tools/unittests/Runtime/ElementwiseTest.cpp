@@ -0,0 +1,73 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/operator/elu.h>
+#include <onnc/Runtime/operator/softplus.h>
+}
+#undef restrict
+
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+typedef std::vector<std::int32_t> Shape;
+
+/* Reproducible values in [-`bound`, `bound`], both ends included */
+static std::valarray<float> sample(const Shape& shape, float bound)
+{
+    std::size_t size = 1;
+    for (std::int32_t dim : shape)
+        size *= dim;
+
+    std::valarray<float> result(size);
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = bound * (2.0f * ((i * 37) % size) / (size - 1) - 1);
+
+    return result;
+}
+
+static void test_elu(const Shape& shape, float bound, float alpha)
+{
+    const std::valarray<float> x = sample(shape, bound);
+    std::valarray<float> expected(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+        expected[i] = x[i] >= 0 ? x[i] : alpha * std::expm1((double)x[i]);
+
+    std::valarray<float> y(x.size());
+    ONNC_RUNTIME_elu_float(nullptr, &x[0], shape.size(), shape.data(),
+                           &y[0], shape.size(), shape.data(), alpha);
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 1e-6f));
+}
+
+SKYPAT_F(Operator_Elu, alpha)
+{
+    test_elu({ 2, 3, 67 }, 10, 1);
+    test_elu({ 2, 3, 67 }, 10, 0.5f);
+    test_elu({ 401 }, 100, 2.5f);
+}
+
+static void test_softplus(const Shape& shape, float bound)
+{
+    const std::valarray<float> x = sample(shape, bound);
+    std::valarray<float> expected(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+        expected[i] = std::fmax((double)x[i], 0) + std::log1p(std::exp(-std::fabs((double)x[i])));
+
+    std::valarray<float> y(x.size());
+    ONNC_RUNTIME_softplus_float(nullptr, &x[0], shape.size(), shape.data(),
+                                &y[0], shape.size(), shape.data());
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 1e-6f));
+}
+
+SKYPAT_F(Operator_Softplus, values)
+{
+    test_softplus({ 2, 3, 67 }, 10);
+}
+
+SKYPAT_F(Operator_Softplus, no_overflow)
+{
+    // e^x overflows a float past 88.7
+    test_softplus({ 401 }, 1000);
+    test_softplus({ 3, 67 }, 1e30f);
+}
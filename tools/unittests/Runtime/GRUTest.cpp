@@ -0,0 +1,162 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/operator/gru.h>
+}
+#undef restrict
+
+#include "recurrent.hpp"
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+
+using namespace onnc::recurrent;
+
+/* The inputs and the attributes of a GRU */
+struct GRU
+{
+    Shape shape;
+    std::string direction;
+    std::vector<std::int32_t> lens;
+    std::vector<Activation> activations;
+    float clip;
+    bool has_initial_h;
+    bool linear_before_reset;
+
+    std::valarray<float> X, W, R, B, H0;
+
+    GRU(const Shape& s, const std::string& dir)
+        : shape(s), direction(dir), clip(0), has_initial_h(false),
+          linear_before_reset(false)
+    {
+        const std::int32_t D = shape.directions, H = shape.hidden;
+        X = sample(shape.steps * shape.batches * shape.input, 1);
+        W = sample(D * 3 * H * shape.input, 2, 0.8f);
+        R = sample(D * 3 * H * H, 3, 0.5f);
+        B = sample(D * 6 * H, 4, 0.5f);
+        H0 = sample(D * shape.batches * H, 5);
+    }
+
+    void reference(std::valarray<float>& Y, std::valarray<float>& Y_h) const
+    {
+        const std::int32_t H = shape.hidden, I = shape.input;
+        Y.resize(shape.steps * shape.directions * shape.batches * H, 0);
+        Y_h.resize(shape.directions * shape.batches * H, 0);
+        if (has_initial_h)
+            Y_h = H0;
+
+        for (std::int32_t d = 0; d < shape.directions; ++d) {
+            const Activation sigmoid = { "Sigmoid", 0, 0 }, tanh = { "Tanh", 0, 0 };
+            const Activation& f = activations.empty() ? sigmoid : activations[2 * d];
+            const Activation& g = activations.empty() ? tanh : activations[2 * d + 1];
+            const float* Wd = &W[d * 3 * H * I];
+            const float* Rd = &R[d * 3 * H * H];
+            const float* Wb = &B[d * 6 * H];
+            const float* Rb = Wb + 3 * H;
+            bool reverse = direction == "reverse" || (direction == "bidirectional" && d == 1);
+
+            run(shape, lens, reverse, d, Y, [&](std::int32_t t, std::int32_t b, float* y) {
+                const float* x = &X[(t * shape.batches + b) * I];
+                float* h = &Y_h[shape.state(d, b)];
+
+                // the update and the reset gates
+                std::vector<float> z(H), r(H), rh(H);
+                for (std::int32_t j = 0; j < H; ++j) {
+                    z[j] = f(onnc::recurrent::clip(dot(x, Wd, j, I) + dot(h, Rd, j, H) + Wb[j] + Rb[j], clip));
+                    r[j] = f(onnc::recurrent::clip(dot(x, Wd, H + j, I) + dot(h, Rd, H + j, H) + Wb[H + j] + Rb[H + j], clip));
+                    rh[j] = r[j] * h[j];
+                }
+
+                // the hidden gate
+                const float* Rh = Rd + 2 * H * H;
+                for (std::int32_t j = 0; j < H; ++j) {
+                    float xh = dot(x, Wd, 2 * H + j, I) + Wb[2 * H + j];
+                    float ht = linear_before_reset ?
+                        xh + r[j] * (dot(h, Rh, j, H) + Rb[2 * H + j]) :
+                        xh + dot(rh.data(), Rh, j, H) + Rb[2 * H + j];
+                    ht = g(onnc::recurrent::clip(ht, clip));
+                    y[j] = (1 - z[j]) * ht + z[j] * h[j];
+                }
+                std::copy(y, y + H, h);
+            });
+        }
+    }
+
+    void expect() const
+    {
+        std::valarray<float> expected_Y, expected_Y_h;
+        reference(expected_Y, expected_Y_h);
+
+        const std::int32_t D = shape.directions, H = shape.hidden;
+        const std::int32_t X_dims[] = { shape.steps, shape.batches, shape.input };
+        const std::int32_t W_dims[] = { D, 3 * H, shape.input };
+        const std::int32_t R_dims[] = { D, 3 * H, H };
+        const std::int32_t B_dims[] = { D, 6 * H };
+        const std::int32_t lens_dims[] = { shape.batches };
+        const std::int32_t H_dims[] = { D, shape.batches, H };
+        const std::int32_t Y_dims[] = { shape.steps, D, shape.batches, H };
+
+        Attributes attributes(activations);
+        std::valarray<float> Y(-1.0f, expected_Y.size()), Y_h(-1.0f, expected_Y_h.size());
+        ONNC_RUNTIME_gru_float(nullptr,
+            &X[0], 3, X_dims, &W[0], 3, W_dims, &R[0], 3, R_dims, &B[0], 2, B_dims,
+            lens_data(lens), 1, lens_dims,
+            has_initial_h ? &H0[0] : nullptr, 3, H_dims,
+            &Y[0], 4, Y_dims, &Y_h[0], 3, H_dims,
+            const_cast<float*>(attributes.alpha.data()), attributes.alpha.size(),
+            const_cast<float*>(attributes.beta.data()), attributes.beta.size(),
+            attributes.names.data(), attributes.names.size(),
+            clip, direction.c_str(), H, linear_before_reset);
+
+        EXPECT_TRUE(onnc::valarray::near(Y, expected_Y, 1e-5f));
+        EXPECT_TRUE(onnc::valarray::near(Y_h, expected_Y_h, 1e-5f));
+    }
+};
+
+SKYPAT_F(Operator_GRU, forward)
+{
+    GRU gru({ 4, 3, 3, 5, 1 }, "forward");
+    gru.expect();
+
+    gru.has_initial_h = true;
+    gru.clip = 0.75f;
+    gru.expect();
+}
+
+SKYPAT_F(Operator_GRU, linear_before_reset)
+{
+    GRU gru({ 4, 3, 3, 5, 1 }, "forward");
+    gru.has_initial_h = true;
+    gru.linear_before_reset = true;
+    gru.expect();
+
+    gru.direction = "reverse";
+    gru.expect();
+}
+
+SKYPAT_F(Operator_GRU, sequence_lens)
+{
+    GRU gru({ 4, 3, 3, 5, 1 }, "forward");
+    gru.lens = { 4, 2, 1 };
+    gru.has_initial_h = true;
+    gru.expect();
+
+    gru.direction = "reverse";
+    gru.expect();
+
+    gru.linear_before_reset = true;
+    gru.expect();
+}
+
+SKYPAT_F(Operator_GRU, bidirectional)
+{
+    GRU gru({ 3, 2, 4, 6, 2 }, "bidirectional");
+    gru.lens = { 3, 2 };
+    gru.has_initial_h = true;
+    gru.expect();
+
+    gru.linear_before_reset = true;
+    gru.activations = {
+        { "HardSigmoid", 0.3f, 0.4f }, { "Softsign", 0, 0 },
+        { "Sigmoid", 0, 0 }, { "ScaledTanh", 1.5f, 0.7f }
+    };
+    gru.expect();
+}
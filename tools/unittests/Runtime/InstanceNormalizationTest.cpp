@@ -0,0 +1,87 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/operator/instancenormalization.h>
+}
+#undef restrict
+
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+typedef std::vector<std::int32_t> Shape;
+
+/* Reproducible values in [-4, 4) plus `shift` */
+static std::valarray<float> sample(std::size_t size, std::size_t seed, float shift)
+{
+    std::valarray<float> result(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = (((i + seed) * 37) % 64) / 8.0f - 4 + shift;
+
+    return result;
+}
+
+static void test_instancenormalization(const Shape& shape, float shift, float epsilon,
+                                       float tolerance = 1e-5f)
+{
+    const std::size_t batches = shape[0], channels = shape[1];
+    std::size_t area = 1;
+    for (std::size_t i = 2; i < shape.size(); ++i)
+        area *= shape[i];
+
+    const std::valarray<float> x = sample(batches * channels * area, 0, shift);
+    const std::valarray<float> scale = sample(channels, 5, 0);
+    const std::valarray<float> bias = sample(channels, 11, 0);
+
+    std::valarray<float> expected(x.size());
+    for (std::size_t n = 0; n < batches; ++n) {
+        for (std::size_t c = 0; c < channels; ++c) {
+            const std::size_t offset = (n * channels + c) * area;
+            double mean = 0, variance = 0;
+
+            for (std::size_t i = 0; i < area; ++i)
+                mean += x[offset + i];
+            mean /= area;
+
+            for (std::size_t i = 0; i < area; ++i)
+                variance += (x[offset + i] - mean) * (x[offset + i] - mean);
+            variance /= area;
+
+            for (std::size_t i = 0; i < area; ++i)
+                expected[offset + i] = scale[c] * (x[offset + i] - mean) / std::sqrt(variance + epsilon) + bias[c];
+        }
+    }
+
+    const Shape channel = { shape[1] };
+    std::valarray<float> y(x.size());
+    ONNC_RUNTIME_instancenormalization_float(nullptr,
+        &x[0], shape.size(), shape.data(),
+        &scale[0], 1, channel.data(),
+        &bias[0], 1, channel.data(),
+        &y[0], shape.size(), shape.data(), epsilon);
+
+    EXPECT_TRUE(onnc::valarray::near(y, expected, tolerance));
+}
+
+SKYPAT_F(Operator_InstanceNormalization, values)
+{
+    // more channels than batches, and the other way around
+    test_instancenormalization({ 1, 3, 4, 5 }, 0, 1e-5f);
+    test_instancenormalization({ 2, 5, 3, 3 }, 0, 1e-5f);
+    test_instancenormalization({ 4, 2, 6, 7 }, 0, 1e-5f);
+    // 1-D and 3-D feature maps
+    test_instancenormalization({ 2, 3, 17 }, 0, 1e-5f);
+    test_instancenormalization({ 1, 2, 3, 4, 5 }, 0, 1e-5f);
+    // a large epsilon shows whether it is added to the variance
+    test_instancenormalization({ 2, 3, 4, 5 }, 0, 1.0f);
+}
+
+/* A large mean must not cancel the variance out.  The mean itself is only
+ * accurate to about 1e-7 of 1000, hence the tolerance.
+ */
+SKYPAT_F(Operator_InstanceNormalization, offset)
+{
+    test_instancenormalization({ 1, 4, 16, 16 }, 1000, 1e-5f, 1e-3f);
+}
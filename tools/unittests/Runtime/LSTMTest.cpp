@@ -0,0 +1,175 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/operator/lstm.h>
+}
+#undef restrict
+
+#include "recurrent.hpp"
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+
+using namespace onnc::recurrent;
+
+/* The inputs and the attributes of an LSTM */
+struct LSTM
+{
+    Shape shape;
+    std::string direction;
+    std::vector<std::int32_t> lens;
+    std::vector<Activation> activations;
+    float clip;
+    bool has_initial_state;
+    bool has_peepholes;
+    bool input_forget;
+
+    std::valarray<float> X, W, R, B, H0, C0, P;
+
+    LSTM(const Shape& s, const std::string& dir)
+        : shape(s), direction(dir), clip(0), has_initial_state(false),
+          has_peepholes(false), input_forget(false)
+    {
+        const std::int32_t D = shape.directions, H = shape.hidden;
+        X = sample(shape.steps * shape.batches * shape.input, 1);
+        W = sample(D * 4 * H * shape.input, 2, 0.8f);
+        R = sample(D * 4 * H * H, 3, 0.5f);
+        B = sample(D * 8 * H, 4, 0.2f);
+        H0 = sample(D * shape.batches * H, 5);
+        C0 = sample(D * shape.batches * H, 6, 2);
+        P = sample(D * 3 * H, 7, 0.5f);
+    }
+
+    void reference(std::valarray<float>& Y, std::valarray<float>& Y_h,
+                   std::valarray<float>& Y_c) const
+    {
+        const std::int32_t H = shape.hidden, I = shape.input;
+        Y.resize(shape.steps * shape.directions * shape.batches * H, 0);
+        Y_h.resize(shape.directions * shape.batches * H, 0);
+        Y_c.resize(Y_h.size(), 0);
+        if (has_initial_state) {
+            Y_h = H0;
+            Y_c = C0;
+        }
+
+        for (std::int32_t d = 0; d < shape.directions; ++d) {
+            const Activation sigmoid = { "Sigmoid", 0, 0 }, tanh = { "Tanh", 0, 0 };
+            const Activation& f = activations.empty() ? sigmoid : activations[3 * d];
+            const Activation& g = activations.empty() ? tanh : activations[3 * d + 1];
+            const Activation& h_act = activations.empty() ? tanh : activations[3 * d + 2];
+            const float* Wd = &W[d * 4 * H * I];
+            const float* Rd = &R[d * 4 * H * H];
+            const float* Bd = &B[d * 8 * H];
+            const float* Pd = &P[d * 3 * H];
+            bool reverse = direction == "reverse" || (direction == "bidirectional" && d == 1);
+
+            run(shape, lens, reverse, d, Y, [&](std::int32_t t, std::int32_t b, float* y) {
+                const float* x = &X[(t * shape.batches + b) * I];
+                float* h = &Y_h[shape.state(d, b)];
+                float* c = &Y_c[shape.state(d, b)];
+
+                // the gates i, o, f, c
+                std::vector<float> gate(4 * H);
+                for (std::int32_t j = 0; j < 4 * H; ++j)
+                    gate[j] = dot(x, Wd, j, I) + dot(h, Rd, j, H) + Bd[j] + Bd[4 * H + j];
+
+                for (std::int32_t j = 0; j < H; ++j) {
+                    float pi = has_peepholes ? Pd[j] * c[j] : 0;
+                    float pf = has_peepholes ? Pd[2 * H + j] * c[j] : 0;
+                    float it = f(onnc::recurrent::clip(gate[j] + pi, clip));
+                    float ft = input_forget ? 1 - it : f(onnc::recurrent::clip(gate[2 * H + j] + pf, clip));
+                    float ct = g(onnc::recurrent::clip(gate[3 * H + j], clip));
+                    c[j] = ft * c[j] + it * ct;
+                    float po = has_peepholes ? Pd[H + j] * c[j] : 0;
+                    float ot = f(onnc::recurrent::clip(gate[H + j] + po, clip));
+                    y[j] = ot * h_act(c[j]);
+                }
+                std::copy(y, y + H, h);
+            });
+        }
+    }
+
+    void expect() const
+    {
+        std::valarray<float> expected_Y, expected_Y_h, expected_Y_c;
+        reference(expected_Y, expected_Y_h, expected_Y_c);
+
+        const std::int32_t D = shape.directions, H = shape.hidden;
+        const std::int32_t X_dims[] = { shape.steps, shape.batches, shape.input };
+        const std::int32_t W_dims[] = { D, 4 * H, shape.input };
+        const std::int32_t R_dims[] = { D, 4 * H, H };
+        const std::int32_t B_dims[] = { D, 8 * H };
+        const std::int32_t lens_dims[] = { shape.batches };
+        const std::int32_t H_dims[] = { D, shape.batches, H };
+        const std::int32_t P_dims[] = { D, 3 * H };
+        const std::int32_t Y_dims[] = { shape.steps, D, shape.batches, H };
+
+        Attributes attributes(activations);
+        std::valarray<float> Y(-1.0f, expected_Y.size());
+        std::valarray<float> Y_h(-1.0f, expected_Y_h.size()), Y_c(-1.0f, expected_Y_c.size());
+        ONNC_RUNTIME_lstm_float(nullptr,
+            &X[0], 3, X_dims, &W[0], 3, W_dims, &R[0], 3, R_dims, &B[0], 2, B_dims,
+            lens_data(lens), 1, lens_dims,
+            has_initial_state ? &H0[0] : nullptr, 3, H_dims,
+            has_initial_state ? &C0[0] : nullptr, 3, H_dims,
+            has_peepholes ? &P[0] : nullptr, 2, P_dims,
+            &Y[0], 4, Y_dims, &Y_h[0], 3, H_dims, &Y_c[0], 3, H_dims,
+            const_cast<float*>(attributes.alpha.data()), attributes.alpha.size(),
+            const_cast<float*>(attributes.beta.data()), attributes.beta.size(),
+            attributes.names.data(), attributes.names.size(),
+            clip, direction.c_str(), H, input_forget);
+
+        EXPECT_TRUE(onnc::valarray::near(Y, expected_Y, 1e-5f));
+        EXPECT_TRUE(onnc::valarray::near(Y_h, expected_Y_h, 1e-5f));
+        EXPECT_TRUE(onnc::valarray::near(Y_c, expected_Y_c, 1e-5f));
+    }
+};
+
+SKYPAT_F(Operator_LSTM, forward)
+{
+    LSTM lstm({ 4, 3, 3, 5, 1 }, "forward");
+    lstm.expect();
+
+    lstm.has_initial_state = true;
+    lstm.clip = 0.75f;
+    lstm.expect();
+
+    lstm.input_forget = true;
+    lstm.expect();
+}
+
+SKYPAT_F(Operator_LSTM, peepholes)
+{
+    LSTM lstm({ 4, 3, 3, 5, 1 }, "forward");
+    lstm.has_initial_state = true;
+    lstm.has_peepholes = true;
+    lstm.expect();
+
+    lstm.direction = "reverse";
+    lstm.expect();
+}
+
+SKYPAT_F(Operator_LSTM, sequence_lens)
+{
+    LSTM lstm({ 4, 3, 3, 5, 1 }, "forward");
+    lstm.lens = { 4, 2, 1 };
+    lstm.has_initial_state = true;
+    lstm.has_peepholes = true;
+    lstm.expect();
+
+    lstm.direction = "reverse";
+    lstm.expect();
+}
+
+SKYPAT_F(Operator_LSTM, bidirectional)
+{
+    LSTM lstm({ 3, 2, 4, 6, 2 }, "bidirectional");
+    lstm.lens = { 3, 2 };
+    lstm.has_initial_state = true;
+    lstm.has_peepholes = true;
+    lstm.expect();
+
+    lstm.activations = {
+        { "HardSigmoid", 0.3f, 0.4f }, { "ScaledTanh", 1.5f, 0.7f }, { "Softsign", 0, 0 },
+        { "Sigmoid", 0, 0 }, { "Affine", 0.5f, 0.1f }, { "LeakyRelu", 0.2f, 0 }
+    };
+    lstm.expect();
+}
@@ -0,0 +1,169 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/onnc-runtime.h>
+#include <onnc/Runtime/operator/averagepool.h>
+#include <onnc/Runtime/operator/batchnormalization.h>
+#include <onnc/Runtime/operator/concat.h>
+#include <onnc/Runtime/operator/lrn.h>
+#include <onnc/Runtime/operator/maxpool.h>
+#include <onnc/Runtime/operator/relu.h>
+#include <onnc/Runtime/operator/sigmoid.h>
+#include <onnc/Runtime/operator/softmax.h>
+#include <onnc/Runtime/operator/sum.h>
+#include <onnc/Runtime/operator/tanh.h>
+}
+#undef restrict
+
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+#include <cstdint>
+
+/* The reference kernels which the MKL-DNN kernels fall back to.  Each test
+ * calls both, so that the runtime fails to link if either is missing.
+ */
+#define DECLARE_REFERENCE(op) \
+    extern "C" decltype(ONNC_RUNTIME_##op##_float) ONNC_RUNTIME_##op##_float_reference;
+
+DECLARE_REFERENCE(averagepool)
+DECLARE_REFERENCE(batchnormalization)
+DECLARE_REFERENCE(concat)
+DECLARE_REFERENCE(lrn)
+DECLARE_REFERENCE(maxpool)
+DECLARE_REFERENCE(relu)
+DECLARE_REFERENCE(sigmoid)
+DECLARE_REFERENCE(softmax)
+DECLARE_REFERENCE(sum)
+DECLARE_REFERENCE(tanh)
+
+static std::valarray<float> sample(std::size_t size)
+{
+    std::valarray<float> result(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = static_cast<float>((i * 37) % 101) / 25 - 2;
+
+    return result;
+}
+
+/* The runtime context, which owns the MKL-DNN engine and primitives */
+class Context
+{
+public:
+    Context() : m_Context(ONNC_RUNTIME_init_runtime()) { }
+    ~Context() { ONNC_RUNTIME_shutdown_runtime(m_Context); }
+    operator void*() const { return m_Context; }
+
+private:
+    void* m_Context;
+};
+
+template<typename Kernel>
+static void test_unary(Kernel* kernel, Kernel* reference)
+{
+    Context context;
+    const std::int32_t dims[] = { 2, 3, 5, 7 };
+    const std::valarray<float> x = sample(2 * 3 * 5 * 7);
+    std::valarray<float> y(x.size()), expected(x.size());
+
+    kernel(context, &x[0], 4, dims, &y[0], 4, dims);
+    reference(nullptr, &x[0], 4, dims, &expected[0], 4, dims);
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 1e-5f));
+}
+
+SKYPAT_F(Operator_MKLDNN, eltwise)
+{
+    test_unary(ONNC_RUNTIME_relu_float, ONNC_RUNTIME_relu_float_reference);
+    test_unary(ONNC_RUNTIME_sigmoid_float, ONNC_RUNTIME_sigmoid_float_reference);
+    test_unary(ONNC_RUNTIME_tanh_float, ONNC_RUNTIME_tanh_float_reference);
+}
+
+SKYPAT_F(Operator_MKLDNN, softmax)
+{
+    Context context;
+    const std::int32_t dims[] = { 3, 10 };
+    const std::valarray<float> x = sample(30);
+    std::valarray<float> y(x.size()), expected(x.size());
+
+    ONNC_RUNTIME_softmax_float(context, &x[0], 2, dims, &y[0], 2, dims, 1);
+    ONNC_RUNTIME_softmax_float_reference(nullptr, &x[0], 2, dims, &expected[0], 2, dims, 1);
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 1e-5f));
+}
+
+SKYPAT_F(Operator_MKLDNN, pooling)
+{
+    Context context;
+    const std::int32_t xdims[] = { 1, 3, 6, 6 };
+    const std::valarray<float> x = sample(3 * 6 * 6);
+
+    std::int32_t kernel[] = { 2, 2 };
+    std::int32_t pads[] = { 0, 0, 0, 0 };
+    std::int32_t strides[] = { 2, 2 };
+    const std::int32_t ydims[] = { 1, 3, 3, 3 };
+    std::valarray<float> y(27), expected(27);
+
+    ONNC_RUNTIME_maxpool_float(context, &x[0], 4, xdims, &y[0], 4, ydims,
+        nullptr, 0, nullptr, "NOTSET", kernel, 2, pads, 4, 0, strides, 2);
+    ONNC_RUNTIME_maxpool_float_reference(nullptr, &x[0], 4, xdims, &expected[0], 4, ydims,
+        nullptr, 0, nullptr, "NOTSET", kernel, 2, pads, 4, 0, strides, 2);
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 0));
+
+    std::int32_t window[] = { 3, 3 };
+    std::int32_t padding[] = { 1, 1, 1, 1 };
+    std::int32_t unit[] = { 1, 1 };
+    std::valarray<float> z(x.size()), expected_z(x.size());
+
+    ONNC_RUNTIME_averagepool_float(context, &x[0], 4, xdims, &z[0], 4, xdims,
+        "NOTSET", 0, window, 2, padding, 4, unit, 2);
+    ONNC_RUNTIME_averagepool_float_reference(nullptr, &x[0], 4, xdims, &expected_z[0], 4, xdims,
+        "NOTSET", 0, window, 2, padding, 4, unit, 2);
+    EXPECT_TRUE(onnc::valarray::near(z, expected_z, 1e-5f));
+}
+
+SKYPAT_F(Operator_MKLDNN, normalization)
+{
+    Context context;
+    const std::int32_t dims[] = { 2, 4, 3, 3 };
+    const std::int32_t cdims[] = { 4 };
+    const std::valarray<float> x = sample(2 * 4 * 3 * 3);
+    const std::valarray<float> scale = { 1.5f, 0.5f, 2, 1 };
+    const std::valarray<float> bias = { 0, 1, -1, 0.25f };
+    const std::valarray<float> mean = { 0.1f, -0.2f, 0.3f, 0 };
+    const std::valarray<float> var = { 1, 2, 0.5f, 4 };
+    std::valarray<float> y(x.size()), expected(x.size());
+
+    ONNC_RUNTIME_batchnormalization_float(context, &x[0], 4, dims,
+        &scale[0], 1, cdims, &bias[0], 1, cdims, &mean[0], 1, cdims, &var[0], 1, cdims,
+        &y[0], 4, dims, nullptr, 0, nullptr, nullptr, 0, nullptr,
+        nullptr, 0, nullptr, nullptr, 0, nullptr, 1e-5f, 0.9f, 1);
+    ONNC_RUNTIME_batchnormalization_float_reference(nullptr, &x[0], 4, dims,
+        &scale[0], 1, cdims, &bias[0], 1, cdims, &mean[0], 1, cdims, &var[0], 1, cdims,
+        &expected[0], 4, dims, nullptr, 0, nullptr, nullptr, 0, nullptr,
+        nullptr, 0, nullptr, nullptr, 0, nullptr, 1e-5f, 0.9f, 1);
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 1e-5f));
+
+    ONNC_RUNTIME_lrn_float(context, &x[0], 4, dims, &y[0], 4, dims, 1e-4f, 0.75f, 1, 3);
+    ONNC_RUNTIME_lrn_float_reference(nullptr, &x[0], 4, dims, &expected[0], 4, dims, 1e-4f, 0.75f, 1, 3);
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 1e-5f));
+}
+
+SKYPAT_F(Operator_MKLDNN, sum_and_concat)
+{
+    Context context;
+    const std::int32_t dims[] = { 2, 3, 4 };
+    const std::valarray<float> a = sample(24);
+    const std::valarray<float> b = a * 0.5f + 1.0f;
+    const float* inputs[] = { &a[0], &b[0] };
+    const std::int32_t ndims[] = { 3, 3 };
+    const std::int32_t* shapes[] = { dims, dims };
+
+    std::valarray<float> y(24), expected(24);
+    ONNC_RUNTIME_sum_float(context, inputs, 2, ndims, shapes, &y[0], 3, dims);
+    ONNC_RUNTIME_sum_float_reference(nullptr, inputs, 2, ndims, shapes, &expected[0], 3, dims);
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 1e-6f));
+
+    const std::int32_t joined[] = { 2, 6, 4 };
+    std::valarray<float> z(48), expected_z(48);
+    ONNC_RUNTIME_concat_float(context, inputs, 2, ndims, shapes, &z[0], 3, joined, 1);
+    ONNC_RUNTIME_concat_float_reference(nullptr, inputs, 2, ndims, shapes, &expected_z[0], 3, joined, 1);
+    EXPECT_TRUE(onnc::valarray::equal(z, expected_z));
+}
@@ -0,0 +1,119 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/operator/averagepool.h>
+#include <onnc/Runtime/operator/maxpool.h>
+}
+#undef restrict
+
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+#include <cstdint>
+#include <vector>
+
+typedef std::vector<std::int32_t> Shape;
+
+/* A pooling window: `kernel x kernel` of `stride`, and the pads in the ONNX
+ * order, i.e. `{ top, left, bottom, right }`
+ */
+struct Window
+{
+    std::int32_t kernel;
+    std::int32_t stride;
+    std::int32_t pads[4];
+};
+
+/* The windows of the specialized 2D loops, with asymmetric pads */
+static const Window windows[] = {
+    { 2, 2, { 0, 0, 0, 0 } },
+    { 2, 2, { 1, 0, 0, 1 } },
+    { 3, 1, { 1, 1, 1, 1 } },
+    { 3, 1, { 2, 0, 1, 2 } },
+    { 3, 2, { 0, 1, 2, 0 } },
+    { 3, 2, { 1, 2, 0, 1 } },
+};
+
+/* Reproducible values in [-4, 4) */
+static std::valarray<float> sample(std::size_t size)
+{
+    std::valarray<float> result(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = ((i * 37) % 64) / 8.0f - 4;
+
+    return result;
+}
+
+/* Pool `x` of NCHW `shape` once by the specialized path, and once as NCDHW
+ * with a unit depth, which takes the N-d path.  Return both results.
+ */
+template<typename Pool>
+static void pool_both_ways(const Shape& shape, const Window& window, Pool pool,
+                           std::valarray<float>& specialized, std::valarray<float>& generic)
+{
+    const std::valarray<float> x = sample(shape[0] * shape[1] * shape[2] * shape[3]);
+    const std::int32_t height = (shape[2] + window.pads[0] + window.pads[2] - window.kernel) / window.stride + 1;
+    const std::int32_t width = (shape[3] + window.pads[1] + window.pads[3] - window.kernel) / window.stride + 1;
+
+    const Shape yshape = { shape[0], shape[1], height, width };
+    std::int32_t kernel[] = { window.kernel, window.kernel };
+    std::int32_t strides[] = { window.stride, window.stride };
+    std::int32_t pads[] = { window.pads[0], window.pads[1], window.pads[2], window.pads[3] };
+    specialized.resize(shape[0] * shape[1] * height * width);
+    pool(&x[0], 4, shape.data(), &specialized[0], yshape.data(), kernel, 2, pads, 4, strides, 2);
+
+    const Shape xshape5 = { shape[0], shape[1], 1, shape[2], shape[3] };
+    const Shape yshape5 = { shape[0], shape[1], 1, height, width };
+    std::int32_t kernel5[] = { 1, window.kernel, window.kernel };
+    std::int32_t strides5[] = { 1, window.stride, window.stride };
+    std::int32_t pads5[] = { 0, window.pads[0], window.pads[1], 0, window.pads[2], window.pads[3] };
+    generic.resize(specialized.size());
+    pool(&x[0], 5, xshape5.data(), &generic[0], yshape5.data(), kernel5, 3, pads5, 6, strides5, 3);
+}
+
+static void test_maxpool(const Shape& shape, const Window& window)
+{
+    std::valarray<float> specialized, generic;
+
+    pool_both_ways(shape, window,
+        [](const float* x, std::int32_t ndim, const std::int32_t* xshape, float* y,
+           const std::int32_t* yshape, std::int32_t* kernel, std::int32_t kernels,
+           std::int32_t* pads, std::int32_t paddings, std::int32_t* strides, std::int32_t stridings) {
+            ONNC_RUNTIME_maxpool_float(nullptr, x, ndim, xshape, y, ndim, yshape,
+                nullptr, 0, nullptr, "NOTSET", kernel, kernels, pads, paddings, 0, strides, stridings);
+        }, specialized, generic);
+
+    EXPECT_TRUE(onnc::valarray::equal(specialized, generic));
+}
+
+static void test_averagepool(const Shape& shape, const Window& window, std::int32_t count_include_pad)
+{
+    std::valarray<float> specialized, generic;
+
+    pool_both_ways(shape, window,
+        [=](const float* x, std::int32_t ndim, const std::int32_t* xshape, float* y,
+            const std::int32_t* yshape, std::int32_t* kernel, std::int32_t kernels,
+            std::int32_t* pads, std::int32_t paddings, std::int32_t* strides, std::int32_t stridings) {
+            ONNC_RUNTIME_averagepool_float(nullptr, x, ndim, xshape, y, ndim, yshape,
+                "NOTSET", count_include_pad, kernel, kernels, pads, paddings, strides, stridings);
+        }, specialized, generic);
+
+    EXPECT_TRUE(onnc::valarray::near(specialized, generic, 1e-6f));
+}
+
+SKYPAT_F(Operator_MaxPool, specialized)
+{
+    for (const Window& window : windows) {
+        test_maxpool({ 2, 3, 7, 9 }, window);
+        test_maxpool({ 1, 2, 8, 8 }, window);
+    }
+}
+
+SKYPAT_F(Operator_AveragePool, specialized)
+{
+    for (const Window& window : windows) {
+        for (std::int32_t count_include_pad = 0; count_include_pad < 2; ++count_include_pad) {
+            test_averagepool({ 2, 3, 7, 9 }, window, count_include_pad);
+            test_averagepool({ 1, 2, 8, 8 }, window, count_include_pad);
+        }
+    }
+}
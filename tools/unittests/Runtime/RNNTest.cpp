@@ -0,0 +1,122 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/operator/rnn.h>
+}
+#undef restrict
+
+#include "recurrent.hpp"
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+
+using namespace onnc::recurrent;
+
+/* The inputs and the attributes of an RNN */
+struct RNN
+{
+    Shape shape;
+    std::string direction;
+    std::vector<std::int32_t> lens;
+    std::vector<Activation> activations;
+    float clip;
+    bool has_initial_h;
+
+    std::valarray<float> X, W, R, B, H0;
+
+    RNN(const Shape& s, const std::string& dir)
+        : shape(s), direction(dir), clip(0), has_initial_h(false)
+    {
+        const std::int32_t D = shape.directions, H = shape.hidden;
+        X = sample(shape.steps * shape.batches * shape.input, 1);
+        W = sample(D * H * shape.input, 2, 0.8f);
+        R = sample(D * H * H, 3, 0.5f);
+        B = sample(D * 2 * H, 4, 0.2f);
+        H0 = sample(D * shape.batches * H, 5);
+    }
+
+    void reference(std::valarray<float>& Y, std::valarray<float>& Y_h) const
+    {
+        const std::int32_t H = shape.hidden, I = shape.input;
+        Y.resize(shape.steps * shape.directions * shape.batches * H, 0);
+        Y_h.resize(shape.directions * shape.batches * H, 0);
+        if (has_initial_h)
+            Y_h = H0;
+
+        for (std::int32_t d = 0; d < shape.directions; ++d) {
+            const Activation f = activations.empty() ? Activation{"Tanh", 0, 0} : activations[d];
+            const float* Wd = &W[d * H * I];
+            const float* Rd = &R[d * H * H];
+            const float* Bd = &B[d * 2 * H];
+            bool reverse = direction == "reverse" || (direction == "bidirectional" && d == 1);
+
+            run(shape, lens, reverse, d, Y, [&](std::int32_t t, std::int32_t b, float* y) {
+                const float* x = &X[(t * shape.batches + b) * I];
+                float* h = &Y_h[shape.state(d, b)];
+                for (std::int32_t j = 0; j < H; ++j)
+                    y[j] = f(onnc::recurrent::clip(dot(x, Wd, j, I) + dot(h, Rd, j, H) + Bd[j] + Bd[H + j], clip));
+                std::copy(y, y + H, h);
+            });
+        }
+    }
+
+    void expect() const
+    {
+        std::valarray<float> expected_Y, expected_Y_h;
+        reference(expected_Y, expected_Y_h);
+
+        const std::int32_t D = shape.directions, H = shape.hidden;
+        const std::int32_t X_dims[] = { shape.steps, shape.batches, shape.input };
+        const std::int32_t W_dims[] = { D, H, shape.input };
+        const std::int32_t R_dims[] = { D, H, H };
+        const std::int32_t B_dims[] = { D, 2 * H };
+        const std::int32_t lens_dims[] = { shape.batches };
+        const std::int32_t H_dims[] = { D, shape.batches, H };
+        const std::int32_t Y_dims[] = { shape.steps, D, shape.batches, H };
+
+        Attributes attributes(activations);
+        std::valarray<float> Y(-1.0f, expected_Y.size()), Y_h(-1.0f, expected_Y_h.size());
+        ONNC_RUNTIME_rnn_float(nullptr,
+            &X[0], 3, X_dims, &W[0], 3, W_dims, &R[0], 3, R_dims, &B[0], 2, B_dims,
+            lens_data(lens), 1, lens_dims,
+            has_initial_h ? &H0[0] : nullptr, 3, H_dims,
+            &Y[0], 4, Y_dims, &Y_h[0], 3, H_dims,
+            const_cast<float*>(attributes.alpha.data()), attributes.alpha.size(),
+            const_cast<float*>(attributes.beta.data()), attributes.beta.size(),
+            attributes.names.data(), attributes.names.size(),
+            clip, direction.c_str(), H);
+
+        EXPECT_TRUE(onnc::valarray::near(Y, expected_Y, 1e-5f));
+        EXPECT_TRUE(onnc::valarray::near(Y_h, expected_Y_h, 1e-5f));
+    }
+};
+
+SKYPAT_F(Operator_RNN, forward)
+{
+    RNN rnn({ 4, 3, 3, 5, 1 }, "forward");
+    rnn.expect();
+
+    rnn.has_initial_h = true;
+    rnn.clip = 0.5f;
+    rnn.expect();
+}
+
+SKYPAT_F(Operator_RNN, sequence_lens)
+{
+    RNN rnn({ 4, 3, 3, 5, 1 }, "forward");
+    rnn.lens = { 4, 2, 1 };
+    rnn.has_initial_h = true;
+    rnn.expect();
+
+    rnn.direction = "reverse";
+    rnn.expect();
+}
+
+SKYPAT_F(Operator_RNN, bidirectional)
+{
+    RNN rnn({ 3, 2, 4, 6, 2 }, "bidirectional");
+    rnn.lens = { 3, 2 };
+    rnn.has_initial_h = true;
+    rnn.expect();
+
+    rnn.activations = { { "Relu", 0, 0 }, { "LeakyRelu", 0.1f, 0 } };
+    rnn.expect();
+}
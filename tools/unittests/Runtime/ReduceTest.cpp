@@ -0,0 +1,319 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/operator/globalaveragepool.h>
+#include <onnc/Runtime/operator/globallppool.h>
+#include <onnc/Runtime/operator/lpnormalization.h>
+#include <onnc/Runtime/operator/reducelogsum.h>
+#include <onnc/Runtime/operator/reducelogsumexp.h>
+#include <onnc/Runtime/operator/reducemax.h>
+#include <onnc/Runtime/operator/reducemean.h>
+#include <onnc/Runtime/operator/reducemin.h>
+#include <onnc/Runtime/operator/reducesum.h>
+#include <onnc/Runtime/operator/reducesumsquare.h>
+}
+#undef restrict
+
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+typedef std::vector<std::int32_t> Shape;
+
+typedef decltype(ONNC_RUNTIME_reducemax_float) ReduceKernel;
+
+static std::size_t size(const Shape& shape)
+{
+    std::size_t result = 1;
+
+    for (std::int32_t dim : shape)
+        result *= dim;
+
+    return result;
+}
+
+/* Reproducible values in [-4, 4) plus `shift` */
+static std::valarray<float> sample(const Shape& shape, float shift)
+{
+    std::valarray<float> result(size(shape));
+
+    for (std::size_t i = 0; i < result.size(); ++i)
+        result[i] = ((i * 37) % 64) / 8.0f - 4 + shift;
+
+    return result;
+}
+
+/* Reduce `x` over `axes` element by element.  No axes mean all axes. */
+static std::valarray<float> reference(const std::valarray<float>& x, const Shape& shape,
+                                      const std::vector<std::int32_t>& axes,
+                                      const std::function<float(float, float)>& op)
+{
+    const std::int32_t order = shape.size();
+    std::vector<bool> reduced(order, axes.empty());
+    for (std::int32_t axis : axes)
+        reduced[axis < 0 ? axis + order : axis] = true;
+
+    Shape output(shape);
+    for (std::int32_t i = 0; i < order; ++i)
+        if (reduced[i])
+            output[i] = 1;
+
+    std::valarray<float> result(size(output));
+    std::vector<bool> seeded(result.size(), false);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        std::size_t index = i, offset = 0, stride = 1;
+        for (std::int32_t axis = order - 1; axis >= 0; --axis) {
+            std::size_t coordinate = index % shape[axis];
+            index /= shape[axis];
+            offset += (reduced[axis] ? 0 : coordinate) * stride;
+            stride *= output[axis];
+        }
+        result[offset] = seeded[offset] ? op(result[offset], x[i]) : x[i];
+        seeded[offset] = true;
+    }
+    return result;
+}
+
+/* Run `kernel` with keepdims = 1 */
+static std::valarray<float> run(ReduceKernel* kernel, const std::valarray<float>& x,
+                                const Shape& shape, std::vector<std::int32_t> axes)
+{
+    Shape output(shape);
+    for (std::int32_t& dim : output)
+        dim = 1;
+    for (std::size_t i = 0; i < shape.size(); ++i) {
+        bool reduced = axes.empty();
+        for (std::int32_t axis : axes)
+            reduced |= (axis < 0 ? axis + (std::int32_t)shape.size() : axis) == (std::int32_t)i;
+        if (!reduced)
+            output[i] = shape[i];
+    }
+
+    std::valarray<float> y(size(output));
+    kernel(nullptr, &x[0], shape.size(), shape.data(), &y[0], output.size(), output.data(),
+           axes.data(), axes.size(), 1);
+    return y;
+}
+
+static void test_reduce(ReduceKernel* kernel, const std::function<float(float, float)>& op,
+                        float shift, const Shape& shape, std::vector<std::int32_t> axes)
+{
+    const std::valarray<float> x = sample(shape, shift);
+    const std::valarray<float> expected = reference(x, shape, axes, op);
+
+    EXPECT_TRUE(onnc::valarray::equal(run(kernel, x, shape, axes), expected));
+}
+
+SKYPAT_F(Operator_Reduce, max)
+{
+    auto max = [](float a, float b) { return std::fmax(a, b); };
+
+    // all negative, so that a seed of 0 shows
+    test_reduce(ONNC_RUNTIME_reducemax_float, max, -5, { 2, 3, 4 }, { 1 });
+    test_reduce(ONNC_RUNTIME_reducemax_float, max, -5, { 2, 3, 4 }, { -1 });
+    test_reduce(ONNC_RUNTIME_reducemax_float, max, -5, { 2, 3, 4 }, { 0, -1 });
+    test_reduce(ONNC_RUNTIME_reducemax_float, max, -5, { 2, 3, 4 }, { -3, 1 });
+    test_reduce(ONNC_RUNTIME_reducemax_float, max, -5, { 2, 3, 4 }, { });
+    test_reduce(ONNC_RUNTIME_reducemax_float, max, -5, { 2, 1, 3, 1, 4 }, { 0, -1 });
+}
+
+SKYPAT_F(Operator_Reduce, min)
+{
+    auto min = [](float a, float b) { return std::fmin(a, b); };
+
+    // all positive, so that a seed of 0 shows
+    test_reduce(ONNC_RUNTIME_reducemin_float, min, 5, { 2, 3, 4 }, { 1 });
+    test_reduce(ONNC_RUNTIME_reducemin_float, min, 5, { 2, 3, 4 }, { -2, -1 });
+    test_reduce(ONNC_RUNTIME_reducemin_float, min, 5, { 2, 3, 4 }, { 0, 2 });
+    test_reduce(ONNC_RUNTIME_reducemin_float, min, 5, { 2, 3, 4 }, { });
+}
+
+static void test_lpnormalization(const Shape& shape, std::int32_t axis, std::int32_t p)
+{
+    // some elements are negative, and none is 0
+    const std::valarray<float> x = sample(shape, 0.0625f);
+    const std::int32_t order = shape.size();
+    const std::valarray<float> terms = p == 1 ? std::valarray<float>(std::abs(x)) : x * x;
+    const std::valarray<float> norms = reference(terms, shape, { axis }, std::plus<float>());
+
+    // divide each element by the norm along `axis`
+    const std::int32_t normalized = axis < 0 ? axis + order : axis;
+    std::size_t inner = 1;
+    for (std::int32_t i = normalized + 1; i < order; ++i)
+        inner *= shape[i];
+    std::valarray<float> expected(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        std::size_t outer = i / (inner * shape[normalized]);
+        float norm = norms[outer * inner + i % inner];
+        expected[i] = x[i] / (p == 1 ? norm : std::sqrt(norm));
+    }
+
+    std::valarray<float> y(x.size());
+    ONNC_RUNTIME_lpnormalization_float(nullptr, &x[0], order, shape.data(),
+                                       &y[0], order, shape.data(), axis, p);
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 1e-6f));
+}
+
+SKYPAT_F(Operator_LpNormalization, norms)
+{
+    test_lpnormalization({ 2, 3, 4 }, -1, 2);
+    test_lpnormalization({ 2, 3, 4 }, -1, 1);
+    test_lpnormalization({ 2, 3, 4 }, 1, 2);
+    test_lpnormalization({ 2, 3, 4 }, 0, 1);
+}
+
+/* Sum `map(x)` over `axes` in double, and apply `finish(sum, count)` */
+static void test_sum(ReduceKernel* kernel, const std::function<double(double)>& map,
+                     const std::function<double(double, double)>& finish,
+                     float shift, const Shape& shape, std::vector<std::int32_t> axes)
+{
+    const std::valarray<float> x = sample(shape, shift);
+    std::valarray<float> terms(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+        terms[i] = map(x[i]);
+
+    std::valarray<float> expected = reference(terms, shape, axes, std::plus<float>());
+    const double count = (double)x.size() / expected.size();
+    for (float& value : expected)
+        value = finish(value, count);
+
+    EXPECT_TRUE(onnc::valarray::near(run(kernel, x, shape, axes), expected, 1e-5f));
+}
+
+static void test_sums(ReduceKernel* kernel, const std::function<double(double)>& map,
+                      const std::function<double(double, double)>& finish, float shift)
+{
+    test_sum(kernel, map, finish, shift, { 2, 3, 4 }, { 1 });
+    test_sum(kernel, map, finish, shift, { 2, 3, 4 }, { -1 });
+    test_sum(kernel, map, finish, shift, { 2, 3, 4 }, { });
+    // several non-adjacent axes, which are transposed innermost
+    test_sum(kernel, map, finish, shift, { 2, 3, 4, 5 }, { 0, 2 });
+    test_sum(kernel, map, finish, shift, { 2, 3, 4, 5 }, { -1, 1 });
+    test_sum(kernel, map, finish, shift, { 3, 2, 1, 4, 5 }, { 0, 3, 4 });
+    // more than one block along the reduced axis, with remainders
+    test_sum(kernel, map, finish, shift, { 3, 300 }, { 1 });
+    test_sum(kernel, map, finish, shift, { 300, 3 }, { 0 });
+}
+
+SKYPAT_F(Operator_Reduce, sum)
+{
+    auto identity = [](double x) { return x; };
+    auto sum = [](double sum, double) { return sum; };
+
+    test_sums(ONNC_RUNTIME_reducesum_float, identity, sum, 0.0625f);
+}
+
+SKYPAT_F(Operator_Reduce, mean)
+{
+    auto identity = [](double x) { return x; };
+    auto mean = [](double sum, double count) { return sum / count; };
+
+    test_sums(ONNC_RUNTIME_reducemean_float, identity, mean, 0.0625f);
+}
+
+SKYPAT_F(Operator_Reduce, sumsquare)
+{
+    auto square = [](double x) { return x * x; };
+    auto sum = [](double sum, double) { return sum; };
+
+    test_sums(ONNC_RUNTIME_reducesumsquare_float, square, sum, 0.0625f);
+}
+
+SKYPAT_F(Operator_Reduce, logsum)
+{
+    auto identity = [](double x) { return x; };
+    auto log = [](double sum, double) { return std::log(sum); };
+
+    // all positive, so that every sum has a logarithm
+    test_sums(ONNC_RUNTIME_reducelogsum_float, identity, log, 5);
+}
+
+SKYPAT_F(Operator_Reduce, logsumexp)
+{
+    auto exp = [](double x) { return std::exp(x); };
+    auto log = [](double sum, double) { return std::log(sum); };
+
+    test_sums(ONNC_RUNTIME_reducelogsumexp_float, exp, log, 0.0625f);
+
+    // large enough that exp(x) overflows without the shift by max(x)
+    const Shape shape = { 2, 5 };
+    std::valarray<float> x = sample(shape, 100);
+    std::valarray<float> expected(2);
+    for (std::size_t i = 0; i < 2; ++i) {
+        double max = -INFINITY, sum = 0;
+        for (std::size_t j = 0; j < 5; ++j)
+            max = std::fmax(max, x[i * 5 + j]);
+        for (std::size_t j = 0; j < 5; ++j)
+            sum += std::exp(x[i * 5 + j] - max);
+        expected[i] = max + std::log(sum);
+    }
+    EXPECT_TRUE(onnc::valarray::near(run(ONNC_RUNTIME_reducelogsumexp_float, x, shape, { 1 }),
+                                     expected, 1e-5f));
+}
+
+/* Summing 0.1 a million times one by one in float is off by about 4% */
+SKYPAT_F(Operator_Reduce, pairwise)
+{
+    auto check = [](const Shape& shape, std::vector<std::int32_t> axes) {
+        const std::valarray<float> x(0.1f, size(shape));
+        const std::valarray<float> y = run(ONNC_RUNTIME_reducesum_float, x, shape, axes);
+        const float expected = 0.1f * (double)x.size() / y.size();
+
+        EXPECT_TRUE(onnc::valarray::near(y, std::valarray<float>(expected, y.size()), 1e-5f));
+    };
+
+    // contiguous lanes
+    check({ 1 << 20 }, { });
+    check({ 2, 1000003 }, { 1 });
+    // strided columns
+    check({ 1 << 18, 4 }, { 0 });
+    check({ 300007, 3 }, { 0 });
+}
+
+static void test_global(const Shape& shape, std::int32_t p)
+{
+    const std::valarray<float> x = sample(shape, 0.0625f);
+    const std::size_t channels = shape[0] * shape[1];
+    const std::size_t area = x.size() / channels;
+
+    std::valarray<float> expected(channels);
+    for (std::size_t c = 0; c < channels; ++c) {
+        double sum = 0;
+        for (std::size_t i = 0; i < area; ++i)
+            sum += p ? std::pow(std::abs(x[c * area + i]), p) : x[c * area + i];
+        expected[c] = p ? std::pow(sum, 1.0 / p) : sum / area;
+    }
+
+    Shape output(shape.size(), 1);
+    output[0] = shape[0];
+    output[1] = shape[1];
+    std::valarray<float> y(channels);
+
+    if (p)
+        ONNC_RUNTIME_globallppool_float(nullptr, &x[0], shape.size(), shape.data(),
+                                        &y[0], output.size(), output.data(), p);
+    else
+        ONNC_RUNTIME_globalaveragepool_float(nullptr, &x[0], shape.size(), shape.data(),
+                                             &y[0], output.size(), output.data());
+
+    EXPECT_TRUE(onnc::valarray::near(y, expected, 1e-5f));
+}
+
+SKYPAT_F(Operator_GlobalPool, average)
+{
+    test_global({ 2, 3, 5, 7 }, 0);
+    test_global({ 1, 4, 17 }, 0);
+    test_global({ 2, 2, 3, 4, 5 }, 0);
+    test_global({ 1, 3, 32, 32 }, 0);
+}
+
+SKYPAT_F(Operator_GlobalPool, lp)
+{
+    for (std::int32_t p = 1; p <= 3; ++p) {
+        test_global({ 2, 3, 5, 7 }, p);
+        test_global({ 1, 4, 17 }, p);
+        test_global({ 1, 3, 32, 32 }, p);
+    }
+}
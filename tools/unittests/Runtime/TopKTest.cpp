@@ -0,0 +1,108 @@
+#define restrict __restrict__
+extern "C" {
+#include <onnc/Runtime/operator/topk.h>
+}
+#undef restrict
+
+#include "valarray.hpp"
+#include <skypat/skypat.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+
+typedef std::vector<std::int32_t> Shape;
+
+/* The elements past the outputs, which the kernel must not touch */
+static const std::size_t kGuard = 16;
+static const float kGuardValue = -12345.0f;
+
+/* Reproducible values with many ties, and huge ones at every 97th element */
+static std::valarray<float> sample(std::size_t size)
+{
+    std::valarray<float> result(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        result[i] = static_cast<float>((i * 7919) % 61) - 30;
+        if (i % 97 == 13)
+            result[i] = (i % 2) ? FLT_MAX : 1e30f;
+        if (i % 89 == 5)
+            result[i] = -FLT_MAX;
+    }
+    return result;
+}
+
+static void test_topk(const Shape& shape, std::int32_t axis, std::int32_t k)
+{
+    const std::int32_t order = shape.size();
+    const std::int32_t normalized = axis < 0 ? axis + order : axis;
+    std::size_t outer = 1, inner = 1;
+    for (std::int32_t i = 0; i < normalized; ++i)
+        outer *= shape[i];
+    for (std::int32_t i = normalized + 1; i < order; ++i)
+        inner *= shape[i];
+    const std::int32_t n = shape[normalized];
+    const std::int32_t kept = std::min(k, n);
+
+    const std::valarray<float> x = sample(outer * n * inner);
+    Shape output(shape);
+    output[normalized] = kept;
+
+    // larger values first, then lower indices
+    std::valarray<float> values(outer * kept * inner), indices(values.size());
+    for (std::size_t o = 0; o < outer; ++o) {
+        for (std::size_t i = 0; i < inner; ++i) {
+            std::vector<std::int32_t> line(n);
+            for (std::int32_t j = 0; j < n; ++j)
+                line[j] = j;
+            std::stable_sort(line.begin(), line.end(), [&](std::int32_t a, std::int32_t b) {
+                return x[(o * n + a) * inner + i] > x[(o * n + b) * inner + i];
+            });
+            for (std::int32_t j = 0; j < kept; ++j) {
+                values[(o * kept + j) * inner + i] = x[(o * n + line[j]) * inner + i];
+                indices[(o * kept + j) * inner + i] = line[j];
+            }
+        }
+    }
+
+    std::valarray<float> y_values(kGuardValue, values.size() + kGuard);
+    std::valarray<float> y_indices(kGuardValue, indices.size() + kGuard);
+    ONNC_RUNTIME_topk_float(nullptr, &x[0], order, shape.data(),
+                            &y_values[0], order, output.data(),
+                            &y_indices[0], order, output.data(), axis, k);
+
+    EXPECT_TRUE(onnc::valarray::equal(std::valarray<float>(y_values[std::slice(0, values.size(), 1)]), values));
+    EXPECT_TRUE(onnc::valarray::equal(std::valarray<float>(y_indices[std::slice(0, indices.size(), 1)]), indices));
+    for (std::size_t i = 0; i < kGuard; ++i) {
+        EXPECT_EQ(y_values[values.size() + i], kGuardValue);
+        EXPECT_EQ(y_indices[indices.size() + i], kGuardValue);
+    }
+}
+
+SKYPAT_F(Operator_TopK, last_axis)
+{
+    // by the heap: k is small against the line
+    test_topk({ 3, 1000 }, -1, 1);
+    test_topk({ 3, 1000 }, -1, 5);
+    test_topk({ 3, 1000 }, 1, 62);
+
+    // by partitioning
+    test_topk({ 3, 1000 }, -1, 63);
+    test_topk({ 3, 1000 }, -1, 500);
+    test_topk({ 3, 1000 }, -1, 1000);
+    test_topk({ 2, 7 }, -1, 3);
+}
+
+SKYPAT_F(Operator_TopK, inner_axis)
+{
+    test_topk({ 2, 500, 3 }, 1, 4);
+    test_topk({ 2, 500, 3 }, -2, 100);
+    test_topk({ 600, 2, 2 }, 0, 10);
+    test_topk({ 600, 2, 2 }, 0, 600);
+}
+
+SKYPAT_F(Operator_TopK, k_beyond_axis)
+{
+    test_topk({ 4, 5 }, -1, 9);
+    test_topk({ 5, 4 }, 0, 9);
+}
@@ -73,3 +73,50 @@ SKYPAT_F(Operator_Transpose, non_broadcast)
     test(2, 3, 1, 2);
     test(3, 1, 3, 3, 7);
 }
+
+template<typename... Args>
+static void test_permutation(std::valarray<std::int32_t> permutation, Args... args)
+{
+    using std::size_t;
+    using std::int32_t;
+
+    std::array<int32_t, sizeof...(Args)> shape = { static_cast<int32_t>(args)... };
+    size_t size = std::accumulate(shape.cbegin(), shape.cend(), static_cast<size_t>(1), std::multiplies<size_t>());
+
+    test_permutedims(onnc::valarray::range<float>(size), permutation,
+        onnc::valarray::make<int32_t>(shape), onnc::valarray::strides(shape));
+}
+
+SKYPAT_F(Operator_Transpose, merged_axes)
+{
+    // { 2, 3 } and { 4, 5 } stay adjacent: a 6x20 matrix transpose
+    test_permutation({ 2, 3, 0, 1 }, 2, 3, 4, 5);
+    // The inner { 4, 5 } stays innermost: rows are copied as a whole
+    test_permutation({ 1, 0, 2, 3 }, 2, 3, 4, 5);
+    // Unit axes are dropped before merging
+    test_permutation({ 3, 1, 2, 0 }, 7, 1, 1, 9);
+    test_permutation({ 0, 3, 1, 2 }, 1, 5, 6, 1);
+}
+
+SKYPAT_F(Operator_Transpose, tiled_2d)
+{
+    // Full 8x8 tiles and partial tiles at both edges
+    test_permutation({ 1, 0 }, 8, 8);
+    test_permutation({ 1, 0 }, 16, 24);
+    test_permutation({ 1, 0 }, 19, 13);
+    test_permutation({ 1, 0 }, 37, 21);
+    test_permutation({ 1, 0 }, 3, 29);
+    test_permutation({ 1, 0 }, 1000, 7);
+}
+
+SKYPAT_F(Operator_Transpose, nchw_nhwc)
+{
+    // NCHW -> NHWC
+    test_permutation({ 0, 2, 3, 1 }, 2, 3, 10, 9);
+    test_permutation({ 0, 2, 3, 1 }, 1, 16, 8, 8);
+    test_permutation({ 0, 2, 3, 1 }, 3, 21, 5, 7);
+    // NHWC -> NCHW
+    test_permutation({ 0, 3, 1, 2 }, 2, 10, 9, 3);
+    test_permutation({ 0, 3, 1, 2 }, 1, 8, 8, 16);
+    test_permutation({ 0, 3, 1, 2 }, 3, 5, 7, 21);
+}
@@ -0,0 +1,145 @@
+#ifndef ONNCRT_TEST_RECURRENT_HPP
+#define ONNCRT_TEST_RECURRENT_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <valarray>
+#include <vector>
+
+/* A plain implementation of the recurrent operators of ONNX, in the layouts
+ * of the runtime, to check the runtime kernels against.
+ */
+namespace onnc {
+namespace recurrent {
+
+/* Reproducible values in [-scale, scale) */
+static std::valarray<float> sample(std::size_t size, unsigned seed, float scale = 1)
+{
+    std::valarray<float> result(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = scale * (static_cast<float>((i * 37 + seed * 11) % 97) / 48.5f - 1);
+
+    return result;
+}
+
+/* An activation function with its alpha and beta */
+struct Activation
+{
+    std::string name;
+    float alpha;
+    float beta;
+
+    float operator()(float x) const
+    {
+        if (name == "Relu")
+            return x > 0 ? x : 0;
+        if (name == "Sigmoid")
+            return 1 / (1 + std::exp(-x));
+        if (name == "Affine")
+            return alpha * x + beta;
+        if (name == "LeakyRelu")
+            return x >= 0 ? x : alpha * x;
+        if (name == "ScaledTanh")
+            return alpha * std::tanh(beta * x);
+        if (name == "HardSigmoid")
+            return std::fmax(0, std::fmin(1, alpha * x + beta));
+        if (name == "Softsign")
+            return x / (1 + std::abs(x));
+        return std::tanh(x);
+    }
+};
+
+/* The `activations`, `activation_alpha` and `activation_beta` attributes of
+ * a list of activation functions
+ */
+struct Attributes
+{
+    std::vector<const char*> names;
+    std::vector<float> alpha;
+    std::vector<float> beta;
+
+    explicit Attributes(const std::vector<Activation>& functions)
+    {
+        for (const Activation& f : functions) {
+            names.push_back(f.name.c_str());
+            if (f.name == "Affine" || f.name == "LeakyRelu" ||
+                f.name == "ScaledTanh" || f.name == "HardSigmoid")
+                alpha.push_back(f.alpha);
+            if (f.name == "Affine" || f.name == "ScaledTanh" || f.name == "HardSigmoid")
+                beta.push_back(f.beta);
+        }
+    }
+};
+
+/* The shapes of a recurrent operator */
+struct Shape
+{
+    std::int32_t steps;
+    std::int32_t batches;
+    std::int32_t input;
+    std::int32_t hidden;
+    std::int32_t directions;
+
+    /* The length of the sequence of a batch */
+    std::int32_t length(const std::vector<std::int32_t>& lens, std::int32_t batch) const
+    {
+        return lens.empty() ? steps : lens[batch];
+    }
+
+    /* The index of the hidden state of [t][d][b] in Y */
+    std::size_t y(std::int32_t t, std::int32_t d, std::int32_t b) const
+    {
+        return ((static_cast<std::size_t>(t) * directions + d) * batches + b) * hidden;
+    }
+
+    /* The index of the hidden state of [d][b] in Y_h and Y_c */
+    std::size_t state(std::int32_t d, std::int32_t b) const
+    {
+        return (static_cast<std::size_t>(d) * batches + b) * hidden;
+    }
+};
+
+/* The sequence_lens input, which the runtime passes as float */
+static const float* lens_data(const std::vector<std::int32_t>& lens)
+{
+    return lens.empty() ? nullptr : reinterpret_cast<const float*>(lens.data());
+}
+
+/* The row `gate` of `x * transpose(w)`, where `w` is [rows][depth] */
+static float dot(const float* x, const float* w, std::int32_t row, std::int32_t depth)
+{
+    float sum = 0;
+
+    for (std::int32_t k = 0; k < depth; ++k)
+        sum += x[k] * w[static_cast<std::size_t>(row) * depth + k];
+
+    return sum;
+}
+
+static float clip(float x, float threshold)
+{
+    return threshold > 0 ? std::fmax(-threshold, std::fmin(threshold, x)) : x;
+}
+
+/* Run one direction of a cell over each sequence.  `step` updates the state
+ * of one batch from the input at one time step.
+ */
+template<typename Step>
+static void run(const Shape& shape, const std::vector<std::int32_t>& lens,
+                bool reverse, std::int32_t d, std::valarray<float>& Y, Step step)
+{
+    for (std::int32_t b = 0; b < shape.batches; ++b) {
+        std::int32_t length = shape.length(lens, b);
+
+        for (std::int32_t s = 0; s < length; ++s) {
+            std::int32_t t = reverse ? length - 1 - s : s;
+            step(t, b, &Y[shape.y(t, d, b)]);
+        }
+    }
+}
+
+} // namespace recurrent
+} // namespace onnc
+#endif
@@ -2,6 +2,7 @@
 #define ONNCRT_TEST_VALARRAY_HPP
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <valarray>
 #include <cstring>
@@ -52,6 +53,23 @@ static bool equal(const std::valarray<T>& x, const std::valarray<T>& y)
     return x.size() == y.size() && !std::memcmp(&x[0], &y[0], x.size() * sizeof(T));
 }
 
+/* Whether `x` and `y` differ by at most `tolerance` relative to `y`, or
+ * absolutely if `y` is small.
+ */
+template<typename T>
+static bool near(const std::valarray<T>& x, const std::valarray<T>& y, T tolerance)
+{
+    if (x.size() != y.size())
+        return false;
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        T scale = std::abs(y[i]) > 1 ? std::abs(y[i]) : 1;
+        if (!(std::abs(x[i] - y[i]) <= tolerance * scale))
+            return false;
+    }
+    return true;
+}
+
 } // namespace valarray
 } // namespace onnc
 #endif
@@ -0,0 +1,186 @@
+//===- SplitNodeTest.cpp --------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Analysis/SplitNode.h>
+#include <onnc/ADT/StringList.h>
+#include <onnc/IR/IRBuilder.h>
+#include <onnc/IR/Module.h>
+#include <onnc/IR/ONNXUtils.h>
+#include <onnc/Target/DLATargetBackend.h>
+#include <onnc/Target/TargetOptions.h>
+#include <onnc/Target/TargetTransformInfo.h>
+#include <string>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Virtual Target
+//===----------------------------------------------------------------------===//
+// A ReLU takes 1000 cycles, a value takes 4 bytes per element, and moving a
+// byte takes a cycle.
+class TilingTargetTransformInfo : public TargetTransformInfo
+{
+public:
+  uint64_t getOperatorCost(const xNode *pNode, unsigned pKind) const override {
+    return 1000;
+  }
+
+  MemSize getOperatorInputMemUsage(const xNode *pNode, unsigned pIdx,
+                                   const LongInts &pNewInputSize) const override {
+    return GetMemSize(pNewInputSize);
+  }
+
+  MemSize getOperatorOutputMemUsage(const xNode *pNode, unsigned pIdx,
+                                    const LongInts &pNewOutputSize) const override {
+    return GetMemSize(pNewOutputSize);
+  }
+
+private:
+  static MemSize GetMemSize(const LongInts& pSizes) {
+    uint64_t size = 4;
+    for (int64_t s : pSizes)
+      size *= s;
+    return MemSize(16, size);
+  }
+};
+
+class TilingTargetBackend : public DLATargetBackend
+{
+public:
+  explicit TilingTargetBackend(const TargetOptions& pOptions)
+    : DLATargetBackend(pOptions) {
+  }
+
+  const TargetTransformInfo* getTTI() const override { return &m_TTI; }
+
+private:
+  TilingTargetTransformInfo m_TTI;
+};
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+/// Load a, b = Relu(a), Store b. Each value is 1x16x8x8.
+static xNode* BuildReluGraph(IRBuilder& pBuilder)
+{
+  pBuilder.CreateTensorGraph("top-level");
+  pBuilder.AddNode("Load", {});
+  pBuilder.AddOutput("a", {1, 16, 8, 8});
+  xNode* relu = pBuilder.AddNode("Relu", {"a"});
+  pBuilder.AddOutput("b", {1, 16, 8, 8});
+  pBuilder.AddNode("Store", {"b"});
+  pBuilder.AddOutput("c", {1, 16, 8, 8});
+  return relu;
+}
+
+/// The memory usage is the sum of the value sizes.
+static uint64_t SumSizes(const ValMemSizeMap& pSizes)
+{
+  uint64_t total = 0;
+  for (const auto& it : pSizes)
+    total += it.second.size;
+  return total;
+}
+
+static uint64_t GetMemUsage(const SplitGraph& pSpGraph)
+{
+  ValMemSizeMap sizes;
+  pSpGraph.getMemUsage(sizes);
+  return SumSizes(sizes);
+}
+
+//===----------------------------------------------------------------------===//
+// SplitNode Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(SplitNodeTest, tiling_candidates)
+{
+  // factors with the same tile size are tried once.
+  SplitGraph::Tilings candidates = SplitGraph::GetTilingCandidates({1, 4, 6});
+  ASSERT_EQ(candidates.size(), 5);
+
+  const unsigned expected[5][2] = { {1, 2}, {1, 4}, {2, 2}, {2, 3}, {2, 6} };
+  for (unsigned i = 0; i < 5; ++i) {
+    EXPECT_EQ(candidates[i].axis, expected[i][0]);
+    EXPECT_EQ(candidates[i].factor, expected[i][1]);
+  }
+
+  EXPECT_TRUE(SplitGraph::GetTilingCandidates({1, 1}).empty());
+}
+
+SKYPAT_F(SplitNodeTest, fits_in_budget)
+{
+  Module module;
+  IRBuilder builder(module);
+  xNode* relu = BuildReluGraph(builder);
+
+  TargetOptions options;
+  TilingTargetBackend backend(options);
+  SplitGraphManager sgMgr(*module.getGraphIR(), backend);
+  SplitGraph& spGraph = *sgMgr.getSplitGraphs().front();
+
+  // no tiling is cheaper than running the graph once.
+  ASSERT_TRUE(spGraph.searchTiling(10000, SumSizes));
+  ASSERT_TRUE(spGraph.getSplitNode(relu)->getNewOutputSize(0) ==
+              LongInts({1, 16, 8, 8}));
+  ASSERT_EQ(GetMemUsage(spGraph), 8192);
+
+  // the ReLU, loading a and storing b.
+  ASSERT_EQ(spGraph.getTilingCost(), 1000 + 4096 + 4096);
+}
+
+SKYPAT_F(SplitNodeTest, must_split)
+{
+  Module module;
+  IRBuilder builder(module);
+  BuildReluGraph(builder);
+
+  TargetOptions options;
+  TilingTargetBackend backend(options);
+  SplitGraphManager sgMgr(*module.getGraphIR(), backend);
+  SplitGraph& spGraph = *sgMgr.getSplitGraphs().front();
+
+  ASSERT_TRUE(spGraph.searchTiling(5000, SumSizes));
+  ASSERT_TRUE(GetMemUsage(spGraph) < 5000);
+}
+
+SKYPAT_F(SplitNodeTest, equal_cost_keeps_first_candidate)
+{
+  Module module;
+  IRBuilder builder(module);
+  xNode* relu = BuildReluGraph(builder);
+
+  TargetOptions options;
+  TilingTargetBackend backend(options);
+  SplitGraphManager sgMgr(*module.getGraphIR(), backend);
+  SplitGraph& spGraph = *sgMgr.getSplitGraphs().front();
+
+  // every tiling into equal tiles costs the same, e.g. 2 or 4 tiles along
+  // the channels, or 2 tiles along the rows. The first fitting one stays.
+  ASSERT_TRUE(spGraph.searchTiling(5000, SumSizes));
+  ASSERT_TRUE(spGraph.getSplitNode(relu)->getNewOutputSize(0) ==
+              LongInts({1, 8, 8, 8}));
+  ASSERT_EQ(spGraph.getTilingCost(), 2 * (500 + 2048 + 2048));
+}
+
+SKYPAT_F(SplitNodeTest, nothing_fits)
+{
+  Module module;
+  IRBuilder builder(module);
+  xNode* relu = BuildReluGraph(builder);
+
+  TargetOptions options;
+  TilingTargetBackend backend(options);
+  SplitGraphManager sgMgr(*module.getGraphIR(), backend);
+  SplitGraph& spGraph = *sgMgr.getSplitGraphs().front();
+
+  // the smallest tiling is kept: one channel per tile.
+  ASSERT_FALSE(spGraph.searchTiling(100, SumSizes));
+  ASSERT_TRUE(spGraph.getSplitNode(relu)->getNewOutputSize(0) ==
+              LongInts({1, 1, 8, 8}));
+  ASSERT_EQ(GetMemUsage(spGraph), 512);
+}